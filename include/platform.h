@@ -122,6 +122,8 @@
 #define platformDelay(t)                      timerDelay(t)             /*!< Performs a delay for the given time (ms)    */
 #define platformGetSysTick()                  platformGetSysTick_zephyr()/*!< Get System Tick ( 1 tick = 1 ms)            */
 #define platformTimerDestroy(t)		       
+#define platformGetCycles()                   timerGetCycles()          /*!< Get the HW cycle counter                    */
+#define platformCyclesToUs(c)                 timerCyclesToUs(c)        /*!< Convert HW cycles to microseconds           */
 
 
 #define platformAssert( exp )                                                              /*!< Asserts whether the given expression is true*/
@@ -201,6 +203,14 @@
     #define platformTimerDestroy( timer )              /*!< Stops and released the given timer            */
 #endif /* platformTimerDestroy */                                                                         
 
+#ifndef platformGetCycles                                                                                 
+    #define platformGetCycles()          platformGetSysTick()  /*!< Get the HW cycle counter (1 tick if none) */
+#endif /* platformGetCycles */                                                                            
+
+#ifndef platformCyclesToUs                                                                                
+    #define platformCyclesToUs( c )      ((c) * 1000U)         /*!< Convert HW cycles to microseconds         */
+#endif /* platformCyclesToUs */                                                                           
+
 #ifndef platformLog                                                                                       
     #define platformLog(...)                           /*!< Log method                                    */
 #endif /* platformLog */
@@ -250,13 +260,27 @@ extern uint8_t globalCommProtectCnt;                                           /
 #define RFAL_FEATURE_ISO_DEP_POLL              true       /*!< Enable/Disable RFAL support for Poller mode (PCD) ISO-DEP (ISO14443-4)    */
 #define RFAL_FEATURE_ISO_DEP_LISTEN            true       /*!< Enable/Disable RFAL support for Listen mode (PICC) ISO-DEP (ISO14443-4)   */
 #define RFAL_FEATURE_NFC_DEP                   true       /*!< Enable/Disable RFAL support for NFC-DEP (NFCIP1/P2P)                      */
+#define RFAL_FEATURE_CD                        true       /*!< Enable/Disable RFAL support for Card Detection pre-filter                 */
+#define RFAL_FEATURE_NFC_STATS                 true       /*!< Enable/Disable RFAL NFC discovery phase latency statistics                */
+#define RFAL_FEATURE_ADAPTIVE_COLL_RES         true       /*!< Enable/Disable adaptive slot count on NFC-B and NFC-F collision resolution*/
+#define RFAL_FEATURE_ISO_DEP_FWT_STATS         true       /*!< Enable/Disable ISO-DEP Poller response time statistics and adaptive FWT   */
+#define RFAL_FEATURE_LLCP                      true       /*!< Enable/Disable RFAL support for LLCP over NFC-DEP                         */
+#define RFAL_FEATURE_SNEP                      true       /*!< Enable/Disable RFAL support for SNEP client and server over LLCP          */
 
 
+#ifdef CONFIG_ST25R3916_LIB_ISO_DEP_FRAME_SIZE
+#define RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN    CONFIG_ST25R3916_LIB_ISO_DEP_FRAME_SIZE /*!< ISO-DEP I-Block max length, set through Kconfig      */
+#else
 #define RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN    256U       /*!< ISO-DEP I-Block max length. Please use values as defined by rfalIsoDepFSx */
+#endif
 #define RFAL_FEATURE_NFC_DEP_BLOCK_MAX_LEN     254U       /*!< NFC-DEP Block/Payload length. Allowed values: 64, 128, 192, 254           */
 #define RFAL_FEATURE_NFC_RF_BUF_LEN            256U       /*!< RF buffer length used by RFAL NFC layer                                   */
 
+#if (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN > 512U)
+#define RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN      RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN /*!< ISO-DEP APDU max length, at least one I-Block           */
+#else
 #define RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN      512U       /*!< ISO-DEP APDU max length.                                                  */
+#endif
 #define RFAL_FEATURE_NFC_DEP_PDU_MAX_LEN       512U       /*!< NFC-DEP PDU max length.                                                   */
 
 /*
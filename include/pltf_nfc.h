@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*! \file pltf_nfc.h
+ *
+ *  \brief Event driven RFAL NFC Data Exchange header file
+ *
+ *   This module lets a thread sleep until the ST25R3916 raises an interrupt
+ *   instead of busy polling rfalNfcWorker() during a Data Exchange, and
+ *   signals the Data Exchange completion through a k_poll_signal.
+ *
+ *   The ST25R3916 interrupt status is read by the thread serving the IRQ
+ *   semaphore given to st25r3916InitInterrupts(), which in turn calls the
+ *   RFAL upper layer callback installed by nfcEventInit().
+ *
+ */
+
+#ifndef PLATFORM_NFC_H
+#define PLATFORM_NFC_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include <zephyr/kernel.h>
+#include "rfal_nfc.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+#ifndef NFC_EVENT_WORKER_PERIOD
+    #define NFC_EVENT_WORKER_PERIOD   10U  /*!< Max time (ms) without running the worker while waiting, serves the RFAL SW timers */
+#endif /* NFC_EVENT_WORKER_PERIOD */
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+ /*!
+ *****************************************************************************
+ * \brief  Initialize NFC events
+ *
+ * Installs the RFAL upper layer callback raising the interrupt event.
+ * Shall be called after rfalNfcInitialize()
+ *****************************************************************************
+ */
+void nfcEventInit( void );
+
+
+ /*!
+ *****************************************************************************
+ * \brief  Wait NFC event
+ *
+ * Blocks the calling thread until the ST25R3916 raises an interrupt or the
+ * given timeout elapses. rfalNfcWorker() is to be executed afterwards.
+ *
+ * \param[in]  timeout : max time to wait
+ *
+ * \return true  : an interrupt has been raised
+ * \return false : timeout
+ *****************************************************************************
+ */
+bool nfcEventWait( k_timeout_t timeout );
+
+
+ /*!
+ *****************************************************************************
+ * \brief  Start Data Exchange signalling its completion
+ *
+ * Starts a Data Exchange (see rfalNfcDataExchangeStart()) and raises the 
+ * given signal with the outcome (ReturnCode) once it terminates. The thread
+ * executing rfalNfcWorker() may wait with nfcEventWait() meanwhile, other
+ * threads may k_poll() on the signal.
+ *
+ * \param[in]  txData    : data to be transmitted
+ * \param[in]  txDataLen : size of the data to be transmitted (in bits or bytes)
+ * \param[out] rxData    : location of the received data after operation is completed
+ * \param[out] rvdLen    : location of the length of the received data (in bits or bytes)
+ * \param[in]  fwt       : FWT to be used in case of RF interface
+ * \param[in]  done      : signal to be raised upon completion
+ *
+ * \return ERR_BUSY      : a signalled Data Exchange is already ongoing
+ * \return ERR_NONE      : No error, exchange started
+ * \return other         : see rfalNfcDataExchangeStart()
+ *****************************************************************************
+ */
+ReturnCode nfcDataExchangeStartSignal( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt, struct k_poll_signal *done );
+
+
+ /*!
+ *****************************************************************************
+ * \brief  Blocking Data Exchange
+ *
+ * Performs a full Data Exchange, running rfalNfcWorker() only when the
+ * ST25R3916 raised an interrupt (or every NFC_EVENT_WORKER_PERIOD) and 
+ * sleeping otherwise, so that other threads are not starved during long
+ * FWT/WTX exchanges. To be called from the thread executing rfalNfcWorker().
+ *
+ * \param[in]  txData    : data to be transmitted
+ * \param[in]  txDataLen : size of the data to be transmitted (in bits or bytes)
+ * \param[out] rxData    : location of the received data after operation is completed
+ * \param[out] rvdLen    : location of the length of the received data (in bits or bytes)
+ * \param[in]  fwt       : FWT to be used in case of RF interface
+ *
+ * \return see rfalNfcDataExchangeGetStatus()
+ *****************************************************************************
+ */
+ReturnCode nfcDataExchangeBlocking( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt );
+
+#endif /* PLATFORM_NFC_H */
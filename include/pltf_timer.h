@@ -101,4 +101,32 @@ bool timerIsExpired( uint32_t timer );
  */
 void timerDelay( uint16_t time );
 
+
+ /*! 
+ *****************************************************************************
+ * \brief  Get Cycles
+ *  
+ * This method returns the free running HW cycle counter, used to measure
+ * short durations with a finer resolution than the System Tick
+ *
+ * \return u32 : current value of the cycle counter
+ *****************************************************************************
+ */
+uint32_t timerGetCycles( void );
+
+
+ /*! 
+ *****************************************************************************
+ * \brief  Cycles To Microseconds
+ *  
+ * This method converts an amount of cycles (as the difference of two 
+ * timerGetCycles() readings) to Microseconds
+ *
+ * \param[in]  cycles : amount of cycles
+ *
+ * \return u32 : the given amount in Microseconds (floor)
+ *****************************************************************************
+ */
+uint32_t timerCyclesToUs( uint32_t cycles );
+
 #endif /* PLATFORM_TIMER */
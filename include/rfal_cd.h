@@ -26,7 +26,10 @@
  *
  *  \brief Implementation of a Card Detection Algorithm
  *
- *
+ *  Cheap, non-blocking presence probe meant as a pre-filter before the 
+ *  full Technology Detection. A single ALL_REQ|ALLB_REQ|SENSF_REQ|INVENTORY 
+ *  is sent per enabled technology on one RF carrier, without the additional 
+ *  exchanges (T1T RID, NFC-F slots retries, Listen phase) of the NFC layer.
  *
  * \addtogroup RFAL
  * @{
@@ -49,8 +52,9 @@
  * INCLUDES
  ******************************************************************************
  */
-#include "rfal_platform.h"
-#include "rfal_utils.h"
+#include "platform.h"
+#include "st_errno.h"
+#include "utils.h"
 
 /*
  ******************************************************************************
@@ -58,6 +62,8 @@
  ******************************************************************************
  */
 
+#define RFAL_CD_TECH_ALL    ((uint8_t)RFAL_CD_TECH_NFCA | (uint8_t)RFAL_CD_TECH_NFCB | (uint8_t)RFAL_CD_TECH_NFCF | (uint8_t)RFAL_CD_TECH_NFCV)  /*!< All technologies probed by Card Detection */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -74,7 +80,7 @@
 typedef enum
 {
     RFAL_CD_TECH_NONE       = 0x00,  /*!< No NFC Technology       */
-    RFAL_CD_TECH_NFCA       = 0x01,  /*!< NFC Technology NFCB     */
+    RFAL_CD_TECH_NFCA       = 0x01,  /*!< NFC Technology NFCA     */
     RFAL_CD_TECH_NFCB       = 0x02,  /*!< NFC Technology NFCB     */
     RFAL_CD_TECH_NFCF       = 0x04,  /*!< NFC Technology NFCF     */
     RFAL_CD_TECH_NFCV       = 0x08,  /*!< NFC Technology NFCV     */
@@ -103,6 +109,7 @@ typedef struct
 {
     bool          detected;         /*!< Card detected flag                                                    */
     rfalCdDetType detType;          /*!< Card detection type                                                   */
+    uint8_t       techs;            /*!< Technologies that answered (rfalCdTech bitmask)                       */
 }
 rfalCdRes;
 
@@ -121,12 +128,11 @@ rfalCdRes;
  *
  * \param[out]  result             : Pointer to detection result|outcome
  *                            
- * \return  RFAL_ERR_PARAM         : Invalid parameters
- * \return  RFAL_ERR_WRONG_STATE   : Incorrect state for this operation
- * \return  RFAL_ERR_NONE          : Detection excuted with no error
- * \return  RFAL_ERR_RF_COLLISION  : RF carrier collision detected
- * \return  RFAL_ERR_XXXX          : Error occurred
- 
+ * \return  ERR_PARAM         : Invalid parameters
+ * \return  ERR_WRONG_STATE   : Incorrect state for this operation
+ * \return  ERR_NONE          : Detection excuted with no error
+ * \return  ERR_RF_COLLISION  : RF carrier collision detected
+ * \return  ERR_XXXX          : Error occurred
  *
  *****************************************************************************
  */
@@ -138,30 +144,53 @@ ReturnCode rfalCdDetectCard( rfalCdRes *result );
  * \brief  Start Card Detection
  *
  * This function starts the detection for a passive NFC card is present 
- * in the vicinity
+ * in the vicinity, probing all the technologies supported (RFAL_CD_TECH_ALL)
+ * The result is only valid once rfalCdGetDetectCardStatus() has returned 
+ * ERR_NONE. Starting a new detection aborts any ongoing one.
  *
  * \param[out]  result             : Pointer to detection result|outcome
  *
- * \return  RFAL_ERR_PARAM         : Invalid parameters
- * \return  RFAL_ERR_WRONG_STATE   : Incorrect state for this operation
- * \return  RFAL_ERR_NONE          : Detection will be executed
+ * \return  ERR_PARAM         : Invalid parameters
+ * \return  ERR_NONE          : Detection will be executed
  *
  *****************************************************************************
  */
 ReturnCode rfalCdStartDetectCard( rfalCdRes *result );
 
 
+/*!
+ *****************************************************************************
+ * \brief  Start Card Detection on the given technologies
+ *
+ * Same as rfalCdStartDetectCard() but only probes the given technologies
+ * so that the callers can skip those they are not interested in.
+ * The field is switched Off when nothing is detected and kept On otherwise,
+ * allowing the following Technology Detection to proceed right away.
+ *
+ * \param[in]   techs              : Technologies to probe (rfalCdTech bitmask)
+ * \param[out]  result             : Pointer to detection result|outcome
+ *
+ * \return  ERR_PARAM         : Invalid parameters
+ * \return  ERR_NONE          : Detection will be executed
+ *
+ *****************************************************************************
+ */
+ReturnCode rfalCdStartDetectCardTechs( uint8_t techs, rfalCdRes *result );
+
+
 /*!
  *****************************************************************************
  * \brief  Get Card Detection Status
  *
- * This function gets the status of the card detection
+ * This function gets the status of the card detection and advances it
+ * rfalWorker() must be executed in between calls
  *
- * \return  RFAL_ERR_PARAM         : Invalid parameters
- * \return  RFAL_ERR_WRONG_STATE   : Incorrect state for this operation
- * \return  RFAL_ERR_NONE          : Detection excuted with no error
- * \return  RFAL_ERR_RF_COLLISION  : RF carrier collision detected
- * \return  RFAL_ERR_XXXX          : Error occurred
+ * \return  ERR_PARAM         : Invalid parameters
+ * \return  ERR_WRONG_STATE   : Incorrect state for this operation
+ * \return  ERR_BUSY          : Detection ongoing
+ * \return  ERR_NONE          : Detection excuted with no error
+ * \return  ERR_RF_COLLISION  : RF carrier collision detected
+ * \return  ERR_XXXX          : Error occurred
  *
  *****************************************************************************
  */
@@ -108,6 +108,35 @@
 
 
 #define RFAL_ISODEP_FSDI_DEFAULT                RFAL_ISODEP_FSXI_256  /*!< Default Frame Size Integer in Poll mode              */
+
+/*! Largest Frame Size Integer the I-Block buffers can hold (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN), max FSDI announced in Poll mode */
+#if   (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 4096U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_4096
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 2048U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_2048
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 1024U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_1024
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 512U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_512
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 256U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_256
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 128U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_128
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 96U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_96
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 64U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_64
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 48U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_48
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 40U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_40
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 32U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_32
+#elif (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN >= 24U)
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_24
+#else
+    #define RFAL_ISODEP_FSDI_MAX                RFAL_ISODEP_FSXI_16
+#endif
 #define RFAL_ISODEP_FSX_KEEP                    (0xFFU)               /*!< Flag to keep FSX from activation                     */
 #define RFAL_ISODEP_DEFAULT_FSCI                RFAL_ISODEP_FSXI_256  /*!< FSCI default value to be used  in Listen Mode        */
 #define RFAL_ISODEP_DEFAULT_FSC                 RFAL_ISODEP_FSX_256   /*!< FSC default value (aligned RFAL_ISODEP_DEFAULT_FSCI) */
@@ -116,6 +145,10 @@
 
 #define RFAL_ISODEP_APDU_MAX_LEN                RFAL_ISODEP_FSX_1024  /*!< Max APDU length                                      */
 
+#define RFAL_ISODEP_SCRIPT_NO_PARAM             (0xFFU)  /*!< APDU script step without a parameter from a previous response     */
+
+#define RFAL_ISODEP_FWT_HIST_LEN                (9U)     /*!< Response time histogram bins: <= FWT/128, FWT/64, ... FWT, > FWT   */
+
 #define RFAL_ISODEP_ATTRIB_RES_MBLI_NO_INFO     (0x00U)  /*!< MBLI indicating no information on its internal input buffer size  */
 #define RFAL_ISODEP_ATTRIB_REQ_PARAM1_DEFAULT   (0x00U)  /*!< Default values of Param 1 of ATTRIB_REQ Digital 1.0  12.6.1.3-5   */
 #define RFAL_ISODEP_ATTRIB_HLINFO_LEN           (32U)    /*!< Maximum Size of Higher Layer Information                          */
@@ -419,6 +452,122 @@ typedef struct
     uint8_t                  DID;                      /*!< Device ID (RFAL_ISODEP_NO_DID if no DID) */
 } rfalIsoDepApduTxRxParam;
 
+
+/*! 
+ * ISO-DEP APDU stream producer, fills the next chunk of the command
+ * 
+ * \param[in]  ctx    : caller context given on rfalIsoDepApduStreamParam
+ * \param[out] buf    : location where the chunk is to be placed
+ * \param[in]  maxLen : maximum chunk length (INF of one I-Block)
+ * \param[out] len    : chunk length placed on buf
+ * \param[out] more   : set to true if the command has further chunks
+ */
+typedef ReturnCode (* rfalIsoDepApduTxCb)( void *ctx, uint8_t *buf, uint16_t maxLen, uint16_t *len, bool *more );
+
+
+/*! 
+ * ISO-DEP APDU stream consumer, called for every chunk of the response
+ * 
+ * \param[in]  ctx    : caller context given on rfalIsoDepApduStreamParam
+ * \param[in]  data   : chunk received (INF of one I-Block)
+ * \param[in]  len    : chunk length
+ * \param[in]  last   : true on the last chunk of the response
+ */
+typedef ReturnCode (* rfalIsoDepApduRxCb)( void *ctx, const uint8_t *data, uint16_t len, bool last );
+
+
+/*! Structure of parameters used on ISO DEP APDU Stream Transceive */
+typedef struct
+{
+    rfalIsoDepApduTxCb       txCb;                     /*!< Command producer                         */
+    rfalIsoDepApduRxCb       rxCb;                     /*!< Response consumer                        */
+    void                     *ctx;                     /*!< Caller context passed to txCb and rxCb   */
+    rfalIsoDepBufFormat      *txBuf;                   /*!< Buffer for one Tx I-Block                */
+    rfalIsoDepBufFormat      *rxBuf;                   /*!< Buffer for one Rx I-Block, not txBuf     */
+    uint32_t                 *rxLen;                   /*!< Total response length in Bytes (optional)*/
+    uint32_t                 FWT;                      /*!< FWT to be used (ignored in Listen Mode)  */
+    uint32_t                 dFWT;                     /*!< Delta FWT to be used                     */
+    uint16_t                 FSx;                      /*!< Other device Frame Size (FSD or FSC)     */
+    uint16_t                 ourFSx;                   /*!< Our device Frame Size (FSD or FSC)       */
+    uint8_t                  DID;                      /*!< Device ID (RFAL_ISODEP_NO_DID if no DID) */
+} rfalIsoDepApduStreamParam;
+
+
+/*! Action taken by the APDU script when the SW1SW2 of a step does not match */
+typedef enum
+{
+    RFAL_ISODEP_SCRIPT_ABORT    = 0,   /*!< Stop the script with ERR_REQUEST                       */
+    RFAL_ISODEP_SCRIPT_END      = 1,   /*!< Stop the script with ERR_NONE, the flow ends here      */
+    RFAL_ISODEP_SCRIPT_CONTINUE = 2    /*!< Go on with the next step                               */
+} rfalIsoDepScriptAction;
+
+
+/*! APDU script step */
+typedef struct
+{
+    const uint8_t            *cApdu;                   /*!< C-APDU                                           */
+    uint16_t                 cApduLen;                 /*!< C-APDU length                                    */
+    uint16_t                 sw;                       /*!< Expected SW1SW2                                  */
+    uint16_t                 swMask;                   /*!< SW1SW2 bits compared (0x0000: any)               */
+    rfalIsoDepScriptAction   onMismatch;               /*!< Action if the SW1SW2 does not match              */
+    uint8_t                  paramStep;                /*!< Step whose R-APDU provides a C-APDU byte (e.g. Le), RFAL_ISODEP_SCRIPT_NO_PARAM: none */
+    int16_t                  paramSrc;                 /*!< Position of that byte on the R-APDU, negative from its end (-1: SW2)  */
+    uint16_t                 paramDst;                 /*!< Position on the C-APDU the byte is placed at     */
+} rfalIsoDepApduStep;
+
+
+/*! ISO-DEP Poller response time statistics of the current session (times in us) */
+typedef struct
+{
+    uint32_t                 rspCnt;                   /*!< Responses timed (I, R and S blocks)              */
+    uint32_t                 rtMin;                    /*!< Shortest response time (end of Tx to end of Rx, the Tx end being estimated from the block length and bit rate) */
+    uint32_t                 rtMax;                    /*!< Longest response time                            */
+    uint64_t                 rtTotal;                  /*!< Accumulated response time, average is rtTotal / rspCnt */
+    uint32_t                 hist[RFAL_ISODEP_FWT_HIST_LEN]; /*!< Responses per bin, bin i up to FWT/2^(7-i), last bin beyond FWT (after WTX) */
+    uint32_t                 wtxCnt;                   /*!< S(WTX) requests received                         */
+    uint8_t                  wtxmMax;                  /*!< Highest WTXM requested                           */
+    uint32_t                 timeoutCnt;               /*!< Timeouts                                         */
+    uint32_t                 localTimeoutCnt;          /*!< Learned local FWT expiries (reception went on up to FWT) */
+    uint32_t                 fwt;                      /*!< FWT of the session (from activation)             */
+    uint32_t                 localFwt;                 /*!< Learned local FWT, 0 if not in use               */
+} rfalIsoDepFwtStats;
+
+
+/*! ISO-DEP Poller link counters of the current session */
+typedef struct
+{
+    uint32_t                 blkCnt;                   /*!< Blocks received or timed out (I, R and S blocks) */
+    uint32_t                 errCnt;                   /*!< Blocks lost to a transmission error or timeout, recovered or not */
+} rfalIsoDepLinkStats;
+
+
+/*! APDU script step response, located on the arena */
+typedef struct
+{
+    uint16_t                 pos;                      /*!< R-APDU position on the arena                     */
+    uint16_t                 len;                      /*!< R-APDU length (data and SW1SW2)                  */
+} rfalIsoDepApduStepRes;
+
+
+/*! Structure of parameters used on ISO DEP APDU Script */
+typedef struct
+{
+    const rfalIsoDepApduStep *steps;                   /*!< Steps to be executed in order                    */
+    uint8_t                  stepCnt;                  /*!< Number of steps                                  */
+    rfalIsoDepApduStepRes    *res;                     /*!< Response of each step (stepCnt entries)          */
+    uint8_t                  *resCnt;                  /*!< Number of steps executed                         */
+    uint8_t                  *arena;                   /*!< R-APDUs placed back to back                      */
+    uint16_t                 arenaLen;                 /*!< Arena length in Bytes                            */
+    rfalIsoDepApduBufFormat  *txBuf;                   /*!< Transmit Buffer struct reference                 */
+    rfalIsoDepApduBufFormat  *rxBuf;                   /*!< Receive Buffer struct reference                  */
+    rfalIsoDepBufFormat      *tmpBuf;                  /*!< Temp buffer for Rx I-Blocks (internal)           */
+    uint32_t                 FWT;                      /*!< FWT to be used (ignored in Listen Mode)          */
+    uint32_t                 dFWT;                     /*!< Delta FWT to be used                             */
+    uint16_t                 FSx;                      /*!< Other device Frame Size (FSD or FSC)             */
+    uint16_t                 ourFSx;                   /*!< Our device Frame Size (FSD or FSC)               */
+    uint8_t                  DID;                      /*!< Device ID (RFAL_ISODEP_NO_DID if no DID)         */
+} rfalIsoDepApduScriptParam;
+
 /*
  ******************************************************************************
  * GLOBAL FUNCTION PROTOTYPES
@@ -675,6 +824,13 @@ ReturnCode rfalIsoDepGetTransceiveStatus( void );
  *  The txBuf  contains a complete APDU to be transmitted 
  *  The Prologue field will be manipulated by the Transceive
  *  
+ *  Chained I-Blocks are framed and received in place: the ISO-DEP header of
+ *  each block is written on the bytes preceding its INF within the APDU 
+ *  buffers, no APDU data is copied. As Poller the response is received 
+ *  directly into rxBuf, param.tmpBuf is only used for the R-Blocks, for the
+ *  first response I-Block when txBuf and rxBuf are the same buffer and in 
+ *  Listen mode
+ *  
  *  \warning the txBuf will be modified during the transmission
  *  \warning the maximum RF frame which can be received is limited by param.tmpBuf
  *  
@@ -705,6 +861,154 @@ ReturnCode rfalIsoDepStartApduTransceive( rfalIsoDepApduTxRxParam param );
  */
 ReturnCode rfalIsoDepGetApduTransceiveStatus( void );
 
+
+/*!
+ *****************************************************************************
+ *  \brief ISO-DEP Start APDU Stream Transceive 
+ *  
+ *  This method triggers a ISO-DEP Transceive of an APDU of any length 
+ *  through a single I-Block buffer per direction. 
+ *  The command is pulled from param.txCb one I-Block at a time and each 
+ *  I-Block of the response is handed to param.rxCb as soon as it is 
+ *  received, so the APDU is not limited by RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN
+ *  
+ *  The callbacks are called from rfalIsoDepStartApduStream() and 
+ *  rfalIsoDepGetApduStreamStatus() context. Data given to param.rxCb is
+ *  only valid during the call
+ *  
+ *  \param[in] param: reference parameters to be used for the Transceive
+ *                     
+ *  \return ERR_PARAM       : Bad request
+ *  \return ERR_WRONG_STATE : The module is not in a proper state
+ *  \return ERR_NONE        : The Transceive request has been started
+ *  \return                 : Error returned by param.txCb
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepStartApduStream( rfalIsoDepApduStreamParam param );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Get the APDU Stream Transceive status
+ *  
+ *  An error returned by a callback aborts the stream and is returned here, 
+ *  the ISO-DEP link is then to be deselected before starting a new APDU 
+ *  
+ *  \return ERR_NONE      : if Transceive has been completed successfully
+ *  \return ERR_BUSY      : if Transceive is ongoing
+ *  \return ERR_PROTO     : if a protocol error occurred
+ *  \return ERR_TIMEOUT   : if a timeout error occurred
+ *  \return ERR_SLEEP_REQ : if Deselect is received and responded
+ *  \return ERR_LINK_LOSS : if communication is lost because Reader/Writer 
+ *                            has turned off its field
+ *  \return               : Error returned by param.txCb or param.rxCb
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepGetApduStreamStatus( void );
+
+
+/*!
+ *****************************************************************************
+ *  \brief ISO-DEP Start APDU Script
+ *  
+ *  This method triggers the execution of a sequence of APDUs back to back, 
+ *  each step being started as soon as the previous R-APDU is checked, with
+ *  no round trip to the caller in between. 
+ *  
+ *  For each step the C-APDU is copied to param.txBuf and, if paramStep is 
+ *  set, one of its bytes is replaced by a byte of a previous R-APDU (e.g. 
+ *  the Le from the SW2 of a 61xx/6Cxx). The SW1SW2 of the R-APDU is then 
+ *  compared with sw under swMask and on mismatch onMismatch is applied.
+ *  Every R-APDU is placed back to back on param.arena, located by param.res
+ *  
+ *  \param[in] param: reference parameters to be used for the Script
+ *                     
+ *  \return ERR_PARAM       : Bad request
+ *  \return ERR_NOMEM       : A C-APDU does not fit into param.txBuf
+ *  \return ERR_WRONG_STATE : The module is not in a proper state
+ *  \return ERR_NONE        : The Script has been started
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepStartApduScript( const rfalIsoDepApduScriptParam *param );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Get the APDU Script status
+ *  
+ *  The param.resCnt and param.res hold the steps executed so far, also 
+ *  when the Script is aborted
+ *  
+ *  \return ERR_NONE      : if the Script has been completed successfully
+ *  \return ERR_BUSY      : if the Script is ongoing
+ *  \return ERR_REQUEST   : if a SW1SW2 did not match on an aborting step
+ *  \return ERR_NOMEM     : if an R-APDU does not fit into the arena
+ *  \return ERR_PROTO     : if an R-APDU has no SW1SW2 or a parameter 
+ *                            is not present on its R-APDU
+ *  \return ERR_TIMEOUT   : if a timeout error occurred
+ *  \return ERR_LINK_LOSS : if communication is lost because Reader/Writer 
+ *                            has turned off its field
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepGetApduScriptStatus( void );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Get the ISO-DEP response time statistics
+ *  
+ *  Returns the response times, WTX requests and timeouts recorded as 
+ *  Poller since the last activation (RATS/ATTRIB)
+ *  
+ *  \param[out] stats : location to place the statistics
+ *  
+ *  \return ERR_PARAM    : Invalid parameter
+ *  \return ERR_DISABLED : Statistics disabled (RFAL_FEATURE_ISO_DEP_FWT_STATS)
+ *  \return ERR_NONE     : No error, statistics placed on stats
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepGetFwtStats( rfalIsoDepFwtStats *stats );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Get the ISO-DEP link counters
+ *  
+ *  Returns the blocks exchanged and the transmission errors (CRC, parity,
+ *  framing and timeout) recorded as Poller since the last activation 
+ *  (RATS/ATTRIB), including the ones ISO-DEP recovered with R-Blocks
+ *  
+ *  \param[out] stats : location to place the counters
+ *  
+ *  \return ERR_PARAM    : Invalid parameter
+ *  \return ERR_NONE     : No error, counters placed on stats
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepGetLinkStats( rfalIsoDepLinkStats *stats );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Set the ISO-DEP adaptive FWT
+ *  
+ *  When enabled, once enough responses of the card have been timed in the 
+ *  current session, the Poller waits for a response only twice the longest
+ *  response seen (plus dFWT) instead of the full FWT, so that transmission
+ *  errors are noticed sooner. 
+ *  The card still has up to FWT: once the local FWT expires reception goes
+ *  on until FWT + dFWT, only then the timeout is handled (ISO14443-4 rule 4,
+ *  R(NAK)). The full FWT is used for the rest of the exchange, while the 
+ *  following ones wait twice as long.
+ *  Not applied in EMVCo compliance mode. The setting is kept across sessions
+ *  
+ *  \param[in] enable : true to enable the adaptive FWT
+ *  
+ *  \return ERR_DISABLED : Statistics disabled (RFAL_FEATURE_ISO_DEP_FWT_STATS)
+ *  \return ERR_NONE     : No error
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepSetFwtAdaptive( bool enable );
+
 /*! 
  *****************************************************************************
  *  \brief  ISO-DEP Send RATS
@@ -806,6 +1110,57 @@ ReturnCode rfalIsoDepATTRIB( const uint8_t* nfcid0, uint8_t PARAM1, rfalBitRate
 ReturnCode rfalIsoDepDeselect( void );
 
 
+/*! 
+ *****************************************************************************
+ *  \brief  ISO-DEP Presence Check
+ *
+ *  This function checks whether the activated PICC is still in the field 
+ *  by sending a R(NAK) and expecting a R(ACK)  ISO14443-4 Rule 12.
+ *  The block number and the last exchanged data are not affected
+ *
+ *  \param[in]  fwt : FWT to be used (including delta FWT)
+ *
+ *  \return ERR_WRONG_STATE : ISO-DEP not in Poller role
+ *  \return ERR_TIMEOUT     : No response rcvd from PICC 
+ *  \return ERR_PROTO       : Response is not a R-Block
+ *  \return ERR_NONE        : PICC present
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepPresenceCheck( uint32_t fwt );
+
+
+/*! 
+ *****************************************************************************
+ *  \brief  ISO-DEP Start Presence Check
+ *
+ *  This function starts the R(NAK) presence check, see rfalIsoDepPresenceCheck()
+ *  Its outcome is retrieved by rfalIsoDepGetPresenceCheckStatus()
+ *
+ *  \param[in]  fwt : FWT to be used (including delta FWT)
+ *
+ *  \return ERR_WRONG_STATE : ISO-DEP not in Poller role
+ *  \return ERR_NONE        : Presence check started
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepStartPresenceCheck( uint32_t fwt );
+
+
+/*! 
+ *****************************************************************************
+ *  \brief  ISO-DEP Get Presence Check Status
+ *
+ *  Returns the status of the presence check started by 
+ *  rfalIsoDepStartPresenceCheck()
+ *
+ *  \return ERR_BUSY    : Presence check ongoing
+ *  \return ERR_TIMEOUT : No response rcvd from PICC 
+ *  \return ERR_PROTO   : Response is not a R-Block
+ *  \return ERR_NONE    : PICC present
+ *****************************************************************************
+ */
+ReturnCode rfalIsoDepGetPresenceCheckStatus( void );
+
+
 /*! 
  *****************************************************************************
  *  \brief  ISO-DEP Poller Handle NFC-A Activation
@@ -0,0 +1,415 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2020 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file rfal_llcp.h
+ *
+ *  \author
+ *
+ *  \brief Provides an NFC Forum LLCP layer on top of NFC-DEP
+ *
+ *  This module implements the Logical Link Control Protocol over an
+ *  activated NFC-DEP device, either as Initiator or as Target:
+ *    - LLC link activation through the General Bytes and deactivation
+ *    - Symmetry, keeping SYMM PDUs to the minimum: a pending PDU is always
+ *      sent instead of a SYMM and an idle Initiator holds the next SYMM
+ *      for half of the remote Link Timeout
+ *    - Connectionless links (UI PDUs)
+ *    - Connection-oriented links (CONNECT, CC, DISC, DM, I, RR, RNR) with
+ *      the I PDUs of a link sent back to back up to the remote Receive Window
+ *
+ *  PDUs are composed and parsed in place on the NFC-DEP PDU buffers, the
+ *  information field of a received PDU is handed to the link callback
+ *  straight from the receive buffer.
+ *
+ *  This implementation was based on the following specs:
+ *    - NFC Forum Logical Link Control Protocol 1.1 2011-06-16
+ *
+ * \addtogroup RFAL
+ * @{
+ *
+ * \addtogroup RFAL-AL
+ * \brief RFAL Abstraction Layer
+ * @{
+ *
+ * \addtogroup LLCP
+ * \brief RFAL LLCP Module
+ * @{
+ *
+ */
+
+#ifndef RFAL_LLCP_H
+#define RFAL_LLCP_H
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "platform.h"
+#include "st_errno.h"
+#include "rfal_nfcDep.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#ifndef RFAL_LLCP_LINK_MAX
+    #define RFAL_LLCP_LINK_MAX          4U       /*!< Number of data links handled concurrently                 */
+#endif
+
+#ifndef RFAL_LLCP_LTO
+    #define RFAL_LLCP_LTO               10U      /*!< Local Link Timeout advertised (10ms units)                */
+#endif
+
+#ifndef RFAL_LLCP_RW
+    #define RFAL_LLCP_RW                4U       /*!< Local Receive Window advertised on connections            */
+#endif
+
+#define RFAL_LLCP_HEADER_LEN            2U       /*!< DSAP | PTYPE | SSAP                                        */
+#define RFAL_LLCP_SEQ_LEN               1U       /*!< N(S) | N(R)                                                */
+#define RFAL_LLCP_MIU_DEFAULT           128U     /*!< Default Maximum Information Unit                           */
+#define RFAL_LLCP_MIU                   (RFAL_FEATURE_NFC_DEP_PDU_MAX_LEN - RFAL_LLCP_HEADER_LEN - RFAL_LLCP_SEQ_LEN) /*!< Local MIU, bound by the NFC-DEP PDU buffer */
+
+#define RFAL_LLCP_SAP_LINK_MGMT         0x00U    /*!< LLC Link Management SAP                                    */
+#define RFAL_LLCP_SAP_SDP               0x01U    /*!< Service Discovery Protocol SAP                             */
+#define RFAL_LLCP_SAP_SNEP              0x04U    /*!< SNEP Server well-known SAP                                 */
+#define RFAL_LLCP_SAP_INVALID           0xFFU    /*!< Invalid SAP                                                */
+
+#define RFAL_LLCP_WKS_LINK_MGMT         0x0001U  /*!< Well-Known Service List bit of the LLC Link Management     */
+#define RFAL_LLCP_WKS_SDP               0x0002U  /*!< Well-Known Service List bit of the SDP                     */
+#define RFAL_LLCP_WKS_SNEP              0x0010U  /*!< Well-Known Service List bit of the SNEP Server             */
+
+#define RFAL_LLCP_GB_MAX_LEN            20U      /*!< Length of the General Bytes composed by rfalLlcpGetGeneralBytes() */
+
+#define RFAL_LLCP_LINK_INVALID          0xFFU    /*!< Invalid link handle                                        */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! LLCP PDU types   LLCP 1.1 Table 2 */
+typedef enum
+{
+    RFAL_LLCP_PTYPE_SYMM    = 0x00,              /*!< Symmetry                                     */
+    RFAL_LLCP_PTYPE_PAX     = 0x01,              /*!< Parameter Exchange                           */
+    RFAL_LLCP_PTYPE_AGF     = 0x02,              /*!< Aggregated Frame                             */
+    RFAL_LLCP_PTYPE_UI      = 0x03,              /*!< Unnumbered Information                       */
+    RFAL_LLCP_PTYPE_CONNECT = 0x04,              /*!< Connect                                      */
+    RFAL_LLCP_PTYPE_DISC    = 0x05,              /*!< Disconnect                                   */
+    RFAL_LLCP_PTYPE_CC      = 0x06,              /*!< Connection Complete                          */
+    RFAL_LLCP_PTYPE_DM      = 0x07,              /*!< Disconnected Mode                            */
+    RFAL_LLCP_PTYPE_FRMR    = 0x08,              /*!< Frame Reject                                 */
+    RFAL_LLCP_PTYPE_SNL     = 0x09,              /*!< Service Name Lookup                          */
+    RFAL_LLCP_PTYPE_I       = 0x0C,              /*!< Information                                  */
+    RFAL_LLCP_PTYPE_RR      = 0x0D,              /*!< Receive Ready                                */
+    RFAL_LLCP_PTYPE_RNR     = 0x0E               /*!< Receive Not Ready                            */
+} rfalLlcpPType;
+
+
+/*! LLCP data link states */
+typedef enum
+{
+    RFAL_LLCP_LINK_ST_FREE,                      /*!< Link not in use                              */
+    RFAL_LLCP_LINK_ST_CONNLESS,                  /*!< Connectionless link bound                    */
+    RFAL_LLCP_LINK_ST_LISTEN,                    /*!< Waiting for a CONNECT                        */
+    RFAL_LLCP_LINK_ST_CONNECTING,                /*!< CONNECT sent, waiting for CC                 */
+    RFAL_LLCP_LINK_ST_CONNECTED,                 /*!< Data link connection established             */
+    RFAL_LLCP_LINK_ST_DISCONNECTING,             /*!< DISC sent, waiting for DM                    */
+    RFAL_LLCP_LINK_ST_CLOSED                     /*!< Connection closed or refused                 */
+} rfalLlcpLinkState;
+
+
+/*!
+ * LLCP link receive callback, called for the information field of each
+ * UI or I PDU received on the link. On a listening link it is also called
+ * without data (NULL, 0) when a connection is accepted
+ *
+ * \param[in]  ctx   : caller context given when the link was created
+ * \param[in]  link  : link handle
+ * \param[in]  data  : information field, only valid during the call
+ * \param[in]  len   : information field length
+ */
+typedef void (* rfalLlcpRxCb)( void *ctx, uint8_t link, const uint8_t *data, uint16_t len );
+
+
+/*! LLCP start parameters */
+typedef struct
+{
+    const rfalNfcDepDevice   *nfcDepDev;         /*!< Activated NFC-DEP device (GB, LR, FWT)       */
+    bool                     isInitiator;        /*!< We are the NFC-DEP Initiator                 */
+    rfalNfcDepPduBufFormat   *txBuf;             /*!< PDU transmit buffer                          */
+    rfalNfcDepPduBufFormat   *rxBuf;             /*!< PDU receive buffer                           */
+    rfalNfcDepBufFormat      *tmpBuf;            /*!< NFC-DEP block buffer used on chaining        */
+    const uint8_t            *firstPdu;          /*!< Target: PDU received with the activation     */
+    uint16_t                 firstPduLen;        /*!< Target: first PDU length                     */
+} rfalLlcpParam;
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ ******************************************************************************
+ */
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Get General Bytes
+ *
+ * Composes the General Bytes to be given on the ATR_REQ/ATR_RES: LLCP magic
+ * number followed by the VERSION, MIUX, WKS, LTO and OPT parameters.
+ * The MIU advertised is the largest the NFC-DEP PDU buffer can receive
+ *
+ * \param[in]   wks   : Well-Known Service List (RFAL_LLCP_WKS_*)
+ * \param[out]  gb    : General Bytes, at least RFAL_LLCP_GB_MAX_LEN long
+ * \param[out]  gbLen : General Bytes length
+ *
+ * \return ERR_PARAM  : Invalid parameter
+ * \return ERR_NONE   : General Bytes composed
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpGetGeneralBytes( uint16_t wks, uint8_t *gb, uint8_t *gbLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Start
+ *
+ * Activates the LLC link over the given NFC-DEP device: the remote General
+ * Bytes are checked for the LLCP magic number and its VERSION, MIUX, WKS and
+ * LTO parameters are retrieved.
+ * Links are to be created after this call and before the first call to
+ * rfalLlcpWorker(), which for a Target processes param->firstPdu
+ *
+ * \param[in]  param : LLCP parameters, the buffers shall be kept while
+ *                     the LLC link is active
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_PROTO      : Remote General Bytes without LLCP magic number
+ * \return ERR_NOTSUPP    : Incompatible LLCP major version
+ * \return ERR_NONE       : LLC link activated
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpStart( const rfalLlcpParam *param );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Worker
+ *
+ * Drives the LLC link: exchanges one PDU in each direction per NFC-DEP
+ * transceive, delivers the received information to the links and composes
+ * the next PDU to be sent. Shall be called periodically while it returns
+ * ERR_BUSY
+ *
+ * \return ERR_BUSY       : LLC link active
+ * \return ERR_NONE       : LLC link deactivated by either side
+ * \return ERR_WRONG_STATE: LLCP not started
+ * \return Other          : NFC-DEP error, LLC link lost
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpWorker( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Deactivate
+ *
+ * Requests the LLC link deactivation, a DISC to the LLC Link Management
+ * SAP is sent by the following rfalLlcpWorker() calls
+ *
+ * \return ERR_WRONG_STATE: LLCP not started
+ * \return ERR_NONE       : Deactivation requested
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpDeactivate( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Connect
+ *
+ * Creates a connection-oriented link and requests its connection to the
+ * given remote SAP, or by service name through the SDP when sn is given
+ *
+ * \param[in]   dsap  : remote SAP (ignored when sn is given)
+ * \param[in]   sn    : remote service name (optional, may be NULL)
+ * \param[in]   rxCb  : callback for the data received on the link
+ * \param[in]   ctx   : caller context given to rxCb
+ * \param[out]  link  : link handle
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_NOMEM      : No link or SAP available
+ * \return ERR_NONE       : CONNECT queued
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpConnect( uint8_t dsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Listen
+ *
+ * Creates a connection-oriented link on the given local SAP which accepts
+ * the first CONNECT addressed to the SAP, or to the SDP with the given
+ * service name. Once that connection is closed the link listens again
+ *
+ * \param[in]   lsap  : local SAP
+ * \param[in]   sn    : local service name (optional, may be NULL)
+ * \param[in]   rxCb  : callback for the data received on the link
+ * \param[in]   ctx   : caller context given to rxCb
+ * \param[out]  link  : link handle
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_NOMEM      : No link available
+ * \return ERR_NONE       : Listening
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpListen( uint8_t lsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Bind
+ *
+ * Creates a connectionless link between the given local and remote SAPs
+ *
+ * \param[in]   lsap  : local SAP
+ * \param[in]   dsap  : remote SAP
+ * \param[in]   rxCb  : callback for the UI PDUs received on lsap
+ * \param[in]   ctx   : caller context given to rxCb
+ * \param[out]  link  : link handle
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_NOMEM      : No link available
+ * \return ERR_NONE       : Link bound
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpBind( uint8_t lsap, uint8_t dsap, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Send
+ *
+ * Queues hdr followed by data to be sent on the link. The information is
+ * split on the link MIU: into I PDUs on a connected link, sent without
+ * waiting for their acknowledgement while the remote Receive Window allows,
+ * or into UI PDUs on a connectionless link.
+ * Each PDU is filled straight from the given buffers, which shall be kept
+ * until rfalLlcpGetSendStatus() returns other than ERR_BUSY
+ *
+ * \param[in]   link    : link handle
+ * \param[in]   hdr     : data to be sent before data (optional, may be NULL)
+ * \param[in]   hdrLen  : hdr length
+ * \param[in]   data    : data to be sent
+ * \param[in]   dataLen : data length
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_WRONG_STATE: Link not connected/bound
+ * \return ERR_BUSY       : Previous data still being sent
+ * \return ERR_NONE       : Data queued
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpSend( uint8_t link, const uint8_t *hdr, uint8_t hdrLen, const uint8_t *data, uint32_t dataLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Get Send Status
+ *
+ * \param[in]   link    : link handle
+ *
+ * \return ERR_BUSY       : Data still queued or not yet acknowledged
+ * \return ERR_LINK_LOSS  : Link closed before all data was acknowledged
+ * \return ERR_PARAM      : Invalid link
+ * \return ERR_NONE       : All data sent and acknowledged
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpGetSendStatus( uint8_t link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Disconnect
+ *
+ * Requests the disconnection of a connected link, a DISC is sent by the
+ * following rfalLlcpWorker() calls
+ *
+ * \param[in]   link    : link handle
+ *
+ * \return ERR_PARAM      : Invalid link
+ * \return ERR_WRONG_STATE: Link not connected
+ * \return ERR_NONE       : DISC queued
+ *****************************************************************************
+ */
+ReturnCode rfalLlcpDisconnect( uint8_t link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Release
+ *
+ * Frees the given link, no PDU is sent
+ *
+ * \param[in]   link    : link handle
+ *****************************************************************************
+ */
+void rfalLlcpRelease( uint8_t link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Get Link State
+ *
+ * \param[in]   link    : link handle
+ *
+ * \return the link state, RFAL_LLCP_LINK_ST_FREE for an invalid link
+ *****************************************************************************
+ */
+rfalLlcpLinkState rfalLlcpGetLinkState( uint8_t link );
+
+
+/*!
+ *****************************************************************************
+ * \brief  LLCP Get Link MIU
+ *
+ * \param[in]   link    : link handle
+ *
+ * \return the largest information field to be sent in one PDU on the link
+ *****************************************************************************
+ */
+uint16_t rfalLlcpGetLinkMiu( uint8_t link );
+
+#endif /* RFAL_LLCP_H */
+
+/**
+  * @}
+  *
+  * @}
+  *
+  * @}
+  */
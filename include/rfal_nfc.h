@@ -67,6 +67,7 @@
 #include "rfal_st25tb.h"
 #include "rfal_nfcDep.h"
 #include "rfal_isoDep.h"
+#include "rfal_cd.h"
 
 
 /*
@@ -83,6 +84,7 @@
 #define RFAL_NFC_POLL_TECH_AP2P          0x0010U  /*!< AP2P technology Flag       */
 #define RFAL_NFC_POLL_TECH_ST25TB        0x0020U  /*!< ST25TB technology Flag     */
 #define RFAL_NFC_POLL_TECH_PROP          0x0040U  /*!< Proprietary technology Flag*/
+#define RFAL_NFC_POLL_TECH_CNT           7U       /*!< Number of Poll technologies */
 #define RFAL_NFC_LISTEN_TECH_A           0x1000U  /*!< NFC-V technology Flag      */
 #define RFAL_NFC_LISTEN_TECH_B           0x2000U  /*!< NFC-V technology Flag      */
 #define RFAL_NFC_LISTEN_TECH_F           0x4000U  /*!< NFC-V technology Flag      */
@@ -125,6 +127,7 @@ typedef enum{
     RFAL_NFC_STATE_IDLE                     =  1,   /*!< Initialize state            */
     RFAL_NFC_STATE_START_DISCOVERY          =  2,   /*!< Start Discovery loop state  */
     RFAL_NFC_STATE_WAKEUP_MODE              =  3,   /*!< Wake-Up state               */
+    RFAL_NFC_STATE_CARD_DETECT              =  4,   /*!< Card Detection state        */
     RFAL_NFC_STATE_POLL_TECHDETECT          =  10,  /*!< Technology Detection state  */
     RFAL_NFC_STATE_POLL_COLAVOIDANCE        =  11,  /*!< Collision Avoidance state   */
     RFAL_NFC_STATE_POLL_SELECT              =  12,  /*!< Wait for Selection state    */
@@ -135,8 +138,10 @@ typedef enum{
     RFAL_NFC_STATE_LISTEN_SLEEP             =  23,  /*!< Listen Sleep state          */
     RFAL_NFC_STATE_ACTIVATED                =  30,  /*!< Activated state             */
     RFAL_NFC_STATE_DATAEXCHANGE             =  31,  /*!< Data Exchange Start state   */
+    RFAL_NFC_STATE_PRESENCE_CHECK           =  32,  /*!< Presence Check state        */
     RFAL_NFC_STATE_DATAEXCHANGE_DONE        =  33,  /*!< Data Exchange terminated    */
-    RFAL_NFC_STATE_DEACTIVATION             =  34   /*!< Deactivation state          */
+    RFAL_NFC_STATE_DEACTIVATION             =  34,  /*!< Deactivation state          */
+    RFAL_NFC_STATE_DEVICE_LOST              =  35   /*!< Activated device removed    */
 }rfalNfcState;
 
 
@@ -231,9 +236,44 @@ typedef struct{
     bool                   wakeupConfigDefault;              /*!< Wake-Up mode default configuration                                 */
     rfalWakeUpConfig       wakeupConfig;                     /*!< Wake-Up mode configuration                                         */
     uint16_t               wakeupNPolls;                     /*!< Number of polling cycles before entering Wake-up                   */
+                                                                                                                                     
+    bool                   cdEnabled;                        /*!< Enable Card Detection pre-filter before Technology Detection       */
+    bool                   adaptiveOrder;                    /*!< Poll technologies ordered by their decayed hit history             */
+    uint16_t               suppressTTL;                      /*!< Time (ms) since last seen a device is not re-activated, 0: disable. Needs devLimit > 1 for another device to be activated */
+    bool                   adaptiveBR;                       /*!< ISO-DEP Poller: highest bit rate (maxBR, 848 if KEEP), lowered per device on link errors */
+    bool                   batchMode;                        /*!< Batch mode: all devices found are activated in turn (see rfalNfcBatchNext()) */
+    uint16_t               pollWindow;                       /*!< Slot scheduling: max Poll time (ms) per cycle, 0: disable          */
+    uint16_t               listenWindow;                     /*!< Slot scheduling: min Listen time (ms) reserved per cycle           */
 }rfalNfcDiscoverParam;
 
 
+/*! Data Exchange completion callback, called from rfalNfcWorker() with the outcome of the exchange          */
+typedef void (* rfalNfcDataExchangeCb)( ReturnCode err );
+
+
+/*! Discovery phase latency statistics, durations in us                                                           */
+typedef struct{
+    uint32_t               cnt;                              /*!< Times the phase has been performed                                 */
+    uint32_t               failCnt;                          /*!< Times the phase has failed (error or nothing found)                */
+    uint32_t               last;                             /*!< Duration of the latest occurrence                                  */
+    uint32_t               min;                              /*!< Shortest duration                                                  */
+    uint32_t               max;                              /*!< Longest duration                                                   */
+    uint64_t               total;                            /*!< Accumulated duration, average is total / cnt                       */
+}rfalNfcPhaseStats;
+
+
+/*! Discovery loop statistics, per technology entries are indexed by the bit position of the RFAL_NFC_POLL_TECH_* flag */
+typedef struct{
+    uint32_t               cycleCnt;                         /*!< Discovery cycles started                                           */
+    rfalNfcPhaseStats      wakeUp;                           /*!< Wake-Up Mode, failed if woke with no device found                  */
+    rfalNfcPhaseStats      techDetect[RFAL_NFC_POLL_TECH_CNT];/*!< Technology Detection, failed if technology not found             */
+    rfalNfcPhaseStats      collResolution;                   /*!< Collision Resolution, failed on error or no device resolved        */
+    rfalNfcPhaseStats      activation[RFAL_NFC_POLL_TECH_CNT];/*!< Activation (RATS/ATTRIB/ATR/PPS) per technology                  */
+    rfalNfcPhaseStats      deactivation;                     /*!< Deactivation                                                       */
+    rfalNfcPhaseStats      discovery;                        /*!< Start of the discovery cycle until a device is activated           */
+}rfalNfcStats;
+
+
 /*! Buffer union, only one interface is used at a time                                                             */
 typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be used concurrently, only one interface at a time */
     uint8_t                  rfBuf[RFAL_FEATURE_NFC_RF_BUF_LEN]; /*!< RF buffer                                    */
@@ -283,6 +323,25 @@ ReturnCode rfalNfcInitialize( void );
  * The number of devices on the list is indicated by the devLimit and shall
  * be at >= 1.
  *
+ * If batchMode is set, all devices found by Collision Resolution are 
+ * activated in turn within the same field session: each one is notified as
+ * RFAL_NFC_STATE_ACTIVATED and the application exchanges data with it as 
+ * usual, then calls rfalNfcBatchNext() to put it to sleep and activate the
+ * next one. RFAL_NFC_STATE_POLL_SELECT is not used. Once all have been 
+ * handled discovery is restarted.
+ *
+ * If pollWindow is set, discovery cycles are slot scheduled: each cycle 
+ * starts every totalDuration (after Wake-up, if any) while no device is 
+ * activated. Poll takes at most pollWindow, and never more than 
+ * totalDuration - listenWindow, so that Listen is kept for the remaining 
+ * time of the cycle (the field is kept Off if no Listen technology is 
+ * enabled, keeping a fixed poll rate). The ratio between both windows sets
+ * the priority of Reader vs Card Emulation mode. Technologies still to be 
+ * detected when the Poll window is over are preempted and, on the fixed 
+ * order, detected first on the next cycle (with adaptiveOrder they become
+ * overdue). Preemption takes place in between Poll commands.
+ * If pollWindow is 0 the Listen phase lasts totalDuration after Poll.
+ *
  * \param[in]  disParams    : discovery configuration parameters
  *
  * \return ERR_WRONG_STATE  : Incorrect state for this operation
@@ -338,6 +397,104 @@ ReturnCode rfalNfcGetDevicesFound( rfalNfcDevice **devList, uint8_t *devCnt );
 ReturnCode rfalNfcGetActiveDevice( rfalNfcDevice **dev );
 
 
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Get Time To Detect
+ *  
+ * It returns the time elapsed from the start of the Technology Detection 
+ * to the first technology found on the last poll cycle where a device was
+ * found. It is up to date when RFAL_NFC_STATE_POLL_COLAVOIDANCE is notified.
+ *
+ * When adaptiveOrder is enabled on rfalNfcDiscover() the technologies are 
+ * probed by decreasing decayed hit rate, and if devLimit is 1 Technology 
+ * Detection concludes on the first technology found. Technologies not 
+ * probed for RFAL_NFC_TECH_MAX_AGE cycles are probed first, so that every 
+ * enabled technology is still probed regularly.
+ *
+ * \param[out]  time         : time to detect (ms)
+ *
+ * \return ERR_REQUEST       : No device has been detected yet
+ * \return ERR_PARAM         : Invalid parameters
+ * \return ERR_NONE          : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcGetTimeToDetect( uint32_t *time );
+
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Get Statistics
+ *  
+ * It returns the latency statistics of the discovery loop phases since the 
+ * last reset: Wake-Up, Technology Detection and Activation per technology, 
+ * Collision Resolution and Deactivation, together with their failure counts.
+ * Durations are measured with the platform cycle counter (platformGetCycles)
+ * and include the time between rfalNfcWorker() calls, the Wake-Up phase is
+ * measured with the System Tick as it may last much longer.
+ * AP2P Activation (ATR) is performed during its Technology Detection and is 
+ * accounted there.
+ *
+ * \param[out]  stats        : pointer where the statistics are to be stored
+ *
+ * \return ERR_DISABLED      : Statistics disabled (RFAL_FEATURE_NFC_STATS)
+ * \return ERR_PARAM         : Invalid parameters
+ * \return ERR_NONE          : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcGetStats( rfalNfcStats *stats );
+
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Reset Statistics
+ *  
+ * Clears the discovery loop statistics. Statistics are also cleared on 
+ * rfalNfcInitialize()
+ *****************************************************************************
+ */
+void rfalNfcResetStats( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Suppression Cache Clear
+ *  
+ * When suppressTTL is set on rfalNfcDiscover() every device activated as 
+ * Poller is remembered by type and NFCID on a small cache (of size 
+ * RFAL_NFC_SUPPRESS_CACHE_LEN). While seen again within suppressTTL it is 
+ * skipped after Collision Resolution, so that other devices may be activated
+ * instead without any delay on the discovery loop.
+ * As the filter runs on the devices Collision Resolution returned, a
+ * suppressed device takes one of the devLimit places: with devLimit 1 a
+ * suppressed device resting in the field hides any other device.
+ * 
+ * This method forgets all devices so that they may be activated again.
+ * The cache is kept across rfalNfcDiscover() calls.
+ *****************************************************************************
+ */
+void rfalNfcSuppressCacheClear( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Bit Rate Cache Clear
+ *  
+ * When adaptiveBR is set on rfalNfcDiscover() ISO-DEP devices are activated
+ * as Poller at the highest bit rate they advertise, up to maxBR (848 kbps 
+ * when maxBR is RFAL_BR_KEEP). The ISO-DEP block errors on the link (CRC, 
+ * parity, framing and timeout, also the ones recovered with R-Blocks) are 
+ * monitored. A device with link errors is tracked by NFCID on a small cache
+ * (of size RFAL_NFC_BR_CACHE_LEN), its counters kept across sessions, and 
+ * once its error rate gets too high it is activated one bit rate lower next
+ * time. After a long enough error free run it is raised one step again.
+ * 
+ * This method forgets all devices so that they are activated at the 
+ * highest bit rate again. The cache is kept across rfalNfcDiscover() calls.
+ *****************************************************************************
+ */
+void rfalNfcBitRateCacheClear( void );
+
+
 /*!
  *****************************************************************************
  * \brief  RFAL NFC Select Device
@@ -356,6 +513,24 @@ ReturnCode rfalNfcGetActiveDevice( rfalNfcDevice **dev );
  */
 ReturnCode rfalNfcSelect( uint8_t devIdx );
 
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Batch Next
+ *  
+ * In batch mode it puts the activated device to sleep and moves on to the 
+ * activation of the next device found, keeping the field on. Once all 
+ * devices have been handled the discovery loop is restarted.
+ * It shall be called once the application is done with the activated 
+ * device, rfalNfcDeactivate() may be used instead to abort the batch.
+ *
+ * \return ERR_WRONG_STATE  : Incorrect state for this operation
+ *                            Batch mode disabled or no device activated
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcBatchNext( void );
+
 /*!
  *****************************************************************************
  * \brief  RFAL NFC Start Data Exchange
@@ -387,6 +562,35 @@ ReturnCode rfalNfcSelect( uint8_t devIdx );
  */
 ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt );
 
+
+/*!
+ *****************************************************************************
+ * \brief  RFAL NFC Start Data Exchange with completion callback
+ *  
+ * Same as rfalNfcDataExchangeStart() but, instead of polling with
+ * rfalNfcDataExchangeGetStatus(), the given callback is called once when
+ * the exchange terminates (with the value rfalNfcDataExchangeGetStatus() 
+ * would return), or with ERR_LINK_LOSS if the device is deactivated first.
+ * 
+ * The callback is called from rfalNfcWorker(), which still needs to be 
+ * executed. It only needs to run when the ST25R3916 has raised an interrupt
+ * (see rfalSetUpperLayerCallback()) or a few ms have elapsed, so that the 
+ * caller may block meanwhile instead of busy polling.
+ *
+ * \param[in]  txData       : data to be transmitted
+ * \param[in]  txDataLen    : size of the data to be transmitted (in bits or bytes)
+ * \param[out] rxData       : location of the received data after operation is completed
+ * \param[out] rvdLen       : location of the length of the received data (in bits or bytes)
+ * \param[in]  fwt          : FWT to be used in case of RF interface
+ * \param[in]  cb           : completion callback
+ *
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_WRONG_STATE  : Incorrect state for this operation
+ * \return ERR_NONE         : No error, exchange started
+ *****************************************************************************
+ */
+ReturnCode rfalNfcDataExchangeStartCb( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt, rfalNfcDataExchangeCb cb );
+
 /*! 
  *****************************************************************************
  * \brief  RFAL NFC Get Data Exchange Status
@@ -426,6 +630,50 @@ ReturnCode rfalNfcDataExchangeGetStatus( void );
  */
 ReturnCode rfalNfcDeactivate( bool discovery );
 
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Presence Check Start
+ *  
+ * It keeps the activated device and periodically checks whether it is still
+ * in the field without going through a new discovery. The cheapest check for
+ * the activated technology/interface is used:
+ *   - ISO-DEP : R(NAK)
+ *   - NFC-DEP : ATN
+ *   - T2T     : READ block 0
+ *   - NFC-F   : SENSF_REQ
+ *   - NFC-V   : INVENTORY masked with the device UID
+ * 
+ * Once the device fails to answer RFAL_NFC_PRESENCE_CHECK_RETRIES + 1 
+ * consecutive checks RFAL_NFC_STATE_DEVICE_LOST is notified and, unless the
+ * caller deactivates, discovery is restarted.
+ * 
+ * A Data Exchange may be started at any time while no check is being 
+ * performed, it terminates the presence check mode
+ *
+ * \param[in]  period       : interval between checks in ms
+ *
+ * \return ERR_WRONG_STATE  : Incorrect state for this operation
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_NOTSUPP      : No presence check for the activated device
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcPresenceCheckStart( uint16_t period );
+
+/*! 
+ *****************************************************************************
+ * \brief  RFAL NFC Presence Check Stop
+ *  
+ * It terminates the presence check mode going back to Activated state
+ *
+ * \return ERR_WRONG_STATE  : Not in presence check mode
+ * \return ERR_BUSY         : A check is ongoing, run the worker and retry
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcPresenceCheckStop( void );
+
 #endif /* RFAL_NFC_H */
 
 
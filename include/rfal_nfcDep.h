@@ -138,6 +138,10 @@
 #define RFAL_NFCDEP_LEN_MIN              3U              /*!< Minimum length byte LEN value                                  */
 #define RFAL_NFCDEP_LEN_MAX              255U            /*!< Maximum length byte LEN value                                  */
 
+#ifndef RFAL_NFCDEP_PSL_AUTO_BR
+    #define RFAL_NFCDEP_PSL_AUTO_BR      RFAL_BR_424     /*!< Highest bit rate an Initiator upgrades to with PSL when RFAL_BR_KEEP is requested, RFAL_BR_KEEP to disable */
+#endif
+
 #define RFAL_NFCDEP_ATRRES_HEADER_LEN    2U              /*!< ATR RES Header Len:  CmdType: 0xD5 + Cod: 0x01                 */
 #define RFAL_NFCDEP_ATRRES_MIN_LEN       17U             /*!< Minimum length for an ATR RES                                  */
 #define RFAL_NFCDEP_ATRRES_MAX_LEN       64U             /*!< Maximum length for an ATR RES  Digital 1.0 14.6.1              */
@@ -443,6 +447,45 @@ typedef struct
 } rfalNfcDepPduTxRxParam;
 
 
+/*! 
+ * NFC-DEP PDU stream producer, fills the next chunk of the PDU to be sent
+ * 
+ * \param[in]  ctx    : caller context given on rfalNfcDepPduStreamParam
+ * \param[out] buf    : location where the chunk is to be placed
+ * \param[in]  maxLen : maximum chunk length (INF of one block)
+ * \param[out] len    : chunk length placed on buf
+ * \param[out] more   : set to true if the PDU has further chunks
+ */
+typedef ReturnCode (* rfalNfcDepPduTxCb)( void *ctx, uint8_t *buf, uint16_t maxLen, uint16_t *len, bool *more );
+
+
+/*! 
+ * NFC-DEP PDU stream consumer, called for every chunk of the PDU received
+ * 
+ * \param[in]  ctx    : caller context given on rfalNfcDepPduStreamParam
+ * \param[in]  data   : chunk received (INF of one block)
+ * \param[in]  len    : chunk length
+ * \param[in]  last   : true on the last chunk of the PDU
+ */
+typedef ReturnCode (* rfalNfcDepPduRxCb)( void *ctx, const uint8_t *data, uint16_t len, bool last );
+
+
+/*! Structure of parameters used on NFC DEP PDU Stream Transceive */
+typedef struct
+{
+    rfalNfcDepPduTxCb        txCb;      /*!< PDU producer                             */
+    rfalNfcDepPduRxCb        rxCb;      /*!< PDU consumer                             */
+    void                     *ctx;      /*!< Caller context passed to txCb and rxCb   */
+    rfalNfcDepBufFormat      *txBuf;    /*!< Buffer for one Tx block                  */
+    rfalNfcDepBufFormat      *rxBuf;    /*!< Buffer for one Rx block, not txBuf       */
+    uint32_t                 *rxLen;    /*!< Total PDU length received (optional)     */
+    uint32_t                 FWT;       /*!< FWT to be used (ignored in Listen Mode)  */
+    uint32_t                 dFWT;      /*!< Delta FWT to be used                     */
+    uint16_t                 FSx;       /*!< Other device Frame Size (FSD or FSC)     */
+    uint8_t                  DID;       /*!< Device ID (RFAL_ISODEP_NO_DID if no DID) */
+} rfalNfcDepPduStreamParam;
+
+
 /*
  * *****************************************************************************
  * GLOBAL VARIABLE DECLARATIONS
@@ -553,6 +596,23 @@ ReturnCode rfalNfcDepPSL( uint8_t BRS, uint8_t FSL );
 ReturnCode rfalNfcDepDSL( void );
 
 
+/*!
+ ******************************************************************************
+ * \brief NFC-DEP Initiator ATN (Attention)
+ * 
+ * This method sends an ATN as Initiator and waits the target's ATN 
+ * response. It may be used to check whether the Target is still present
+ * The PNI is not affected
+ * 
+ * \return ERR_NONE        : Target present
+ * \return ERR_WRONG_STATE : Not configured as Initiator
+ * \return ERR_TIMEOUT     : Timeout occurred
+ * \return ERR_PROTO       : Protocol error occurred
+ ******************************************************************************
+ */
+ReturnCode rfalNfcDepATN( void );
+
+
 /*!
  ******************************************************************************
  * \brief NFC-DEP Initiator RLS (Release)
@@ -576,12 +636,17 @@ ReturnCode rfalNfcDepRLS( void );
  *  \brief  NFC-DEP Initiator Handle  Activation
  *   
  *  This performs a Activation into NFC-DEP layer with the given
- *  parameters. It sends ATR_REQ and if the higher bit rates are supported by 
- *  both devices it additionally sends PSL
+ *  parameters. It sends ATR_REQ and then a PSL to the highest bit rate
+ *  supported by both devices up to desiredBR, carrying the common LR (a PSL
+ *  is also sent at the current bit rate if only the LR differs).
+ *  Upon a transmission error the same PSL_REQ is retransmitted. Should the
+ *  PSL still fail its error is returned, as the Target may already be at 
+ *  the new bit rate, and the next activation stays one bit rate lower
  *  Once Activated all details of the device are provided on nfcDepDev
  *   
  *  \param[in]  param     : required parameters to initialize and send ATR_REQ
- *  \param[in]  desiredBR : Desired bit rate supported by the Poller
+ *  \param[in]  desiredBR : Highest bit rate supported by the Poller, 
+ *                          RFAL_BR_KEEP for RFAL_NFCDEP_PSL_AUTO_BR
  *  \param[out] nfcDepDev : NFC-DEP information of the activated Listen device
  *
  *  \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
@@ -772,6 +837,50 @@ ReturnCode rfalNfcDepStartPduTransceive( rfalNfcDepPduTxRxParam param );
  */
 ReturnCode rfalNfcDepGetPduTransceiveStatus( void );
 
+
+/*!
+ *****************************************************************************
+ * \brief Start PDU Stream Transceive 
+ * 
+ * This method triggers a NFC-DEP Transceive of a PDU of any length through 
+ * a single block buffer per direction. 
+ * The PDU is pulled from param.txCb one block at a time and each block of 
+ * the PDU received is handed to param.rxCb as soon as it is received, so 
+ * the PDU is not limited by RFAL_FEATURE_NFC_DEP_PDU_MAX_LEN
+ * 
+ * The callbacks are called from rfalNfcDepStartPduStream() and 
+ * rfalNfcDepGetPduStreamStatus() context. Data given to param.rxCb is
+ * only valid during the call
+ * 
+ * \param[in] param: reference parameters to be used for the Transceive
+ *                    
+ * \return ERR_PARAM       : Bad request
+ * \return ERR_NONE        : The Transceive request has been started
+ * \return                 : Error returned by param.txCb
+ *****************************************************************************
+ */
+ReturnCode rfalNfcDepStartPduStream( rfalNfcDepPduStreamParam param );
+
+
+/*!
+ *****************************************************************************
+ * \brief Return the PDU Stream Transceive status
+ *
+ * An error returned by a callback aborts the stream and is returned here,
+ * the NFC-DEP link is then to be deactivated before starting a new PDU
+ * 
+ * \return ERR_NONE      : Transceive has been completed successfully
+ * \return ERR_BUSY      : Transceive is ongoing
+ * \return ERR_PROTO     : Protocol error occurred
+ * \return ERR_TIMEOUT   : Timeout error occurred
+ * \return ERR_SLEEP_REQ : Deselect has been received and responded
+ * \return ERR_LINK_LOSS : Communication is lost because Reader/Writer 
+ *                            has turned off its field
+ * \return               : Error returned by param.txCb or param.rxCb
+ *****************************************************************************
+ */
+ReturnCode rfalNfcDepGetPduStreamStatus( void );
+
 #endif /* RFAL_NFCDEP_H_ */
 
 /**
@@ -232,6 +232,43 @@ ReturnCode rfalNfcaPollerInitialize( void );
 ReturnCode rfalNfcaPollerCheckPresence( rfal14443AShortFrameCmd cmd, rfalNfcaSensRes *sensRes );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-A Poller Start Check Presence
+ *  
+ * This method triggers the ALL_REQ (WUPA) or SENS_REQ (REQA) of
+ * rfalNfcaPollerCheckPresence() without waiting for the response
+ *  
+ * \param[in]  cmd     : Indicate if to send an ALL_REQ or a SENS_REQ
+ * \param[out] sensRes : If received, the SENS_RES
+ *
+ * \warning sensRes must remain valid until the operation has concluded
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Generic internal error 
+ * \return ERR_NONE         : No error, response reception ongoing
+ *****************************************************************************
+ */
+ReturnCode rfalNfcaPollerStartCheckPresence( rfal14443AShortFrameCmd cmd, rfalNfcaSensRes *sensRes );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-A Poller Get Check Presence Status
+ *  
+ * Gets the status of the Check Presence triggered by 
+ * rfalNfcaPollerStartCheckPresence()
+ *
+ * \return ERR_BUSY         : Operation ongoing
+ * \return ERR_IO           : Generic internal error 
+ * \return ERR_TIMEOUT      : Timeout error, no listener device detected
+ * \return ERR_NONE         : No error, one or more device in the field
+ *****************************************************************************
+ */
+ReturnCode rfalNfcaPollerGetCheckPresenceStatus( void );
+
+
 /*! 
  *****************************************************************************
  * \brief  NFC-A Poller Select
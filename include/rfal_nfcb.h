@@ -172,6 +172,16 @@ typedef struct
     bool              isSleep;                                  /*!< Device sleeping flag  */
 }rfalNfcbListenDevice;
 
+
+/*! NFC-B Collision Resolution statistics (last collision resolution) */
+typedef struct
+{
+    uint8_t           rounds;                                   /*!< Slotted rounds (xxxB_REQ) performed     */
+    uint16_t          slots;                                    /*!< Slots opened on all rounds              */
+    uint16_t          collisions;                               /*!< Slots with a collision or invalid frame */
+    uint32_t          airTime;                                  /*!< Time from first request until last response [us] */
+}rfalNfcbColResStats;
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -243,6 +253,49 @@ ReturnCode rfalNfcbPollerInitializeWithParams( uint8_t AFI, uint8_t PARAM );
 ReturnCode rfalNfcbPollerCheckPresence( rfalNfcbSensCmd cmd, rfalNfcbSlots slots, rfalNfcbSensbRes *sensbRes, uint8_t *sensbResLen );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-B Poller Start Check Presence
+ *  
+ * This method triggers the ALLB_REQ (WUPB) or SENSB_REQ (REQB) of
+ * rfalNfcbPollerCheckPresence() without waiting for the response
+ *  
+ * \param[in]  cmd         : Indicate if to send an ALL_REQ or a SENS_REQ
+ * \param[in]  slots       : The number of slots to be announced
+ * \param[out] sensbRes    : If received, the SENSB_RES
+ * \param[out] sensbResLen : If received, the SENSB_RES length
+ *
+ * \warning sensbRes and sensbResLen must remain valid until the operation 
+ *          has concluded
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NONE         : No error, response reception ongoing
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerStartCheckPresence( rfalNfcbSensCmd cmd, rfalNfcbSlots slots, rfalNfcbSensbRes *sensbRes, uint8_t *sensbResLen );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-B Poller Get Check Presence Status
+ *  
+ * Gets the status of the Check Presence triggered by 
+ * rfalNfcbPollerStartCheckPresence()
+ *
+ * \return ERR_BUSY         : Operation ongoing
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_TIMEOUT      : Timeout error, no listener device detected
+ * \return ERR_RF_COLLISION : Collision detected one or more device in the field
+ * \return ERR_PAR          : Parity error detected, one or more device in the field
+ * \return ERR_PROTO        : Protocol error detected, invalid SENSB_RES received
+ * \return ERR_NONE         : No error, SENSB_RES received
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerGetCheckPresenceStatus( void );
+
+
 /*! 
  *****************************************************************************
  * \brief  NFC-B Poller Sleep
@@ -448,6 +501,24 @@ ReturnCode rfalNfcbPollerStartSlottedCollisionResolution( rfalComplianceMode com
  */
 ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void );
 
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-B Get Collision Resolution Statistics
+ *    
+ *  Retrieves the number of rounds, slots and the time spent on the last
+ *  (or ongoing) Collision Resolution.
+ *  With RFAL_FEATURE_ADAPTIVE_COLL_RES the number of slots of each round in 
+ *  NFC Forum mode is estimated from the collided slots of the previous one.
+ *
+ * \param[out] stats : location to place the statistics
+ * 
+ * \return ERR_PARAM  : Invalid parameters
+ * \return ERR_NONE   : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcbPollerGetCollisionResolutionStats( rfalNfcbColResStats *stats );
+
 /*! 
  *****************************************************************************
  * \brief  NFC-B TR2 code to FDT
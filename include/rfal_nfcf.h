@@ -174,6 +174,15 @@ typedef struct
     rfalNfcfSensfRes  sensfRes;                 /*!< SENF_RES           */
 } rfalNfcfListenDevice;
 
+/*! NFC-F Collision Resolution statistics (last collision resolution) */
+typedef struct
+{
+    uint8_t           rounds;                   /*!< Polling rounds (SENSF_REQ) performed          */
+    uint16_t          slots;                    /*!< Time Slots opened on all rounds               */
+    uint16_t          collisions;               /*!< Time Slots with a collision                   */
+    uint32_t          airTime;                  /*!< Time from first request until last response [us] */
+} rfalNfcfColResStats;
+
 typedef  uint16_t rfalNfcfServ;                 /*!< NFC-F Service Code */
 
 /*! NFC-F Block List Element (2 or 3 bytes element)       T3T 1.0 5.6.1 */
@@ -361,6 +370,25 @@ ReturnCode rfalNfcfPollerStartCollisionResolution( rfalComplianceMode compMode,
 ReturnCode rfalNfcfPollerGetCollisionResolutionStatus( void );
 
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-F Get Collision Resolution Statistics
+ *    
+ *  Retrieves the number of rounds, Time Slots and the time spent on the last
+ *  (or ongoing) Collision Resolution.
+ *  With RFAL_FEATURE_ADAPTIVE_COLL_RES the number of Time Slots of each round
+ *  is estimated from the responses and collisions of the previous one, and
+ *  further rounds are performed while collisions are detected.
+ *
+ * \param[out] stats : location to place the statistics
+ * 
+ * \return ERR_PARAM  : Invalid parameters
+ * \return ERR_NONE   : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcfPollerGetCollisionResolutionStats( rfalNfcfColResStats *stats );
+
+
 /*! 
  *****************************************************************************
  * \brief  NFC-F Poller Check/Read
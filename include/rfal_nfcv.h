@@ -241,6 +241,15 @@ typedef struct
 } rfalNfcvListenDevice;
 
 
+/*! NFC-V Inventory engine parameters */
+typedef struct
+{
+    bool                    useAfi;     /*!< Only devices of the given AFI answer               */
+    uint8_t                 afi;        /*!< Application Family Identifier (if useAfi)          */
+    bool                    stayQuiet;  /*!< Put each device identified to QUIET (SLPV_REQ)     */
+} rfalNfcvInventoryParam;
+
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -281,6 +290,42 @@ ReturnCode rfalNfcvPollerInitialize( void );
  */
 ReturnCode rfalNfcvPollerCheckPresence( rfalNfcvInventoryRes *invRes );
 
+/*! 
+ *****************************************************************************
+ * \brief  NFC-V Poller Start Check Presence
+ *  
+ * This method triggers the INVENTORY_REQ of rfalNfcvPollerCheckPresence()
+ * without waiting for the response
+ *  
+ * \param[out] invRes : If received, the INVENTORY_RES. Please note that
+ *                      received invRes may contain errors and is not
+ *                      guaranteed to contain valid data.
+ *
+ * \warning invRes must remain valid until the operation has concluded
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NONE         : No error, response reception ongoing
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerStartCheckPresence( rfalNfcvInventoryRes *invRes );
+
+/*! 
+ *****************************************************************************
+ * \brief  NFC-V Poller Get Check Presence Status
+ *  
+ * Gets the status of the Check Presence triggered by 
+ * rfalNfcvPollerStartCheckPresence()
+ *
+ * \return ERR_BUSY         : Operation ongoing
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_TIMEOUT      : Timeout error, no listener device detected
+ * \return ERR_NONE         : No error, one or more device in the field
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerGetCheckPresenceStatus( void );
+
 /*! 
  *****************************************************************************
  * \brief NFC-F Poller Poll
@@ -353,6 +398,34 @@ ReturnCode rfalNfcvPollerCollisionResolution( rfalComplianceMode compMode, uint8
  */
 ReturnCode rfalNfcvPollerSleepCollisionResolution( uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
 
+/*!
+ *****************************************************************************
+ * \brief  NFC-V Poller Inventory engine
+ *
+ * Inventories all devices in the field with 16 slot INVENTORY_REQs, which 
+ * is different from Activity 2.0 9.3.7.
+ * The mask tree is walked depth first from an explicit stack of pending masks,
+ * each round sends the INVENTORY_REQ and all slot EOFs back to back.
+ * Optionally only devices of a given AFI are inventoried and the devices 
+ * identified are put to QUIET right after each round. When the stack of
+ * pending masks is exceeded, the inventory is repeated while QUIET devices
+ * are being added. Should collisions still have been dropped, the devices
+ * found are kept and ERR_NOMEM is returned.
+ *
+ * \param[in]  param        : Inventory parameters (AFI, Stay Quiet)
+ * \param[in]  devLimit     : device limit value, and size nfcvDevList
+ * \param[out] nfcvDevList  : NFC-V listener devices list
+ * \param[out] devCnt       : Devices found counter
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or mode not set
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Generic internal error
+ * \return ERR_NOMEM        : Stack of pending masks exceeded, devices may be missing
+ * \return ERR_NONE         : No error
+ *****************************************************************************
+ */
+ReturnCode rfalNfcvPollerInventoryAll( const rfalNfcvInventoryParam *param, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt );
+
 /*! 
  *****************************************************************************
  * \brief  NFC-V Poller Sleep
@@ -181,6 +181,8 @@
 #define rfalConvBitsToBytes( n )             (uint16_t)( ((uint16_t)(n)+(RFAL_BITS_IN_BYTE-1U)) / (RFAL_BITS_IN_BYTE) )  /*!< Converts the given n from bits to bytes    */
 #define rfalConvBytesToBits( n )             (uint32_t)( (uint32_t)(n) * (RFAL_BITS_IN_BYTE) )                           /*!< Converts the given n from bytes to bits    */
 
+#define rfalCollResBacklog( c )              (uint16_t)( (((uint16_t)(c) * 239U) + 99U) / 100U )                          /*!< Estimates the devices behind c collided slots (Schoute: 2.39 per slot) */
+
 
 #define rfalRunBlocking( e, fn )              do{ (e)=(fn); rfalWorker(); }while( (e) == ERR_BUSY )                      /*!< Macro used for the blocking methods        */
 
@@ -461,6 +463,14 @@ typedef enum
 typedef uint8_t rfalFeliCaPollRes[RFAL_FELICA_POLL_RES_LEN];
 
 
+/*! ISO15693 Anticollision slot result */
+typedef struct
+{
+    ReturnCode ret;                     /*!< Slot result: ERR_NONE, ERR_TIMEOUT or the transmission error */
+    uint16_t   rxLen;                   /*!< Received length in bits                                      */
+} rfalISO15693SlotRes;
+
+
 /*******************************************************************************/
 
 
@@ -1121,6 +1131,46 @@ void rfalWorker( void );
 ReturnCode rfalISO14443ATransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt );
 
 
+/*!
+ *****************************************************************************
+ *  \brief Starts the transceive of an ISO14443A ShortFrame
+ *
+ *  Sends REQA/WUPA and leaves the reception of the response ongoing.
+ *  Completion is retrieved with rfalISO14443AGetTransceiveShortFrameStatus()
+ *
+ * \param[in]  txCmd    : type of short frame to be sent REQA or WUPA
+ * \param[out] rxBuf    : buffer to place the response
+ * \param[in]  rxBufLen : length of rxBuf
+ * \param[out] rxRcvdLen: received length
+ * \param[in]  fwt      : Frame Waiting Time in 1/fc
+ *
+ * \return ERR_WRONG_STATE  : RFAL not initialized or incorrect mode
+ * \return ERR_PARAM        : Invalid parameters
+ * \return ERR_IO           : Internal error
+ * \return ERR_NONE         : ShortFrame sent, reception ongoing
+ *
+ *****************************************************************************
+ */
+ReturnCode rfalISO14443AStartTransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt );
+
+
+/*!
+ *****************************************************************************
+ *  \brief Get ISO14443A ShortFrame Status
+ *
+ *  Gets the status of the transceive triggered by
+ *  rfalISO14443AStartTransceiveShortFrame()
+ *
+ * \return ERR_BUSY         : Reception ongoing
+ * \return ERR_NONE         : If there is response
+ * \return ERR_TIMEOUT      : If there is no response
+ * \return ERR_RF_COLLISION : A collision was detected
+ *
+ *****************************************************************************
+ */
+ReturnCode rfalISO14443AGetTransceiveShortFrameStatus( void );
+
+
 /*!
  *****************************************************************************
  * \brief Sends an ISO14443A Anticollision Frame 
@@ -1258,6 +1308,33 @@ ReturnCode rfalISO15693TransceiveAnticollisionFrame( uint8_t *txBuf, uint8_t txB
 ReturnCode rfalISO15693TransceiveEOFAnticollision( uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen );
 
 
+/*!
+ *****************************************************************************
+ * \brief Sends an ISO15693 Anticollision Frame and its slot EOFs
+ * 
+ * This sends the Anticollision|Inventory frame (INVENTORY_REQ) followed by
+ * the EOFs of the remaining slots back to back, keeping the Anticollision 
+ * configuration for the whole sequence.
+ * The response of each slot is placed at rxBuf + (slot * rxSlotLen)
+ *
+ * \warning rxSlotLen must be able to contain the payload and CRC
+ * 
+ * \param[in]  txBuf        : Buffer where outgoing message is located
+ * \param[in]  txBufLen     : Length of the outgoing message in bytes
+ * \param[in]  slotCnt      : Number of slots (1 or 16)
+ * \param[in]  slotGap      : Delay in ms before the next slot after a collision or partial response
+ * \param[out] rxBuf        : Buffer where incoming messages will be placed (slotCnt * rxSlotLen)
+ * \param[in]  rxSlotLen    : Maximum length of the incoming message of each slot in bytes
+ * \param[out] slotRes      : Result of each slot (slotCnt entries)
+ * 
+ * \return  ERR_NONE        : Slot sequence done, check each slot result
+ * \return  ERR_WRONG_STATE : RFAL not initialized or mode not set
+ * \return  ERR_PARAM       : Invalid parameters
+ *****************************************************************************
+ */
+ReturnCode rfalISO15693TransceiveAnticollisionSlots( uint8_t *txBuf, uint8_t txBufLen, uint8_t slotCnt, uint8_t slotGap, uint8_t *rxBuf, uint8_t rxSlotLen, rfalISO15693SlotRes *slotRes );
+
+
 /*!
  *****************************************************************************
  * \brief Sends an ISO15693 EOF
@@ -1527,6 +1604,57 @@ bool rfalWakeUpModeHasWoke( void );
 ReturnCode rfalWakeUpModeGetInfo( bool force, rfalWakeUpInfo *info );
 
 
+/*!
+ *****************************************************************************
+ * \brief Wake-Up Mode Report Result
+ *
+ * Reports whether the polling cycle that followed the last wake-up found a
+ * device. A wake-up with no device found is counted as a false wake-up.
+ * When adaptive thresholds are enabled a false wake-up raises the margin 
+ * added to the deltas derived from the noise floor, while a genuine one 
+ * relaxes it.
+ * 
+ * \param[in]  devFound    : true if a device was found after the wake-up
+ *
+ * \return ERR_WRONG_STATE : No wake-up awaiting its result
+ * \return ERR_NONE        : Done with no error
+ *****************************************************************************
+ */
+ReturnCode rfalWakeUpModeReportResult( bool devFound );
+
+
+/*!
+ *****************************************************************************
+ * \brief Wake-Up Mode Get Statistics
+ *
+ * Returns the Wake-Up Mode duty-cycle counters and the time spent in Wake-Up
+ * Mode and with the field On since the last reset, together with the 
+ * estimated charge per hour. The estimation uses a simple per-state current 
+ * model whose parameters are device specific and can be overridden at 
+ * compile time. The remaining time is accounted at Ready mode current.
+ * Measurements performed autonomously by the HW Wake-Up are derived from 
+ * the time spent in Wake-Up Mode and the configured period.
+ * 
+ * \param[out] stats       : pointer where the statistics are to be stored
+ *
+ * \return ERR_PARAM       : Invalid parameter
+ * \return ERR_NONE        : Done with no error
+ *****************************************************************************
+ */
+ReturnCode rfalWakeUpModeGetStats( rfalWakeUpStats *stats );
+
+
+/*!
+ *****************************************************************************
+ * \brief Wake-Up Mode Reset Statistics
+ *
+ * Clears the Wake-Up Mode duty-cycle and energy statistics and restarts the
+ * accounting from now
+ *****************************************************************************
+ */
+void rfalWakeUpModeResetStats( void );
+
+
 /*!
  *****************************************************************************
  * \brief Wake-Up Mode Stop
@@ -0,0 +1,177 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2020 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file rfal_snep.h
+ *
+ *  \author
+ *
+ *  \brief Provides an NFC Forum SNEP client and server on top of LLCP
+ *
+ *  The client pushes an NDEF message to the remote default SNEP server
+ *  (PUT request), the server receives the NDEF messages pushed by the
+ *  remote client. Both run on the LLC link driven by rfalLlcpWorker().
+ *
+ *  A message longer than the link MIU is sent as a first fragment and,
+ *  once the peer answers Continue, the remaining fragments are handed to
+ *  LLCP at once so that they go back to back up to the Receive Window.
+ *
+ *  This implementation was based on the following specs:
+ *    - NFC Forum Simple NDEF Exchange Protocol 1.0 2011-08-31
+ *
+ * \addtogroup RFAL
+ * @{
+ *
+ * \addtogroup RFAL-AL
+ * \brief RFAL Abstraction Layer
+ * @{
+ *
+ * \addtogroup SNEP
+ * \brief RFAL SNEP Module
+ * @{
+ *
+ */
+
+#ifndef RFAL_SNEP_H
+#define RFAL_SNEP_H
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "platform.h"
+#include "st_errno.h"
+#include "rfal_llcp.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define RFAL_SNEP_SN                    "urn:nfc:sn:snep" /*!< Default SNEP server service name         */
+#define RFAL_SNEP_VERSION               0x10U    /*!< SNEP version 1.0                                   */
+#define RFAL_SNEP_HEADER_LEN            6U       /*!< Version | Request/Response | Length(4)             */
+
+#define RFAL_SNEP_REQ_CONTINUE          0x00U    /*!< Request Continue                                   */
+#define RFAL_SNEP_REQ_GET               0x01U    /*!< Request Get                                        */
+#define RFAL_SNEP_REQ_PUT               0x02U    /*!< Request Put                                        */
+#define RFAL_SNEP_REQ_REJECT            0x7FU    /*!< Request Reject                                     */
+
+#define RFAL_SNEP_RES_CONTINUE          0x80U    /*!< Response Continue                                  */
+#define RFAL_SNEP_RES_SUCCESS           0x81U    /*!< Response Success                                   */
+#define RFAL_SNEP_RES_NOT_FOUND         0xC0U    /*!< Response Not Found                                 */
+#define RFAL_SNEP_RES_EXCESS_DATA       0xC1U    /*!< Response Excess Data                               */
+#define RFAL_SNEP_RES_BAD_REQUEST       0xC2U    /*!< Response Bad Request                               */
+#define RFAL_SNEP_RES_NOT_IMPLEMENTED   0xE0U    /*!< Response Not Implemented                           */
+#define RFAL_SNEP_RES_UNSUPPORTED_VER   0xE1U    /*!< Response Unsupported Version                       */
+#define RFAL_SNEP_RES_REJECT            0xFFU    /*!< Response Reject                                    */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*!
+ * SNEP server callback, called with each NDEF message received on a PUT
+ *
+ * \param[in]  ctx     : caller context given on rfalSnepServerStart()
+ * \param[in]  ndef    : NDEF message, in the buffer given on rfalSnepServerStart()
+ * \param[in]  ndefLen : NDEF message length
+ */
+typedef void (* rfalSnepServerCb)( void *ctx, const uint8_t *ndef, uint32_t ndefLen );
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTION PROTOTYPES
+ ******************************************************************************
+ */
+
+/*!
+ *****************************************************************************
+ * \brief  SNEP Client Start Put
+ *
+ * Connects to the remote default SNEP server and pushes the given NDEF
+ * message. The LLC link shall be active (rfalLlcpStart()), the exchange
+ * progresses with rfalLlcpWorker() and rfalSnepClientGetPutStatus()
+ *
+ * \param[in]  ndef    : NDEF message, shall be kept until the Put completes
+ * \param[in]  ndefLen : NDEF message length
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_BUSY       : Previous Put still ongoing
+ * \return ERR_NOMEM      : No LLCP link available
+ * \return ERR_NONE       : Put started
+ *****************************************************************************
+ */
+ReturnCode rfalSnepClientStartPut( const uint8_t *ndef, uint32_t ndefLen );
+
+
+/*!
+ *****************************************************************************
+ * \brief  SNEP Client Get Put Status
+ *
+ * Progresses the Put started by rfalSnepClientStartPut(), the connection
+ * is released once the server response is received
+ *
+ * \return ERR_BUSY       : Put ongoing
+ * \return ERR_REQUEST    : Put rejected by the server
+ * \return ERR_LINK_LOSS  : Connection refused or lost
+ * \return ERR_WRONG_STATE: No Put started
+ * \return ERR_NONE       : NDEF message accepted by the server
+ *****************************************************************************
+ */
+ReturnCode rfalSnepClientGetPutStatus( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  SNEP Server Start
+ *
+ * Starts the default SNEP server on the LLC link (rfalLlcpStart() shall
+ * have been called). The NDEF messages pushed are reassembled in the given
+ * buffer and handed to cb, a Get request is answered Not Implemented
+ *
+ * \param[in]  buf    : buffer for the NDEF message received
+ * \param[in]  bufLen : buffer length, longer messages are rejected
+ * \param[in]  cb     : callback for the NDEF messages received
+ * \param[in]  ctx    : caller context given to cb
+ *
+ * \return ERR_PARAM      : Invalid parameter
+ * \return ERR_NOMEM      : No LLCP link available
+ * \return ERR_NONE       : Server listening
+ *****************************************************************************
+ */
+ReturnCode rfalSnepServerStart( uint8_t *buf, uint32_t bufLen, rfalSnepServerCb cb, void *ctx );
+
+#endif /* RFAL_SNEP_H */
+
+/**
+  * @}
+  *
+  * @}
+  *
+  * @}
+  */
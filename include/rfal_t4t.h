@@ -80,6 +80,11 @@
 
 #define RFAL_T4T_ISO7816_STATUS_COMPLETE                      0x9000U                        /*!< Command completed \ Normal processing - No further qualification*/
 
+#define RFAL_T4T_NDEF_CC_LEN                                    15U                          /*!< CC file length up to the NDEF File Control TLV (T4T 2.0)        */
+#define RFAL_T4T_NDEF_CC_EXT_LEN                                17U                          /*!< CC file length with the ENDEF File Control TLV (T4T 3.0)        */
+#define RFAL_T4T_NDEF_MLE_MIN                               0x000FU                          /*!< Minimum MLe value allowed on the CC file                        */
+#define RFAL_T4T_NDEF_ACCESS_GRANTED                          0x00U                          /*!< NDEF file read/write access granted without any security        */
+
 
 /*
 ******************************************************************************
@@ -130,6 +135,47 @@ typedef enum
     RFAL_T4T_INS_UPDATEBINARY_ODO = 0xD7U                      /*!< T4T UpdateBinay using ODO                          */
 } rfalT4tCmds;
 
+
+/*! T4T Capability Container contents   T4T 2.0 5.1 & T4T 3.0 5.1 */
+typedef struct
+{
+    uint8_t                  version;                          /*!< Mapping version (major|minor)                      */
+    uint16_t                 MLe;                              /*!< Maximum R-APDU data size                           */
+    uint16_t                 MLc;                              /*!< Maximum C-APDU data size                           */
+    uint8_t                  fileId[2];                        /*!< NDEF file identifier                               */
+    uint32_t                 maxNdefSize;                      /*!< NDEF file size, including the NLEN/ENLEN field     */
+    uint8_t                  readAccess;                       /*!< NDEF file read access condition                    */
+    uint8_t                  writeAccess;                      /*!< NDEF file write access condition                   */
+    uint8_t                  nlenLen;                          /*!< NLEN (2) or ENLEN (4) field length                 */
+    bool                     v1Mapping;                        /*!< Card only answered to the Mapping Version 1 AID    */
+}rfalT4tCc;
+
+
+/*! T4T NDEF Read parameters */
+typedef struct
+{
+    const rfalIsoDepDevice   *isoDepDev;                       /*!< Activated ISO-DEP device (FSC, FWT, DID)           */
+    rfalIsoDepBufFormat      *txBuf;                           /*!< Buffer for one Tx I-Block                          */
+    rfalIsoDepBufFormat      *rxBuf;                           /*!< Buffer for one Rx I-Block, not txBuf               */
+    uint8_t                  *ndefBuf;                         /*!< Destination of the NDEF message                    */
+    uint32_t                 ndefBufLen;                       /*!< ndefBuf size                                       */
+    uint32_t                 *ndefLen;                         /*!< NDEF message length read                           */
+    rfalT4tCc                *cc;                              /*!< Parsed CC file (optional, may be NULL)             */
+}rfalT4tNdefReadParam;
+
+
+/*! T4T NDEF Write parameters */
+typedef struct
+{
+    const rfalIsoDepDevice   *isoDepDev;                       /*!< Activated ISO-DEP device (FSC, FWT, DID)           */
+    rfalIsoDepBufFormat      *txBuf;                           /*!< Buffer for one Tx I-Block                          */
+    rfalIsoDepBufFormat      *rxBuf;                           /*!< Buffer for one Rx I-Block, not txBuf               */
+    const uint8_t            *ndefMsg;                         /*!< NDEF message to be written                         */
+    uint32_t                 ndefMsgLen;                       /*!< NDEF message length                                */
+    uint32_t                 *rate;                            /*!< Write throughput in Bytes/s (optional, may be NULL)*/
+    rfalT4tCc                *cc;                              /*!< Parsed CC file (optional, may be NULL)             */
+}rfalT4tNdefWriteParam;
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -348,6 +394,104 @@ ReturnCode rfalT4TPollerComposeWriteData( rfalIsoDepApduBufFormat *cApduBuf, uin
  */
 ReturnCode rfalT4TPollerComposeWriteDataODO( rfalIsoDepApduBufFormat *cApduBuf, uint32_t offset, const uint8_t* data, uint8_t dataLen, uint16_t *cApduLen );
 
+
+
+/*! 
+ *****************************************************************************
+ * \brief  T4T Start NDEF Read
+ *  
+ * This method starts the read of the NDEF message of an activated T4T.
+ * The NDEF Tag Application and the CC file are selected and the CC file 
+ * is read to obtain the MLe and the NDEF File Control TLV. The NDEF file is 
+ * then selected and, after its NLEN/ENLEN, read with the largest chunk the 
+ * card allows: up to MLe per READ BINARY, using extended Le when MLe exceeds
+ * 255 and ODO READ BINARY for offsets beyond 7FFFh.
+ *
+ * The R-APDUs are streamed through the ISO-DEP layer: the data of each 
+ * I-Block is placed directly at its position in param->ndefBuf so neither 
+ * the chunk size nor the message length are bound by 
+ * RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN
+ *
+ * \see rfalIsoDepStartApduStream()
+ * \see rfalT4TPollerGetNdefReadStatus()
+ * 
+ * \param[in]  param : NDEF Read parameters, the buffers shall be kept 
+ *                      until the read has finished
+ * 
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_NONE         : NDEF Read started
+ *****************************************************************************
+ */
+ReturnCode rfalT4TPollerStartNdefRead( const rfalT4tNdefReadParam *param );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  T4T Get NDEF Read Status
+ *  
+ * This method drives the NDEF Read started by rfalT4TPollerStartNdefRead() 
+ * and shall be called until it returns other than ERR_BUSY
+ * 
+ * \return ERR_BUSY         : NDEF Read ongoing
+ * \return ERR_REQUEST      : Card answered a command with a SW other than 9000
+ * \return ERR_PROTO        : Invalid CC file, NLEN or R-APDU
+ * \return ERR_NOTSUPP      : NDEF file not readable without security
+ * \return ERR_NOMEM        : NDEF message does not fit into param->ndefBuf
+ * \return ERR_NONE         : NDEF message read, param->ndefLen updated
+ * \return Other            : ISO-DEP error
+ *****************************************************************************
+ */
+ReturnCode rfalT4TPollerGetNdefReadStatus( void );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  T4T Start NDEF Write
+ *  
+ * This method starts the write of an NDEF message to an activated T4T.
+ * The NDEF Tag Application and the CC file are selected and parsed as on
+ * rfalT4TPollerStartNdefRead(). The NDEF file is then updated following 
+ * the T4T procedure: NLEN/ENLEN is first set to zero, the message is written
+ * and NLEN/ENLEN is written last, so an interrupted write leaves an empty 
+ * NDEF file instead of a corrupted message.
+ *
+ * Each UPDATE BINARY carries as much data as MLc allows, using extended Lc
+ * when MLc exceeds 255 and ODO UPDATE BINARY for offsets beyond 7FFFh. 
+ * When the C-APDU does not fit into one frame it is trimmed to fill whole 
+ * I-Blocks of the negotiated FSC. The message is streamed from 
+ * param->ndefMsg directly into the I-Blocks
+ *
+ * \see rfalIsoDepStartApduStream()
+ * \see rfalT4TPollerGetNdefWriteStatus()
+ * 
+ * \param[in]  param : NDEF Write parameters, the buffers shall be kept 
+ *                      until the write has finished
+ * 
+ * \return ERR_PARAM        : Invalid parameter
+ * \return ERR_NONE         : NDEF Write started
+ *****************************************************************************
+ */
+ReturnCode rfalT4TPollerStartNdefWrite( const rfalT4tNdefWriteParam *param );
+
+
+/*! 
+ *****************************************************************************
+ * \brief  T4T Get NDEF Write Status
+ *  
+ * This method drives the NDEF Write started by rfalT4TPollerStartNdefWrite()
+ * and shall be called until it returns other than ERR_BUSY
+ * 
+ * \return ERR_BUSY         : NDEF Write ongoing
+ * \return ERR_REQUEST      : Card answered a command with a SW other than 9000
+ * \return ERR_PROTO        : Invalid CC file or R-APDU
+ * \return ERR_NOTSUPP      : NDEF file not writable without security
+ * \return ERR_NOMEM        : NDEF message does not fit into the NDEF file
+ * \return ERR_NONE         : NDEF message written, param->rate updated
+ * \return Other            : ISO-DEP error
+ *****************************************************************************
+ */
+ReturnCode rfalT4TPollerGetNdefWriteStatus( void );
+
 #endif /* RFAL_T4T_H */
 
 /**
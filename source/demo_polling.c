@@ -51,6 +51,9 @@
 #include "demo.h"
 #include "utils.h"
 #include "rfal_nfc.h"
+#include "pltf_nfc.h"
+#include "rfal_llcp.h"
+#include "rfal_snep.h"
 #include "logger.h"
 #include <psa/crypto.h>
 #include <psa/crypto_extra.h>
@@ -105,7 +108,6 @@ LOG_MODULE_DECLARE(st25r3916);
 
 /* P2P communication data */
 static uint8_t NFCID3[] = {0x01, 0xFE, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
-static uint8_t GB[] = {0x46, 0x66, 0x6d, 0x01, 0x01, 0x11, 0x02, 0x02, 0x07, 0x80, 0x03, 0x02, 0x00, 0x03, 0x04, 0x01, 0x32, 0x07, 0x01, 0x03};
     
 /* APDUs communication data */    
 #if RFAL_FEATURE_ISO_DEP_POLL
@@ -117,12 +119,15 @@ static uint8_t readBinary[] = { 0x00, 0xB0, 0x00, 0x00, 0x0F };
    ppseSelectApp[] = { 0x00, 0xA4, 0x04, 0x00, 0x0E, 0x32, 0x50, 0x41, 0x59, 0x2E, 0x53, 0x59, 0x53, 0x2E, 0x44, 0x44, 0x46, 0x30, 0x31, 0x00 } */
 #endif /* RFAL_FEATURE_ISO_DEP_POLL */
 
-#if RFAL_FEATURE_NFC_DEP
-/* P2P communication data */    
-static uint8_t ndefLLCPSYMM[] = {0x00, 0x00};
-static uint8_t ndefInit[] = {0x05, 0x20, 0x06, 0x0F, 0x75, 0x72, 0x6E, 0x3A, 0x6E, 0x66, 0x63, 0x3A, 0x73, 0x6E, 0x3A, 0x73, 0x6E, 0x65, 0x70, 0x02, 0x02, 0x07, 0x80, 0x05, 0x01, 0x02};
-static uint8_t ndefUriSTcom[] = {0x13, 0x20, 0x00, 0x10, 0x02, 0x00, 0x00, 0x00, 0x19, 0xc1, 0x01, 0x00, 0x00, 0x00, 0x12, 0x55, 0x00, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x74, 0x2e, 0x63, 0x6f, 0x6d};
-#endif /* RFAL_FEATURE_NFC_DEP */
+#if RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP
+/* P2P communication data: NDEF URI record 'http://www.st.com' pushed over SNEP */
+static const uint8_t ndefUriSTcom[] = {0xc1, 0x01, 0x00, 0x00, 0x00, 0x12, 0x55, 0x00, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x74, 0x2e, 0x63, 0x6f, 0x6d};
+
+static rfalNfcDepPduBufFormat llcpTxBuf;                   /* LLCP PDUs are composed/parsed in place */
+static rfalNfcDepPduBufFormat llcpRxBuf;
+static rfalNfcDepBufFormat    llcpTmpBuf;
+static uint8_t                snepRxBuf[256];              /* NDEF message pushed by the remote device */
+#endif /* RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP */
 
 #if RFAL_SUPPORT_CE && RFAL_FEATURE_LISTEN_MODE
 #if RFAL_SUPPORT_MODE_LISTEN_NFCA
@@ -247,17 +252,20 @@ bool demoIni( void )
     err = rfalNfcInitialize();
     if( err == ERR_NONE )
     {
+        nfcEventInit();                                 /* Sleep on the ST25R3916 IRQ during Data Exchanges */
+        
         discParam.compMode      = RFAL_COMPLIANCE_MODE_NFC;
-        discParam.devLimit      = 1U;
+        discParam.devLimit      = 2U;                  /* Room for a new tag next to a suppressed one (see suppressTTL) */
         discParam.nfcfBR        = RFAL_BR_212;
         discParam.ap2pBR        = RFAL_BR_424;
         discParam.maxBR         = RFAL_BR_KEEP;
 
-        discParam.isoDepFS = RFAL_ISODEP_FSXI_256;
+        discParam.isoDepFS = RFAL_ISODEP_FSDI_MAX;               /* Largest frame our buffers hold, card FSC is honoured on Tx */
         discParam.nfcDepLR = RFAL_NFCDEP_LR_254; 
         ST_MEMCPY( &discParam.nfcid3, NFCID3, sizeof(NFCID3) );
-        ST_MEMCPY( &discParam.GB, GB, sizeof(GB) );
-        discParam.GBLen         = sizeof(GB);
+#if RFAL_FEATURE_LLCP
+        rfalLlcpGetGeneralBytes( RFAL_LLCP_WKS_SNEP, discParam.GB, &discParam.GBLen );  /* MIU as large as the NFC-DEP PDU buffer */
+#endif /* RFAL_FEATURE_LLCP */
         discParam.p2pNfcaPrio   = true;
 
         discParam.notifyCb             = demoNotif;
@@ -265,6 +273,8 @@ bool demoIni( void )
         discParam.wakeupConfigDefault  = true;
         discParam.wakeupNPolls         = 1U;
         discParam.totalDuration        = 100U;
+        discParam.suppressTTL          = 500U;                        /* Do not re-activate tags left in the field, instead of delaying the polling loop (card emulation is not suppressed) */
+        discParam.adaptiveBR           = true;                        /* ISO-DEP cards at their highest bit rate, lowered for cards whose link fails */
         discParam.techs2Find           = RFAL_NFC_TECH_NONE;          /* For the demo, enable the NFC Technlogies based on RFAL Feature switches */
 
 
@@ -510,17 +520,6 @@ void demoCycle( void )
                 }
                 
                 rfalNfcDeactivate( false );
-
-#if !defined(DEMO_NO_DELAY_IN_DEMOCYCLE)
-                switch( nfcDevice->type )
-                {
-                    case RFAL_NFC_POLL_TYPE_NFCA:
-                    case RFAL_NFC_POLL_TYPE_NFCF:
-                        break; /* When being in card emulation don't delay as some polling devices (phones) rely on tags to be re-discoverable */
-                    default:
-                        platformDelay(500); /* Delay before re-starting polling loop to not flood the UART log with re-discovered tags */
-                }
-#endif /* DEMO_NO_DELAY_IN_DEMOCYCLE */
                 
                 state = DEMO_ST_START_DISCOVERY;
             }
@@ -673,37 +672,71 @@ static void demoNfcv( rfalNfcvListenDevice *nfcvDev )
 }
 
 
+#if RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP
+/*!
+ *****************************************************************************
+ * \brief Demo SNEP server callback
+ *
+ * Logs the NDEF message pushed by the remote device
+ *
+ *****************************************************************************
+ */
+static void demoSnepRcvd( void *ctx, const uint8_t *ndef, uint32_t ndefLen )
+{
+    NO_WARNING( ctx );
+    platformLog(" NDEF received: %s\r\n", hex2str( (uint8_t*)ndef, ndefLen ) );
+}
+#endif /* RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP */
+
+
 /*!
  *****************************************************************************
  * \brief Demo P2P Exchange
  *
  * Sends a NDEF URI record 'http://www.ST.com' via NFC-DEP (P2P) protocol.
  * 
- * This method sends a set of static predefined frames which tries to establish
- * a LLCP connection, followed by the NDEF record, and then keeps sending 
- * LLCP SYMM packets to maintain the connection.
- * 
+ * The LLC link is activated over the NFC-DEP device and the NDEF record is
+ * pushed to the remote SNEP server, while the local SNEP server accepts the
+ * NDEF messages pushed by the remote device. The LLC link is then kept
+ * until the device is removed, LLCP holding the SYMM PDUs within the
+ * remote Link Timeout.
  * 
  *****************************************************************************
  */
 void demoP2P( rfalNfcDevice *nfcDev )
 {
-#if RFAL_FEATURE_NFC_DEP
+#if RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP
     
-    uint16_t   *rxLen;
-    uint8_t    *rxData;
-    ReturnCode err;
+    uint16_t      *rxLen;
+    uint8_t       *rxData;
+    rfalLlcpParam llcpParam;
+    ReturnCode    err;
+    ReturnCode    putErr;
+    
+    llcpParam.nfcDepDev   = &nfcDev->proto.nfcDep;
+    llcpParam.isInitiator = true;
+    llcpParam.txBuf       = &llcpTxBuf;
+    llcpParam.rxBuf       = &llcpRxBuf;
+    llcpParam.tmpBuf      = &llcpTmpBuf;
+    llcpParam.firstPdu    = NULL;
+    llcpParam.firstPduLen = 0;
     
     /* In Listen mode retrieve the first request from Initiator */
     if( nfcDev->type == RFAL_NFC_POLL_TYPE_AP2P )
     {
-        demoTransceiveBlocking( NULL, 0, &rxData, &rxLen, 0);   
+        err = demoTransceiveBlocking( NULL, 0, &rxData, &rxLen, 0);
+        if( err != ERR_NONE )
+        {
+            return;
+        }
         
-        /* Initiator request is being ignored/discarded  */
+        llcpParam.isInitiator = false;
+        llcpParam.firstPdu    = rxData;
+        llcpParam.firstPduLen = *rxLen;
     }
 
     platformLog(" Initialize device .. ");
-    err = demoTransceiveBlocking( ndefInit, sizeof(ndefInit), &rxData, &rxLen, RFAL_FWT_NONE);
+    err = rfalLlcpStart( &llcpParam );
     if( err != ERR_NONE )
     {
         platformLog("failed.\r\n");
@@ -711,26 +744,45 @@ void demoP2P( rfalNfcDevice *nfcDev )
     }
     platformLog("succeeded.\r\n");
 
+    rfalSnepServerStart( snepRxBuf, sizeof(snepRxBuf), demoSnepRcvd, NULL );
+
     platformLog(" Push NDEF Uri: www.st.com .. ");
-    err = demoTransceiveBlocking( ndefUriSTcom, sizeof(ndefUriSTcom), &rxData, &rxLen, RFAL_FWT_NONE);
-    if( err != ERR_NONE )
+    putErr = rfalSnepClientStartPut( ndefUriSTcom, sizeof(ndefUriSTcom) );
+    if( putErr != ERR_NONE )
     {
         platformLog("failed.\r\n");
-        return;
     }
-    platformLog("succeeded.\r\n");
-
-
-    platformLog(" Device present, maintaining connection ");
-    while(err == ERR_NONE) 
+    else
     {
-        err = demoTransceiveBlocking( ndefLLCPSYMM, sizeof(ndefLLCPSYMM), &rxData, &rxLen, RFAL_FWT_NONE);
-        platformLog(".");
-        platformDelay(50);
+        putErr = ERR_BUSY;
+    }
+    
+    do
+    {
+        rfalWorker();
+        err = rfalLlcpWorker();
+        
+        if( putErr == ERR_BUSY )
+        {
+            putErr = rfalSnepClientGetPutStatus();
+            if( putErr != ERR_BUSY )
+            {
+                platformLog("%s.\r\n Device present, maintaining connection ", ((putErr != ERR_NONE) ? "failed" : "succeeded") );
+            }
+        }
+        
+        if( err == ERR_BUSY )
+        {
+            nfcEventWait( K_MSEC( NFC_EVENT_WORKER_PERIOD ) );
+        }
     }
+    while( err == ERR_BUSY );
+    
     platformLog("\r\n Device removed.\r\n");
     
-#endif /* RFAL_FEATURE_NFC_DEP */
+#else
+    NO_WARNING( nfcDev );
+#endif /* RFAL_FEATURE_NFC_DEP && RFAL_FEATURE_SNEP */
 }
 
 
@@ -797,18 +849,7 @@ void demoAPDU( void )
  */
 ReturnCode demoTransceiveBlocking( uint8_t *txBuf, uint16_t txBufSize, uint8_t **rxData, uint16_t **rcvLen, uint32_t fwt )
 {
-    ReturnCode err;
-    
-    err = rfalNfcDataExchangeStart( txBuf, txBufSize, rxData, rcvLen, fwt );
-    if( err == ERR_NONE )
-    {
-        do{
-            rfalNfcWorker();
-            err = rfalNfcDataExchangeGetStatus();
-        }
-        while( err == ERR_BUSY );
-    }
-    return err;
+    return nfcDataExchangeBlocking( txBuf, txBufSize, rxData, rcvLen, fwt );
 }
 
 void flash_setup(void)
@@ -0,0 +1,456 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file rfal_cd.c
+ *
+ *  \author
+ *
+ *  \brief Implementation of a Card Detection Algorithm
+ *
+ *  The detection turns the field On once and sends a single presence
+ *  command per technology (NFC-A ALL_REQ, NFC-B ALLB_REQ, NFC-F SENSF_REQ,
+ *  NFC-V INVENTORY 1 slot). Any answer, even a garbled or colliding one, is
+ *  taken as presence so that the following full Technology Detection is
+ *  never skipped while something is in the field.
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "rfal_cd.h"
+#include "rfal_rf.h"
+#include "rfal_nfca.h"
+#include "rfal_nfcb.h"
+#include "rfal_nfcf.h"
+#include "rfal_nfcv.h"
+
+/*
+ ******************************************************************************
+ * ENABLE SWITCH
+ ******************************************************************************
+ */
+#ifndef RFAL_FEATURE_CD
+    #define RFAL_FEATURE_CD   false    /* Card Detection module configuration missing. Disabled by default */
+#endif
+
+#if RFAL_FEATURE_CD
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+/*
+ ******************************************************************************
+ * GLOBAL MACROS
+ ******************************************************************************
+ */
+
+#define rfalCdIsPresence( e )   (((e) != ERR_TIMEOUT) && ((e) != ERR_WRONG_STATE) && ((e) != ERR_PARAM))  /*!< Any answer to the probe, even an erroneous one, indicates presence */
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! Card Detection states                                                                                      */
+typedef enum
+{
+    RFAL_CD_ST_IDLE,                /*!< No detection ongoing                                                  */
+    RFAL_CD_ST_TECH_INIT,           /*!< Configure next technology and start GT                                */
+    RFAL_CD_ST_TECH_GT,             /*!< Wait for GT to be fulfilled                                           */
+    RFAL_CD_ST_TECH_POLL,           /*!< Presence command ongoing                                              */
+    RFAL_CD_ST_DONE                 /*!< Detection concluded                                                   */
+}rfalCdState;
+
+
+/*! Card Detection context                                                                                     */
+typedef struct
+{
+    rfalCdState   state;            /*!< Current state                                                         */
+    uint8_t       techs2do;         /*!< Technologies still to be probed                                       */
+    uint8_t       curTech;          /*!< Technology currently being probed                                     */
+    uint8_t       techsFound;       /*!< Technologies that answered                                            */
+    bool          multiDev;         /*!< A collision was observed within a technology                          */
+    rfalCdRes     *result;          /*!< Location of the result                                                */
+    rfalNfcaSensRes      sensRes;   /*!< SENS_RES of the ongoing NFC-A probe                                   */
+    rfalNfcbSensbRes     sensbRes;  /*!< SENSB_RES of the ongoing NFC-B probe                                  */
+    uint8_t              sensbLen;  /*!< SENSB_RES length of the ongoing NFC-B probe                           */
+    rfalNfcvInventoryRes invRes;    /*!< INVENTORY_RES of the ongoing NFC-V probe                              */
+}rfalCd;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static rfalCd gCd;
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+static ReturnCode rfalCdTechInit( uint8_t tech );
+static ReturnCode rfalCdTechPoll( uint8_t tech );
+static ReturnCode rfalCdTechPollStatus( uint8_t tech );
+static void rfalCdConclude( void );
+
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode rfalCdDetectCard( rfalCdRes *result )
+{
+    ReturnCode ret;
+
+    EXIT_ON_ERR( ret, rfalCdStartDetectCard( result ) );
+    rfalRunBlocking( ret, rfalCdGetDetectCardStatus() );
+
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalCdStartDetectCard( rfalCdRes *result )
+{
+    return rfalCdStartDetectCardTechs( RFAL_CD_TECH_ALL, result );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalCdStartDetectCardTechs( uint8_t techs, rfalCdRes *result )
+{
+    if( result == NULL )
+    {
+        return ERR_PARAM;
+    }
+
+    /* Only the technologies supported by this build can be probed */
+    techs &= RFAL_CD_TECH_ALL;
+#if !RFAL_FEATURE_NFCA
+    techs &= ~(uint8_t)RFAL_CD_TECH_NFCA;
+#endif /* RFAL_FEATURE_NFCA */
+#if !RFAL_FEATURE_NFCB
+    techs &= ~(uint8_t)RFAL_CD_TECH_NFCB;
+#endif /* RFAL_FEATURE_NFCB */
+#if !RFAL_FEATURE_NFCF
+    techs &= ~(uint8_t)RFAL_CD_TECH_NFCF;
+#endif /* RFAL_FEATURE_NFCF */
+#if !RFAL_FEATURE_NFCV
+    techs &= ~(uint8_t)RFAL_CD_TECH_NFCV;
+#endif /* RFAL_FEATURE_NFCV */
+
+    if( techs == (uint8_t)RFAL_CD_TECH_NONE )
+    {
+        return ERR_PARAM;
+    }
+
+    ST_MEMSET( result, 0x00, sizeof(rfalCdRes) );
+    result->detType = RFAL_CD_UNKOWN;
+
+    gCd.techs2do   = techs;
+    gCd.curTech    = (uint8_t)RFAL_CD_TECH_NONE;
+    gCd.techsFound = (uint8_t)RFAL_CD_TECH_NONE;
+    gCd.multiDev   = false;
+    gCd.result     = result;
+    gCd.state      = RFAL_CD_ST_TECH_INIT;
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalCdGetDetectCardStatus( void )
+{
+    ReturnCode ret;
+
+    switch( gCd.state )
+    {
+        /*******************************************************************************/
+        case RFAL_CD_ST_TECH_INIT:
+
+            if( gCd.techs2do == (uint8_t)RFAL_CD_TECH_NONE )
+            {
+                rfalCdConclude();
+                return ERR_NONE;
+            }
+
+            /* Pick the lowest pending technology: A, B, F then V */
+            gCd.curTech   = (uint8_t)(gCd.techs2do & (uint8_t)(~gCd.techs2do + 1U));
+            gCd.techs2do &= (uint8_t)~gCd.curTech;
+
+            ret = rfalCdTechInit( gCd.curTech );
+            if( ret != ERR_NONE )
+            {
+                /* An external field (ERR_RF_COLLISION) or a failure to configure aborts the detection */
+                rfalFieldOff();
+                gCd.state = RFAL_CD_ST_IDLE;
+                return ret;
+            }
+
+            gCd.state = RFAL_CD_ST_TECH_GT;
+            return ERR_BUSY;
+
+        /*******************************************************************************/
+        case RFAL_CD_ST_TECH_GT:
+
+            if( !rfalIsGTExpired() )
+            {
+                return ERR_BUSY;
+            }
+
+            ret = rfalCdTechPoll( gCd.curTech );
+            if( ret == ERR_BUSY )
+            {
+                gCd.state = RFAL_CD_ST_TECH_POLL;
+                return ERR_BUSY;
+            }
+            break;
+
+        /*******************************************************************************/
+        case RFAL_CD_ST_TECH_POLL:
+
+            ret = rfalCdTechPollStatus( gCd.curTech );
+            if( ret == ERR_BUSY )
+            {
+                return ERR_BUSY;
+            }
+            break;
+
+        /*******************************************************************************/
+        case RFAL_CD_ST_DONE:
+            return ERR_NONE;
+
+        /*******************************************************************************/
+        case RFAL_CD_ST_IDLE:
+        default:
+            return ERR_WRONG_STATE;
+    }
+
+
+    /*******************************************************************************/
+    /* Presence command concluded for the current technology                       */
+    if( rfalCdIsPresence( ret ) )
+    {
+        gCd.techsFound |= gCd.curTech;
+
+        if( ret == ERR_RF_COLLISION )
+        {
+            gCd.multiDev = true;
+        }
+    }
+
+    gCd.state = RFAL_CD_ST_TECH_INIT;
+    return ERR_BUSY;
+}
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static ReturnCode rfalCdTechInit( uint8_t tech )
+{
+    ReturnCode ret;
+
+    switch( tech )
+    {
+    #if RFAL_FEATURE_NFCA
+        case (uint8_t)RFAL_CD_TECH_NFCA:
+            EXIT_ON_ERR( ret, rfalNfcaPollerInitialize() );
+            break;
+    #endif /* RFAL_FEATURE_NFCA */
+
+    #if RFAL_FEATURE_NFCB
+        case (uint8_t)RFAL_CD_TECH_NFCB:
+            EXIT_ON_ERR( ret, rfalNfcbPollerInitialize() );
+            break;
+    #endif /* RFAL_FEATURE_NFCB */
+
+    #if RFAL_FEATURE_NFCF
+        case (uint8_t)RFAL_CD_TECH_NFCF:
+            EXIT_ON_ERR( ret, rfalNfcfPollerInitialize( RFAL_BR_212 ) );
+            break;
+    #endif /* RFAL_FEATURE_NFCF */
+
+    #if RFAL_FEATURE_NFCV
+        case (uint8_t)RFAL_CD_TECH_NFCV:
+            EXIT_ON_ERR( ret, rfalNfcvPollerInitialize() );
+            break;
+    #endif /* RFAL_FEATURE_NFCV */
+
+        default:
+            return ERR_PARAM;
+    }
+
+    /* Turns the Field On (if not yet) and starts GT timer */
+    return rfalFieldOnAndStartGT();
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalCdTechPoll( uint8_t tech )
+{
+    ReturnCode ret;
+
+    ret = ERR_TIMEOUT;
+
+    switch( tech )
+    {
+    #if RFAL_FEATURE_NFCA
+        case (uint8_t)RFAL_CD_TECH_NFCA:
+            ret = rfalNfcaPollerStartCheckPresence( RFAL_14443A_SHORTFRAME_CMD_WUPA, &gCd.sensRes );
+            break;
+    #endif /* RFAL_FEATURE_NFCA */
+
+    #if RFAL_FEATURE_NFCB
+        case (uint8_t)RFAL_CD_TECH_NFCB:
+            ret = rfalNfcbPollerStartCheckPresence( RFAL_NFCB_SENS_CMD_ALLB_REQ, RFAL_NFCB_SLOT_NUM_1, &gCd.sensbRes, &gCd.sensbLen );
+            break;
+    #endif /* RFAL_FEATURE_NFCB */
+
+    #if RFAL_FEATURE_NFCF
+        case (uint8_t)RFAL_CD_TECH_NFCF:
+            ret = rfalNfcfPollerStartCheckPresence();
+            break;
+    #endif /* RFAL_FEATURE_NFCF */
+
+    #if RFAL_FEATURE_NFCV
+        case (uint8_t)RFAL_CD_TECH_NFCV:
+            ret = rfalNfcvPollerStartCheckPresence( &gCd.invRes );
+            break;
+    #endif /* RFAL_FEATURE_NFCV */
+
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+
+    if( ret == ERR_NONE )
+    {
+        ret = ERR_BUSY;                                              /* Completion retrieved on RFAL_CD_ST_TECH_POLL */
+    }
+
+    return ret;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalCdTechPollStatus( uint8_t tech )
+{
+    ReturnCode ret;
+
+    ret = ERR_TIMEOUT;
+
+    switch( tech )
+    {
+    #if RFAL_FEATURE_NFCA
+        case (uint8_t)RFAL_CD_TECH_NFCA:
+            ret = rfalNfcaPollerGetCheckPresenceStatus();
+            break;
+    #endif /* RFAL_FEATURE_NFCA */
+
+    #if RFAL_FEATURE_NFCB
+        case (uint8_t)RFAL_CD_TECH_NFCB:
+            ret = rfalNfcbPollerGetCheckPresenceStatus();
+            break;
+    #endif /* RFAL_FEATURE_NFCB */
+
+    #if RFAL_FEATURE_NFCF
+        case (uint8_t)RFAL_CD_TECH_NFCF:
+            ret = rfalNfcfPollerGetCheckPresenceStatus();
+            break;
+    #endif /* RFAL_FEATURE_NFCF */
+
+    #if RFAL_FEATURE_NFCV
+        case (uint8_t)RFAL_CD_TECH_NFCV:
+            ret = rfalNfcvPollerGetCheckPresenceStatus();
+            break;
+    #endif /* RFAL_FEATURE_NFCV */
+
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+
+    return ret;
+}
+
+
+/*******************************************************************************/
+static void rfalCdConclude( void )
+{
+    uint8_t techCnt;
+    uint8_t techs;
+
+    /* Count the technologies that answered */
+    techCnt = 0;
+    for( techs = gCd.techsFound; techs != 0U; techs &= (uint8_t)(techs - 1U) )
+    {
+        techCnt++;
+    }
+
+    gCd.result->techs    = gCd.techsFound;
+    gCd.result->detected = (techCnt > 0U);
+
+    if( techCnt == 0U )
+    {
+        gCd.result->detType = RFAL_CD_NOT_FOUND;
+        rfalFieldOff();                                              /* Nothing around, no need to keep the carrier */
+    }
+    else if( gCd.multiDev )
+    {
+        gCd.result->detType = RFAL_CD_MULTIPLE_DEV;
+    }
+    else if( techCnt > 1U )
+    {
+        gCd.result->detType = RFAL_CD_MULTIPLE_TECH;
+    }
+    else if( gCd.techsFound == (uint8_t)RFAL_CD_TECH_NFCV )
+    {
+        gCd.result->detType = RFAL_CD_CARD_TECH;                     /* NFC-V is not emulated by phones */
+    }
+    else
+    {
+        gCd.result->detType = RFAL_CD_SINGLE_DEV;
+    }
+
+    gCd.state = RFAL_CD_ST_DONE;
+}
+
+#endif /* RFAL_FEATURE_CD */
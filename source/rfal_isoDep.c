@@ -55,8 +55,11 @@
     #error " RFAL: Invalid ISO-DEP Configuration. Please select at least one mode: Poller and/or Listener. "
 #endif
 
-/* Check for valid I-Block length [RFAL_ISODEP_FSX_16 ; RFAL_ISODEP_FSX_4096]*/
-#if( (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN > 4096 ) || (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN < 16) )
+/* Check for valid I-Block length: one of the FSx values  ISO14443-4 Table 2 */
+#if( (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 16) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 24) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 32) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 40) && \
+     (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 48) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 64) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 96) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 128) && \
+     (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 256) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 512) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 1024) && (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 2048) && \
+     (RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN != 4096) )
     #error " RFAL: Invalid ISO-DEP IBlock Max length. Please change RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN. "
 #endif
 
@@ -65,6 +68,10 @@
     #error " RFAL: Invalid ISO-DEP APDU Max length. Please change RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN. "
 #endif
 
+#ifndef RFAL_FEATURE_ISO_DEP_FWT_STATS
+    #define RFAL_FEATURE_ISO_DEP_FWT_STATS   false    /* ISO-DEP response time statistics configuration missing. Disabled by default */
+#endif
+
 /*
  ******************************************************************************
  * DEFINES
@@ -88,6 +95,14 @@
 #define ISODEP_PCB_INVALID              (0x40U)      /*!< Bit mask of an Invalid PCB    */
 
 #define ISODEP_HDR_MAX_LEN              (RFAL_ISODEP_PCB_LEN + RFAL_ISODEP_DID_LEN + RFAL_ISODEP_NAD_LEN)          /*!< Max header length (PCB + DID + NAD)      */
+#define ISODEP_SW1SW2_LEN               (2U)                                                                       /*!< R-APDU status word length (SW1 SW2)     */
+
+#ifndef ISODEP_FWT_LEARN_MIN
+    #define ISODEP_FWT_LEARN_MIN        (16U)        /*!< Responses timed before the learned local FWT is applied          */
+#endif /* ISODEP_FWT_LEARN_MIN */
+#define ISODEP_FWT_LOCAL_MIN            (rfalConvMsTo1fc(1U))  /*!< Shortest learned local FWT (1/fc)                  */
+#define ISODEP_TX_ETU_PER_BYTE          (9U)         /*!< Shortest Tx byte duration in etu (NFC-A: 8 data + parity)        */
+#define ISODEP_TX_1ETU_IN_1FC           (128U)       /*!< etu duration at 106kbps (1/fc)                                   */
 
 #define ISODEP_PCB_IB_VALID_MASK        (ISODEP_PCB_B6_BIT | ISODEP_PCB_B2_BIT)                     /*!< Bit mask for the MUST bits on I-Block    */
 #define ISODEP_PCB_IB_VALID_VAL         (ISODEP_PCB_B2_BIT)                                         /*!< Value for the MUST bits on I-Block       */
@@ -427,6 +442,32 @@ typedef struct{
   uint16_t                APDUTxPos;        /*!< APDU Tx position               */
   uint16_t                APDURxPos;        /*!< APDU Rx position               */
   bool                    isAPDURxChaining; /*!< APDU Transceive chaining flag  */
+  bool                    isAPDUTxRx;       /*!< I-Block exchange part of an APDU transceive     */
+  bool                    isRxInPlace;      /*!< I-Block being received at its APDU position    */
+  bool                    isRxBlkInPlace;   /*!< Last I-Block INF already at its APDU position  */
+  uint8_t                 rxInPlaceSave[ISODEP_HDR_MAX_LEN]; /*!< APDU bytes overlapped by the I-Block header */
+  
+  rfalIsoDepApduStreamParam streamParam;    /*!< APDU Stream params             */
+  uint32_t                streamRxPos;      /*!< APDU Stream total Rx length    */
+  uint16_t                streamBlkLen;     /*!< APDU Stream I-Block Rx length  */
+  
+  rfalIsoDepApduScriptParam script;         /*!< APDU Script params             */
+  uint16_t                scriptArenaPos;   /*!< APDU Script arena position     */
+  uint16_t                scriptRxLen;      /*!< APDU Script current R-APDU len */
+  
+  rfalIsoDepLinkStats     linkStats;        /*!< Link counters of the session   */
+  
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+  rfalIsoDepFwtStats      fwtStats;         /*!< Response time statistics       */
+  uint32_t                fwtTxStart;       /*!< Last block Tx start (cycles)   */
+  uint32_t                fwtTxDur;         /*!< Last block Tx duration (us)    */
+  uint32_t                fwtRtMax;         /*!< Longest response time (1/fc)   */
+  uint32_t                fwtLocalRem;      /*!< FWT left after the local FWT   */
+  uint8_t                 fwtLocalShift;    /*!< Learned FWT margin (2^(n+1))   */
+  bool                    isFwtLocal;       /*!< Last block waits the local FWT */
+  bool                    isFwtLocalOff;    /*!< Full FWT for current exchange  */
+  bool                    isFwtAdaptive;    /*!< Adaptive FWT enabled           */
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
   
 }rfalIsoDep;
 
@@ -448,6 +489,18 @@ static void rfalIsoDepClearCounters( void );
 static ReturnCode rfalIsoDepTx( uint8_t pcb, const uint8_t* txBuf, uint8_t *infBuf, uint16_t infLen, uint32_t fwt );
 static ReturnCode rfalIsoDepHandleControlMsg( rfalIsoDepControlMsg controlMsg, uint8_t param );
 static void rfalIsoDepApdu2IBLockParam( rfalIsoDepApduTxRxParam apduParam, rfalIsoDepTxRxParam *iBlockParam, uint16_t txPos, uint16_t rxPos );
+static void rfalIsoDepApduRxSet( uint16_t rxPos );
+static ReturnCode rfalIsoDepApduRxDone( uint16_t infLen );
+static ReturnCode rfalIsoDepStartApduIBlock( rfalIsoDepTxRxParam txRxParam );
+static ReturnCode rfalIsoDepApduStreamNextTx( void );
+static ReturnCode rfalIsoDepApduScriptNext( void );
+
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+static void rfalIsoDepFwtStatsReset( void );
+static uint32_t rfalIsoDepFwtLocal( uint32_t fwt );
+static void rfalIsoDepFwtRecord( ReturnCode ret );
+static ReturnCode rfalIsoDepFwtLocalResume( void );
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
 
 #if RFAL_FEATURE_ISO_DEP_POLL
     static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsChaining );
@@ -543,10 +596,180 @@ static ReturnCode rfalIsoDepTx( uint8_t pcb, const uint8_t* txBuf, uint8_t *infB
     }
         
     
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    fwt                = rfalIsoDepFwtLocal( fwt );
+    gIsoDep.fwtTxStart = platformGetCycles();
+    
+    /* Shortest time the block (and CRC) takes on air, subtracted so the response is timed from the end of Tx */
+    gIsoDep.fwtTxDur   = rfalConv1fcToUs( ((uint32_t)txBufLen + ISODEP_CRC_LEN) * ISODEP_TX_ETU_PER_BYTE * (ISODEP_TX_1ETU_IN_1FC >> (uint8_t)gIsoDep.txBR) );
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+    
     rfalCreateByteFlagsTxRxContext( ctx, txBlock, txBufLen, gIsoDep.rxBuf, gIsoDep.rxBufLen, gIsoDep.rxLen, RFAL_TXRX_FLAGS_DEFAULT, ((gIsoDep.role == ISODEP_ROLE_PICC) ? RFAL_FWT_NONE : fwt ) );
     return rfalStartTransceive( &ctx );
 }
 
+
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+
+/*******************************************************************************/
+static void rfalIsoDepFwtStatsReset( void )
+{
+    ST_MEMSET( &gIsoDep.fwtStats, 0x00, sizeof(gIsoDep.fwtStats) );
+    gIsoDep.fwtRtMax      = 0;
+    gIsoDep.fwtLocalShift = 0;
+    gIsoDep.isFwtLocal    = false;
+    gIsoDep.isFwtLocalOff = false;
+}
+
+
+/*******************************************************************************/
+/* Returns the timeout to wait for a block sent with the given FWT: the learned
+ * local FWT on the regular waits (not on WTX nor Deselect) once enough 
+ * responses have been timed, the given FWT otherwise                         */
+static uint32_t rfalIsoDepFwtLocal( uint32_t fwt )
+{
+    uint32_t local;
+    
+    gIsoDep.isFwtLocal = false;
+    
+    if( (gIsoDep.role != ISODEP_ROLE_PCD) || !gIsoDep.isFwtAdaptive || gIsoDep.isFwtLocalOff || (gIsoDep.compMode == RFAL_COMPLIANCE_MODE_EMV) ||
+        (gIsoDep.fwtStats.rspCnt < ISODEP_FWT_LEARN_MIN) || (fwt != (gIsoDep.fwt + gIsoDep.dFwt)) )
+    {
+        return fwt;
+    }
+    
+    /* Twice (widened by 2^fwtLocalShift) the longest response seen, never beyond FWT */
+    if( gIsoDep.fwtRtMax >= (gIsoDep.fwt >> (1U + gIsoDep.fwtLocalShift)) )
+    {
+        local = gIsoDep.fwt;
+    }
+    else
+    {
+        local = MAX( (gIsoDep.fwtRtMax << (1U + gIsoDep.fwtLocalShift)), ISODEP_FWT_LOCAL_MIN );
+        local = MIN( local, gIsoDep.fwt );
+    }
+    local += gIsoDep.dFwt;
+    
+    gIsoDep.fwtStats.localFwt = (uint32_t)(((uint64_t)local * RFAL_US_IN_MS) / RFAL_1MS_IN_1FC);
+    gIsoDep.isFwtLocal        = (local < fwt);
+    gIsoDep.fwtLocalRem       = (fwt - local);
+    
+    return local;
+}
+
+
+/*******************************************************************************/
+/* Accounts the outcome of the block reception on the statistics             */
+static void rfalIsoDepFwtRecord( ReturnCode ret )
+{
+    uint32_t rtUs;
+    uint32_t rtFc;
+    uint8_t  bin;
+    
+    switch( ret )
+    {
+        case ERR_NONE:
+            rtUs = platformCyclesToUs( platformGetCycles() - gIsoDep.fwtTxStart );
+            rtUs = ((rtUs > gIsoDep.fwtTxDur) ? (rtUs - gIsoDep.fwtTxDur) : 0U);             /* From the end of Tx */
+            rtFc = (uint32_t)MIN( (((uint64_t)rtUs * RFAL_1MS_IN_1FC) / RFAL_US_IN_MS), UINT32_MAX );
+            
+            gIsoDep.fwtStats.rtMin    = ((gIsoDep.fwtStats.rspCnt == 0U) ? rtUs : MIN( gIsoDep.fwtStats.rtMin, rtUs ));
+            gIsoDep.fwtStats.rtMax    = MAX( gIsoDep.fwtStats.rtMax, rtUs );
+            gIsoDep.fwtStats.rtTotal += rtUs;
+            gIsoDep.fwtStats.rspCnt++;
+            gIsoDep.fwtRtMax          = MAX( gIsoDep.fwtRtMax, rtFc );
+            
+            /* Bin i holds the responses up to FWT/2^(7-i), the last one those beyond FWT */
+            for( bin = 0; bin < (RFAL_ISODEP_FWT_HIST_LEN - 1U); bin++ )
+            {
+                if( rtFc <= (gIsoDep.fwt >> ((RFAL_ISODEP_FWT_HIST_LEN - 2U) - bin)) )
+                {
+                    break;
+                }
+            }
+            gIsoDep.fwtStats.hist[bin]++;
+            break;
+        
+        case ERR_TIMEOUT:
+            /* The card may just be slower than learned: full FWT for the rest of the exchange, wider local FWT next */
+            if( gIsoDep.isFwtLocal )
+            {
+                gIsoDep.fwtStats.localTimeoutCnt++;
+                gIsoDep.isFwtLocalOff = true;
+                gIsoDep.fwtLocalShift = (uint8_t)MIN( (gIsoDep.fwtLocalShift + 1U), 8U );
+                break;
+            }
+            
+            gIsoDep.fwtStats.timeoutCnt++;
+            break;
+        
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+}
+
+
+/*******************************************************************************/
+/* The local FWT expired while the card still has the rest of its FWT: keep on 
+ * receiving (no Tx) until FWT + dFWT, only then the timeout is a real one    */
+static ReturnCode rfalIsoDepFwtLocalResume( void )
+{
+    rfalTransceiveContext ctx;
+    
+    gIsoDep.isFwtLocal = false;
+    
+    rfalCreateByteFlagsTxRxContext( ctx, NULL, 0U, gIsoDep.rxBuf, gIsoDep.rxBufLen, gIsoDep.rxLen, RFAL_TXRX_FLAGS_DEFAULT, gIsoDep.fwtLocalRem );
+    return rfalStartTransceive( &ctx );
+}
+
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepGetLinkStats( rfalIsoDepLinkStats *stats )
+{
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    *stats = gIsoDep.linkStats;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepGetFwtStats( rfalIsoDepFwtStats *stats )
+{
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    *stats     = gIsoDep.fwtStats;
+    stats->fwt = (uint32_t)(((uint64_t)gIsoDep.fwt * RFAL_US_IN_MS) / RFAL_1MS_IN_1FC);
+    return ERR_NONE;
+#else
+    NO_WARNING( stats );
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepSetFwtAdaptive( bool enable )
+{
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    gIsoDep.isFwtAdaptive = enable;
+    return ERR_NONE;
+#else
+    NO_WARNING( enable );
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+}
+
 /*******************************************************************************/
 static ReturnCode rfalIsoDepHandleControlMsg( rfalIsoDepControlMsg controlMsg, uint8_t param )
 {
@@ -706,6 +929,9 @@ void rfalIsoDepInitialize( void )
     
     gIsoDep.APDURxPos       = 0;
     gIsoDep.APDUTxPos       = 0;
+    gIsoDep.isAPDUTxRx      = false;
+    gIsoDep.isRxInPlace     = false;
+    gIsoDep.isRxBlkInPlace  = false;
     gIsoDep.APDUParam.rxLen = NULL;
     gIsoDep.APDUParam.rxBuf = NULL;
     gIsoDep.APDUParam.txBuf = NULL;
@@ -791,6 +1017,22 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
         case ISODEP_ST_PCD_RX:
                       
             ret = rfalGetTransceiveStatus();
+            
+        #if RFAL_FEATURE_ISO_DEP_FWT_STATS
+            rfalIsoDepFwtRecord( ret );
+            
+            if( (ret == ERR_TIMEOUT) && gIsoDep.isFwtLocal )
+            {
+                EXIT_ON_ERR( ret, rfalIsoDepFwtLocalResume() );                /* Not a timeout yet, no R(NAK) within FWT */
+                return ERR_BUSY;
+            }
+        #endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+            
+            if( ret != ERR_BUSY )
+            {
+                gIsoDep.linkStats.blkCnt++;
+            }
+            
             switch( ret )
             {
                 /* Data rcvd with error or timeout -> Send R-NAK */
@@ -800,6 +1042,8 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
                 case ERR_FRAMING:          /* added to handle test cases scenario TC_POL_NFCB_T4AT_BI_82_x_y & TC_POL_NFCB_T4BT_BI_82_x_y */
                 case ERR_INCOMPLETE_BYTE:  /* added to handle test cases scenario TC_POL_NFCB_T4AT_BI_82_x_y & TC_POL_NFCB_T4BT_BI_82_x_y */
                     
+                    gIsoDep.linkStats.errCnt++;
+                    
                     if( gIsoDep.isRxChaining )
                     {   /* Rule 5 - In PICC chaining when a invalid/timeout occurs -> R-ACK */                        
                         EXIT_ON_ERR( ret, rfalIsoDepHandleControlMsg( ISODEP_R_ACK, RFAL_ISODEP_NO_PARAM ) );
@@ -873,6 +1117,11 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
                         gIsoDep.cntSWtxNack = 0;       /* Reset R(NACK)->S(WTX) counter */
                     }
                     
+                #if RFAL_FEATURE_ISO_DEP_FWT_STATS
+                    gIsoDep.fwtStats.wtxCnt++;
+                    gIsoDep.fwtStats.wtxmMax = MAX( gIsoDep.fwtStats.wtxmMax, rfalIsoDep_GetWTXM(gIsoDep.rxBuf[gIsoDep.hdrLen]) );
+                #endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+                    
                     /* Rule 3 - respond to S-block: get 1st INF byte S(STW): Power + WTXM */
                     EXIT_ON_ERR( ret, rfalIsoDepHandleControlMsg( ISODEP_S_WTX, rfalIsoDep_GetWTXM(gIsoDep.rxBuf[gIsoDep.hdrLen]) ) );                    
                     return ERR_BUSY;
@@ -955,9 +1204,6 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
                         
                         rfalIsoDepClearCounters();  /* Clear counters in case R counter is already at max */
                         
-                        /* Rule 2 - Send ACK */
-                        EXIT_ON_ERR( ret, rfalIsoDepHandleControlMsg( ISODEP_R_ACK, RFAL_ISODEP_NO_PARAM ) );
-                        
                         /* Received I-Block with chaining, send current data to DH */
                         
                         /* remove ISO DEP header, check is necessary to move the INF data on the buffer */
@@ -967,6 +1213,16 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
                             ST_MEMMOVE( &gIsoDep.rxBuf[gIsoDep.rxBufInfPos], &gIsoDep.rxBuf[gIsoDep.hdrLen], *outActRxLen );
                         }
                         
+                        /* On APDU transceive place this INF and receive the next I-Block right after it */
+                        if( gIsoDep.isAPDUTxRx )
+                        {
+                            EXIT_ON_ERR( ret, rfalIsoDepApduRxDone( *outActRxLen ) );
+                            rfalIsoDepApduRxSet( (gIsoDep.APDURxPos + *outActRxLen) );
+                        }
+                        
+                        /* Rule 2 - Send ACK */
+                        EXIT_ON_ERR( ret, rfalIsoDepHandleControlMsg( ISODEP_R_ACK, RFAL_ISODEP_NO_PARAM ) );
+                        
                         rfalIsoDepClearCounters();
                         return ERR_AGAIN;       /* Send Again signalling to run again, but some chaining data has arrived */
                     }
@@ -996,6 +1252,11 @@ static ReturnCode rfalIsoDepDataExchangePCD( uint16_t *outActRxLen, bool *outIsC
                     
                     gIsoDep.state = ISODEP_ST_IDLE;
                     rfalIsoDepClearCounters();
+                    
+                    if( gIsoDep.isAPDUTxRx )
+                    {
+                        return rfalIsoDepApduRxDone( *outActRxLen );
+                    }
                     return ERR_NONE;
                 }
                 else
@@ -1060,6 +1321,65 @@ ReturnCode rfalIsoDepDeselect( void )
     return ((cntRerun == 0U) ? ERR_TIMEOUT : ret);
 }
 
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepStartPresenceCheck( uint32_t fwt )
+{
+    if( gIsoDep.role != ISODEP_ROLE_PCD )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    /*******************************************************************************/
+    /* Use the control msg buffer, user buffers of the last exchange are left as is */
+    gIsoDep.rxLen       = &gIsoDep.ctrlRxLen;
+    gIsoDep.rxBuf       = gIsoDep.ctrlBuf;
+    gIsoDep.rxBufLen    = ISODEP_CONTROLMSG_BUF_LEN;
+    gIsoDep.state       = ISODEP_ST_IDLE;
+    gIsoDep.isAPDUTxRx  = false;
+    
+    ST_MEMSET( gIsoDep.ctrlBuf, 0x00, ISODEP_CONTROLMSG_BUF_LEN );
+    
+    /* ISO14443-4 Rule 12: the PICC answers a R(NAK) not carrying its current block number with a R(ACK) *
+     * The current block number is already toggled to the next I-Block, so no block number is consumed    */
+    return rfalIsoDepTx( rfalIsoDep_PCBRNAK( gIsoDep.blockNumber ), gIsoDep.ctrlBuf, &gIsoDep.ctrlBuf[RFAL_ISODEP_PCB_LEN + RFAL_ISODEP_DID_LEN], 0, fwt );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepGetPresenceCheckStatus( void )
+{
+    ReturnCode ret;
+    
+    ret = rfalGetTransceiveStatus();
+    if( ret != ERR_NONE )
+    {
+        return ret;
+    }
+    
+    gIsoDep.ctrlRxLen = rfalConvBitsToBytes( gIsoDep.ctrlRxLen );
+    
+    /* Any valid R-Block means the PICC is still there and in the protocol */
+    if( (gIsoDep.ctrlRxLen < RFAL_ISODEP_PCB_LEN) || !rfalIsoDep_PCBisRBlock( gIsoDep.ctrlBuf[ISODEP_PCB_POS] ) )
+    {
+        return ERR_PROTO;
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepPresenceCheck( uint32_t fwt )
+{
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalIsoDepStartPresenceCheck( fwt ) );
+    rfalRunBlocking( ret, rfalIsoDepGetPresenceCheckStatus() );
+    
+    return ret;
+}
+
 #endif /* RFAL_FEATURE_ISO_DEP_POLL */
 
 
@@ -1095,8 +1415,8 @@ uint16_t rfalIsoDepFSxI2FSx( uint8_t FSxI )
     uint16_t fsx;
     uint8_t  fsi;
     
-    /* Enforce maximum FSxI/FSx allowed - NFC Forum and EMVCo differ */
-    fsi = (( gIsoDep.compMode == RFAL_COMPLIANCE_MODE_EMV ) ? MIN( FSxI, RFAL_ISODEP_FSDI_MAX_EMV ) : MIN( FSxI, RFAL_ISODEP_FSDI_MAX_NFC ));
+    /* Enforce maximum FSxI/FSx allowed - NFC Forum and EMVCo differ, ISO14443-4 Amd2 and Digital 2.1 allow up to 4096 */
+    fsi = (( gIsoDep.compMode == RFAL_COMPLIANCE_MODE_EMV ) ? MIN( FSxI, RFAL_ISODEP_FSDI_MAX_EMV ) : MIN( FSxI, RFAL_ISODEP_FSDI_MAX_NFC_21 ));
     
     switch( fsi )
     {
@@ -1469,6 +1789,14 @@ ReturnCode rfalIsoDepStartTransceive( rfalIsoDepTxRxParam param )
     gIsoDep.rxBufInfPos  = (uint8_t)((uint32_t)param.rxBuf->inf - (uint32_t)param.rxBuf->prologue);
     gIsoDep.rxBufLen     = sizeof(rfalIsoDepBufFormat);
     
+    gIsoDep.isAPDUTxRx     = false;
+    gIsoDep.isRxInPlace    = false;
+    gIsoDep.isRxBlkInPlace = false;
+    
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    gIsoDep.isFwtLocalOff  = false;
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+    
     gIsoDep.rxLen        = param.rxLen;
     gIsoDep.rxChaining   = param.isRxChaining;
     
@@ -1901,6 +2229,7 @@ static ReturnCode rfalIsoDepDataExchangePICC( void )
 static ReturnCode rfalIsoDepStartRATS( rfalIsoDepFSxI FSDI, uint8_t DID, rfalIsoDepAts *ats, uint8_t *atsLen )
 {
     rfalTransceiveContext ctx;
+    uint8_t               fsdi;
     
     if( ats == NULL)
     {
@@ -1914,7 +2243,10 @@ static ReturnCode rfalIsoDepStartRATS( rfalIsoDepFSxI FSDI, uint8_t DID, rfalIso
     /*******************************************************************************/
     /* Compose RATS */
     gIsoDep.actv.ratsReq.CMD   = RFAL_ISODEP_CMD_RATS;
-    gIsoDep.actv.ratsReq.PARAM = (((uint8_t)FSDI << RFAL_ISODEP_RATS_PARAM_FSDI_SHIFT) & RFAL_ISODEP_RATS_PARAM_FSDI_MASK) | (DID & RFAL_ISODEP_RATS_PARAM_DID_MASK);
+    /* Never announce a frame larger than the I-Block buffers can hold */
+    fsdi = MIN( (uint8_t)FSDI, (uint8_t)RFAL_ISODEP_FSDI_MAX );
+    
+    gIsoDep.actv.ratsReq.PARAM = ((fsdi << RFAL_ISODEP_RATS_PARAM_FSDI_SHIFT) & RFAL_ISODEP_RATS_PARAM_FSDI_MASK) | (DID & RFAL_ISODEP_RATS_PARAM_DID_MASK);
     
     rfalCreateByteFlagsTxRxContext( ctx, (uint8_t*)&gIsoDep.actv.ratsReq, sizeof(rfalIsoDepRats), (uint8_t*)ats, sizeof(rfalIsoDepAts), &gIsoDep.rxBufLen, RFAL_TXRX_FLAGS_DEFAULT, RFAL_ISODEP_T4T_FWT_ACTIVATION );
     return rfalStartTransceive( &ctx );
@@ -2039,7 +2371,7 @@ static ReturnCode rfalIsoDepStartATTRIB( const uint8_t* nfcid0, uint8_t PARAM1,
     /* Compose ATTRIB command */
     gIsoDep.actv.attribReq.cmd          = RFAL_ISODEP_CMD_ATTRIB;
     gIsoDep.actv.attribReq.Param.PARAM1 = PARAM1;
-    gIsoDep.actv.attribReq.Param.PARAM2 = ( ((((uint8_t)DSI<<RFAL_ISODEP_ATTRIB_PARAM2_DSI_SHIFT) | ((uint8_t)DRI<<RFAL_ISODEP_ATTRIB_PARAM2_DRI_SHIFT)) & RFAL_ISODEP_ATTRIB_PARAM2_DXI_MASK) | ((uint8_t)FSDI & RFAL_ISODEP_ATTRIB_PARAM2_FSDI_MASK) );
+    gIsoDep.actv.attribReq.Param.PARAM2 = ( ((((uint8_t)DSI<<RFAL_ISODEP_ATTRIB_PARAM2_DSI_SHIFT) | ((uint8_t)DRI<<RFAL_ISODEP_ATTRIB_PARAM2_DRI_SHIFT)) & RFAL_ISODEP_ATTRIB_PARAM2_DXI_MASK) | (MIN( (uint8_t)FSDI, (uint8_t)RFAL_ISODEP_FSDI_MAX ) & RFAL_ISODEP_ATTRIB_PARAM2_FSDI_MASK) );
     gIsoDep.actv.attribReq.Param.PARAM3 = PARAM3;
     gIsoDep.actv.attribReq.Param.PARAM4 = (DID & RFAL_ISODEP_ATTRIB_PARAM4_DID_MASK);
     ST_MEMCPY(gIsoDep.actv.attribReq.nfcid0, nfcid0, RFAL_NFCB_NFCID0_LEN);
@@ -2127,6 +2459,11 @@ ReturnCode rfalIsoDepPollAStartActivation( rfalIsoDepFSxI FSDI, uint8_t DID, rfa
     /* Start RATS Transceive */
     EXIT_ON_ERR( ret, rfalIsoDepStartRATS( FSDI, DID, &rfalIsoDepDev->activation.A.Listener.ATS, &rfalIsoDepDev->activation.A.Listener.ATSLen ) );
     
+    ST_MEMSET( &gIsoDep.linkStats, 0x00, sizeof(gIsoDep.linkStats) );   /* New session */
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    rfalIsoDepFwtStatsReset();                     /* New session */
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
+    
     rfalIsoDepDev->info.DSI = maxBR;
     gIsoDep.actvDev     = rfalIsoDepDev;
     gIsoDep.cntRRetrys  = gIsoDep.maxRetriesRATS;
@@ -2378,6 +2715,10 @@ ReturnCode rfalIsoDepPollBStartActivation( rfalIsoDepFSxI FSDI, uint8_t DID, rfa
                                &rfalIsoDepDev->activation.B.Listener.ATTRIB_RESLen
                              ) );
     
+    ST_MEMSET( &gIsoDep.linkStats, 0x00, sizeof(gIsoDep.linkStats) );   /* New session */
+#if RFAL_FEATURE_ISO_DEP_FWT_STATS
+    rfalIsoDepFwtStatsReset();                     /* New session */
+#endif /* RFAL_FEATURE_ISO_DEP_FWT_STATS */
     
     gIsoDep.actvDev = rfalIsoDepDev;
     return ret;
@@ -2686,14 +3027,92 @@ static uint32_t rfalIsoDepSFGI2SFGT( uint8_t sfgi )
          iBlockParam->txBufLen     = (apduParam.txBufLen - txPos);
      }
      
-     /* TxBuf is moved to the beginning for every I-Block */
-     iBlockParam->txBuf        = (rfalIsoDepBufFormat*)apduParam.txBuf;   /*  PRQA S 0310 # MISRA 11.3 - Intentional safe cast to avoiding large buffer duplication */
-     iBlockParam->rxBuf        = apduParam.tmpBuf;                        /* Simply using the apdu buffer is not possible because of current ACK handling */
+     /* I-Block framed in place, the prologue is written on the bytes preceding the chunk (already sent) */
+     iBlockParam->txBuf        = (rfalIsoDepBufFormat*)&((uint8_t*)apduParam.txBuf)[txPos];   /*  PRQA S 0310 # MISRA 11.3 - Intentional safe cast to avoiding large buffer duplication */
+     iBlockParam->rxBuf        = apduParam.tmpBuf;                        /* R-Blocks while chaining on Tx, see rfalIsoDepApduRxSet() for I-Blocks */
      iBlockParam->isRxChaining = &gIsoDep.isAPDURxChaining;
      iBlockParam->rxLen        = apduParam.rxLen;
 }
+
+
+/*******************************************************************************/
+/* Points the reception of the next I-Block so that its INF lands straight at
+ * the given APDU position. The header is received on the preceding bytes, 
+ * which are saved and restored once the I-Block is done.
+ * The tmp buffer is used instead in Listen mode, when the APDU buffer has no
+ * room left for a full frame, or while the response would overwrite the 
+ * command still to be acknowledged (same Tx and Rx APDU buffer).              */
+static void rfalIsoDepApduRxSet( uint16_t rxPos )
+{
+    uint16_t space;
+    
+    gIsoDep.isAPDUTxRx  = true;
+    gIsoDep.isRxInPlace = false;
+    
+    space = (((uint16_t)RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN > rxPos) ? (uint16_t)(RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN - rxPos) : 0U);
+    
+    if( (gIsoDep.role != ISODEP_ROLE_PCD) || ((space + gIsoDep.hdrLen) < gIsoDep.ourFsx) ||
+        ((gIsoDep.APDUParam.rxBuf == gIsoDep.APDUParam.txBuf) && (rxPos == 0U)) )
+    {
+        gIsoDep.rxBuf       = gIsoDep.APDUParam.tmpBuf->prologue;
+        gIsoDep.rxBufInfPos = (uint8_t)((uint32_t)gIsoDep.APDUParam.tmpBuf->inf - (uint32_t)gIsoDep.APDUParam.tmpBuf->prologue);
+        gIsoDep.rxBufLen    = sizeof(rfalIsoDepBufFormat);
+        return;
+    }
+    
+    gIsoDep.rxBuf       = &gIsoDep.APDUParam.rxBuf->apdu[rxPos] - gIsoDep.hdrLen;   /* Within the APDU buffer, the prologue is at least the header length */
+    gIsoDep.rxBufInfPos = gIsoDep.hdrLen;
+    gIsoDep.rxBufLen    = (uint16_t)MIN( sizeof(rfalIsoDepBufFormat), ((uint32_t)space + gIsoDep.hdrLen) );
+    gIsoDep.isRxInPlace = true;
+    
+    ST_MEMCPY( gIsoDep.rxInPlaceSave, gIsoDep.rxBuf, gIsoDep.hdrLen );
+}
+
+
+/*******************************************************************************/
+/* Places the INF of the I-Block just received at the current APDU position   */
+static ReturnCode rfalIsoDepApduRxDone( uint16_t infLen )
+{
+    gIsoDep.isRxBlkInPlace = true;
+    
+    if( gIsoDep.isRxInPlace )
+    {
+        /* INF already in place, restore the APDU bytes overlapped by the header */
+        ST_MEMCPY( gIsoDep.rxBuf, gIsoDep.rxInPlaceSave, gIsoDep.hdrLen );
+        return ERR_NONE;
+    }
+    
+    if( infLen > 0U )    /* MISRA 21.18 */
+    {
+        /* Ensure that data in tmpBuf still fits into APDU buffer */
+        if( (gIsoDep.APDURxPos + infLen) > (uint16_t)RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN )
+        {
+            return ERR_NOMEM;
+        }
+        
+        ST_MEMCPY( &gIsoDep.APDUParam.rxBuf->apdu[gIsoDep.APDURxPos], gIsoDep.APDUParam.tmpBuf->inf, infLen );
+    }
+    return ERR_NONE;
+}
  
  
+/*******************************************************************************/
+/* Starts the next I-Block of the APDU, receiving the response in place       */
+static ReturnCode rfalIsoDepStartApduIBlock( rfalIsoDepTxRxParam txRxParam )
+{
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalIsoDepStartTransceive( txRxParam ) );
+    
+    /* Response I-Blocks only follow the last (non chained) I-Block */
+    if( !txRxParam.isTxChaining )
+    {
+        rfalIsoDepApduRxSet( gIsoDep.APDURxPos );
+    }
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalIsoDepStartApduTransceive( rfalIsoDepApduTxRxParam param )
 {
@@ -2711,7 +3130,7 @@ ReturnCode rfalIsoDepStartApduTransceive( rfalIsoDepApduTxRxParam param )
     /* Convert APDU TxRxParams to I-Block TxRxParams */
     rfalIsoDepApdu2IBLockParam( gIsoDep.APDUParam, &txRxParam, gIsoDep.APDUTxPos, gIsoDep.APDURxPos );
     
-    return rfalIsoDepStartTransceive( txRxParam );
+    return rfalIsoDepStartApduIBlock( txRxParam );
 }
  
  
@@ -2736,13 +3155,7 @@ ReturnCode rfalIsoDepGetApduTransceiveStatus( void )
                 /* Convert APDU TxRxParams to I-Block TxRxParams */
                 rfalIsoDepApdu2IBLockParam( gIsoDep.APDUParam, &txRxParam, gIsoDep.APDUTxPos, gIsoDep.APDURxPos );
                 
-                if( txRxParam.txBufLen > 0U )      /* MISRA 21.18 */
-                {
-                    /* Move next I-Block to beginning of APDU Tx buffer */
-                    ST_MEMCPY( gIsoDep.APDUParam.txBuf->apdu, &gIsoDep.APDUParam.txBuf->apdu[gIsoDep.APDUTxPos], txRxParam.txBufLen );
-                }
-                
-                EXIT_ON_ERR( ret, rfalIsoDepStartTransceive( txRxParam ) );
+                EXIT_ON_ERR( ret, rfalIsoDepStartApduIBlock( txRxParam ) );
                 return ERR_BUSY;
             }
              
@@ -2765,18 +3178,17 @@ ReturnCode rfalIsoDepGetApduTransceiveStatus( void )
                 return ERR_NONE;
             }
             
-            if( *gIsoDep.APDUParam.rxLen > 0U )    /* MISRA 21.18 */
+            /* INF not yet placed on the APDU buffer (Listen mode), copy it from tmp buffer */
+            if( !gIsoDep.isRxBlkInPlace )
             {
-                /* Ensure that data in tmpBuf still fits into APDU buffer */
-                if( (gIsoDep.APDURxPos + (*gIsoDep.APDUParam.rxLen)) > (uint16_t)RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN )
+                gIsoDep.isRxInPlace = false;
+                if( rfalIsoDepApduRxDone( *gIsoDep.APDUParam.rxLen ) != ERR_NONE )
                 {
                     return ERR_NOMEM;
                 }
-                
-                /* Copy chained packet from tmp buffer to APDU buffer */
-                ST_MEMCPY( &gIsoDep.APDUParam.rxBuf->apdu[gIsoDep.APDURxPos], gIsoDep.APDUParam.tmpBuf->inf, *gIsoDep.APDUParam.rxLen );
-                gIsoDep.APDURxPos += *gIsoDep.APDUParam.rxLen;
             }
+            gIsoDep.isRxBlkInPlace = false;
+            gIsoDep.APDURxPos     += *gIsoDep.APDUParam.rxLen;
             
             /* Update output param rxLen */
             *gIsoDep.APDUParam.rxLen = gIsoDep.APDURxPos;
@@ -2784,13 +3196,256 @@ ReturnCode rfalIsoDepGetApduTransceiveStatus( void )
             /* Wait for following I-Block or APDU TxRx has finished */
             return ((ret == ERR_AGAIN) ? ERR_BUSY : ERR_NONE);
         
+        /*******************************************************************************/
+        case ERR_BUSY:
+            break;
+        
         /*******************************************************************************/
         default:
-            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            /* Exchange failed, give back the APDU bytes overlapped by an in place header */
+            if( gIsoDep.isRxInPlace && !gIsoDep.isRxBlkInPlace )
+            {
+                ST_MEMCPY( gIsoDep.rxBuf, gIsoDep.rxInPlaceSave, gIsoDep.hdrLen );
+            }
+            gIsoDep.isRxInPlace = false;
             break;
     }
     
     return ret;
  }
+ 
+ 
+/*******************************************************************************/
+/* Pulls the next command chunk from the producer and sends it as I-Block     */
+static ReturnCode rfalIsoDepApduStreamNextTx( void )
+{
+    ReturnCode          ret;
+    rfalIsoDepTxRxParam txRxParam;
+    uint16_t            maxLen;
+    uint16_t            len;
+    bool                more;
+    
+    len    = 0;
+    more   = false;
+    maxLen = (uint16_t)MIN( rfalIsoDepGetMaxInfLen(), RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN );
+    
+    EXIT_ON_ERR( ret, gIsoDep.streamParam.txCb( gIsoDep.streamParam.ctx, gIsoDep.streamParam.txBuf->inf, maxLen, &len, &more ) );
+    
+    if( len > maxLen )
+    {
+        return ERR_PARAM;
+    }
+    
+    txRxParam.txBuf        = gIsoDep.streamParam.txBuf;
+    txRxParam.txBufLen     = len;
+    txRxParam.isTxChaining = more;
+    txRxParam.rxBuf        = gIsoDep.streamParam.rxBuf;
+    txRxParam.rxLen        = &gIsoDep.streamBlkLen;
+    txRxParam.isRxChaining = &gIsoDep.isAPDURxChaining;
+    txRxParam.DID          = gIsoDep.streamParam.DID;
+    txRxParam.FSx          = gIsoDep.streamParam.FSx;
+    txRxParam.ourFSx       = gIsoDep.streamParam.ourFSx;
+    txRxParam.FWT          = gIsoDep.streamParam.FWT;
+    txRxParam.dFWT         = gIsoDep.streamParam.dFWT;
+    
+    return rfalIsoDepStartTransceive( txRxParam );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepStartApduStream( rfalIsoDepApduStreamParam param )
+{
+    if( (param.txCb == NULL) || (param.rxCb == NULL) || (param.txBuf == NULL) || (param.rxBuf == NULL) || (param.txBuf == param.rxBuf) )
+    {
+        return ERR_PARAM;
+    }
+    
+    /* Initialize and store APDU Stream context */
+    gIsoDep.streamParam  = param;
+    gIsoDep.streamRxPos  = 0;
+    gIsoDep.streamBlkLen = 0;
+    
+    /* Assign current FSx to calculate INF length (only change the FSx from activation if no to Keep) */
+    gIsoDep.ourFsx = (( param.ourFSx != RFAL_ISODEP_FSX_KEEP ) ? param.ourFSx : gIsoDep.ourFsx);
+    gIsoDep.fsx    = param.FSx;
+    
+    return rfalIsoDepApduStreamNextTx();
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepGetApduStreamStatus( void )
+{
+    ReturnCode ret;
+    ReturnCode cbRet;
+    
+    ret = rfalIsoDepGetTransceiveStatus();
+    switch( ret )
+    {
+        /*******************************************************************************/
+        case ERR_NONE:
+            
+            /* Check if we are still doing chaining on Tx */
+            if( gIsoDep.isTxChaining )
+            {
+                EXIT_ON_ERR( ret, rfalIsoDepApduStreamNextTx() );
+                return ERR_BUSY;
+            }
+            
+            /* APDU TxRx is done */
+            /* fall through */
+        
+        /*******************************************************************************/
+        case ERR_AGAIN:        /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
+            
+            gIsoDep.streamRxPos += gIsoDep.streamBlkLen;
+            if( gIsoDep.streamParam.rxLen != NULL )
+            {
+                *gIsoDep.streamParam.rxLen = gIsoDep.streamRxPos;
+            }
+            
+            /* Hand the I-Block to the consumer before the following one is read */
+            cbRet = gIsoDep.streamParam.rxCb( gIsoDep.streamParam.ctx, gIsoDep.streamParam.rxBuf->inf, gIsoDep.streamBlkLen, (ret == ERR_NONE) );
+            if( cbRet != ERR_NONE )
+            {
+                return cbRet;
+            }
+            
+            /* Wait for following I-Block or APDU TxRx has finished */
+            return ((ret == ERR_AGAIN) ? ERR_BUSY : ERR_NONE);
+        
+        /*******************************************************************************/
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+    
+    return ret;
+}
+
+/*******************************************************************************/
+/* Composes the C-APDU of the current step and starts its transceive          */
+static ReturnCode rfalIsoDepApduScriptNext( void )
+{
+    const rfalIsoDepApduStep    *step;
+    const rfalIsoDepApduStepRes *src;
+    rfalIsoDepApduTxRxParam     txRx;
+    int32_t                     srcPos;
+    
+    step = &gIsoDep.script.steps[*gIsoDep.script.resCnt];
+    
+    if( (step->cApdu == NULL) || (step->cApduLen > (uint16_t)RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN) )
+    {
+        return ERR_NOMEM;
+    }
+    ST_MEMCPY( gIsoDep.script.txBuf->apdu, step->cApdu, step->cApduLen );
+    
+    /* Place the parameter taken from a previous R-APDU */
+    if( step->paramStep != RFAL_ISODEP_SCRIPT_NO_PARAM )
+    {
+        if( (step->paramStep >= *gIsoDep.script.resCnt) || (step->paramDst >= step->cApduLen) )
+        {
+            return ERR_PARAM;
+        }
+        
+        src    = &gIsoDep.script.res[step->paramStep];
+        srcPos = ((step->paramSrc < 0) ? ((int32_t)src->len + step->paramSrc) : (int32_t)step->paramSrc);
+        if( (srcPos < 0) || (srcPos >= (int32_t)src->len) )
+        {
+            return ERR_PROTO;
+        }
+        
+        gIsoDep.script.txBuf->apdu[step->paramDst] = gIsoDep.script.arena[ (src->pos + (uint16_t)srcPos) ];
+    }
+    
+    txRx.txBuf    = gIsoDep.script.txBuf;
+    txRx.txBufLen = step->cApduLen;
+    txRx.rxBuf    = gIsoDep.script.rxBuf;
+    txRx.rxLen    = &gIsoDep.scriptRxLen;
+    txRx.tmpBuf   = gIsoDep.script.tmpBuf;
+    txRx.FWT      = gIsoDep.script.FWT;
+    txRx.dFWT     = gIsoDep.script.dFWT;
+    txRx.FSx      = gIsoDep.script.FSx;
+    txRx.ourFSx   = gIsoDep.script.ourFSx;
+    txRx.DID      = gIsoDep.script.DID;
+    
+    return rfalIsoDepStartApduTransceive( txRx );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepStartApduScript( const rfalIsoDepApduScriptParam *param )
+{
+    if( (param == NULL) || (param->steps == NULL) || (param->stepCnt == 0U) || (param->res == NULL) || (param->resCnt == NULL) ||
+        (param->arena == NULL) || (param->txBuf == NULL) || (param->rxBuf == NULL) || (param->tmpBuf == NULL) )
+    {
+        return ERR_PARAM;
+    }
+    
+    gIsoDep.script         = *param;
+    gIsoDep.scriptArenaPos = 0;
+    *gIsoDep.script.resCnt = 0;
+    
+    return rfalIsoDepApduScriptNext();
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalIsoDepGetApduScriptStatus( void )
+{
+    ReturnCode               ret;
+    uint16_t                 sw;
+    uint16_t                 len;
+    const rfalIsoDepApduStep *step;
+    rfalIsoDepApduStepRes    *res;
+    
+    ret = rfalIsoDepGetApduTransceiveStatus();
+    if( ret != ERR_NONE )
+    {
+        return ret;
+    }
+    
+    step = &gIsoDep.script.steps[*gIsoDep.script.resCnt];
+    res  = &gIsoDep.script.res[*gIsoDep.script.resCnt];
+    len  = gIsoDep.scriptRxLen;
+    
+    if( len < ISODEP_SW1SW2_LEN )
+    {
+        return ERR_PROTO;
+    }
+    
+    if( (gIsoDep.scriptArenaPos + len) > gIsoDep.script.arenaLen )
+    {
+        return ERR_NOMEM;
+    }
+    
+    /* Keep the R-APDU on the arena, right after the previous one */
+    ST_MEMCPY( &gIsoDep.script.arena[gIsoDep.scriptArenaPos], gIsoDep.script.rxBuf->apdu, len );
+    res->pos                = gIsoDep.scriptArenaPos;
+    res->len                = len;
+    gIsoDep.scriptArenaPos += len;
+    (*gIsoDep.script.resCnt)++;
+    
+    sw = GETU16( &gIsoDep.script.rxBuf->apdu[ (len - ISODEP_SW1SW2_LEN) ] );
+    if( (sw & step->swMask) != (step->sw & step->swMask) )
+    {
+        if( step->onMismatch == RFAL_ISODEP_SCRIPT_ABORT )
+        {
+            return ERR_REQUEST;
+        }
+        if( step->onMismatch == RFAL_ISODEP_SCRIPT_END )
+        {
+            return ERR_NONE;
+        }
+    }
+    
+    if( *gIsoDep.script.resCnt >= gIsoDep.script.stepCnt )
+    {
+        return ERR_NONE;
+    }
+    
+    EXIT_ON_ERR( ret, rfalIsoDepApduScriptNext() );
+    return ERR_BUSY;
+}
 
 #endif /* RFAL_FEATURE_ISO_DEP */
@@ -0,0 +1,1220 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2020 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file rfal_llcp.c
+ *
+ *  \author
+ *
+ *  \brief Implementation of the NFC Forum LLCP on top of NFC-DEP
+ *
+ *  Each NFC-DEP transceive carries exactly one LLCP PDU in each direction.
+ *  The PDU to be sent is chosen in the following order: LLC link
+ *  deactivation, DM for an unknown SAP, then per link (round robin) its
+ *  pending CONNECT/CC/DISC/DM, an I PDU if the remote Receive Window is
+ *  open, an RR if a received I PDU is still unacknowledged, a UI PDU, and
+ *  only when nothing is pending a SYMM.
+ *  Acknowledgements ride on the I PDUs sent, so an RR is only used when
+ *  the link has nothing to send.
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "rfal_llcp.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * ENABLE SWITCH
+ ******************************************************************************
+ */
+
+#ifndef RFAL_FEATURE_LLCP
+    #define RFAL_FEATURE_LLCP   false    /* LLCP module configuration missing. Disabled by default */
+#endif
+
+#if RFAL_FEATURE_LLCP
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define LLCP_VERSION                0x11U    /*!< LLCP version 1.1                                    */
+#define LLCP_VERSION_MAJOR_MASK     0xF0U    /*!< LLCP major version mask                             */
+#define LLCP_LTO_DEFAULT            100U     /*!< Default Link Timeout (ms)        LLCP 1.1 4.5.4     */
+#define LLCP_LTO_UNIT               10U      /*!< LTO parameter unit (ms)                             */
+#define LLCP_RW_DEFAULT             1U       /*!< Default Receive Window           LLCP 1.1 4.5.2     */
+#define LLCP_MIUX_MASK              0x07FFU  /*!< MIUX value mask                                     */
+#define LLCP_RW_MASK                0x0FU    /*!< RW value mask                                       */
+#define LLCP_SEQ_MASK               0x0FU    /*!< N(S) / N(R) modulus mask                            */
+#define LLCP_SAP_MASK               0x3FU    /*!< DSAP / SSAP mask                                    */
+#define LLCP_SAP_SDP_FIRST          0x10U    /*!< First SAP assigned by the SDP                       */
+#define LLCP_SAP_FIRST_FREE         0x20U    /*!< First SAP not bound to a service name               */
+#define LLCP_AGF_LEN_LEN            2U       /*!< Length field of a PDU within an AGF                 */
+#define LLCP_OPT_LSC_BOTH           0x03U    /*!< Link Service Class: connectionless and connection-oriented */
+
+#define LLCP_PARAM_VERSION          0x01U    /*!< VERSION parameter type                              */
+#define LLCP_PARAM_MIUX             0x02U    /*!< MIUX parameter type                                 */
+#define LLCP_PARAM_WKS              0x03U    /*!< WKS parameter type                                  */
+#define LLCP_PARAM_LTO              0x04U    /*!< LTO parameter type                                  */
+#define LLCP_PARAM_RW               0x05U    /*!< RW parameter type                                   */
+#define LLCP_PARAM_SN               0x06U    /*!< SN parameter type                                   */
+#define LLCP_PARAM_OPT              0x07U    /*!< OPT parameter type                                  */
+#define LLCP_PARAM_HDR_LEN          2U       /*!< Parameter type and length                           */
+
+#define LLCP_DM_REASON_DISC         0x00U    /*!< DM reason: disconnect acknowledged                  */
+#define LLCP_DM_REASON_NO_CONN      0x01U    /*!< DM reason: no active connection                     */
+#define LLCP_DM_REASON_NO_SERVICE   0x02U    /*!< DM reason: no service bound to the target SAP       */
+#define LLCP_DM_REASON_REJECTED     0x03U    /*!< DM reason: CONNECT rejected                         */
+
+/*
+ ******************************************************************************
+ * GLOBAL MACROS
+ ******************************************************************************
+ */
+
+#define llcpGetDsap( p )            ((uint8_t)((p)[0] >> 2U))                                                         /*!< DSAP of the given PDU  */
+#define llcpGetPType( p )           ((uint8_t)((uint8_t)(((p)[0] & 0x03U) << 2U) | (uint8_t)((p)[1] >> 6U)))           /*!< PTYPE of the given PDU */
+#define llcpGetSsap( p )            ((uint8_t)((p)[1] & LLCP_SAP_MASK))                                               /*!< SSAP of the given PDU  */
+#define llcpSeqInc( s )             ((uint8_t)(((s) + 1U) & LLCP_SEQ_MASK))                                           /*!< Next N(S) / N(R)       */
+#define llcpIsLinkValid( l )        (((l) < RFAL_LLCP_LINK_MAX) && (gLlcp.links[(l)].state != RFAL_LLCP_LINK_ST_FREE)) /*!< Link handle in use     */
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! LLCP states */
+typedef enum
+{
+    LLCP_ST_IDLE,                            /*!< LLC link not active                                 */
+    LLCP_ST_RX_FIRST,                        /*!< Target: first PDU to be processed                   */
+    LLCP_ST_TX,                              /*!< Next PDU to be sent                                 */
+    LLCP_ST_TXRX                             /*!< NFC-DEP transceive ongoing                          */
+} rfalLlcpState;
+
+
+/*! LLCP data link */
+typedef struct
+{
+    rfalLlcpLinkState  state;                /*!< Link state                                          */
+    uint8_t            lsap;                 /*!< Local SAP                                           */
+    uint8_t            rsap;                 /*!< Remote SAP                                          */
+    const char         *sn;                  /*!< Service name (CONNECT by name or listening name)    */
+    rfalLlcpRxCb       rxCb;                 /*!< Receive callback                                    */
+    void               *ctx;                 /*!< Receive callback context                            */
+    bool               isListener;           /*!< Link created by rfalLlcpListen()                    */
+    uint8_t            pendPType;            /*!< Control PDU to be sent (CONNECT/CC/DISC/DM), 0 if none */
+    uint8_t            dmReason;             /*!< Reason of the DM to be sent                         */
+    uint16_t           miu;                  /*!< Remote MIU on this link                             */
+    uint8_t            rw;                   /*!< Remote Receive Window                               */
+    bool               isRemBusy;            /*!< RNR received                                        */
+    uint8_t            vs;                   /*!< Send State Variable V(S)                            */
+    uint8_t            vsa;                  /*!< Send Acknowledgement State Variable V(SA)           */
+    uint8_t            vr;                   /*!< Receive State Variable V(R)                         */
+    uint8_t            vra;                  /*!< Receive Acknowledgement State Variable V(RA)        */
+    const uint8_t      *txHdr;               /*!< Data queued to be sent before txData                */
+    uint8_t            txHdrLen;             /*!< txHdr length                                        */
+    const uint8_t      *txData;              /*!< Data queued to be sent                              */
+    uint32_t           txLen;                /*!< txHdrLen + txData length                            */
+    uint32_t           txPos;                /*!< Bytes of txHdr|txData already placed in PDUs        */
+} rfalLlcpLink;
+
+
+/*! LLCP context */
+typedef struct
+{
+    rfalLlcpState      state;                /*!< Current state                                       */
+    rfalLlcpParam      param;                /*!< Start parameters                                    */
+    uint16_t           remMiu;               /*!< Remote link MIU                                     */
+    uint16_t           remLto;               /*!< Remote Link Timeout (ms)                            */
+    uint16_t           remWks;               /*!< Remote Well-Known Service List                      */
+    uint16_t           FSx;                  /*!< NFC-DEP remote Frame Size                           */
+    uint16_t           rxLen;                /*!< Received PDU length                                 */
+    uint8_t            nextSap;              /*!< Next local SAP to assign                            */
+    uint8_t            rrLink;               /*!< Link served first on the next PDU                   */
+    bool               isTxSymm;             /*!< Last PDU sent was a SYMM                            */
+    bool               isDeactReq;           /*!< LLC link deactivation requested                     */
+    bool               isDeactSent;          /*!< DISC to the LLC Link Management SAP sent            */
+    bool               isDmPending;          /*!< DM for a PDU not matching any link to be sent       */
+    uint8_t            dmDsap;               /*!< DSAP of the pending DM                              */
+    uint8_t            dmSsap;               /*!< SSAP of the pending DM                              */
+    uint8_t            dmReason;             /*!< Reason of the pending DM                            */
+    uint32_t           symmTimer;            /*!< Initiator: time until the next SYMM may be sent     */
+    rfalLlcpLink       links[RFAL_LLCP_LINK_MAX]; /*!< Data links                                     */
+} rfalLlcpCtx;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static const uint8_t gLlcpMagic[] = {0x46, 0x66, 0x6D};      /*!< LLCP magic number   LLCP 1.1 6.2.3.1 */
+
+static rfalLlcpCtx gLlcp;
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static uint8_t  rfalLlcpNewLink( rfalLlcpLinkState state, uint8_t lsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx );
+static void     rfalLlcpParseParams( const uint8_t *params, uint16_t len, uint16_t *miu, uint8_t *rw, const uint8_t **sn, uint8_t *snLen );
+static uint16_t rfalLlcpPutHeader( uint8_t *pdu, uint8_t dsap, rfalLlcpPType ptype, uint8_t ssap );
+static uint16_t rfalLlcpPutConnParams( uint8_t *pdu, const char *sn );
+static uint16_t rfalLlcpTxFill( rfalLlcpLink *l, uint8_t *dst, uint16_t maxLen );
+static uint16_t rfalLlcpComposeLink( rfalLlcpLink *l, uint8_t *pdu );
+static uint16_t rfalLlcpCompose( void );
+static bool     rfalLlcpIsTxPending( void );
+static void     rfalLlcpProcessConnect( const uint8_t *pdu, uint16_t len );
+static ReturnCode rfalLlcpProcessSingle( const uint8_t *pdu, uint16_t len );
+static ReturnCode rfalLlcpProcess( const uint8_t *pdu, uint16_t len );
+static ReturnCode rfalLlcpStartTxRx( void );
+static void     rfalLlcpCloseLink( rfalLlcpLink *l );
+static void     rfalLlcpCloseAll( void );
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static uint8_t rfalLlcpNewLink( rfalLlcpLinkState state, uint8_t lsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx )
+{
+    uint8_t i;
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        if( gLlcp.links[i].state == RFAL_LLCP_LINK_ST_FREE )
+        {
+            ST_MEMSET( &gLlcp.links[i], 0x00, sizeof(rfalLlcpLink) );
+            gLlcp.links[i].state = state;
+            gLlcp.links[i].lsap  = lsap;
+            gLlcp.links[i].rsap  = RFAL_LLCP_SAP_INVALID;
+            gLlcp.links[i].sn    = sn;
+            gLlcp.links[i].rxCb  = rxCb;
+            gLlcp.links[i].ctx   = ctx;
+            gLlcp.links[i].isListener = (state == RFAL_LLCP_LINK_ST_LISTEN);
+            gLlcp.links[i].miu   = gLlcp.remMiu;
+            gLlcp.links[i].rw    = LLCP_RW_DEFAULT;
+            return i;
+        }
+    }
+
+    return RFAL_LLCP_LINK_INVALID;
+}
+
+
+/*******************************************************************************/
+/* Retrieves the MIUX, RW and SN parameters of a CONNECT/CC   LLCP 1.1 4.5   */
+static void rfalLlcpParseParams( const uint8_t *params, uint16_t len, uint16_t *miu, uint8_t *rw, const uint8_t **sn, uint8_t *snLen )
+{
+    uint16_t it;
+    uint8_t  pLen;
+
+    it = 0;
+    while( (it + LLCP_PARAM_HDR_LEN) <= len )
+    {
+        pLen = params[it + 1U];
+        if( (it + LLCP_PARAM_HDR_LEN + pLen) > len )
+        {
+            break;
+        }
+
+        switch( params[it] )
+        {
+            case LLCP_PARAM_MIUX:
+                if( pLen == 2U )
+                {
+                    *miu = (uint16_t)(RFAL_LLCP_MIU_DEFAULT + (GETU16( &params[it + LLCP_PARAM_HDR_LEN] ) & LLCP_MIUX_MASK));
+                }
+                break;
+
+            case LLCP_PARAM_RW:
+                if( pLen == 1U )
+                {
+                    *rw = (params[it + LLCP_PARAM_HDR_LEN] & LLCP_RW_MASK);
+                }
+                break;
+
+            case LLCP_PARAM_SN:
+                if( sn != NULL )
+                {
+                    *sn    = &params[it + LLCP_PARAM_HDR_LEN];
+                    *snLen = pLen;
+                }
+                break;
+
+            default:
+                /* MISRA 16.4: no empty default statement (a comment being enough) */
+                break;
+        }
+
+        it += (LLCP_PARAM_HDR_LEN + (uint16_t)pLen);
+    }
+}
+
+
+/*******************************************************************************/
+static uint16_t rfalLlcpPutHeader( uint8_t *pdu, uint8_t dsap, rfalLlcpPType ptype, uint8_t ssap )
+{
+    pdu[0] = (uint8_t)((uint8_t)(dsap << 2U) | ((uint8_t)ptype >> 2U));
+    pdu[1] = (uint8_t)((uint8_t)((uint8_t)ptype << 6U) | (ssap & LLCP_SAP_MASK));
+
+    return RFAL_LLCP_HEADER_LEN;
+}
+
+
+/*******************************************************************************/
+/* MIUX and RW of a CONNECT/CC, followed by the SN of a CONNECT by name      */
+static uint16_t rfalLlcpPutConnParams( uint8_t *pdu, const char *sn )
+{
+    uint16_t it;
+    uint16_t miux;
+    size_t   snLen;
+
+    it   = 0;
+    miux = (uint16_t)(RFAL_LLCP_MIU - RFAL_LLCP_MIU_DEFAULT);
+
+    pdu[it++] = LLCP_PARAM_MIUX;
+    pdu[it++] = 2U;
+    pdu[it++] = (uint8_t)(miux >> 8U);
+    pdu[it++] = (uint8_t)(miux & 0xFFU);
+    pdu[it++] = LLCP_PARAM_RW;
+    pdu[it++] = 1U;
+    pdu[it++] = RFAL_LLCP_RW;
+
+    if( sn != NULL )
+    {
+        snLen     = strlen( sn );
+        pdu[it++] = LLCP_PARAM_SN;
+        pdu[it++] = (uint8_t)snLen;
+        ST_MEMCPY( &pdu[it], sn, snLen );
+        it       += (uint16_t)snLen;
+    }
+
+    return it;
+}
+
+
+/*******************************************************************************/
+/* Places the next part of the queued txHdr|txData into the PDU              */
+static uint16_t rfalLlcpTxFill( rfalLlcpLink *l, uint8_t *dst, uint16_t maxLen )
+{
+    uint32_t n;
+    uint16_t len;
+
+    len = 0;
+
+    if( l->txPos < l->txHdrLen )
+    {
+        n = MIN( (uint32_t)maxLen, (l->txHdrLen - l->txPos) );
+        ST_MEMCPY( dst, &l->txHdr[l->txPos], n );
+
+        len       = (uint16_t)n;
+        l->txPos += n;
+    }
+
+    if( (l->txPos >= l->txHdrLen) && (l->txPos < l->txLen) )
+    {
+        n = MIN( (uint32_t)(maxLen - len), (l->txLen - l->txPos) );
+        ST_MEMCPY( &dst[len], &l->txData[l->txPos - l->txHdrLen], n );
+
+        len      += (uint16_t)n;
+        l->txPos += n;
+    }
+
+    return len;
+}
+
+
+/*******************************************************************************/
+/* Composes the PDU the link has pending, returns 0 if nothing to be sent    */
+static uint16_t rfalLlcpComposeLink( rfalLlcpLink *l, uint8_t *pdu )
+{
+    uint16_t len;
+
+    switch( l->state )
+    {
+        /*******************************************************************************/
+        case RFAL_LLCP_LINK_ST_CONNLESS:
+
+            if( l->txPos < l->txLen )
+            {
+                len = rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_UI, l->lsap );
+                return (len + rfalLlcpTxFill( l, &pdu[len], l->miu ));
+            }
+            break;
+
+        /*******************************************************************************/
+        case RFAL_LLCP_LINK_ST_CONNECTING:
+        case RFAL_LLCP_LINK_ST_CONNECTED:
+        case RFAL_LLCP_LINK_ST_DISCONNECTING:
+        case RFAL_LLCP_LINK_ST_LISTEN:
+
+            if( l->pendPType == (uint8_t)RFAL_LLCP_PTYPE_CONNECT )
+            {
+                l->pendPType = 0;
+                len  = rfalLlcpPutHeader( pdu, ((l->sn != NULL) ? RFAL_LLCP_SAP_SDP : l->rsap), RFAL_LLCP_PTYPE_CONNECT, l->lsap );
+                return (len + rfalLlcpPutConnParams( &pdu[len], l->sn ));
+            }
+
+            if( l->pendPType == (uint8_t)RFAL_LLCP_PTYPE_CC )
+            {
+                l->pendPType = 0;
+                len  = rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_CC, l->lsap );
+                return (len + rfalLlcpPutConnParams( &pdu[len], NULL ));
+            }
+
+            if( l->pendPType == (uint8_t)RFAL_LLCP_PTYPE_DISC )
+            {
+                l->pendPType = 0;
+                return rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_DISC, l->lsap );
+            }
+
+            if( l->pendPType == (uint8_t)RFAL_LLCP_PTYPE_DM )
+            {
+                len          = rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_DM, l->lsap );
+                rfalLlcpCloseLink( l );
+                pdu[len++]   = l->dmReason;
+                return len;
+            }
+
+            if( l->state != RFAL_LLCP_LINK_ST_CONNECTED )
+            {
+                break;
+            }
+
+            /* I PDU while the remote Receive Window is open, acknowledging what was received */
+            if( (l->txPos < l->txLen) && (!l->isRemBusy) && ((uint8_t)((l->vs - l->vsa) & LLCP_SEQ_MASK) < l->rw) )
+            {
+                len        = rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_I, l->lsap );
+                pdu[len++] = (uint8_t)((uint8_t)(l->vs << 4U) | l->vr);
+                l->vs      = llcpSeqInc( l->vs );
+                l->vra     = l->vr;
+                return (len + rfalLlcpTxFill( l, &pdu[len], l->miu ));
+            }
+
+            /* Nothing to carry the acknowledgement */
+            if( l->vra != l->vr )
+            {
+                len        = rfalLlcpPutHeader( pdu, l->rsap, RFAL_LLCP_PTYPE_RR, l->lsap );
+                pdu[len++] = l->vr;
+                l->vra     = l->vr;
+                return len;
+            }
+            break;
+
+        /*******************************************************************************/
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************/
+/* Composes the next PDU to be sent into txBuf                               */
+static uint16_t rfalLlcpCompose( void )
+{
+    uint8_t  *pdu;
+    uint16_t len;
+    uint8_t  i;
+    uint8_t  idx;
+
+    pdu = gLlcp.param.txBuf->pdu;
+
+    gLlcp.isTxSymm = false;
+
+    if( gLlcp.isDeactReq )
+    {
+        gLlcp.isDeactSent = true;
+        return rfalLlcpPutHeader( pdu, RFAL_LLCP_SAP_LINK_MGMT, RFAL_LLCP_PTYPE_DISC, RFAL_LLCP_SAP_LINK_MGMT );
+    }
+
+    if( gLlcp.isDmPending )
+    {
+        gLlcp.isDmPending = false;
+        len               = rfalLlcpPutHeader( pdu, gLlcp.dmDsap, RFAL_LLCP_PTYPE_DM, gLlcp.dmSsap );
+        pdu[len++]        = gLlcp.dmReason;
+        return len;
+    }
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        idx = (uint8_t)((gLlcp.rrLink + i) % RFAL_LLCP_LINK_MAX);
+        len = rfalLlcpComposeLink( &gLlcp.links[idx], pdu );
+        if( len > 0U )
+        {
+            gLlcp.rrLink = (uint8_t)((idx + 1U) % RFAL_LLCP_LINK_MAX);
+            return len;
+        }
+    }
+
+    gLlcp.isTxSymm = true;
+    return rfalLlcpPutHeader( pdu, RFAL_LLCP_SAP_LINK_MGMT, RFAL_LLCP_PTYPE_SYMM, RFAL_LLCP_SAP_LINK_MGMT );
+}
+
+
+/*******************************************************************************/
+/* Checks whether anything other than a SYMM is to be sent                   */
+static bool rfalLlcpIsTxPending( void )
+{
+    const rfalLlcpLink *l;
+    uint8_t            i;
+
+    if( gLlcp.isDeactReq || gLlcp.isDmPending )
+    {
+        return true;
+    }
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        l = &gLlcp.links[i];
+
+        if( (l->pendPType != 0U) || (l->vra != l->vr) )
+        {
+            return true;
+        }
+
+        if( (l->txPos < l->txLen) && ( (l->state == RFAL_LLCP_LINK_ST_CONNLESS) ||
+           ((l->state == RFAL_LLCP_LINK_ST_CONNECTED) && (!l->isRemBusy) && ((uint8_t)((l->vs - l->vsa) & LLCP_SEQ_MASK) < l->rw)) ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*******************************************************************************/
+/* Accepts a CONNECT on a listening link or answers it with a DM             */
+static void rfalLlcpProcessConnect( const uint8_t *pdu, uint16_t len )
+{
+    rfalLlcpLink  *l;
+    const uint8_t *sn;
+    uint8_t       snLen;
+    uint16_t      miu;
+    uint8_t       rw;
+    uint8_t       dsap;
+    uint8_t       i;
+    uint8_t       reason;
+
+    dsap   = llcpGetDsap( pdu );
+    sn     = NULL;
+    snLen  = 0;
+    miu    = RFAL_LLCP_MIU_DEFAULT;
+    rw     = LLCP_RW_DEFAULT;
+    reason = LLCP_DM_REASON_NO_SERVICE;
+
+    rfalLlcpParseParams( &pdu[RFAL_LLCP_HEADER_LEN], (len - RFAL_LLCP_HEADER_LEN), &miu, &rw, &sn, &snLen );
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        l = &gLlcp.links[i];
+
+        /* Only server links accept a CONNECT, client links sharing the service name or SAP are not matched */
+        if( (!l->isListener) || (l->state == RFAL_LLCP_LINK_ST_FREE) )
+        {
+            continue;
+        }
+
+        /* CONNECT to the SAP itself or to the SDP with the service name */
+        if( ((dsap == RFAL_LLCP_SAP_SDP) && (l->sn != NULL) && (sn != NULL) && (strlen( l->sn ) == snLen) && (ST_BYTECMP( l->sn, sn, snLen ) == 0)) ||
+            ((dsap != RFAL_LLCP_SAP_SDP) && (l->lsap == dsap)) )
+        {
+            if( l->state != RFAL_LLCP_LINK_ST_LISTEN )
+            {
+                reason = LLCP_DM_REASON_REJECTED;
+                break;
+            }
+
+            l->vs        = 0;
+            l->vsa       = 0;
+            l->vr        = 0;
+            l->vra       = 0;
+            l->rsap      = llcpGetSsap( pdu );
+            l->miu       = MIN( miu, (uint16_t)RFAL_LLCP_MIU );
+            l->rw        = rw;
+            l->state     = RFAL_LLCP_LINK_ST_CONNECTED;
+            l->pendPType = (uint8_t)RFAL_LLCP_PTYPE_CC;
+            l->txLen     = 0;
+            l->txPos     = 0;
+
+            /* Notify the connection */
+            if( l->rxCb != NULL )
+            {
+                l->rxCb( l->ctx, i, NULL, 0 );
+            }
+            return;
+        }
+    }
+
+    gLlcp.isDmPending = true;
+    gLlcp.dmDsap      = llcpGetSsap( pdu );
+    gLlcp.dmSsap      = dsap;
+    gLlcp.dmReason    = reason;
+}
+
+
+/*******************************************************************************/
+/* Processes one PDU (not an AGF)                                            */
+static ReturnCode rfalLlcpProcessSingle( const uint8_t *pdu, uint16_t len )
+{
+    rfalLlcpLink *l;
+    uint8_t      dsap;
+    uint8_t      ssap;
+    uint8_t      ptype;
+    uint8_t      i;
+
+    if( len < RFAL_LLCP_HEADER_LEN )
+    {
+        return ERR_NONE;
+    }
+
+    dsap  = llcpGetDsap( pdu );
+    ssap  = llcpGetSsap( pdu );
+    ptype = llcpGetPType( pdu );
+
+    if( ptype == (uint8_t)RFAL_LLCP_PTYPE_SYMM )
+    {
+        return ERR_NONE;
+    }
+
+    if( ptype == (uint8_t)RFAL_LLCP_PTYPE_CONNECT )
+    {
+        rfalLlcpProcessConnect( pdu, len );
+        return ERR_NONE;
+    }
+
+    /* LLC link deactivation   LLCP 1.1 6.2.3.2 */
+    if( (ptype == (uint8_t)RFAL_LLCP_PTYPE_DISC) && (dsap == RFAL_LLCP_SAP_LINK_MGMT) && (ssap == RFAL_LLCP_SAP_LINK_MGMT) )
+    {
+        return ERR_RELEASE_REQ;
+    }
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        l = &gLlcp.links[i];
+
+        if( (l->state == RFAL_LLCP_LINK_ST_FREE) || (l->lsap != dsap) )
+        {
+            continue;
+        }
+
+        switch( ptype )
+        {
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_UI:
+                if( (l->state == RFAL_LLCP_LINK_ST_CONNLESS) && (l->rxCb != NULL) )
+                {
+                    l->rxCb( l->ctx, i, &pdu[RFAL_LLCP_HEADER_LEN], (len - RFAL_LLCP_HEADER_LEN) );
+                }
+                return ERR_NONE;
+
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_CC:
+                if( l->state == RFAL_LLCP_LINK_ST_CONNECTING )
+                {
+                    /* On a CONNECT by name the SSAP is the one of the service */
+                    l->rsap  = ssap;
+                    l->miu   = RFAL_LLCP_MIU_DEFAULT;
+                    rfalLlcpParseParams( &pdu[RFAL_LLCP_HEADER_LEN], (len - RFAL_LLCP_HEADER_LEN), &l->miu, &l->rw, NULL, NULL );
+                    l->miu   = MIN( l->miu, (uint16_t)RFAL_LLCP_MIU );
+                    l->state = RFAL_LLCP_LINK_ST_CONNECTED;
+                    return ERR_NONE;
+                }
+                break;
+
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_DM:
+                if( (l->state == RFAL_LLCP_LINK_ST_CONNECTING) || (l->state == RFAL_LLCP_LINK_ST_CONNECTED) || (l->state == RFAL_LLCP_LINK_ST_DISCONNECTING) )
+                {
+                    rfalLlcpCloseLink( l );
+                    return ERR_NONE;
+                }
+                break;
+
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_DISC:
+                if( (l->state == RFAL_LLCP_LINK_ST_CONNECTED) && (l->rsap == ssap) )
+                {
+                    l->pendPType = (uint8_t)RFAL_LLCP_PTYPE_DM;
+                    l->dmReason  = LLCP_DM_REASON_DISC;
+                    return ERR_NONE;
+                }
+                break;
+
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_I:
+                if( (l->state == RFAL_LLCP_LINK_ST_CONNECTED) && (l->rsap == ssap) && (len > RFAL_LLCP_HEADER_LEN) )
+                {
+                    /* Sequence error: the connection is no longer reliable */
+                    if( (pdu[RFAL_LLCP_HEADER_LEN] >> 4U) != l->vr )
+                    {
+                        l->pendPType = (uint8_t)RFAL_LLCP_PTYPE_DISC;
+                        l->state     = RFAL_LLCP_LINK_ST_DISCONNECTING;
+                        return ERR_NONE;
+                    }
+
+                    l->vr  = llcpSeqInc( l->vr );
+                    l->vsa = (pdu[RFAL_LLCP_HEADER_LEN] & LLCP_SEQ_MASK);
+
+                    if( l->rxCb != NULL )
+                    {
+                        l->rxCb( l->ctx, i, &pdu[RFAL_LLCP_HEADER_LEN + RFAL_LLCP_SEQ_LEN], (len - RFAL_LLCP_HEADER_LEN - RFAL_LLCP_SEQ_LEN) );
+                    }
+                    return ERR_NONE;
+                }
+                break;
+
+            /*******************************************************************************/
+            case RFAL_LLCP_PTYPE_RR:
+            case RFAL_LLCP_PTYPE_RNR:
+                if( (l->state == RFAL_LLCP_LINK_ST_CONNECTED) && (l->rsap == ssap) && (len > RFAL_LLCP_HEADER_LEN) )
+                {
+                    l->vsa       = (pdu[RFAL_LLCP_HEADER_LEN] & LLCP_SEQ_MASK);
+                    l->isRemBusy = (ptype == (uint8_t)RFAL_LLCP_PTYPE_RNR);
+                    return ERR_NONE;
+                }
+                break;
+
+            /*******************************************************************************/
+            default:
+                /* PAX, FRMR, SNL and reserved types are ignored */
+                return ERR_NONE;
+        }
+    }
+
+    /* Connection-oriented PDU to a SAP without connection */
+    if( (ptype == (uint8_t)RFAL_LLCP_PTYPE_I) || (ptype == (uint8_t)RFAL_LLCP_PTYPE_RR) || (ptype == (uint8_t)RFAL_LLCP_PTYPE_RNR) || (ptype == (uint8_t)RFAL_LLCP_PTYPE_DISC) )
+    {
+        gLlcp.isDmPending = true;
+        gLlcp.dmDsap      = ssap;
+        gLlcp.dmSsap      = dsap;
+        gLlcp.dmReason    = LLCP_DM_REASON_NO_CONN;
+    }
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+/* Processes the received PDU, unpacking an AGF                              */
+static ReturnCode rfalLlcpProcess( const uint8_t *pdu, uint16_t len )
+{
+    ReturnCode ret;
+    uint16_t   it;
+    uint16_t   pLen;
+
+    if( (len < RFAL_LLCP_HEADER_LEN) || (llcpGetPType( pdu ) != (uint8_t)RFAL_LLCP_PTYPE_AGF) )
+    {
+        return rfalLlcpProcessSingle( pdu, len );
+    }
+
+    it = RFAL_LLCP_HEADER_LEN;
+    while( (it + LLCP_AGF_LEN_LEN) <= len )
+    {
+        pLen = GETU16( &pdu[it] );
+        it  += LLCP_AGF_LEN_LEN;
+
+        if( (it + pLen) > len )
+        {
+            break;
+        }
+
+        EXIT_ON_ERR( ret, rfalLlcpProcessSingle( &pdu[it], pLen ) );
+        it += pLen;
+    }
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalLlcpStartTxRx( void )
+{
+    rfalNfcDepPduTxRxParam txRx;
+
+    txRx.txBuf    = gLlcp.param.txBuf;
+    txRx.txBufLen = rfalLlcpCompose();
+    txRx.rxBuf    = gLlcp.param.rxBuf;
+    txRx.rxLen    = &gLlcp.rxLen;
+    txRx.tmpBuf   = gLlcp.param.tmpBuf;
+    txRx.FWT      = gLlcp.param.nfcDepDev->info.FWT;
+    txRx.dFWT     = gLlcp.param.nfcDepDev->info.dFWT;
+    txRx.FSx      = gLlcp.FSx;
+    txRx.DID      = RFAL_NFCDEP_DID_KEEP;
+
+    return rfalNfcDepStartPduTransceive( txRx );
+}
+
+
+/*******************************************************************************/
+/* A listening link gets back to accept the next connection                  */
+static void rfalLlcpCloseLink( rfalLlcpLink *l )
+{
+    l->state     = (l->isListener ? RFAL_LLCP_LINK_ST_LISTEN : RFAL_LLCP_LINK_ST_CLOSED);
+    l->pendPType = 0;
+    l->txLen     = 0;
+    l->txPos     = 0;
+}
+
+
+/*******************************************************************************/
+static void rfalLlcpCloseAll( void )
+{
+    uint8_t i;
+
+    for( i = 0; i < RFAL_LLCP_LINK_MAX; i++ )
+    {
+        if( gLlcp.links[i].state != RFAL_LLCP_LINK_ST_FREE )
+        {
+            gLlcp.links[i].state = RFAL_LLCP_LINK_ST_CLOSED;
+        }
+    }
+
+    gLlcp.state = LLCP_ST_IDLE;
+}
+
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode rfalLlcpGetGeneralBytes( uint16_t wks, uint8_t *gb, uint8_t *gbLen )
+{
+    uint8_t  it;
+    uint16_t miux;
+
+    if( (gb == NULL) || (gbLen == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    it   = 0;
+    miux = (uint16_t)(RFAL_LLCP_MIU - RFAL_LLCP_MIU_DEFAULT);
+
+    ST_MEMCPY( gb, gLlcpMagic, sizeof(gLlcpMagic) );
+    it += (uint8_t)sizeof(gLlcpMagic);
+
+    gb[it++] = LLCP_PARAM_VERSION;
+    gb[it++] = 1U;
+    gb[it++] = LLCP_VERSION;
+    gb[it++] = LLCP_PARAM_MIUX;
+    gb[it++] = 2U;
+    gb[it++] = (uint8_t)(miux >> 8U);
+    gb[it++] = (uint8_t)(miux & 0xFFU);
+    gb[it++] = LLCP_PARAM_WKS;
+    gb[it++] = 2U;
+    gb[it++] = (uint8_t)((wks | RFAL_LLCP_WKS_LINK_MGMT) >> 8U);
+    gb[it++] = (uint8_t)((wks | RFAL_LLCP_WKS_LINK_MGMT) & 0xFFU);
+    gb[it++] = LLCP_PARAM_LTO;
+    gb[it++] = 1U;
+    gb[it++] = RFAL_LLCP_LTO;
+    gb[it++] = LLCP_PARAM_OPT;
+    gb[it++] = 1U;
+    gb[it++] = LLCP_OPT_LSC_BOTH;
+
+    *gbLen = it;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpStart( const rfalLlcpParam *param )
+{
+    const uint8_t *gb;
+    uint8_t       gbLen;
+    uint8_t       it;
+    uint8_t       pLen;
+
+    if( (param == NULL) || (param->nfcDepDev == NULL) || (param->txBuf == NULL) || (param->rxBuf == NULL) || (param->tmpBuf == NULL) ||
+        ((!param->isInitiator) && ((param->firstPdu == NULL) || (param->firstPduLen == 0U))) )
+    {
+        return ERR_PARAM;
+    }
+
+    ST_MEMSET( &gLlcp, 0x00, sizeof(rfalLlcpCtx) );
+    gLlcp.param   = *param;
+    gLlcp.remMiu  = RFAL_LLCP_MIU_DEFAULT;
+    gLlcp.remLto  = LLCP_LTO_DEFAULT;
+    gLlcp.nextSap = LLCP_SAP_FIRST_FREE;
+
+    /* Remote General Bytes, from the ATR_RES as Initiator and from the ATR_REQ as Target */
+    gb        = (param->isInitiator ? param->nfcDepDev->activation.Target.ATR_RES.GBt : param->nfcDepDev->activation.Initiator.ATR_REQ.GBi);
+    gLlcp.FSx = param->nfcDepDev->info.FS;   /* Frame Size as negotiated, PSL included */
+    gbLen = MIN( param->nfcDepDev->info.GBLen, (uint8_t)RFAL_NFCDEP_GB_MAX_LEN );
+
+    if( (gbLen < sizeof(gLlcpMagic)) || (ST_BYTECMP( gb, gLlcpMagic, sizeof(gLlcpMagic) ) != 0) )
+    {
+        return ERR_PROTO;
+    }
+
+    /* Parse the LLC parameters   LLCP 1.1 6.2.3.1 */
+    it = (uint8_t)sizeof(gLlcpMagic);
+    while( (it + LLCP_PARAM_HDR_LEN) <= gbLen )
+    {
+        pLen = gb[it + 1U];
+        if( (it + LLCP_PARAM_HDR_LEN + pLen) > gbLen )
+        {
+            break;
+        }
+
+        switch( gb[it] )
+        {
+            case LLCP_PARAM_VERSION:
+                if( (pLen == 1U) && ((gb[it + LLCP_PARAM_HDR_LEN] & LLCP_VERSION_MAJOR_MASK) != (LLCP_VERSION & LLCP_VERSION_MAJOR_MASK)) )
+                {
+                    return ERR_NOTSUPP;
+                }
+                break;
+
+            case LLCP_PARAM_MIUX:
+                if( pLen == 2U )
+                {
+                    gLlcp.remMiu = (uint16_t)(RFAL_LLCP_MIU_DEFAULT + (GETU16( &gb[it + LLCP_PARAM_HDR_LEN] ) & LLCP_MIUX_MASK));
+                }
+                break;
+
+            case LLCP_PARAM_WKS:
+                if( pLen == 2U )
+                {
+                    gLlcp.remWks = GETU16( &gb[it + LLCP_PARAM_HDR_LEN] );
+                }
+                break;
+
+            case LLCP_PARAM_LTO:
+                if( (pLen == 1U) && (gb[it + LLCP_PARAM_HDR_LEN] != 0U) )
+                {
+                    gLlcp.remLto = ((uint16_t)gb[it + LLCP_PARAM_HDR_LEN] * LLCP_LTO_UNIT);
+                }
+                break;
+
+            default:
+                /* MISRA 16.4: no empty default statement (a comment being enough) */
+                break;
+        }
+
+        it += (LLCP_PARAM_HDR_LEN + pLen);
+    }
+
+    /* The PDUs sent are bound by our own buffer as well */
+    gLlcp.remMiu = MIN( gLlcp.remMiu, (uint16_t)RFAL_LLCP_MIU );
+    gLlcp.state  = (param->isInitiator ? LLCP_ST_TX : LLCP_ST_RX_FIRST);
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpWorker( void )
+{
+    ReturnCode ret;
+
+    switch( gLlcp.state )
+    {
+        /*******************************************************************************/
+        case LLCP_ST_RX_FIRST:
+
+            ret = rfalLlcpProcess( gLlcp.param.firstPdu, gLlcp.param.firstPduLen );
+            if( ret != ERR_NONE )
+            {
+                rfalLlcpCloseAll();
+                return ((ret == ERR_RELEASE_REQ) ? ERR_NONE : ret);
+            }
+
+            gLlcp.state = LLCP_ST_TX;
+            /* fall through */
+
+        /*******************************************************************************/
+        case LLCP_ST_TX:  /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
+
+            /* An idle Initiator holds the SYMM, anything else is sent right away */
+            if( gLlcp.param.isInitiator && (gLlcp.symmTimer != 0U) && (!platformTimerIsExpired( gLlcp.symmTimer )) && (!rfalLlcpIsTxPending()) )
+            {
+                return ERR_BUSY;
+            }
+            platformTimerDestroy( gLlcp.symmTimer );
+            gLlcp.symmTimer = 0;
+
+            ret = rfalLlcpStartTxRx();
+            if( ret != ERR_NONE )
+            {
+                rfalLlcpCloseAll();
+                return ret;
+            }
+
+            gLlcp.state = LLCP_ST_TXRX;
+            return ERR_BUSY;
+
+        /*******************************************************************************/
+        case LLCP_ST_TXRX:
+
+            ret = rfalNfcDepGetPduTransceiveStatus();
+            if( ret == ERR_BUSY )
+            {
+                return ERR_BUSY;
+            }
+
+            /* After the LLC link deactivation no answer is expected */
+            if( gLlcp.isDeactSent )
+            {
+                rfalLlcpCloseAll();
+                return ERR_NONE;
+            }
+
+            if( ret != ERR_NONE )
+            {
+                rfalLlcpCloseAll();
+                return ret;
+            }
+
+            ret = rfalLlcpProcess( gLlcp.param.rxBuf->pdu, gLlcp.rxLen );
+            if( ret != ERR_NONE )
+            {
+                rfalLlcpCloseAll();
+                return ((ret == ERR_RELEASE_REQ) ? ERR_NONE : ret);
+            }
+
+            /* Both sides idle: hold the next SYMM within the remote Link Timeout */
+            if( gLlcp.isTxSymm && (gLlcp.rxLen >= RFAL_LLCP_HEADER_LEN) && (llcpGetPType( gLlcp.param.rxBuf->pdu ) == (uint8_t)RFAL_LLCP_PTYPE_SYMM) )
+            {
+                gLlcp.symmTimer = platformTimerCreate( (uint16_t)(gLlcp.remLto / 2U) );
+            }
+
+            gLlcp.state = LLCP_ST_TX;
+            return ERR_BUSY;
+
+        /*******************************************************************************/
+        default:
+            return ERR_WRONG_STATE;
+    }
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpDeactivate( void )
+{
+    if( gLlcp.state == LLCP_ST_IDLE )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    gLlcp.isDeactReq = true;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpConnect( uint8_t dsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link )
+{
+    uint8_t idx;
+
+    if( (link == NULL) || ((sn == NULL) && ((dsap > LLCP_SAP_MASK) || (dsap == RFAL_LLCP_SAP_LINK_MGMT))) || ((sn != NULL) && (strlen( sn ) > (size_t)UINT8_MAX)) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( gLlcp.nextSap > LLCP_SAP_MASK )
+    {
+        return ERR_NOMEM;
+    }
+
+    idx = rfalLlcpNewLink( RFAL_LLCP_LINK_ST_CONNECTING, gLlcp.nextSap, sn, rxCb, ctx );
+    if( idx == RFAL_LLCP_LINK_INVALID )
+    {
+        return ERR_NOMEM;
+    }
+
+    gLlcp.nextSap++;
+    gLlcp.links[idx].rsap      = dsap;
+    gLlcp.links[idx].pendPType = (uint8_t)RFAL_LLCP_PTYPE_CONNECT;
+
+    *link = idx;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpListen( uint8_t lsap, const char *sn, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link )
+{
+    uint8_t idx;
+
+    if( (link == NULL) || (lsap > LLCP_SAP_MASK) || (lsap <= RFAL_LLCP_SAP_SDP) )
+    {
+        return ERR_PARAM;
+    }
+
+    idx = rfalLlcpNewLink( RFAL_LLCP_LINK_ST_LISTEN, lsap, sn, rxCb, ctx );
+    if( idx == RFAL_LLCP_LINK_INVALID )
+    {
+        return ERR_NOMEM;
+    }
+
+    *link = idx;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpBind( uint8_t lsap, uint8_t dsap, rfalLlcpRxCb rxCb, void *ctx, uint8_t *link )
+{
+    uint8_t idx;
+
+    if( (link == NULL) || (lsap > LLCP_SAP_MASK) || (lsap <= RFAL_LLCP_SAP_SDP) || (dsap > LLCP_SAP_MASK) )
+    {
+        return ERR_PARAM;
+    }
+
+    idx = rfalLlcpNewLink( RFAL_LLCP_LINK_ST_CONNLESS, lsap, NULL, rxCb, ctx );
+    if( idx == RFAL_LLCP_LINK_INVALID )
+    {
+        return ERR_NOMEM;
+    }
+
+    gLlcp.links[idx].rsap = dsap;
+
+    *link = idx;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpSend( uint8_t link, const uint8_t *hdr, uint8_t hdrLen, const uint8_t *data, uint32_t dataLen )
+{
+    rfalLlcpLink *l;
+
+    if( (!llcpIsLinkValid( link )) || ((hdr == NULL) && (hdrLen > 0U)) || ((data == NULL) && (dataLen > 0U)) )
+    {
+        return ERR_PARAM;
+    }
+
+    l = &gLlcp.links[link];
+
+    if( (l->state != RFAL_LLCP_LINK_ST_CONNECTED) && (l->state != RFAL_LLCP_LINK_ST_CONNLESS) )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    if( l->txPos < l->txLen )
+    {
+        return ERR_BUSY;
+    }
+
+    l->txHdr    = hdr;
+    l->txHdrLen = hdrLen;
+    l->txData   = data;
+    l->txLen    = ((uint32_t)hdrLen + dataLen);
+    l->txPos    = 0;
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpGetSendStatus( uint8_t link )
+{
+    const rfalLlcpLink *l;
+
+    if( !llcpIsLinkValid( link ) )
+    {
+        return ERR_PARAM;
+    }
+
+    l = &gLlcp.links[link];
+
+    if( (l->state == RFAL_LLCP_LINK_ST_CONNLESS) && (l->txPos >= l->txLen) )
+    {
+        return ERR_NONE;
+    }
+
+    if( (l->state == RFAL_LLCP_LINK_ST_CONNECTED) && (l->txPos >= l->txLen) && (l->vsa == l->vs) )
+    {
+        return ERR_NONE;
+    }
+
+    return (((l->state == RFAL_LLCP_LINK_ST_CONNECTED) || (l->state == RFAL_LLCP_LINK_ST_CONNLESS)) ? ERR_BUSY : ERR_LINK_LOSS);
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalLlcpDisconnect( uint8_t link )
+{
+    if( !llcpIsLinkValid( link ) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( gLlcp.links[link].state != RFAL_LLCP_LINK_ST_CONNECTED )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    gLlcp.links[link].state     = RFAL_LLCP_LINK_ST_DISCONNECTING;
+    gLlcp.links[link].pendPType = (uint8_t)RFAL_LLCP_PTYPE_DISC;
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void rfalLlcpRelease( uint8_t link )
+{
+    if( link < RFAL_LLCP_LINK_MAX )
+    {
+        gLlcp.links[link].state = RFAL_LLCP_LINK_ST_FREE;
+    }
+}
+
+
+/*******************************************************************************/
+rfalLlcpLinkState rfalLlcpGetLinkState( uint8_t link )
+{
+    return ((link < RFAL_LLCP_LINK_MAX) ? gLlcp.links[link].state : RFAL_LLCP_LINK_ST_FREE);
+}
+
+
+/*******************************************************************************/
+uint16_t rfalLlcpGetLinkMiu( uint8_t link )
+{
+    return (llcpIsLinkValid( link ) ? gLlcp.links[link].miu : 0U);
+}
+
+#endif /* RFAL_FEATURE_LLCP */
@@ -38,6 +38,16 @@
 #include "rfal_nfc.h"
 #include "utils.h"
 #include "rfal_analogConfig.h"
+#include "rfal_t2t.h"
+
+/*
+ ******************************************************************************
+ * ENABLE SWITCH
+ ******************************************************************************
+ */
+#ifndef RFAL_FEATURE_NFC_STATS
+    #define RFAL_FEATURE_NFC_STATS   false    /* NFC statistics configuration missing. Disabled by default */
+#endif
 
 
 /*
@@ -47,6 +57,38 @@
 */
 #define RFAL_NFC_MAX_DEVICES          5U    /* Max number of devices supported */
 
+#define RFAL_NFC_CD_TECHS             (RFAL_NFC_POLL_TECH_A | RFAL_NFC_POLL_TECH_B | RFAL_NFC_POLL_TECH_F | RFAL_NFC_POLL_TECH_V)  /* Poll technologies probed by Card Detection, same bits as rfalCdTech */
+#define RFAL_NFC_NON_CD_TECHS         (RFAL_NFC_POLL_TECH_AP2P | RFAL_NFC_POLL_TECH_ST25TB | RFAL_NFC_POLL_TECH_PROP)             /* Poll technologies not covered by Card Detection                    */
+
+#define RFAL_NFC_POLL_TECHS           (RFAL_NFC_CD_TECHS | RFAL_NFC_NON_CD_TECHS)  /* All Poll technologies                                           */
+#define RFAL_NFC_TECH_SCORE_MAX       0xFFFFU                                       /* Technology score of a 100% hit rate                             */
+#define RFAL_NFC_TECH_SCORE_DECAY     2U                                            /* Each probe weights 1/2^n on the technology score                */
+#ifndef RFAL_NFC_TECH_MAX_AGE
+    #define RFAL_NFC_TECH_MAX_AGE     8U                                            /* Max poll cycles a technology may be left unprobed (adaptive)    */
+#endif /* RFAL_NFC_TECH_MAX_AGE */
+
+#ifndef RFAL_NFC_PRESENCE_CHECK_RETRIES
+    #define RFAL_NFC_PRESENCE_CHECK_RETRIES  1U                                     /* Failed presence checks retried before the device is lost        */
+#endif /* RFAL_NFC_PRESENCE_CHECK_RETRIES */
+
+#ifndef RFAL_NFC_SUPPRESS_CACHE_LEN
+    #define RFAL_NFC_SUPPRESS_CACHE_LEN      8U                                     /* Recently activated devices remembered for suppression           */
+#endif /* RFAL_NFC_SUPPRESS_CACHE_LEN */
+#define RFAL_NFC_SUPPRESS_ID_MAX_LEN         RFAL_NFCA_CASCADE_3_UID_LEN            /* Longest NFCID/UID kept on the suppression cache                 */
+
+#ifndef RFAL_NFC_BR_CACHE_LEN
+    #define RFAL_NFC_BR_CACHE_LEN            4U                                     /* Devices remembered with a lowered ISO-DEP bit rate              */
+#endif /* RFAL_NFC_BR_CACHE_LEN */
+#ifndef RFAL_NFC_BR_ERR_MIN
+    #define RFAL_NFC_BR_ERR_MIN              2U                                     /* Link errors on a device before the bit rate is lowered          */
+#endif /* RFAL_NFC_BR_ERR_MIN */
+#ifndef RFAL_NFC_BR_ERR_RATIO
+    #define RFAL_NFC_BR_ERR_RATIO            8U                                     /* Bit rate lowered above 1 link error every n blocks              */
+#endif /* RFAL_NFC_BR_ERR_RATIO */
+#ifndef RFAL_NFC_BR_RECOVER_CNT
+    #define RFAL_NFC_BR_RECOVER_CNT          64U                                    /* Error free blocks before the bit rate is raised again           */
+#endif /* RFAL_NFC_BR_RECOVER_CNT */
+
 
 /*
 ******************************************************************************
@@ -55,6 +97,16 @@
 */
 
 #define rfalNfcNfcNotify( st )                         if( gNfcDev.disc.notifyCb != NULL )  gNfcDev.disc.notifyCb( (st) )
+
+#if RFAL_FEATURE_NFC_STATS
+    #define rfalNfcStatsStart( t )                     ((t) = platformGetCycles())
+    #define rfalNfcStatsStop( ph, t, fail )            rfalNfcStatsRecord( &(ph), platformCyclesToUs( platformGetCycles() - (t) ), (fail) )
+    #define rfalNfcStatsStopMs( ph, t, fail )          rfalNfcStatsRecord( &(ph), (MIN( (platformGetSysTick() - (t)), (UINT32_MAX / 1000U) ) * 1000U), (fail) )
+#else
+    #define rfalNfcStatsStart( t )
+    #define rfalNfcStatsStop( ph, t, fail )
+    #define rfalNfcStatsStopMs( ph, t, fail )
+#endif /* RFAL_FEATURE_NFC_STATS */
     
 #define rfalNfcpCbPollerInitialize()                   ((gNfcDev.disc.propNfc.rfalNfcpPollerInitialize != NULL) ? gNfcDev.disc.propNfc.rfalNfcpPollerInitialize() : ERR_NOTSUPP )
 #define rfalNfcpCbPollerTechnologyDetection()          ((gNfcDev.disc.propNfc.rfalNfcpPollerTechnologyDetection != NULL) ? gNfcDev.disc.propNfc.rfalNfcpPollerTechnologyDetection() : ERR_TIMEOUT )
@@ -69,6 +121,26 @@
 ******************************************************************************
 */
 
+/*! Suppression cache entry, free when idLen is 0 or expired                                                       */
+typedef struct{
+    uint32_t                expiry;                          /* Suppression expiry timer                        */
+    rfalNfcDevType          type;                            /* Device type                                     */
+    uint8_t                 idLen;                           /* NFCID/UID length                                */
+    uint8_t                 id[RFAL_NFC_SUPPRESS_ID_MAX_LEN];/* NFCID/UID                                       */
+}rfalNfcSuppressEntry;
+
+
+/*! Bit rate cache entry, free when idLen is 0                                                                     */
+typedef struct{
+    rfalNfcDevType          type;                            /* Device type                                     */
+    rfalBitRate             maxBR;                           /* Bit rate ceiling for the next activations       */
+    uint16_t                blkCnt;                          /* Blocks exchanged, accumulated across sessions   */
+    uint16_t                errCnt;                          /* Link errors, accumulated across sessions        */
+    uint8_t                 idLen;                           /* NFCID/UID length                                */
+    uint8_t                 id[RFAL_NFC_SUPPRESS_ID_MAX_LEN];/* NFCID/UID                                       */
+}rfalNfcBrEntry;
+
+
 /*! Buffer union, only one interface is used at a time                                                             */
 typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Members of the union will not be used concurrently, only one interface at a time */
     rfalIsoDepBufFormat   isoDepBuf;                  /*!< ISO-DEP buffer format (with header/prologue)       */
@@ -88,13 +160,48 @@ typedef struct{
     rfalNfcDevice           devList[RFAL_NFC_MAX_DEVICES];   /*!< Location of device list          */
     uint8_t                 devCnt;             /* Decices found counter                           */
     uint32_t                discTmr;            /* Discovery Total duration timer                  */
+    uint32_t                pollTmr;            /* Poll window timer (slot scheduling)             */
+    uint16_t                techsSkipped;       /* Technologies preempted on the last Poll window  */
     ReturnCode              dataExErr;          /* Last Data Exchange error                        */
+    rfalNfcDataExchangeCb   dataExCb;           /* Data Exchange completion callback               */
     bool                    discRestart;        /* Restart discover after deactivation flag        */
     bool                    isRxChaining;       /* Flag indicating Other device is chaining        */
     uint32_t                lmMask;             /* Listen Mode mask                                */
     bool                    isTechInit;         /* Flag indicating technology has been set         */
     bool                    isOperOngoing;      /* Flag indicating opration is ongoing             */
     
+    uint16_t                pollTech;           /* Technology currently being detected             */
+    bool                    isPollCycle;        /* Flag indicating Tech Detection cycle ongoing    */
+    uint32_t                techDctStart;       /* Tech Detection cycle start time                 */
+    uint32_t                timeToDetect;       /* Time to first technology found (last found)     */
+    bool                    isDetected;         /* Flag indicating timeToDetect is valid           */
+    uint16_t                techScore[RFAL_NFC_POLL_TECH_CNT];  /* Decayed hit rate per technology */
+    uint8_t                 techAge[RFAL_NFC_POLL_TECH_CNT];    /* Cycles since technology probed  */
+    
+    uint16_t                presPeriod;         /* Presence check period                           */
+    uint32_t                presTmr;            /* Presence check period timer                     */
+    uint8_t                 presRetries;        /* Consecutive failed presence checks              */
+    bool                    isPresOngoing;      /* Flag indicating a non-blocking check is ongoing */
+    
+    rfalNfcSuppressEntry    suppress[RFAL_NFC_SUPPRESS_CACHE_LEN];  /* Recently activated devices (hash set) */
+    
+    rfalNfcBrEntry          brCache[RFAL_NFC_BR_CACHE_LEN];  /* Devices with link errors or a lowered ISO-DEP bit rate */
+    uint8_t                 brNext;             /* Bit rate cache entry replaced next              */
+    rfalIsoDepLinkStats     linkSeen;           /* ISO-DEP link counters already accounted         */
+    
+#if RFAL_FEATURE_NFC_STATS
+    rfalNfcStats            stats;              /* Discovery phase latency statistics              */
+    uint32_t                discStart;          /* Discovery cycle start (cycles)                  */
+    uint32_t                techStart;          /* Current technology detection start (cycles)     */
+    uint32_t                phaseStart;         /* Current phase start (cycles)                    */
+    uint32_t                wuStart;            /* Wake-Up mode start (ms)                         */
+    bool                    isWoke;             /* Flag indicating cycle triggered by a wake-up    */
+#endif /* RFAL_FEATURE_NFC_STATS */
+    
+#if RFAL_FEATURE_CD
+    rfalCdRes               cdRes;              /* Card Detection result                           */
+#endif /* RFAL_FEATURE_CD */
+    
     rfalNfcBuffer           txBuf;              /* Tx buffer for Data Exchange                     */
     rfalNfcBuffer           rxBuf;              /* Rx buffer for Data Exchange                     */
     uint16_t                rxLen;              /* Length of received data on Data Exchange        */
@@ -123,9 +230,31 @@ typedef struct{
 ******************************************************************************
 */
 static ReturnCode rfalNfcPollTechDetetection( void );
+static uint16_t rfalNfcPollNextTech( void );
+static void rfalNfcPollTechConclude( void );
+static uint8_t rfalNfcTechIdx( uint16_t tech );
 static ReturnCode rfalNfcPollCollResolution( void );
 static ReturnCode rfalNfcPollActivation( uint8_t devIt );
 static ReturnCode rfalNfcDeactivation( void );
+static bool rfalNfcPresenceCheckIsSupported( const rfalNfcDevice *dev );
+static ReturnCode rfalNfcPresenceCheck( void );
+static uint8_t rfalNfcDevIdGet( const rfalNfcDevice *dev, const uint8_t **id );
+static bool rfalNfcSuppressCheck( const rfalNfcDevice *dev, bool insert );
+static void rfalNfcSuppressFilter( void );
+static rfalNfcBrEntry* rfalNfcBrLookup( const rfalNfcDevice *dev, bool insert );
+static rfalBitRate rfalNfcBrMax( const rfalNfcDevice *dev );
+#if RFAL_FEATURE_ISO_DEP
+static void rfalNfcBrLinkUpdate( void );
+#endif /* RFAL_FEATURE_ISO_DEP */
+static void rfalNfcPollSleep( rfalNfcDevice *dev );
+static void rfalNfcBatchAdvance( void );
+static void rfalNfcDataExchangeComplete( ReturnCode err );
+static void rfalNfcSchedCycleStart( void );
+
+#if RFAL_FEATURE_NFC_STATS
+static uint8_t rfalNfcDevTechIdx( rfalNfcDevType type );
+static void rfalNfcStatsRecord( rfalNfcPhaseStats *ph, uint32_t dur, bool fail );
+#endif /* RFAL_FEATURE_NFC_STATS */
 
 #if RFAL_FEATURE_NFC_DEP
 static ReturnCode rfalNfcNfcDepActivate( rfalNfcDevice *device, rfalNfcDepCommMode commMode, const uint8_t *atrReq, uint16_t atrReqLen );
@@ -143,6 +272,17 @@ ReturnCode rfalNfcInitialize( void )
     
     gNfcDev.state = RFAL_NFC_STATE_NOTINIT;
     
+    /* Clear the technology detection history */
+    gNfcDev.isDetected = false;
+    ST_MEMSET( gNfcDev.techScore, 0x00, sizeof(gNfcDev.techScore) );
+    ST_MEMSET( gNfcDev.techAge, 0x00, sizeof(gNfcDev.techAge) );
+    
+    gNfcDev.dataExCb = NULL;
+    
+    rfalNfcSuppressCacheClear();
+    rfalNfcBitRateCacheClear();
+    rfalNfcResetStats();
+    
     rfalAnalogConfigInitialize();              /* Initialize RFAL's Analog Configs */
     EXIT_ON_ERR( err, rfalInitialize() );      /* Initialize RFAL */
     
@@ -163,7 +303,8 @@ ReturnCode rfalNfcDiscover( const rfalNfcDiscoverParam *disParams )
     if( (disParams == NULL) || (disParams->devLimit > RFAL_NFC_MAX_DEVICES) || (disParams->devLimit == 0U)                                                 || 
         ( (disParams->maxBR > RFAL_BR_1695) && (disParams->maxBR != RFAL_BR_KEEP) )                                                                        ||
         ( ((disParams->techs2Find & RFAL_NFC_POLL_TECH_F) != 0U)     && (disParams->nfcfBR != RFAL_BR_212) && (disParams->nfcfBR != RFAL_BR_424) )         ||
-        ( (((disParams->techs2Find & RFAL_NFC_POLL_TECH_AP2P) != 0U) && (disParams->ap2pBR > RFAL_BR_424)) || (disParams->GBLen > RFAL_NFCDEP_GB_MAX_LEN) )  )
+        ( (((disParams->techs2Find & RFAL_NFC_POLL_TECH_AP2P) != 0U) && (disParams->ap2pBR > RFAL_BR_424)) || (disParams->GBLen > RFAL_NFCDEP_GB_MAX_LEN) )  ||
+        ( (disParams->pollWindow != 0U) && (disParams->listenWindow >= disParams->totalDuration) )                                                         )
     {
         return ERR_PARAM;
     }
@@ -189,6 +330,7 @@ ReturnCode rfalNfcDiscover( const rfalNfcDiscoverParam *disParams )
     gNfcDev.devCnt          = 0;
     gNfcDev.discRestart     = true;
     gNfcDev.isTechInit      = false;
+    gNfcDev.techsSkipped    = RFAL_NFC_TECH_NONE;
     gNfcDev.disc            = *disParams;
     
     
@@ -215,6 +357,8 @@ ReturnCode rfalNfcDiscover( const rfalNfcDiscoverParam *disParams )
 /*******************************************************************************/
 ReturnCode rfalNfcDeactivate( bool discovery )
 {
+    ReturnCode err;
+    
     /* Check for valid state */
     if( gNfcDev.state <= RFAL_NFC_STATE_IDLE )
     {
@@ -231,13 +375,65 @@ ReturnCode rfalNfcDeactivate( bool discovery )
     else
     {
         /* Otherwise deactivate immediately and go to IDLE */
-        rfalNfcDeactivation();
+        rfalNfcStatsStart( gNfcDev.phaseStart );
+        err = rfalNfcDeactivation();
+        rfalNfcStatsStop( gNfcDev.stats.deactivation, gNfcDev.phaseStart, (err != ERR_NONE) );
+        NO_WARNING(err);
+        
         gNfcDev.state = RFAL_NFC_STATE_IDLE;
     }
     
     return ERR_NONE;
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcPresenceCheckStart( uint16_t period )
+{
+    /* Check for valid state */
+    if( ((gNfcDev.state != RFAL_NFC_STATE_ACTIVATED) && (gNfcDev.state != RFAL_NFC_STATE_DATAEXCHANGE_DONE)) || (gNfcDev.activeDev == NULL) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    if( period == 0U )
+    {
+        return ERR_PARAM;
+    }
+    
+    if( !rfalNfcPresenceCheckIsSupported( gNfcDev.activeDev ) )
+    {
+        return ERR_NOTSUPP;
+    }
+    
+    gNfcDev.presPeriod    = period;
+    gNfcDev.presRetries   = 0;
+    gNfcDev.isPresOngoing = false;
+    
+    platformTimerDestroy( gNfcDev.presTmr );
+    gNfcDev.presTmr = platformTimerCreate( gNfcDev.presPeriod );
+    
+    gNfcDev.state = RFAL_NFC_STATE_PRESENCE_CHECK;
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcPresenceCheckStop( void )
+{
+    if( gNfcDev.state != RFAL_NFC_STATE_PRESENCE_CHECK )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    if( gNfcDev.isPresOngoing )
+    {
+        return ERR_BUSY;
+    }
+    
+    platformTimerDestroy( gNfcDev.presTmr );
+    gNfcDev.state = RFAL_NFC_STATE_ACTIVATED;
+    return ERR_NONE;
+}
+
 /*******************************************************************************/
 ReturnCode rfalNfcSelect( uint8_t devIdx )
 {
@@ -249,6 +445,22 @@ ReturnCode rfalNfcSelect( uint8_t devIdx )
     
     gNfcDev.selDevIdx = devIdx;
     gNfcDev.state     = RFAL_NFC_STATE_POLL_ACTIVATION;
+    rfalNfcStatsStart( gNfcDev.phaseStart );
+    
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+ReturnCode rfalNfcBatchNext( void )
+{
+    /* Check for valid state */
+    if( (!gNfcDev.disc.batchMode) || (gNfcDev.activeDev == NULL) || 
+        ((gNfcDev.state != RFAL_NFC_STATE_ACTIVATED) && (gNfcDev.state != RFAL_NFC_STATE_DATAEXCHANGE_DONE)) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    rfalNfcBatchAdvance();
     
     return ERR_NONE;
 }
@@ -280,6 +492,66 @@ ReturnCode rfalNfcGetDevicesFound( rfalNfcDevice **devList, uint8_t *devCnt )
     return ERR_NONE;
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcGetTimeToDetect( uint32_t *time )
+{
+    if( time == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    if( !gNfcDev.isDetected )
+    {
+        return ERR_REQUEST;
+    }
+    
+    *time = gNfcDev.timeToDetect;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void rfalNfcSuppressCacheClear( void )
+{
+    ST_MEMSET( gNfcDev.suppress, 0x00, sizeof(gNfcDev.suppress) );
+}
+
+
+/*******************************************************************************/
+void rfalNfcBitRateCacheClear( void )
+{
+    ST_MEMSET( gNfcDev.brCache, 0x00, sizeof(gNfcDev.brCache) );
+    gNfcDev.brNext = 0;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcGetStats( rfalNfcStats *stats )
+{
+#if RFAL_FEATURE_NFC_STATS
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    ST_MEMCPY( stats, &gNfcDev.stats, sizeof(rfalNfcStats) );
+    return ERR_NONE;
+#else
+    NO_WARNING(stats);
+    return ERR_DISABLED;
+#endif /* RFAL_FEATURE_NFC_STATS */
+}
+
+
+/*******************************************************************************/
+void rfalNfcResetStats( void )
+{
+#if RFAL_FEATURE_NFC_STATS
+    ST_MEMSET( &gNfcDev.stats, 0x00, sizeof(gNfcDev.stats) );
+#endif /* RFAL_FEATURE_NFC_STATS */
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalNfcGetActiveDevice( rfalNfcDevice **dev )
 {
@@ -328,7 +600,16 @@ void rfalNfcWorker( void )
             gNfcDev.selDevIdx   = 0;
             gNfcDev.techsFound  = RFAL_NFC_TECH_NONE;
             gNfcDev.techs2do    = gNfcDev.disc.techs2Find;
+            gNfcDev.pollTech    = RFAL_NFC_TECH_NONE;
+            gNfcDev.isPollCycle = false;
             gNfcDev.state       = RFAL_NFC_STATE_POLL_TECHDETECT;
+            rfalNfcSchedCycleStart();
+            
+        #if RFAL_FEATURE_NFC_STATS
+            gNfcDev.stats.cycleCnt++;
+            gNfcDev.isWoke = false;
+            rfalNfcStatsStart( gNfcDev.discStart );
+        #endif /* RFAL_FEATURE_NFC_STATS */
         
         #if RFAL_FEATURE_WAKEUP_MODE    
             /* Check if Low power Wake-Up is to be performed */
@@ -338,6 +619,10 @@ void rfalNfcWorker( void )
                 err = rfalWakeUpModeStart( (gNfcDev.disc.wakeupConfigDefault ? NULL : &gNfcDev.disc.wakeupConfig) );
                 if( err == ERR_NONE )
                 {
+                #if RFAL_FEATURE_NFC_STATS
+                    gNfcDev.wuStart = platformGetSysTick();
+                #endif /* RFAL_FEATURE_NFC_STATS */
+                    
                     gNfcDev.state = RFAL_NFC_STATE_WAKEUP_MODE;
                     rfalNfcNfcNotify( gNfcDev.state );                                /* Notify caller that WU was started */
                 }
@@ -345,6 +630,15 @@ void rfalNfcWorker( void )
             gNfcDev.techDctCnt++;
             
         #endif /* RFAL_FEATURE_WAKEUP_MODE */
+        
+        #if RFAL_FEATURE_CD
+            /* Check if the Card Detection pre-filter is to be performed before polling */
+            if( gNfcDev.disc.cdEnabled && (gNfcDev.state == RFAL_NFC_STATE_POLL_TECHDETECT) )
+            {
+                gNfcDev.state         = RFAL_NFC_STATE_CARD_DETECT;
+                gNfcDev.isOperOngoing = false;
+            }
+        #endif /* RFAL_FEATURE_CD */
             break;
         
         /*******************************************************************************/
@@ -355,8 +649,24 @@ void rfalNfcWorker( void )
             if( rfalWakeUpModeHasWoke() )
             {
                 rfalWakeUpModeStop();                                                 /* Disable Wake-up mode           */
+                
+            #if RFAL_FEATURE_NFC_STATS
+                rfalNfcStatsStopMs( gNfcDev.stats.wakeUp, gNfcDev.wuStart, false );
+                gNfcDev.isWoke = true;
+                rfalNfcStatsStart( gNfcDev.discStart );                               /* Discovery latency counted from wake-up */
+            #endif /* RFAL_FEATURE_NFC_STATS */
+                
                 gNfcDev.state      = RFAL_NFC_STATE_POLL_TECHDETECT;                  /* Go to Technology detection     */
                 gNfcDev.techDctCnt = 1;                                               /* Tech Detect counter (1 woke)   */
+                rfalNfcSchedCycleStart();                                             /* Cycle starts once woke         */
+                
+            #if RFAL_FEATURE_CD
+                if( gNfcDev.disc.cdEnabled )
+                {
+                    gNfcDev.state         = RFAL_NFC_STATE_CARD_DETECT;               /* Confirm the wake-up cheaply first */
+                    gNfcDev.isOperOngoing = false;
+                }
+            #endif /* RFAL_FEATURE_CD */
                 
                 rfalNfcNfcNotify( gNfcDev.state );                                    /* Notify caller that WU has woke */
             }
@@ -364,16 +674,95 @@ void rfalNfcWorker( void )
 
             break;
             
+        /*******************************************************************************/
+        case RFAL_NFC_STATE_CARD_DETECT:
+            
+    #if RFAL_FEATURE_CD
+            if( !gNfcDev.isOperOngoing )
+            {
+                err = rfalCdStartDetectCardTechs( (uint8_t)(gNfcDev.techs2do & RFAL_NFC_CD_TECHS), &gNfcDev.cdRes );
+                if( err != ERR_NONE )
+                {
+                    gNfcDev.state = RFAL_NFC_STATE_POLL_TECHDETECT;                   /* Nothing to pre-filter, perform Technology Detection */
+                    break;
+                }
+                
+                gNfcDev.isOperOngoing = true;
+                break;
+            }
+            
+            err = rfalCdGetDetectCardStatus();
+            if( err == ERR_BUSY )                                                     /* Wait until Card Detection is concluded */
+            {
+                break;
+            }
+            gNfcDev.isOperOngoing = false;
+            
+            if( err == ERR_NONE )
+            {
+                /* Skip the technologies that did not answer the probe */
+                gNfcDev.techs2do &= (uint16_t)~(RFAL_NFC_CD_TECHS & (uint16_t)~gNfcDev.cdRes.techs);
+                
+                /* If nothing else is left to poll, skip Technology Detection altogether */
+                if( !gNfcDev.cdRes.detected && ((gNfcDev.techs2do & RFAL_NFC_NON_CD_TECHS) == 0U) )
+                {
+                #if RFAL_FEATURE_WAKEUP_MODE
+                    if( gNfcDev.disc.wakeupEnabled )
+                    {
+                        rfalWakeUpModeReportResult( false );                          /* Report the false wake-up, if any */
+                    }
+                #endif /* RFAL_FEATURE_WAKEUP_MODE */
+                
+                #if RFAL_FEATURE_NFC_STATS
+                    if( gNfcDev.isWoke )
+                    {
+                        gNfcDev.stats.wakeUp.failCnt++;
+                    }
+                #endif /* RFAL_FEATURE_NFC_STATS */
+                
+                    if( gNfcDev.disc.pollWindow == 0U )                               /* With slot scheduling the cycle timer runs already */
+                    {
+                        platformTimerDestroy( gNfcDev.discTmr );
+                        gNfcDev.discTmr = (uint32_t)platformTimerCreate( gNfcDev.disc.totalDuration );
+                    }
+                    
+                    gNfcDev.state = RFAL_NFC_STATE_LISTEN_TECHDETECT;                 /* Nothing found as poller, go to listener */
+                    break;
+                }
+            }
+            
+            gNfcDev.state = RFAL_NFC_STATE_POLL_TECHDETECT;                           /* Something around or unable to tell, perform Technology Detection */
+    #endif /* RFAL_FEATURE_CD */
+            break;
+            
         /*******************************************************************************/
         case RFAL_NFC_STATE_POLL_TECHDETECT:
             
-            /* Start total duration timer */
-            platformTimerDestroy( gNfcDev.discTmr );
-            gNfcDev.discTmr = (uint32_t)platformTimerCreate( gNfcDev.disc.totalDuration );
+            /* Start total duration timer, with slot scheduling the cycle timer runs already */
+            if( gNfcDev.disc.pollWindow == 0U )
+            {
+                platformTimerDestroy( gNfcDev.discTmr );
+                gNfcDev.discTmr = (uint32_t)platformTimerCreate( gNfcDev.disc.totalDuration );
+            }
         
             err = rfalNfcPollTechDetetection();                                       /* Perform Technology Detection                         */
             if( err != ERR_BUSY )                                                     /* Wait until all technologies are performed            */
             {
+            #if RFAL_FEATURE_WAKEUP_MODE
+                if( gNfcDev.disc.wakeupEnabled )
+                {
+                    /* Feed the outcome back into the Wake-up thresholds (ignored if this cycle was not triggered by a wake-up) */
+                    rfalWakeUpModeReportResult( ((err == ERR_NONE) && (gNfcDev.techsFound != RFAL_NFC_TECH_NONE)) );
+                }
+            #endif /* RFAL_FEATURE_WAKEUP_MODE */
+            
+            #if RFAL_FEATURE_NFC_STATS
+                if( gNfcDev.isWoke && ((err != ERR_NONE) || (gNfcDev.techsFound == RFAL_NFC_TECH_NONE)) )
+                {
+                    gNfcDev.stats.wakeUp.failCnt++;
+                }
+            #endif /* RFAL_FEATURE_NFC_STATS */
+            
                 if( ( err != ERR_NONE) || (gNfcDev.techsFound == RFAL_NFC_TECH_NONE) )/* Check if any error occurred or no techs were found   */
                 {
                     rfalFieldOff();
@@ -383,6 +772,8 @@ void rfalNfcWorker( void )
                 
                 gNfcDev.techs2do = gNfcDev.techsFound;                                /* Store the found technologies for collision resolution */
                 gNfcDev.state    = RFAL_NFC_STATE_POLL_COLAVOIDANCE;                  /* One or more devices found, go to Collision Avoidance  */
+                rfalNfcStatsStart( gNfcDev.phaseStart );
+                rfalNfcNfcNotify( gNfcDev.state );                                    /* Notify caller, time to detect available */
             }
             break;
             
@@ -393,14 +784,21 @@ void rfalNfcWorker( void )
             err = rfalNfcPollCollResolution();                                        /* Resolve any eventual collision                       */
             if( err != ERR_BUSY )                                                     /* Wait until all technologies are performed            */
             {
+                rfalNfcStatsStop( gNfcDev.stats.collResolution, gNfcDev.phaseStart, ((err != ERR_NONE) || (gNfcDev.devCnt == 0U)) );
+                
+                if( err == ERR_NONE )
+                {
+                    rfalNfcSuppressFilter();                                          /* Skip devices activated recently                      */
+                }
+                
                 if( (err != ERR_NONE) || (gNfcDev.devCnt == 0U) )                     /* Check if any error occurred or no devices were found */
                 {
                     gNfcDev.state = RFAL_NFC_STATE_DEACTIVATION;
                     break;                                                            /* Unable to retrieve any device, restart loop          */
                 }
                 
-                /* Check if more than one device has been found */
-                if( gNfcDev.devCnt > 1U )
+                /* Check if more than one device has been found (batch mode activates all of them in turn) */
+                if( (gNfcDev.devCnt > 1U) && (!gNfcDev.disc.batchMode) )
                 {
                     /* If more than one device was found inform upper layer to choose which one to activate */
                     if( gNfcDev.disc.notifyCb != NULL )
@@ -414,6 +812,7 @@ void rfalNfcWorker( void )
                 /* If only one device or no callback has been set, activate the first device found */
                 gNfcDev.selDevIdx = 0U;
                 gNfcDev.state = RFAL_NFC_STATE_POLL_ACTIVATION;
+                rfalNfcStatsStart( gNfcDev.phaseStart );
             }
             break;
         
@@ -424,12 +823,31 @@ void rfalNfcWorker( void )
             err = rfalNfcPollActivation( gNfcDev.selDevIdx );
             if( err != ERR_BUSY )                                                         /* Wait until all Activation is complete */
             {
+            #if RFAL_FEATURE_NFC_STATS
+                if( gNfcDev.selDevIdx < gNfcDev.devCnt )
+                {
+                    rfalNfcStatsStop( gNfcDev.stats.activation[rfalNfcDevTechIdx( gNfcDev.devList[gNfcDev.selDevIdx].type )], gNfcDev.phaseStart, (err != ERR_NONE) );
+                }
+                if( err == ERR_NONE )
+                {
+                    rfalNfcStatsStop( gNfcDev.stats.discovery, gNfcDev.discStart, false );
+                }
+            #endif /* RFAL_FEATURE_NFC_STATS */
+                
                 if( err != ERR_NONE )                                                     /* Activation failed selected device  */
                 {
+                    if( gNfcDev.disc.batchMode )
+                    {
+                        rfalNfcBatchAdvance();                                            /* In batch mode skip to the next device */
+                        break;
+                    }
+                    
                     gNfcDev.state = RFAL_NFC_STATE_DEACTIVATION;                          /* If Activation failed, restart loop */
                     break;
                 }
                 
+                rfalNfcSuppressCheck( gNfcDev.activeDev, true );                          /* Remember device to suppress its re-activation */
+                
                 gNfcDev.state = RFAL_NFC_STATE_ACTIVATED;                                 /* Device has been properly activated */
                 rfalNfcNfcNotify( gNfcDev.state );                                        /* Inform upper layer that a device has been activated */
             }
@@ -443,6 +861,7 @@ void rfalNfcWorker( void )
             
             if( gNfcDev.dataExErr != ERR_BUSY )                                       /* If Dataexchange has terminated */
             {
+                rfalNfcDataExchangeComplete( gNfcDev.dataExErr );                     /* Signal the completion, if requested */
                 gNfcDev.state = RFAL_NFC_STATE_DATAEXCHANGE_DONE;                     /* Go to done state               */
                 rfalNfcNfcNotify( gNfcDev.state );                                    /* And notify caller              */
             }
@@ -454,10 +873,55 @@ void rfalNfcWorker( void )
             break;
             
             
+        /*******************************************************************************/
+        case RFAL_NFC_STATE_PRESENCE_CHECK:
+            
+            if( !gNfcDev.isPresOngoing && !platformTimerIsExpired( gNfcDev.presTmr ) )
+            {
+                break;                                                                /* Wait until next check is due */
+            }
+            
+            err = rfalNfcPresenceCheck();
+            if( err == ERR_BUSY )
+            {
+                break;
+            }
+            
+            platformTimerDestroy( gNfcDev.presTmr );
+            
+            if( err == ERR_NONE )
+            {
+                gNfcDev.presRetries = 0;
+                gNfcDev.presTmr     = platformTimerCreate( gNfcDev.presPeriod );      /* Device present, wait for the next period */
+                break;
+            }
+            
+            if( gNfcDev.presRetries < RFAL_NFC_PRESENCE_CHECK_RETRIES )
+            {
+                gNfcDev.presRetries++;
+                gNfcDev.presTmr     = platformTimerCreate( 0 );                       /* Retry right away */
+                break;
+            }
+            
+            gNfcDev.state = RFAL_NFC_STATE_DEVICE_LOST;                               /* Device no longer answers */
+            rfalNfcNfcNotify( gNfcDev.state );                                        /* Notify caller (active device still available) */
+            break;
+            
+            
+        /*******************************************************************************/
+        case RFAL_NFC_STATE_DEVICE_LOST:
+            
+            gNfcDev.activeDev = NULL;                                                 /* Device is gone, no protocol deactivation */
+            gNfcDev.state     = RFAL_NFC_STATE_DEACTIVATION;
+            break;
+            
+            
         /*******************************************************************************/
         case RFAL_NFC_STATE_DEACTIVATION:
             
-            rfalNfcDeactivation();                                                    /* Deactivate current device */
+            rfalNfcStatsStart( gNfcDev.phaseStart );
+            err = rfalNfcDeactivation();                                              /* Deactivate current device */
+            rfalNfcStatsStop( gNfcDev.stats.deactivation, gNfcDev.phaseStart, (err != ERR_NONE) );
         
             gNfcDev.state = ((gNfcDev.discRestart) ? RFAL_NFC_STATE_START_DISCOVERY : RFAL_NFC_STATE_IDLE);
             rfalNfcNfcNotify( gNfcDev.state );                                        /* Notify caller             */
@@ -559,8 +1023,18 @@ ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_
     /*******************************************************************************/
     /* The Data Exchange is divided in two different moments, the trigger/Start of *
      *  the transfer followed by the check until its completion                    */
-    if( (gNfcDev.state >= RFAL_NFC_STATE_ACTIVATED) && (gNfcDev.activeDev != NULL) )
+    if( (gNfcDev.state >= RFAL_NFC_STATE_ACTIVATED) && (gNfcDev.state != RFAL_NFC_STATE_DEVICE_LOST) && (gNfcDev.activeDev != NULL) )
     {
+        /* A Data Exchange terminates the presence check mode, unless a check is ongoing */
+        if( gNfcDev.state == RFAL_NFC_STATE_PRESENCE_CHECK )
+        {
+            if( gNfcDev.isPresOngoing )
+            {
+                return ERR_BUSY;
+            }
+            platformTimerDestroy( gNfcDev.presTmr );
+        }
+        
         
         /*******************************************************************************/
         /* In Listen mode is the Poller that initiates the communicatation             */
@@ -647,9 +1121,7 @@ ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_
                 }
                 
                 rfalNfcDepTxRx.DID       = RFAL_NFCDEP_DID_KEEP;
-                rfalNfcDepTxRx.FSx       = rfalNfcIsRemDevListener(gNfcDev.activeDev->type) ?
-                                           rfalNfcDepLR2FS( (uint8_t)rfalNfcDepPP2LR( gNfcDev.activeDev->proto.nfcDep.activation.Target.ATR_RES.PPt ) ) :
-                                           rfalNfcDepLR2FS( (uint8_t)rfalNfcDepPP2LR( gNfcDev.activeDev->proto.nfcDep.activation.Initiator.ATR_REQ.PPi ) );
+                rfalNfcDepTxRx.FSx       = gNfcDev.activeDev->proto.nfcDep.info.FS;        /* Frame size as updated by PSL, if any */
                 rfalNfcDepTxRx.dFWT      = gNfcDev.activeDev->proto.nfcDep.info.dFWT;
                 rfalNfcDepTxRx.FWT       = gNfcDev.activeDev->proto.nfcDep.info.FWT;
                 rfalNfcDepTxRx.txBuf     = &gNfcDev.txBuf.nfcDepBuf;
@@ -677,6 +1149,7 @@ ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_
         if( err == ERR_NONE )
         {
             gNfcDev.dataExErr = ERR_BUSY;
+            gNfcDev.dataExCb  = NULL;
             gNfcDev.state     = RFAL_NFC_STATE_DATAEXCHANGE;
         }
         
@@ -687,6 +1160,29 @@ ReturnCode rfalNfcDataExchangeStart( uint8_t *txData, uint16_t txDataLen, uint8_
 }
 
 
+/*******************************************************************************/
+ReturnCode rfalNfcDataExchangeStartCb( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt, rfalNfcDataExchangeCb cb )
+{
+    ReturnCode err;
+    
+    if( cb == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    EXIT_ON_ERR( err, rfalNfcDataExchangeStart( txData, txDataLen, rxData, rvdLen, fwt ) );
+    
+    /* In Listen mode move to Data Exchange right away, as rfalNfcDataExchangeGetStatus() would */
+    if( gNfcDev.state == RFAL_NFC_STATE_ACTIVATED )
+    {
+        rfalNfcDataExchangeGetStatus();
+    }
+    
+    gNfcDev.dataExCb = cb;
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalNfcDataExchangeGetStatus( void )
 {
@@ -737,6 +1233,10 @@ ReturnCode rfalNfcDataExchangeGetStatus( void )
             /*******************************************************************************/
             case RFAL_NFC_INTERFACE_ISODEP:
                 gNfcDev.dataExErr = rfalIsoDepGetApduTransceiveStatus();
+                if( gNfcDev.dataExErr != ERR_BUSY )
+                {
+                    rfalNfcBrLinkUpdate();
+                }
                 break;
         #endif /* RFAL_FEATURE_ISO_DEP */
                 
@@ -787,16 +1287,57 @@ static ReturnCode rfalNfcPollTechDetetection( void )
 {
     ReturnCode           err;
     
+    uint8_t              i;
+    
     err = ERR_NONE;
     
     /* Supress warning when specific RFAL features have been disabled */
     NO_WARNING(err);   
     
     
+    /*******************************************************************************/
+    /* Account a new Technology Detection cycle                                    */
+    if( !gNfcDev.isPollCycle )
+    {
+        gNfcDev.isPollCycle  = true;
+        gNfcDev.techDctStart = platformGetSysTick();
+        
+        for( i = 0; i < RFAL_NFC_POLL_TECH_CNT; i++ )
+        {
+            /* Technologies left out (e.g. by Card Detection) were checked already */
+            gNfcDev.techAge[i] = ( ((gNfcDev.techs2do & (1U << i)) != 0U) ? (uint8_t)MIN( (gNfcDev.techAge[i] + 1U), 0xFFU ) : 0U );
+        }
+    }
+    
+    /* Slot scheduling: once the Poll window is over (and no detection is ongoing) preempt the technology and leave the remaining for the next cycle */
+    if( (gNfcDev.disc.pollWindow != 0U) && (!gNfcDev.isOperOngoing) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECHS) != 0U) && platformTimerIsExpired( gNfcDev.pollTmr ) )
+    {
+        gNfcDev.techsSkipped = (gNfcDev.techs2do & RFAL_NFC_POLL_TECHS);
+        gNfcDev.techs2do    &= (uint16_t)~RFAL_NFC_POLL_TECHS;
+        gNfcDev.isTechInit   = false;
+        
+        if( (gNfcDev.techsSkipped & gNfcDev.pollTech) != 0U )
+        {
+            gNfcDev.pollTech = RFAL_NFC_TECH_NONE;                                    /* Not detected, keep its history untouched */
+        }
+    }
+    
+    /* Select the next technology once the previous one has been concluded */
+    if( (gNfcDev.techs2do & gNfcDev.pollTech) == 0U )
+    {
+        if( gNfcDev.pollTech != RFAL_NFC_TECH_NONE )
+        {
+            rfalNfcPollTechConclude();
+        }
+        gNfcDev.pollTech = rfalNfcPollNextTech();
+        rfalNfcStatsStart( gNfcDev.techStart );
+    }
+    
+    
     /*******************************************************************************/
     /* AP2P Technology Detection                                                   */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_AP2P) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_AP2P) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_AP2P) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_AP2P) )
     {
         
     #if RFAL_FEATURE_NFC_DEP
@@ -825,6 +1366,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
                 gNfcDev.devList->rfInterface = RFAL_NFC_INTERFACE_NFCDEP;
                 gNfcDev.devCnt++;
                 
+                rfalNfcPollTechConclude();
                 return ERR_NONE;
             }
             
@@ -840,7 +1382,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-A Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_A) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_A) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_A) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_A) )
     {
         
     #if RFAL_FEATURE_NFCA
@@ -875,7 +1417,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-B Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_B) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_B) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_B) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_B) )
     {
     #if RFAL_FEATURE_NFCB
         
@@ -909,7 +1451,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-F Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_F) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_F) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_F) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_F) )
     {
     #if RFAL_FEATURE_NFCF
      
@@ -941,8 +1483,9 @@ static ReturnCode rfalNfcPollTechDetetection( void )
                     gNfcDev.techsFound |= RFAL_NFC_POLL_TECH_F;
                 }
                 
-                gNfcDev.isTechInit = false;
-                gNfcDev.techs2do  &= ~RFAL_NFC_POLL_TECH_F;
+                gNfcDev.isTechInit    = false;
+                gNfcDev.isOperOngoing = false;                                       /* Detection concluded */
+                gNfcDev.techs2do     &= ~RFAL_NFC_POLL_TECH_F;
             }
         }
         
@@ -955,7 +1498,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive NFC-V Technology Detection                                          */
     /*******************************************************************************/
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_V) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_V) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_V) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_V) )
     {
     #if RFAL_FEATURE_NFCV
         
@@ -989,7 +1532,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive Proprietary Technology ST25TB                                       */
     /*******************************************************************************/  
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_ST25TB) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_ST25TB) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_ST25TB) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_ST25TB) )
     {
     #if RFAL_FEATURE_ST25TB
         
@@ -1020,7 +1563,7 @@ static ReturnCode rfalNfcPollTechDetetection( void )
     /*******************************************************************************/
     /* Passive Proprietary Technology                                              */
     /*******************************************************************************/  
-    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_PROP) != 0U) && ((gNfcDev.techs2do & RFAL_NFC_POLL_TECH_PROP) != 0U) )
+    if( ((gNfcDev.disc.techs2Find & RFAL_NFC_POLL_TECH_PROP) != 0U) && (gNfcDev.pollTech == RFAL_NFC_POLL_TECH_PROP) )
     {
         if( !gNfcDev.isTechInit )
         {
@@ -1049,10 +1592,252 @@ static ReturnCode rfalNfcPollTechDetetection( void )
 
 /*!
  ******************************************************************************
- * \brief Poller Collision Resolution
+ * \brief Technology index
  * 
- * This method implements the Collision Resolution on all technologies that
- * have been detected before.
+ * Returns the index of the given Poll technology flag on the per technology
+ * history arrays
+ ******************************************************************************
+ */
+static uint8_t rfalNfcTechIdx( uint16_t tech )
+{
+    uint8_t idx;
+    
+    /* Poll technologies are single bit flags, use the bit position as index */
+    idx = 0;
+    while( (tech >>= 1U) != 0U )
+    {
+        idx++;
+    }
+    
+    return idx;
+}
+
+
+#if RFAL_FEATURE_NFC_STATS
+
+/*!
+ ******************************************************************************
+ * \brief Device technology index
+ * 
+ * Returns the index of the Poll technology a device found as Poller has been 
+ * detected with, on the per technology statistics arrays
+ ******************************************************************************
+ */
+static uint8_t rfalNfcDevTechIdx( rfalNfcDevType type )
+{
+    switch( type )
+    {
+        case RFAL_NFC_LISTEN_TYPE_NFCA:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_A );
+        case RFAL_NFC_LISTEN_TYPE_NFCB:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_B );
+        case RFAL_NFC_LISTEN_TYPE_NFCF:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_F );
+        case RFAL_NFC_LISTEN_TYPE_NFCV:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_V );
+        case RFAL_NFC_LISTEN_TYPE_ST25TB:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_ST25TB );
+        case RFAL_NFC_LISTEN_TYPE_AP2P:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_AP2P );
+        default:
+            return rfalNfcTechIdx( RFAL_NFC_POLL_TECH_PROP );
+    }
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Statistics Record
+ * 
+ * Accounts one occurrence of a discovery phase with the given duration
+ * 
+ * \param[in]  ph   : phase statistics to be updated
+ * \param[in]  dur  : phase duration (us)
+ * \param[in]  fail : whether the phase has failed
+ ******************************************************************************
+ */
+static void rfalNfcStatsRecord( rfalNfcPhaseStats *ph, uint32_t dur, bool fail )
+{
+    ph->min    = ( (ph->cnt == 0U) ? dur : MIN( ph->min, dur ) );
+    ph->max    = MAX( ph->max, dur );
+    ph->last   = dur;
+    ph->total += dur;
+    ph->cnt++;
+    
+    if( fail )
+    {
+        ph->failCnt++;
+    }
+}
+
+#endif /* RFAL_FEATURE_NFC_STATS */
+
+
+/*!
+ ******************************************************************************
+ * \brief Slot Scheduling Cycle Start
+ * 
+ * Starts the discovery cycle and Poll window timers when slot scheduling is
+ * enabled. The Poll window is bounded so that the Listen window still fits
+ * within the cycle.
+ ******************************************************************************
+ */
+static void rfalNfcSchedCycleStart( void )
+{
+    gNfcDev.isOperOngoing = false;                                                    /* Nothing left ongoing by the previous cycle */
+    
+    if( gNfcDev.disc.pollWindow == 0U )
+    {
+        return;
+    }
+    
+    platformTimerDestroy( gNfcDev.discTmr );
+    platformTimerDestroy( gNfcDev.pollTmr );
+    
+    gNfcDev.discTmr = (uint32_t)platformTimerCreate( gNfcDev.disc.totalDuration );
+    gNfcDev.pollTmr = (uint32_t)platformTimerCreate( MIN( gNfcDev.disc.pollWindow, (uint16_t)(gNfcDev.disc.totalDuration - gNfcDev.disc.listenWindow) ) );
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Poller Next Technology
+ * 
+ * Selects the next technology to be detected out of the ones still to do. 
+ * By default the fixed order AP2P, A, B, F, V, ST25TB, Proprietary is used.
+ * With adaptiveOrder the technology with the highest decayed hit rate is 
+ * selected, unless a technology has been left unprobed for too long.
+ * 
+ * \return  Technology to be detected, RFAL_NFC_TECH_NONE if none is left
+ ******************************************************************************
+ */
+static uint16_t rfalNfcPollNextTech( void )
+{
+    /* Fixed order used when no history is to be used, and to break ties */
+    static const uint16_t order[RFAL_NFC_POLL_TECH_CNT] = { RFAL_NFC_POLL_TECH_AP2P, RFAL_NFC_POLL_TECH_A, RFAL_NFC_POLL_TECH_B, RFAL_NFC_POLL_TECH_F, 
+                                                            RFAL_NFC_POLL_TECH_V, RFAL_NFC_POLL_TECH_ST25TB, RFAL_NFC_POLL_TECH_PROP };
+    uint8_t  i;
+    uint8_t  idx;
+    uint16_t best;
+    uint32_t bestRank;
+    uint32_t rank;
+    
+    best     = RFAL_NFC_TECH_NONE;
+    bestRank = 0;
+    
+    for( i = 0; i < RFAL_NFC_POLL_TECH_CNT; i++ )
+    {
+        if( (gNfcDev.techs2do & order[i]) == 0U )
+        {
+            continue;
+        }
+        
+        if( !gNfcDev.disc.adaptiveOrder )
+        {
+            /* Technologies preempted on the previous cycle go first */
+            if( (gNfcDev.techsSkipped & order[i]) != 0U )
+            {
+                return order[i];
+            }
+            
+            if( best == RFAL_NFC_TECH_NONE )
+            {
+                best = order[i];
+            }
+            continue;
+        }
+        
+        /* Overdue technologies rank above any score, the most overdue first */
+        idx  = rfalNfcTechIdx( order[i] );
+        rank = gNfcDev.techScore[idx];
+        if( gNfcDev.techAge[idx] >= RFAL_NFC_TECH_MAX_AGE )
+        {
+            rank += ((uint32_t)gNfcDev.techAge[idx] << 16U);
+        }
+        
+        if( (best == RFAL_NFC_TECH_NONE) || (rank > bestRank) )
+        {
+            best     = order[i];
+            bestRank = rank;
+        }
+    }
+    
+    return best;
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Poller Technology Concluded
+ * 
+ * Updates the history of the technology just detected and, with adaptiveOrder
+ * and a devLimit of 1, concludes Technology Detection on the first technology
+ * found provided that no overdue technology is still to be probed.
+ ******************************************************************************
+ */
+static void rfalNfcPollTechConclude( void )
+{
+    uint8_t  idx;
+    uint8_t  i;
+    bool     hit;
+    bool     overdue;
+    
+    idx = rfalNfcTechIdx( gNfcDev.pollTech );
+    hit = ((gNfcDev.techsFound & gNfcDev.pollTech) != 0U);
+    
+    gNfcDev.techsSkipped &= (uint16_t)~gNfcDev.pollTech;
+    
+    rfalNfcStatsStop( gNfcDev.stats.techDetect[idx], gNfcDev.techStart, !hit );
+    
+    /* Exponentially decayed hit rate of the technology */
+    if( hit )
+    {
+        gNfcDev.techScore[idx] += ((RFAL_NFC_TECH_SCORE_MAX - gNfcDev.techScore[idx]) >> RFAL_NFC_TECH_SCORE_DECAY);
+    }
+    else
+    {
+        gNfcDev.techScore[idx] -= (gNfcDev.techScore[idx] >> RFAL_NFC_TECH_SCORE_DECAY);
+    }
+    gNfcDev.techAge[idx] = 0;
+    
+    if( hit )
+    {
+        /* Record the time to the first technology found on this cycle */
+        if( gNfcDev.techsFound == gNfcDev.pollTech )
+        {
+            gNfcDev.timeToDetect = (platformGetSysTick() - gNfcDev.techDctStart);
+            gNfcDev.isDetected   = true;
+        }
+        
+        /* Early exit if a single device is wanted, once all overdue technologies have been probed */
+        if( gNfcDev.disc.adaptiveOrder && (gNfcDev.disc.devLimit == 1U) )
+        {
+            overdue = false;
+            for( i = 0; i < RFAL_NFC_POLL_TECH_CNT; i++ )
+            {
+                if( ((gNfcDev.techs2do & (1U << i)) != 0U) && (gNfcDev.techAge[i] >= RFAL_NFC_TECH_MAX_AGE) )
+                {
+                    overdue = true;
+                }
+            }
+            
+            if( !overdue )
+            {
+                gNfcDev.techs2do &= ~RFAL_NFC_POLL_TECHS;
+            }
+        }
+    }
+    
+    gNfcDev.pollTech = RFAL_NFC_TECH_NONE;
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Poller Collision Resolution
+ * 
+ * This method implements the Collision Resolution on all technologies that
+ * have been detected before.
  * 
  * \return  ERR_NONE         : Operation completed with no error
  * \return  ERR_BUSY         : Operation ongoing
@@ -1486,7 +2271,7 @@ static ReturnCode rfalNfcPollActivation( uint8_t devIt )
                     {
                         /* Perform ISO-DEP (ISO14443-4) activation: RATS and PPS if supported */
                         rfalIsoDepInitialize();
-                        EXIT_ON_ERR( err, rfalIsoDepPollAStartActivation( gNfcDev.disc.isoDepFS, RFAL_ISODEP_NO_DID, gNfcDev.disc.maxBR, &gNfcDev.devList[devIt].proto.isoDep ) );
+                        EXIT_ON_ERR( err, rfalIsoDepPollAStartActivation( gNfcDev.disc.isoDepFS, RFAL_ISODEP_NO_DID, rfalNfcBrMax( &gNfcDev.devList[devIt] ), &gNfcDev.devList[devIt].proto.isoDep ) );
                         
                         gNfcDev.isOperOngoing = true;
                         return ERR_BUSY;
@@ -1564,7 +2349,7 @@ static ReturnCode rfalNfcPollActivation( uint8_t devIt )
                 {
                     rfalIsoDepInitialize();
                     /* Perform ISO-DEP (ISO14443-4) activation: ATTRIB    */
-                    EXIT_ON_ERR( err, rfalIsoDepPollBStartActivation( gNfcDev.disc.isoDepFS, RFAL_ISODEP_NO_DID, gNfcDev.disc.maxBR, 0x00, &gNfcDev.devList[devIt].dev.nfcb, NULL, 0, &gNfcDev.devList[devIt].proto.isoDep ) );
+                    EXIT_ON_ERR( err, rfalIsoDepPollBStartActivation( gNfcDev.disc.isoDepFS, RFAL_ISODEP_NO_DID, rfalNfcBrMax( &gNfcDev.devList[devIt] ), 0x00, &gNfcDev.devList[devIt].dev.nfcb, NULL, 0, &gNfcDev.devList[devIt].proto.isoDep ) );
                     
                     gNfcDev.isOperOngoing = true;
                     return ERR_BUSY;
@@ -2014,6 +2799,647 @@ static ReturnCode rfalNfcNfcDepActivate( rfalNfcDevice *device, rfalNfcDepCommMo
 #endif /* RFAL_FEATURE_NFC_DEP */
 
 
+/*!
+ ******************************************************************************
+ * \brief Presence Check Is Supported
+ * 
+ * Checks whether a presence check exists for the given activated device
+ * 
+ * \param[in]  dev : activated device
+ * 
+ * \return  true if supported, false otherwise
+ ******************************************************************************
+ */
+static bool rfalNfcPresenceCheckIsSupported( const rfalNfcDevice *dev )
+{
+    if( !rfalNfcIsRemDevListener( dev->type ) )
+    {
+        return false;                                                                 /* Only as Poller/Initiator */
+    }
+    
+    switch( dev->rfInterface )
+    {
+    #if RFAL_FEATURE_ISO_DEP_POLL
+        case RFAL_NFC_INTERFACE_ISODEP:
+            return true;
+    #endif /* RFAL_FEATURE_ISO_DEP_POLL */
+        
+    #if RFAL_FEATURE_NFC_DEP
+        case RFAL_NFC_INTERFACE_NFCDEP:
+            return true;
+    #endif /* RFAL_FEATURE_NFC_DEP */
+        
+        case RFAL_NFC_INTERFACE_RF:
+            switch( dev->type )
+            {
+            #if RFAL_FEATURE_NFCA && RFAL_FEATURE_T2T
+                case RFAL_NFC_LISTEN_TYPE_NFCA:
+                    return (dev->dev.nfca.type == RFAL_NFCA_T2T);
+            #endif /* RFAL_FEATURE_NFCA && RFAL_FEATURE_T2T */
+                
+            #if RFAL_FEATURE_NFCF
+                case RFAL_NFC_LISTEN_TYPE_NFCF:
+                    return true;
+            #endif /* RFAL_FEATURE_NFCF */
+                
+            #if RFAL_FEATURE_NFCV
+                case RFAL_NFC_LISTEN_TYPE_NFCV:
+                    return true;
+            #endif /* RFAL_FEATURE_NFCV */
+                
+                default:
+                    return false;
+            }
+        
+        default:
+            return false;
+    }
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Presence Check
+ * 
+ * Performs the cheapest check for the activated device technology/interface.
+ * ISO-DEP and NFC-F checks are non-blocking, the remaining are short blocking
+ * exchanges
+ * 
+ * \return  ERR_NONE  : Device present
+ * \return  ERR_BUSY  : Operation ongoing
+ * \return  ERR_XXXX  : Device did not answer properly
+ ******************************************************************************
+ */
+static ReturnCode rfalNfcPresenceCheck( void )
+{
+    ReturnCode ret;
+    
+    /*******************************************************************************/
+    /* Retrieve the result of an ongoing non-blocking check                        */
+    if( gNfcDev.isPresOngoing )
+    {
+        ret = ERR_INTERNAL;
+        
+    #if RFAL_FEATURE_ISO_DEP_POLL
+        if( gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_ISODEP )
+        {
+            ret = rfalIsoDepGetPresenceCheckStatus();
+        }
+    #endif /* RFAL_FEATURE_ISO_DEP_POLL */
+        
+    #if RFAL_FEATURE_NFCF
+        if( gNfcDev.activeDev->rfInterface == RFAL_NFC_INTERFACE_RF )
+        {
+            ret = rfalNfcfPollerGetCheckPresenceStatus();
+        }
+    #endif /* RFAL_FEATURE_NFCF */
+        
+        gNfcDev.isPresOngoing = (ret == ERR_BUSY);
+        return ret;
+    }
+    
+    /*******************************************************************************/
+    switch( gNfcDev.activeDev->rfInterface )
+    {
+    #if RFAL_FEATURE_ISO_DEP_POLL
+        case RFAL_NFC_INTERFACE_ISODEP:
+            EXIT_ON_ERR( ret, rfalIsoDepStartPresenceCheck( (gNfcDev.activeDev->proto.isoDep.info.FWT + gNfcDev.activeDev->proto.isoDep.info.dFWT) ) );
+            gNfcDev.isPresOngoing = true;
+            return ERR_BUSY;
+    #endif /* RFAL_FEATURE_ISO_DEP_POLL */
+        
+    #if RFAL_FEATURE_NFC_DEP
+        case RFAL_NFC_INTERFACE_NFCDEP:
+            return rfalNfcDepATN();
+    #endif /* RFAL_FEATURE_NFC_DEP */
+        
+        case RFAL_NFC_INTERFACE_RF:
+            switch( gNfcDev.activeDev->type )
+            {
+            #if RFAL_FEATURE_NFCA && RFAL_FEATURE_T2T
+                case RFAL_NFC_LISTEN_TYPE_NFCA:
+                {
+                    uint8_t  rxBuf[RFAL_T2T_READ_DATA_LEN];
+                    uint16_t rcvLen;
+                    
+                    return rfalT2TPollerRead( 0, rxBuf, (uint16_t)sizeof(rxBuf), &rcvLen );
+                }
+            #endif /* RFAL_FEATURE_NFCA && RFAL_FEATURE_T2T */
+                
+            #if RFAL_FEATURE_NFCF
+                case RFAL_NFC_LISTEN_TYPE_NFCF:
+                    EXIT_ON_ERR( ret, rfalNfcfPollerStartCheckPresence() );
+                    gNfcDev.isPresOngoing = true;
+                    return ERR_BUSY;
+            #endif /* RFAL_FEATURE_NFCF */
+                
+            #if RFAL_FEATURE_NFCV
+                case RFAL_NFC_LISTEN_TYPE_NFCV:
+                {
+                    rfalNfcvInventoryRes invRes;
+                    
+                    /* Mask with the whole UID so that only the activated VICC may answer */
+                    return rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, (uint8_t)rfalConvBytesToBits(RFAL_NFCV_UID_LEN), gNfcDev.activeDev->dev.nfcv.InvRes.UID, &invRes, NULL );
+                }
+            #endif /* RFAL_FEATURE_NFCV */
+                
+                default:
+                    return ERR_NOTSUPP;
+            }
+        
+        default:
+            return ERR_NOTSUPP;
+    }
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Device Id Get
+ * 
+ * Retrieves the NFCID/UID of a device as found by Collision Resolution, 
+ * before activation has assigned nfcid. Devices without a stable id 
+ * (T1T, NFC-DEP, Listen mode) return a length of 0
+ * 
+ * \param[in]   dev : device
+ * \param[out]  id  : location of the device's id
+ * 
+ * \return  id length
+ ******************************************************************************
+ */
+static uint8_t rfalNfcDevIdGet( const rfalNfcDevice *dev, const uint8_t **id )
+{
+    switch( dev->type )
+    {
+        case RFAL_NFC_LISTEN_TYPE_NFCA:
+            *id = dev->dev.nfca.nfcId1;
+            return dev->dev.nfca.nfcId1Len;
+            
+        case RFAL_NFC_LISTEN_TYPE_NFCB:
+            *id = dev->dev.nfcb.sensbRes.nfcid0;
+            return RFAL_NFCB_NFCID0_LEN;
+            
+        case RFAL_NFC_LISTEN_TYPE_NFCF:
+            *id = dev->dev.nfcf.sensfRes.NFCID2;
+            return RFAL_NFCF_NFCID2_LEN;
+            
+        case RFAL_NFC_LISTEN_TYPE_NFCV:
+            *id = dev->dev.nfcv.InvRes.UID;
+            return RFAL_NFCV_UID_LEN;
+            
+        case RFAL_NFC_LISTEN_TYPE_ST25TB:
+            *id = dev->dev.st25tb.UID;
+            return RFAL_ST25TB_UID_LEN;
+            
+        default:
+            *id = NULL;
+            return 0;
+    }
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Suppression Check
+ * 
+ * Looks up the device on the suppression cache, a small hash set keyed by
+ * type and NFCID with linear probing. Expired entries are released while 
+ * probing. A device found has its suppression extended by suppressTTL, so 
+ * that a device left in the field is not activated again.
+ * 
+ * \param[in]  dev    : device
+ * \param[in]  insert : add the device if not found (evicting its home 
+ *                      slot if the cache is full)
+ * 
+ * \return  true if the device is currently suppressed
+ ******************************************************************************
+ */
+static bool rfalNfcSuppressCheck( const rfalNfcDevice *dev, bool insert )
+{
+    const uint8_t        *id;
+    uint8_t              idLen;
+    uint8_t              i;
+    uint8_t              home;
+    uint8_t              freeIdx;
+    uint32_t             hash;
+    rfalNfcSuppressEntry *entry;
+    
+    idLen = rfalNfcDevIdGet( dev, &id );
+    if( (gNfcDev.disc.suppressTTL == 0U) || (idLen == 0U) || (idLen > RFAL_NFC_SUPPRESS_ID_MAX_LEN) )
+    {
+        return false;
+    }
+    
+    /* FNV-1a over type and id */
+    hash = (2166136261UL ^ (uint32_t)dev->type) * 16777619UL;
+    for( i = 0; i < idLen; i++ )
+    {
+        hash = (hash ^ id[i]) * 16777619UL;
+    }
+    
+    home    = (uint8_t)(hash % RFAL_NFC_SUPPRESS_CACHE_LEN);
+    freeIdx = RFAL_NFC_SUPPRESS_CACHE_LEN;
+    
+    for( i = 0; i < RFAL_NFC_SUPPRESS_CACHE_LEN; i++ )
+    {
+        entry = &gNfcDev.suppress[ ((home + i) % RFAL_NFC_SUPPRESS_CACHE_LEN) ];
+        
+        if( (entry->idLen != 0U) && platformTimerIsExpired( entry->expiry ) )
+        {
+            entry->idLen = 0;                                                         /* Release expired entry */
+        }
+        
+        if( entry->idLen == 0U )
+        {
+            freeIdx = ((freeIdx == RFAL_NFC_SUPPRESS_CACHE_LEN) ? (uint8_t)((home + i) % RFAL_NFC_SUPPRESS_CACHE_LEN) : freeIdx);
+            continue;
+        }
+        
+        if( (entry->type == dev->type) && (entry->idLen == idLen) && (ST_BYTECMP( entry->id, id, idLen ) == 0) )
+        {
+            entry->expiry = platformTimerCreate( gNfcDev.disc.suppressTTL );
+            return true;
+        }
+    }
+    
+    if( insert )
+    {
+        entry         = &gNfcDev.suppress[ ((freeIdx != RFAL_NFC_SUPPRESS_CACHE_LEN) ? freeIdx : home) ];
+        entry->type   = dev->type;
+        entry->idLen  = idLen;
+        entry->expiry = platformTimerCreate( gNfcDev.disc.suppressTTL );
+        ST_MEMCPY( entry->id, id, idLen );
+    }
+    
+    return false;
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Bit Rate cache lookup
+ * 
+ * Looks up the device on the bit rate cache (searched linearly, it is kept
+ * small). 
+ * 
+ * \param[in]  dev    : device
+ * \param[in]  insert : add the device if not found, replacing the entries
+ *                      in turn once the cache is full
+ * 
+ * \return  the device entry, NULL if not found (and not inserted)
+ ******************************************************************************
+ */
+static rfalNfcBrEntry* rfalNfcBrLookup( const rfalNfcDevice *dev, bool insert )
+{
+    const uint8_t  *id;
+    uint8_t        idLen;
+    uint8_t        i;
+    uint8_t        freeIdx;
+    rfalNfcBrEntry *entry;
+    
+    idLen = rfalNfcDevIdGet( dev, &id );
+    if( (idLen == 0U) || (idLen > RFAL_NFC_SUPPRESS_ID_MAX_LEN) )
+    {
+        return NULL;
+    }
+    
+    freeIdx = RFAL_NFC_BR_CACHE_LEN;
+    for( i = 0; i < RFAL_NFC_BR_CACHE_LEN; i++ )
+    {
+        entry = &gNfcDev.brCache[i];
+        
+        if( entry->idLen == 0U )
+        {
+            freeIdx = ((freeIdx == RFAL_NFC_BR_CACHE_LEN) ? i : freeIdx);
+        }
+        else if( (entry->type == dev->type) && (entry->idLen == idLen) && (ST_BYTECMP( entry->id, id, idLen ) == 0) )
+        {
+            return entry;
+        }
+        else
+        {
+            /* MISRA 15.7 - Empty else */
+        }
+    }
+    
+    if( !insert )
+    {
+        return NULL;
+    }
+    
+    if( freeIdx == RFAL_NFC_BR_CACHE_LEN )
+    {
+        freeIdx        = gNfcDev.brNext;
+        gNfcDev.brNext = (uint8_t)((gNfcDev.brNext + 1U) % RFAL_NFC_BR_CACHE_LEN);
+    }
+    
+    entry        = &gNfcDev.brCache[freeIdx];
+    entry->type  = dev->type;
+    entry->idLen = idLen;
+    entry->maxBR  = RFAL_BR_848;
+    entry->blkCnt = 0;
+    entry->errCnt = 0;
+    ST_MEMCPY( entry->id, id, idLen );
+    
+    return entry;
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Bit Rate ceiling
+ * 
+ * Computes the maximum bit rate the device is to be activated with and 
+ * starts the link monitoring of the new session
+ * 
+ * \param[in]  dev    : device about to be activated
+ * 
+ * \return  maximum bit rate for the ISO-DEP activation (PPS/ATTRIB)
+ ******************************************************************************
+ */
+static rfalBitRate rfalNfcBrMax( const rfalNfcDevice *dev )
+{
+    rfalBitRate          maxBR;
+    const rfalNfcBrEntry *entry;
+    
+    ST_MEMSET( &gNfcDev.linkSeen, 0x00, sizeof(gNfcDev.linkSeen) );              /* ISO-DEP counters restart on activation */
+    
+    if( !gNfcDev.disc.adaptiveBR )
+    {
+        return gNfcDev.disc.maxBR;
+    }
+    
+    maxBR = ( ((gNfcDev.disc.maxBR == RFAL_BR_KEEP) || (gNfcDev.disc.maxBR > RFAL_BR_848)) ? RFAL_BR_848 : gNfcDev.disc.maxBR );
+    
+    entry = rfalNfcBrLookup( dev, false );
+    if( entry != NULL )
+    {
+        maxBR = MIN( maxBR, entry->maxBR );
+    }
+    
+    return maxBR;
+}
+
+
+#if RFAL_FEATURE_ISO_DEP
+/*!
+ ******************************************************************************
+ * \brief Bit Rate link update
+ * 
+ * Accounts the ISO-DEP blocks exchanged and the transmission errors seen 
+ * (also the ones ISO-DEP recovered with R-Blocks) since the last call. A 
+ * device is tracked on the cache by NFCID from its first link error, its 
+ * counters being kept across sessions. Once its link error rate gets above 
+ * 1/RFAL_NFC_BR_ERR_RATIO it is remembered one bit rate below the current 
+ * one, which is applied on its next activation (PPS/ATTRIB are only allowed
+ * right after RATS/ATTRIB). A long enough error free run raises a lowered 
+ * device one step again.
+ ******************************************************************************
+ */
+static void rfalNfcBrLinkUpdate( void )
+{
+    rfalIsoDepLinkStats link;
+    rfalBitRate         curBR;
+    rfalNfcBrEntry      *entry;
+    uint32_t            blks;
+    uint32_t            errs;
+    
+    if( (!gNfcDev.disc.adaptiveBR) || (gNfcDev.activeDev == NULL) ||
+        ((gNfcDev.activeDev->type != RFAL_NFC_LISTEN_TYPE_NFCA) && (gNfcDev.activeDev->type != RFAL_NFC_LISTEN_TYPE_NFCB)) )
+    {
+        return;
+    }
+    
+    if( rfalIsoDepGetLinkStats( &link ) != ERR_NONE )
+    {
+        return;
+    }
+    
+    blks             = (link.blkCnt - gNfcDev.linkSeen.blkCnt);
+    errs             = (link.errCnt - gNfcDev.linkSeen.errCnt);
+    gNfcDev.linkSeen = link;
+    
+    entry = rfalNfcBrLookup( gNfcDev.activeDev, (errs != 0U) );                 /* Only devices with link errors take an entry */
+    if( entry == NULL )
+    {
+        return;
+    }
+    
+    entry->blkCnt = (uint16_t)MIN( ((uint32_t)entry->blkCnt + blks), 0xFFFFU );
+    entry->errCnt = (uint16_t)MIN( ((uint32_t)entry->errCnt + errs), 0xFFFFU );
+    
+    curBR = MIN( gNfcDev.activeDev->proto.isoDep.info.DSI, gNfcDev.activeDev->proto.isoDep.info.DRI );
+    
+    /* Too many errors, lower the bit rate for the next activation */
+    if( (entry->errCnt >= RFAL_NFC_BR_ERR_MIN) && (((uint32_t)entry->errCnt * RFAL_NFC_BR_ERR_RATIO) > entry->blkCnt) )
+    {
+        if( curBR > RFAL_BR_106 )
+        {
+            entry->maxBR = (rfalBitRate)((uint8_t)curBR - 1U);   /* PRQA S 4342 # MISRA 10.5 - curBR within [RFAL_BR_212 ; RFAL_BR_848] */
+        }
+        
+        entry->blkCnt = 0;
+        entry->errCnt = 0;
+        return;
+    }
+    
+    /* Error free run long enough, try one bit rate higher next time */
+    if( entry->blkCnt >= RFAL_NFC_BR_RECOVER_CNT )
+    {
+        if( (entry->errCnt == 0U) && (curBR >= entry->maxBR) )
+        {
+            if( entry->maxBR >= RFAL_BR_424 )
+            {
+                entry->idLen = 0;                                  /* Back to the highest bit rate, release entry */
+                return;
+            }
+            entry->maxBR = (rfalBitRate)((uint8_t)entry->maxBR + 1U);  /* PRQA S 4342 # MISRA 10.5 - maxBR below RFAL_BR_848 */
+        }
+        
+        entry->blkCnt = 0;
+        entry->errCnt = 0;
+    }
+}
+#endif /* RFAL_FEATURE_ISO_DEP */
+
+
+/*!
+ ******************************************************************************
+ * \brief Suppression Filter
+ * 
+ * Removes from the device list the devices currently suppressed, keeping 
+ * the order of the remaining ones
+ ******************************************************************************
+ */
+static void rfalNfcSuppressFilter( void )
+{
+    uint8_t devIt;
+    uint8_t cnt;
+    
+    cnt = 0;
+    for( devIt = 0; devIt < gNfcDev.devCnt; devIt++ )
+    {
+        if( !rfalNfcSuppressCheck( &gNfcDev.devList[devIt], false ) )
+        {
+            if( cnt != devIt )
+            {
+                gNfcDev.devList[cnt] = gNfcDev.devList[devIt];
+            }
+            cnt++;
+        }
+    }
+    
+    gNfcDev.devCnt = cnt;
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Poller Sleep
+ * 
+ * Puts the given activated device to sleep so that it no longer interferes
+ * with the activation of the other devices in the field: 
+ * ISO-DEP DESELECT, NFC-DEP DSL, NFC-A HLTA, NFC-B SLPB, NFC-V Stay Quiet.
+ * NFC-F and ST25TB devices are addressed by their ids and left as is.
+ * 
+ * \param[in]  dev : activated device
+ ******************************************************************************
+ */
+static void rfalNfcPollSleep( rfalNfcDevice *dev )
+{
+    switch( dev->rfInterface )
+    {
+    #if RFAL_FEATURE_ISO_DEP && RFAL_FEATURE_ISO_DEP_POLL
+        case RFAL_NFC_INTERFACE_ISODEP:
+            rfalIsoDepDeselect();                                                     /* Deselected PICC enters HALT */
+            break;
+    #endif /* RFAL_FEATURE_ISO_DEP_POLL */
+        
+    #if RFAL_FEATURE_NFC_DEP
+        case RFAL_NFC_INTERFACE_NFCDEP:
+            rfalNfcDepDSL();                                                          /* Deselected Target enters Sleep */
+            break;
+    #endif /* RFAL_FEATURE_NFC_DEP */
+        
+        case RFAL_NFC_INTERFACE_RF:
+            switch( dev->type )
+            {
+            #if RFAL_FEATURE_NFCA
+                case RFAL_NFC_LISTEN_TYPE_NFCA:
+                    rfalNfcaPollerSleep();
+                    break;
+            #endif /* RFAL_FEATURE_NFCA */
+                
+            #if RFAL_FEATURE_NFCB
+                case RFAL_NFC_LISTEN_TYPE_NFCB:
+                    rfalNfcbPollerSleep( dev->dev.nfcb.sensbRes.nfcid0 );
+                    break;
+            #endif /* RFAL_FEATURE_NFCB */
+                
+            #if RFAL_FEATURE_NFCV
+                case RFAL_NFC_LISTEN_TYPE_NFCV:
+                    rfalNfcvPollerSleep( (uint8_t)RFAL_NFCV_REQ_FLAG_DEFAULT, dev->dev.nfcv.InvRes.UID );
+                    break;
+            #endif /* RFAL_FEATURE_NFCV */
+                
+                default:
+                    /* MISRA 16.4: no empty default statement (a comment being enough) */
+                    break;
+            }
+            break;
+        
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+    
+    if( dev->type == RFAL_NFC_LISTEN_TYPE_NFCA )
+    {
+        dev->dev.nfca.isSleep = true;
+    }
+    else if( dev->type == RFAL_NFC_LISTEN_TYPE_NFCB )
+    {
+        dev->dev.nfcb.isSleep = true;
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Batch Advance
+ * 
+ * In batch mode puts the current device to sleep and moves on to the 
+ * activation of the next device found, keeping the field on. Once all 
+ * devices have been handled the discovery loop is restarted
+ ******************************************************************************
+ */
+static void rfalNfcBatchAdvance( void )
+{
+    rfalNfcDevice *next;
+    
+    if( gNfcDev.activeDev != NULL )
+    {
+        rfalNfcPollSleep( gNfcDev.activeDev );
+        gNfcDev.activeDev = NULL;                                                     /* Already asleep, no deactivation needed */
+    }
+    
+    gNfcDev.selDevIdx++;
+    if( gNfcDev.selDevIdx >= gNfcDev.devCnt )
+    {
+        gNfcDev.state = RFAL_NFC_STATE_DEACTIVATION;                                  /* All devices handled, restart loop */
+        return;
+    }
+    
+    /* Previous exchanges may have moved the device out of its state, wake and select it explicitly */
+    next = &gNfcDev.devList[gNfcDev.selDevIdx];
+    if( next->type == RFAL_NFC_LISTEN_TYPE_NFCA )
+    {
+        next->dev.nfca.isSleep = true;
+    }
+    else if( next->type == RFAL_NFC_LISTEN_TYPE_NFCB )
+    {
+        next->dev.nfcb.isSleep = true;
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+    
+    gNfcDev.isTechInit    = false;
+    gNfcDev.isOperOngoing = false;
+    gNfcDev.state         = RFAL_NFC_STATE_POLL_ACTIVATION;
+    rfalNfcStatsStart( gNfcDev.phaseStart );
+}
+
+
+/*!
+ ******************************************************************************
+ * \brief Data Exchange Complete
+ * 
+ * Invokes the completion callback of the ongoing Data Exchange, if any,
+ * only once
+ * 
+ * \param[in]  err : Data Exchange outcome to be reported
+ ******************************************************************************
+ */
+static void rfalNfcDataExchangeComplete( ReturnCode err )
+{
+    rfalNfcDataExchangeCb cb;
+    
+    cb               = gNfcDev.dataExCb;
+    gNfcDev.dataExCb = NULL;
+    
+    if( cb != NULL )
+    {
+        cb( err );
+    }
+}
+
+
 /*!
  ******************************************************************************
  * \brief Poller NFC Deactivate
@@ -2028,6 +3454,8 @@ static ReturnCode rfalNfcNfcDepActivate( rfalNfcDevice *device, rfalNfcDepCommMo
  */
 static ReturnCode rfalNfcDeactivation( void )
 {
+    rfalNfcDataExchangeComplete( ERR_LINK_LOSS );                                         /* Release any caller waiting on an exchange */
+    
     /* Check if a device has been activated */
     if( gNfcDev.activeDev != NULL )
     {
@@ -69,6 +69,7 @@
  ******************************************************************************
  */
 #define NFCIP_ATR_RETRY_MAX             2U                              /*!< Max consecutive retrys of an ATR REQ with transm error*/
+#define NFCIP_PSL_RETRY_MAX             2U                              /*!< Max consecutive retrys of a PSL REQ with transm error */
 
 #define NFCIP_PSLPAY_LEN                (2U)                            /*!< PSL Payload length (BRS + FSL)                        */
 #define NFCIP_PSLREQ_LEN                (3U + RFAL_NFCDEP_LEN_LEN)      /*!< PSL REQ length (incl LEN)                             */
@@ -85,6 +86,9 @@
 #define NFCIP_DSLRES_LEN                (3U + RFAL_NFCDEP_LEN_LEN)      /*!< DSL RES length (incl LEN)                             */
 #define NFCIP_DSLRES_MIN                (2U + RFAL_NFCDEP_LEN_LEN)      /*!< Minimum length for a DSL RES (incl LEN)               */
 
+#define NFCIP_ATNRES_MIN                (3U + RFAL_NFCDEP_LEN_LEN)      /*!< Minimum length for a ATN RES (incl LEN)               */
+#define NFCIP_ATNRES_MAX_LEN            (5U + RFAL_NFCDEP_LEN_LEN)      /*!< Maximum length for a ATN RES (incl LEN, DID and NAD)  */
+
 #define NFCIP_DSLRES_MAX_LEN            (3U + RFAL_NFCDEP_LEN_LEN)      /*!< Maximum length for a DSL RES (incl LEN)               */
 #define NFCIP_RLSRES_MAX_LEN            (3U + RFAL_NFCDEP_LEN_LEN)      /*!< Minimum length for a RLS RES (incl LEN)               */
 #define NFCIP_TARGET_RES_MAX            ( MAX( NFCIP_RLSRES_MAX_LEN, NFCIP_DSLRES_MAX_LEN) ) /*!< Max target control res length    */
@@ -353,6 +357,10 @@ typedef struct{
   uint16_t                PDUTxPos;          /*!< PDU Tx position                               */
   uint16_t                PDURxPos;          /*!< PDU Rx position                               */
   bool                    isPDURxChaining;   /*!< PDU Transceive chaining flag                  */
+  
+  rfalNfcDepPduStreamParam streamParam;      /*!< PDU Stream params                             */
+  uint32_t                streamRxPos;       /*!< PDU Stream total Rx length                    */
+  uint16_t                streamBlkLen;      /*!< PDU Stream block Rx length                    */
 }rfalNfcDep;
 
 
@@ -363,6 +371,7 @@ typedef struct{
  */
 
 static rfalNfcDep gNfcip;                    /*!< NFCIP module instance                         */
+static rfalBitRate gNfcipPslMaxBR = RFAL_BR_KEEP; /*!< PSL bit rate ceiling of the next activation, kept across rfalNfcDepInitialize() */
 
 
 /*
@@ -377,6 +386,8 @@ static ReturnCode nfcipDEPControlMsg( uint8_t pfb, uint8_t RTOX  );
 static ReturnCode nfcipInitiatorHandleDEP( ReturnCode rxRes, uint16_t rxLen, uint16_t *outActRxLen, bool *outIsChaining );
 static ReturnCode nfcipTargetHandleRX( ReturnCode rxRes, uint16_t *outActRxLen, bool *outIsChaining );
 static ReturnCode nfcipTargetHandleActivation( rfalNfcDepDevice *nfcDepDev, uint8_t *outBRS );
+static uint16_t   nfcipMaxInfLen( uint16_t FSx, uint8_t DID );
+static ReturnCode rfalNfcDepPduStreamNextTx( void );
 
 
 /*!
@@ -2153,6 +2164,62 @@ ReturnCode rfalNfcDepDSL( void )
 }
 
 
+/*******************************************************************************/
+ReturnCode rfalNfcDepATN( void )
+{
+    ReturnCode ret;
+    uint8_t    rxBuf[NFCIP_ATNRES_MAX_LEN];
+    uint8_t    rxMsgIt;
+    uint16_t   rxLen = 0;
+    
+    if( gNfcip.cfg.role == RFAL_NFCDEP_ROLE_TARGET )
+    {
+        return ERR_WRONG_STATE;                           /* Only the Initiator may send an ATN */
+    }
+    
+    gNfcip.rxBuf     = rxBuf;
+    gNfcip.rxBufLen  = (uint16_t)sizeof(rxBuf);
+    gNfcip.rxRcvdLen = &rxLen;
+    
+    /* An ATN is answered by the Target with an ATN, the PNI is kept */
+    EXIT_ON_ERR( ret, nfcipDEPControlMsg( nfcip_PFBSPDU_ATN(), 0 ) );
+    EXIT_ON_ERR( ret, nfcipDataRx( true ) );
+    
+    /*******************************************************************************/
+    rxMsgIt = 0;
+    
+    if( rxBuf[rxMsgIt++] < NFCIP_ATNRES_MIN )             /* Checking length: LEN + DEP_RES + PFB */
+    {
+        return ERR_PROTO;
+    }
+    
+    if( rxBuf[rxMsgIt++] != NFCIP_RES )                   /* Checking if is a response      */
+    {
+        return ERR_PROTO;
+    }
+    
+    if( rxBuf[rxMsgIt++] != (uint8_t)NFCIP_CMD_DEP_RES )  /* Checking if is DEP RES         */
+    {
+        return ERR_PROTO;
+    }
+    
+    if( !nfcip_PFBisSATN( rxBuf[rxMsgIt++] ) )           /* Checking if is a S-ATN         */
+    {
+        return ERR_PROTO;
+    }
+    
+    if( gNfcip.cfg.did != RFAL_NFCDEP_DID_NO ) 
+    {
+        if ( rxBuf[rxMsgIt++] != gNfcip.cfg.did ) 
+        {
+            return ERR_PROTO;
+        }
+    }
+    
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalNfcDepRLS( void )
 {   
@@ -2205,9 +2272,9 @@ ReturnCode rfalNfcDepInitiatorHandleActivation( rfalNfcDepAtrParam* param, rfalB
 {
     ReturnCode ret;
     uint8_t    maxRetyrs;
-    uint8_t    PSL_BRS;
     uint8_t    PSL_FSL;
-    bool       sendPSL;
+    rfalBitRate PSL_BR;
+    rfalBitRate maxBR;
     
     if( (param == NULL) || (nfcDepDev == NULL) )
     {
@@ -2254,94 +2321,104 @@ ReturnCode rfalNfcDepInitiatorHandleActivation( rfalNfcDepAtrParam* param, rfalB
     
     
     /*******************************************************************************/
-    /* Check if a PSL needs to be sent                                                */
+    /* Upgrade with PSL                                                            */
     /*******************************************************************************/
-    sendPSL = false;
-    PSL_BRS = rfalNfcDepDx2BRS( nfcDepDev->info.DSI );  /* Set current bit rate divisor on both directions  */
-    PSL_FSL = nfcDepDev->info.LR;                       /* Set current Frame Size                           */
-    
     
-
     /* Activity 1.0  9.4.4.15 & 9.4.6.3   NFC-DEP Activation PSL
     *  Activity 2.0  9.4.4.17 & 9.4.6.6   NFC-DEP Activation PSL
     *     
     *  PSL_REQ shall only be sent if desired bit rate is different from current (Activity 1.0)
     *  PSL_REQ shall be sent to update LR or bit rate  (Activity 2.0)
+    *  
+    *  The PSL is sent to upgrade the bit rate and/or to set the LR common to both devices
     * */
-
-#if 0 /* PSL due to LR is disabled, can be enabled if desired*/
-    /*******************************************************************************/
-    /* Check Frame Size                                                            */
-    /*******************************************************************************/
-    if( gNfcip.cfg.lr < nfcDepDev->info.LR )  /* If our Length reduction is smaller */   
+    maxBR   = ((desiredBR == RFAL_BR_KEEP) ? RFAL_NFCDEP_PSL_AUTO_BR : desiredBR);
+    maxBR   = ((maxBR == RFAL_BR_KEEP) ? nfcDepDev->info.DSI : maxBR);
+    maxBR   = ((maxBR > RFAL_BR_848) ? RFAL_BR_848 : maxBR);                        /* Highest NFC-DEP bit rate nfcipDxIsSupported() accepts */
+    PSL_FSL = MIN( nfcDepDev->info.LR, (param->LR & RFAL_NFCDEP_LR_VAL_MASK) );
+    
+    /* A PSL failed on the previous activation, stay below its bit rate this time */
+    if( (gNfcipPslMaxBR != RFAL_BR_KEEP) && (maxBR > gNfcipPslMaxBR) )
     {
-        sendPSL = true;
-        
-        nfcDepDev->info.LR   = MIN( nfcDepDev->info.LR, gNfcip.cfg.lr );
-        
-        gNfcip.cfg.lr = nfcDepDev->info.LR;                /* Update nfcip LR  to be used */
-        gNfcip.fsc    = rfalNfcDepLR2FS( gNfcip.cfg.lr );  /* Update nfcip FSC to be used */     
-        
-        PSL_FSL       = gNfcip.cfg.lr;                     /* Set LR to be sent           */
-        
-        nfcipLogI( " NFCIP(I) Frame Size differ, PSL new fsc: %d \r\n", gNfcip.fsc );
+        maxBR = MAX( gNfcipPslMaxBR, nfcDepDev->info.DSI );
     }
-#endif
+    gNfcipPslMaxBR = RFAL_BR_KEEP;
+    
+#if !RFAL_FEATURE_NFCF
+    /* Passive NFC-A higher bit rates are only reachable with NFC-F framing */
+    if( (nfcDepDev->info.DSI == RFAL_BR_106) && (gNfcip.cfg.commMode == RFAL_NFCDEP_COMM_PASSIVE) )
+    {
+        maxBR = nfcDepDev->info.DSI;
+    }
+#endif /* !RFAL_FEATURE_NFCF */
     
+    /* Highest bit rate supported by both devices up to maxBR */
+    PSL_BR = maxBR;
+    while( (PSL_BR > nfcDepDev->info.DSI) && !nfcipDxIsSupported( (uint8_t)PSL_BR, nfcDepDev->activation.Target.ATR_RES.BRt, nfcDepDev->activation.Target.ATR_RES.BSt ) )
+    {
+        PSL_BR = (rfalBitRate)((uint8_t)PSL_BR - 1U);   /* PRQA S 4342 # MISRA 10.5 - PSL_BR above the current bit rate */
+    }
+    
+    if( (PSL_BR == nfcDepDev->info.DSI) && (PSL_FSL == nfcDepDev->info.LR) )
+    {
+        return ERR_NONE;   /* No PSL has been sent */
+    }
+    
+    /* Apply target's FWT for PSL_REQ        Digital 2.2  17.11.2.5 */
+    gNfcip.cfg.fwt = nfcDepDev->info.FWT;
     
     /*******************************************************************************/
-    /* Check Baud rates                                                            */
+    /* Send PSL REQ and wait for response                                          */
     /*******************************************************************************/
-    if( (nfcDepDev->info.DSI != desiredBR) && (desiredBR != RFAL_BR_KEEP) )    /* if desired BR is different    */
+    /* Only the same PSL_REQ is retransmitted: if just the PSL_RES was lost the   *
+     * Target already runs at the new bit rate, a different one would not match  */
+    maxRetyrs = NFCIP_PSL_RETRY_MAX;
+    do
     {
-        if( nfcipDxIsSupported( (uint8_t)desiredBR, nfcDepDev->activation.Target.ATR_RES.BRt, nfcDepDev->activation.Target.ATR_RES.BSt ) )  /* if desired BR is supported     */    /* MISRA 13.5 */
-        {
-            sendPSL = true;
-            PSL_BRS = rfalNfcDepDx2BRS( desiredBR );
+        ret = rfalNfcDepPSL( rfalNfcDepDx2BRS( PSL_BR ), PSL_FSL );
         
-            nfcipLogI( " NFCIP(I) BR differ, PSL BR: 0x%02X \r\n", PSL_BRS );
+        if( nfcipIsTransmissionError(ret) )
+        {
+            continue;
         }
+        break;
     }
-
+    while( (maxRetyrs--) != 0U );
     
-    /*******************************************************************************/
-    if( sendPSL )
+    if( ret != ERR_NONE )
     {
-        /* Apply target's FWT for PSL_REQ        Digital 2.2  17.11.2.5 */
-        gNfcip.cfg.fwt = nfcDepDev->info.FWT;
+        nfcipLogI( " NFCIP(I) PSL BR: %d failed: %d \r\n", PSL_BR, ret );
         
-        /*******************************************************************************/
-        /* Send PSL REQ and wait for response                                          */
-        /*******************************************************************************/
-        EXIT_ON_ERR( ret, rfalNfcDepPSL(PSL_BRS, PSL_FSL) );
-        
-        /* Check if bit rate has been changed */
-        if( nfcDepDev->info.DSI != desiredBR )
+        /* Link state unknown, fail the activation and use a lower bit rate on the next one */
+        if( PSL_BR > nfcDepDev->info.DSI )
         {
-            /* Check if device was in Passive NFC-A and went to higher bit rates, use NFC-F */
-            if( (nfcDepDev->info.DSI == RFAL_BR_106) && (gNfcip.cfg.commMode == RFAL_NFCDEP_COMM_PASSIVE) )
-            {
-                
-            #if RFAL_FEATURE_NFCF 
-                /* If Passive initialize NFC-F module */
-                rfalNfcfPollerInitialize( desiredBR );
-            #else /* RFAL_FEATURE_NFCF */
-                return ERR_NOTSUPP;
-            #endif /* RFAL_FEATURE_NFCF */
-                
-            }
-            
-            nfcDepDev->info.DRI  = desiredBR;  /* DSI Bit Rate coding from Initiator  to Target  */
-            nfcDepDev->info.DSI  = desiredBR;  /* DRI Bit Rate coding from Target to Initiator   */
-            
-            rfalSetBitRate( nfcDepDev->info.DSI, nfcDepDev->info.DRI );
+            gNfcipPslMaxBR = (rfalBitRate)((uint8_t)PSL_BR - 1U);   /* PRQA S 4342 # MISRA 10.5 - PSL_BR above the current bit rate */
         }
-        
-        
-        return ERR_NONE;   /* PSL has been sent    */
+        return ret;
+    }
+    
+    nfcipLogI( " NFCIP(I) PSL BR: %d LR: %d \r\n", PSL_BR, PSL_FSL );
+    
+    /* Check if device was in Passive NFC-A and went to higher bit rates, use NFC-F */
+    if( (nfcDepDev->info.DSI == RFAL_BR_106) && (PSL_BR != RFAL_BR_106) && (gNfcip.cfg.commMode == RFAL_NFCDEP_COMM_PASSIVE) )
+    {
+    #if RFAL_FEATURE_NFCF 
+        /* If Passive initialize NFC-F module */
+        rfalNfcfPollerInitialize( PSL_BR );
+    #endif /* RFAL_FEATURE_NFCF */
     }
     
-    return ERR_NONE;       /* No PSL has been sent */
+    nfcDepDev->info.DRI  = PSL_BR;  /* DSI Bit Rate coding from Initiator  to Target  */
+    nfcDepDev->info.DSI  = PSL_BR;  /* DRI Bit Rate coding from Target to Initiator   */
+    nfcDepDev->info.LR   = PSL_FSL;
+    nfcDepDev->info.FS   = rfalNfcDepLR2FS( nfcDepDev->info.LR );
+    
+    gNfcip.cfg.lr = nfcDepDev->info.LR;                /* Update nfcip LR  to be used */
+    gNfcip.fsc    = nfcDepDev->info.FS;                /* Update nfcip FSC to be used */
+    
+    rfalSetBitRate( nfcDepDev->info.DSI, nfcDepDev->info.DRI );
+    
+    return ERR_NONE;   /* PSL has been sent    */
 }
 
 
@@ -2583,6 +2660,18 @@ ReturnCode rfalNfcDepGetTransceiveStatus( void )
 
 
 
+/*******************************************************************************/
+static uint16_t nfcipMaxInfLen( uint16_t FSx, uint8_t DID )
+{
+    uint16_t maxInfLen;
+    
+    maxInfLen  = (FSx - (RFAL_NFCDEP_HEADER + RFAL_NFCDEP_DEP_PFB_LEN));
+    maxInfLen += ((DID != RFAL_NFCDEP_DID_NO) ? RFAL_NFCDEP_DID_LEN : 0U);
+    
+    return maxInfLen;
+}
+
+
  /*******************************************************************************/
  static void rfalNfcDepPdu2BLockParam( rfalNfcDepPduTxRxParam pduParam, rfalNfcDepTxRxParam *blockParam, uint16_t txPos, uint16_t rxPos )
 {
@@ -2596,8 +2685,7 @@ ReturnCode rfalNfcDepGetTransceiveStatus( void )
     blockParam->dFWT   = pduParam.dFWT;
 
     /* Calculate max INF/Payload to be sent to other device */
-    maxInfLen  = (blockParam->FSx - (RFAL_NFCDEP_HEADER + RFAL_NFCDEP_DEP_PFB_LEN));
-    maxInfLen += ((blockParam->DID != RFAL_NFCDEP_DID_NO) ? RFAL_NFCDEP_DID_LEN : 0U);
+    maxInfLen  = nfcipMaxInfLen( blockParam->FSx, blockParam->DID );
 
 
     if( (pduParam.txBufLen - txPos) > maxInfLen )
@@ -2717,4 +2805,109 @@ ReturnCode rfalNfcDepGetPduTransceiveStatus( void )
  }
 
 
+/*******************************************************************************/
+/* Pulls the next PDU chunk from the producer and sends it as one block       */
+static ReturnCode rfalNfcDepPduStreamNextTx( void )
+{
+    ReturnCode          ret;
+    rfalNfcDepTxRxParam txRxParam;
+    uint16_t            maxLen;
+    uint16_t            len;
+    bool                more;
+    
+    len    = 0;
+    more   = false;
+    maxLen = (uint16_t)MIN( nfcipMaxInfLen( gNfcip.streamParam.FSx, gNfcip.streamParam.DID ), RFAL_FEATURE_NFC_DEP_BLOCK_MAX_LEN );
+    
+    EXIT_ON_ERR( ret, gNfcip.streamParam.txCb( gNfcip.streamParam.ctx, gNfcip.streamParam.txBuf->inf, maxLen, &len, &more ) );
+    
+    if( len > maxLen )
+    {
+        return ERR_PARAM;
+    }
+    
+    txRxParam.txBuf        = gNfcip.streamParam.txBuf;
+    txRxParam.txBufLen     = len;
+    txRxParam.isTxChaining = more;
+    txRxParam.rxBuf        = gNfcip.streamParam.rxBuf;
+    txRxParam.rxLen        = &gNfcip.streamBlkLen;
+    txRxParam.isRxChaining = &gNfcip.isPDURxChaining;
+    txRxParam.DID          = gNfcip.streamParam.DID;
+    txRxParam.FSx          = gNfcip.streamParam.FSx;
+    txRxParam.FWT          = gNfcip.streamParam.FWT;
+    txRxParam.dFWT         = gNfcip.streamParam.dFWT;
+    
+    return rfalNfcDepStartTransceive( &txRxParam );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcDepStartPduStream( rfalNfcDepPduStreamParam param )
+{
+    if( (param.txCb == NULL) || (param.rxCb == NULL) || (param.txBuf == NULL) || (param.rxBuf == NULL) || (param.txBuf == param.rxBuf) ||
+        (param.FSx <= (RFAL_NFCDEP_HEADER + RFAL_NFCDEP_DEP_PFB_LEN)) )
+    {
+        return ERR_PARAM;
+    }
+    
+    /* Initialize and store PDU Stream context */
+    gNfcip.streamParam  = param;
+    gNfcip.streamRxPos  = 0;
+    gNfcip.streamBlkLen = 0;
+    
+    return rfalNfcDepPduStreamNextTx();
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcDepGetPduStreamStatus( void )
+{
+    ReturnCode ret;
+    ReturnCode cbRet;
+    
+    ret = rfalNfcDepGetTransceiveStatus();
+    switch( ret )
+    {
+        /*******************************************************************************/
+        case ERR_NONE:
+            
+            /* Check if we are still doing chaining on Tx */
+            if( gNfcip.isTxChaining )
+            {
+                EXIT_ON_ERR( ret, rfalNfcDepPduStreamNextTx() );
+                return ERR_BUSY;
+            }
+            
+            /* PDU TxRx is done */
+            /* fall through */
+        
+        /*******************************************************************************/
+        case ERR_AGAIN:        /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
+            
+            gNfcip.streamRxPos += gNfcip.streamBlkLen;
+            if( gNfcip.streamParam.rxLen != NULL )
+            {
+                *gNfcip.streamParam.rxLen = gNfcip.streamRxPos;
+            }
+            
+            /* Hand the block to the consumer before the following one is received */
+            cbRet = gNfcip.streamParam.rxCb( gNfcip.streamParam.ctx, gNfcip.streamParam.rxBuf->inf, gNfcip.streamBlkLen, (ret == ERR_NONE) );
+            if( cbRet != ERR_NONE )
+            {
+                return cbRet;
+            }
+            
+            /* Wait for following block or PDU TxRx has finished */
+            return ((ret == ERR_AGAIN) ? ERR_BUSY : ERR_NONE);
+        
+        /*******************************************************************************/
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+    
+    return ret;
+}
+
+
 #endif /* RFAL_FEATURE_NFC_DEP */
@@ -82,6 +82,14 @@
 
 #define RFAL_NFCA_T_RETRANS         5U                    /*!< t RETRANSMISSION [3, 33]ms   EMVCo 2.6  A.5      */
 #define RFAL_NFCA_N_RETRANS         2U                    /*!< Number of retries            EMVCo 2.6  9.6.1.3  */
+
+#ifndef RFAL_NFCA_CR_PIPELINE
+    #define RFAL_NFCA_CR_PIPELINE   true                  /*!< Resolve all devices on a single call keeping the collision tree */
+#endif /* RFAL_NFCA_CR_PIPELINE */
+
+#ifndef RFAL_NFCA_CR_COLL_STACK_LEN
+    #define RFAL_NFCA_CR_COLL_STACK_LEN 16U               /*!< Unexplored collision points kept on the collision tree          */
+#endif /* RFAL_NFCA_CR_COLL_STACK_LEN */
  
 
 /*! SDD_REQ (Select) Cascade Levels  */
@@ -108,6 +116,7 @@ enum
 #define rfalNfcaSelPar( nBy, nbi )         (uint8_t)((((nBy)<<4U) & 0xF0U) | ((nbi)&0x0FU) )         /*!< Calculates SEL_PAR with the bytes/bits to be sent */
 #define rfalNfcaCLn2SELCMD( cl )           (uint8_t)((uint8_t)(RFAL_NFCA_CMD_SEL_CL1) + (2U*(cl)))   /*!< Calculates SEL_CMD with the given cascade level   */
 #define rfalNfcaNfcidLen2CL( len )         ((len) / 5U)                                              /*!< Calculates cascade level by the NFCID length      */
+#define rfalNfcaCRIsWaiting()              ((gNfca.CR.tmrFDT != 0U) && !platformTimerIsExpired( gNfca.CR.tmrFDT ))  /*!< Checks if waiting to retransmit */
 
 /*
 ******************************************************************************
@@ -125,6 +134,14 @@ typedef enum{
 }rfalNfcaColResState;
 
 
+/*! Collision point: bit of the SDD_REQ where a collision took place, the branch with the bit set to Zero is still unexplored */
+typedef struct{
+    uint8_t               cascadeLv;       /*!< Cascade Level of the collision                          */
+    uint8_t               bytesTxRx;       /*!< Byte of the collision (within SDD_REQ)                  */
+    uint8_t               bitsTxRx;        /*!< Bit of the collision                                    */
+}rfalNfcaCollPoint;
+
+
 /*! Colission Resolution context */
 typedef struct{
     uint8_t               devLimit;        /*!< Device limit to be used                                 */
@@ -147,6 +164,13 @@ typedef struct{
     uint8_t               retries;          /*!< Retries to be performed upon a timeout error (Single CR)*/
     uint8_t               backtrackCnt;     /*!< Backtrack retries (Single CR)                           */
     bool                  doBacktrack;      /*!< Backtrack flag (Single CR)                              */
+    
+    rfalNfcaSelReq        pathSel[RFAL_NFCA_CASCADE_3_UID_LEN / RFAL_NFCA_CASCADE_1_UID_LEN + 1U]; /*!< SEL_REQ per Cascade Level of the last device (Full CR) */
+    rfalNfcaCollPoint     collStack[RFAL_NFCA_CR_COLL_STACK_LEN]; /*!< Unexplored collision points, deepest on top (Full CR) */
+    uint8_t               collCnt;          /*!< Number of unexplored collision points (Full CR)          */
+    rfalNfcaCollPoint     resume;           /*!< Collision point being resumed (Full CR)                  */
+    uint8_t               resumeLv;         /*!< Cascade Levels below are selected directly (Full CR)     */
+    bool                  isResumed;        /*!< Resuming from a collision point (Full CR)                */
 }rfalNfcaColResParams;
 
 
@@ -178,6 +202,9 @@ static rfalNfca gNfca;  /*!< RFAL NFC-A instance  */
 static uint8_t    rfalNfcaCalculateBcc( const uint8_t* buf, uint8_t bufLen );
 static ReturnCode rfalNfcaPollerStartSingleCollisionResolution( uint8_t devLimit, bool *collPending, rfalNfcaSelRes *selRes, uint8_t *nfcId1, uint8_t *nfcId1Len );
 static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void );
+static ReturnCode rfalNfcaPollerGetFullCollisionResolutionStep( void );
+static void       rfalNfcaCollTreeResume( void );
+static ReturnCode rfalNfcaCollTreeRestart( void );
 
 /*
  ******************************************************************************
@@ -232,15 +259,57 @@ static ReturnCode rfalNfcaPollerStartSingleCollisionResolution( uint8_t devLimit
     gNfca.CR.doBacktrack  = false;
     gNfca.CR.backtrackCnt = 3U;
     
+    gNfca.CR.resumeLv     = (uint8_t)RFAL_NFCA_SEL_CASCADE_L1;
+    gNfca.CR.isResumed    = false;
+    
     return ERR_NONE;
 }
 
 
+/*******************************************************************************/
+static void rfalNfcaCollTreeResume( void )
+{
+    if( gNfca.CR.collCnt == 0U )
+    {
+        return;
+    }
+    
+    /* Explore the deepest branch left: Cascade Levels above it are shared with the last device and selected directly */
+    gNfca.CR.collCnt--;
+    gNfca.CR.resume    = gNfca.CR.collStack[gNfca.CR.collCnt];
+    gNfca.CR.resumeLv  = gNfca.CR.resume.cascadeLv;
+    gNfca.CR.isResumed = true;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalNfcaCollTreeRestart( void )
+{
+    rfalNfcaSensRes sensRes;
+    
+    /* Branch no longer answers (e.g. device removed), forget the tree and restart from the first Cascade Level */
+    gNfca.CR.collCnt    = 0;
+    gNfca.CR.resumeLv   = (uint8_t)RFAL_NFCA_SEL_CASCADE_L1;
+    gNfca.CR.isResumed  = false;
+    gNfca.CR.cascadeLv  = (uint8_t)RFAL_NFCA_SEL_CASCADE_L1;
+    gNfca.CR.state      = RFAL_NFCA_CR_CL;
+    *gNfca.CR.nfcId1Len = 0;
+    
+    /* Devices not matching a direct SEL_REQ went back to IDLE */
+    return rfalNfcaPollerCheckPresence( RFAL_14443A_SHORTFRAME_CMD_REQA, &sensRes );
+}
+
+
 /*******************************************************************************/
 static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
 {
     ReturnCode ret;
     uint8_t    collBit = 1U;  /* standards mandate or recommend collision bit to be set to One. */
+    bool       isBccColl;
+    uint8_t    *sel;
+    
+    isBccColl = false;
+    sel       = (uint8_t*)&gNfca.CR.selReq;
     
     
     /* Check if FDT timer is still running */
@@ -261,11 +330,38 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
         /*******************************************************************************/
         case RFAL_NFCA_CR_CL:
             
-            /* Initialize the SDD_REQ to send for the new cascade level */
-            ST_MEMSET( (uint8_t*)&gNfca.CR.selReq, 0x00, sizeof(rfalNfcaSelReq) );
-        
-            gNfca.CR.bytesTxRx = RFAL_NFCA_SDD_REQ_LEN;
-            gNfca.CR.bitsTxRx  = 0U;
+            /* Cascade Level shared with the branch being resumed, select it right away */
+            if( gNfca.CR.cascadeLv < gNfca.CR.resumeLv )
+            {
+                gNfca.CR.selReq  = gNfca.CR.pathSel[gNfca.CR.cascadeLv];
+                gNfca.CR.retries = RFAL_NFCA_N_RETRANS;
+                gNfca.CR.state   = RFAL_NFCA_CR_SEL;
+                break;
+            }
+            
+            if( gNfca.CR.isResumed )
+            {
+                /* Resume the anticollision from the collision point, taking the unexplored branch (bit Zero) */
+                gNfca.CR.selReq    = gNfca.CR.pathSel[gNfca.CR.cascadeLv];
+                sel[gNfca.CR.resume.bytesTxRx] &= (uint8_t)((1U << gNfca.CR.resume.bitsTxRx) - 1U);
+                ST_MEMSET( &sel[(gNfca.CR.resume.bytesTxRx + 1U)], 0x00, (sizeof(rfalNfcaSelReq) - (gNfca.CR.resume.bytesTxRx + 1U)) );
+                
+                gNfca.CR.bytesTxRx = gNfca.CR.resume.bytesTxRx;
+                gNfca.CR.bitsTxRx  = (gNfca.CR.resume.bitsTxRx + 1U);
+                if( gNfca.CR.bitsTxRx == RFAL_BITS_IN_BYTE )
+                {
+                    gNfca.CR.bitsTxRx = 0;
+                    gNfca.CR.bytesTxRx++;
+                }
+            }
+            else
+            {
+                /* Initialize the SDD_REQ to send for the new cascade level */
+                ST_MEMSET( (uint8_t*)&gNfca.CR.selReq, 0x00, sizeof(rfalNfcaSelReq) );
+            
+                gNfca.CR.bytesTxRx = RFAL_NFCA_SDD_REQ_LEN;
+                gNfca.CR.bitsTxRx  = 0U;
+            }
             gNfca.CR.state     = RFAL_NFCA_CR_SDD;
         
             /* fall through */
@@ -289,6 +385,14 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                 break;
             }
             
+            /* The resumed branch does not answer, restart the anticollision */
+            if( (ret == ERR_TIMEOUT) && gNfca.CR.isResumed )
+            {
+                EXIT_ON_ERR( ret, rfalNfcaCollTreeRestart() );
+                break;
+            }
+            gNfca.CR.isResumed = false;
+            
             /* Covert rxLen into bytes */
             gNfca.CR.rxLen = rfalConvBitsToBytes( gNfca.CR.rxLen );
             
@@ -318,6 +422,13 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                 collBit = (uint8_t)((0U==collBit)?1U:0U); // invert the collision bit
                 gNfca.CR.doBacktrack = true;
                 gNfca.CR.backtrackCnt--;
+                
+                /* The branch is being explored now, drop it from the collision tree */
+                if( (gNfca.CR.collCnt > 0U) && (gNfca.CR.collStack[gNfca.CR.collCnt - 1U].cascadeLv == gNfca.CR.cascadeLv) &&
+                    (gNfca.CR.collStack[gNfca.CR.collCnt - 1U].bytesTxRx == gNfca.CR.bytesTxRx) && (gNfca.CR.collStack[gNfca.CR.collCnt - 1U].bitsTxRx == gNfca.CR.bitsTxRx) )
+                {
+                    gNfca.CR.collCnt--;
+                }
             }
             else
             {
@@ -338,6 +449,7 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                     gNfca.CR.bytesTxRx = RFAL_NFCA_CASCADE_1_UID_LEN + RFAL_NFCA_SDD_REQ_LEN - 1U;
                     gNfca.CR.bitsTxRx = 7;
                     collBit = (uint8_t)( ((uint8_t*)&gNfca.CR.selReq)[gNfca.CR.bytesTxRx] & (1U << gNfca.CR.bitsTxRx) ); /* Not a real collision, extract the actual bit for the subsequent code */
+                    isBccColl = true;
                 }
                 
                 if( (gNfca.CR.devLimit == 0U) && !(*gNfca.CR.collPend) )
@@ -350,6 +462,15 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                 
                 *gNfca.CR.collPend = true;
                 
+                /* Remember the branch not taken (bit Zero) to resume the next device from it */
+                if( !gNfca.CR.doBacktrack && !isBccColl && (collBit != 0U) && (gNfca.CR.collCnt < RFAL_NFCA_CR_COLL_STACK_LEN) )
+                {
+                    gNfca.CR.collStack[gNfca.CR.collCnt].cascadeLv = gNfca.CR.cascadeLv;
+                    gNfca.CR.collStack[gNfca.CR.collCnt].bytesTxRx = gNfca.CR.bytesTxRx;
+                    gNfca.CR.collStack[gNfca.CR.collCnt].bitsTxRx  = gNfca.CR.bitsTxRx;
+                    gNfca.CR.collCnt++;
+                }
+                
                 /* Set and select the collision bit, with the number of bytes/bits successfully TxRx */
                 if (collBit != 0U)
                 {
@@ -394,6 +515,7 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
             /*******************************************************************************/
             /* Anticollision OK, Select this Cascade Level */
             gNfca.CR.selReq.selPar = RFAL_NFCA_SEL_SELPAR;
+            gNfca.CR.pathSel[gNfca.CR.cascadeLv] = gNfca.CR.selReq;
             
             gNfca.CR.retries = RFAL_NFCA_N_RETRANS;
             gNfca.CR.state   = RFAL_NFCA_CR_SEL;
@@ -414,6 +536,13 @@ static ReturnCode rfalNfcaPollerGetSingleCollisionResolutionStatus( void )
                 break;
             }
             
+            /* The resumed branch does not answer, restart the anticollision */
+            if( (ret == ERR_TIMEOUT) && (gNfca.CR.cascadeLv < gNfca.CR.resumeLv) )
+            {
+                EXIT_ON_ERR( ret, rfalNfcaCollTreeRestart() );
+                break;
+            }
+            
             if( ret != ERR_NONE )
             {
                 return ret;
@@ -485,12 +614,30 @@ ReturnCode rfalNfcaPollerInitialize( void )
 ReturnCode rfalNfcaPollerCheckPresence( rfal14443AShortFrameCmd cmd, rfalNfcaSensRes *sensRes )
 {
     ReturnCode ret;
-    uint16_t   rcvLen;
     
+    EXIT_ON_ERR( ret, rfalNfcaPollerStartCheckPresence( cmd, sensRes ) );
+    rfalRunBlocking( ret, rfalNfcaPollerGetCheckPresenceStatus() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcaPollerStartCheckPresence( rfal14443AShortFrameCmd cmd, rfalNfcaSensRes *sensRes )
+{
     /* Digital 1.1 6.10.1.3  For Commands ALL_REQ, SENS_REQ, SDD_REQ, and SEL_REQ, the NFC Forum Device      *
      *              MUST treat receipt of a Listen Frame at a time after FDT(Listen, min) as a Timeour Error */
     
-    ret = rfalISO14443ATransceiveShortFrame(  cmd, (uint8_t*)sensRes, (uint8_t)rfalConvBytesToBits(sizeof(rfalNfcaSensRes)), &rcvLen, RFAL_NFCA_FDTMIN  );
+    return rfalISO14443AStartTransceiveShortFrame( cmd, (uint8_t*)sensRes, (uint8_t)rfalConvBytesToBits(sizeof(rfalNfcaSensRes)), &gNfca.CR.rxLen, RFAL_NFCA_FDTMIN );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcaPollerGetCheckPresenceStatus( void )
+{
+    ReturnCode ret;
+    
+    ret = rfalISO14443AGetTransceiveShortFrameStatus();
     if( (ret == ERR_RF_COLLISION) || (ret == ERR_CRC)  || (ret == ERR_NOMEM) || (ret == ERR_FRAMING) || (ret == ERR_PAR) )
     {
        ret = ERR_NONE;
@@ -582,6 +729,7 @@ ReturnCode rfalNfcaPollerStartFullCollisionResolution( rfalComplianceMode compMo
     gNfca.CR.devLimit    = devLimit;
     gNfca.CR.nfcaDevList = nfcaDevList;
     gNfca.CR.compMode    = compMode;
+    gNfca.CR.collCnt     = 0;
     
     
     #if RFAL_FEATURE_T1T
@@ -611,6 +759,22 @@ ReturnCode rfalNfcaPollerStartFullCollisionResolution( rfalComplianceMode compMo
 
 /*******************************************************************************/
 ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
+{
+    ReturnCode ret;
+    
+    /* Issue the next SDD_REQ/SEL_REQ right away, only yield while waiting to retransmit */
+    do
+    {
+        ret = rfalNfcaPollerGetFullCollisionResolutionStep();
+    }
+    while( ((bool)RFAL_NFCA_CR_PIPELINE) && (ret == ERR_BUSY) && !rfalNfcaCRIsWaiting() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalNfcaPollerGetFullCollisionResolutionStep( void )
 {
     ReturnCode ret;
     uint8_t    newDevType;
@@ -630,7 +794,15 @@ ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
     
     
     /*******************************************************************************/
-    EXIT_ON_ERR( ret, rfalNfcaPollerGetSingleCollisionResolutionStatus() );
+    ret = rfalNfcaPollerGetSingleCollisionResolutionStatus();
+    if( ((bool)RFAL_NFCA_CR_PIPELINE) && (ret == ERR_TIMEOUT) && (*gNfca.CR.devCnt > 0U) )
+    {
+        return ERR_NONE;                                 /* Collision tree points no longer answer, keep the ones resolved */
+    }
+    if( ret != ERR_NONE )
+    {
+        return ret;
+    }
 
     /* Assign Listen Device */
     newDevType = ((uint8_t)gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].selRes.sak) & RFAL_NFCA_SEL_RES_CONF_MASK;  /* MISRA 10.8 */
@@ -639,7 +811,12 @@ ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
     gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].isSleep = false;
     (*gNfca.CR.devCnt)++;
 
-    
+    /* Branches left on the collision tree are devices still to be resolved, even if none collided on this one */
+    if( ((bool)RFAL_NFCA_CR_PIPELINE) && (gNfca.CR.collCnt != 0U) )
+    {
+        gNfca.CR.collPending = true;
+    }
+
     /* If a collision was detected and device counter is lower than limit  Activity 1.1  9.3.4.21 */
     if( (*gNfca.CR.devCnt < gNfca.CR.devLimit) && (gNfca.CR.collPending) )
     {
@@ -677,6 +854,11 @@ ReturnCode rfalNfcaPollerGetFullCollisionResolutionStatus( void )
                                                                          &gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].selRes, 
                                                                          (uint8_t*)&gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].nfcId1, 
                                                                          &gNfca.CR.nfcaDevList[*gNfca.CR.devCnt].nfcId1Len ) );
+        
+        if( (bool)RFAL_NFCA_CR_PIPELINE )
+        {
+            rfalNfcaCollTreeResume();                    /* Continue from the collision tree instead of from scratch */
+        }
     
         return ERR_BUSY;
     }
@@ -47,6 +47,10 @@
     #define RFAL_FEATURE_NFCB   false    /* NFC-B module configuration missing. Disabled by default */
 #endif
 
+#ifndef RFAL_FEATURE_ADAPTIVE_COLL_RES
+    #define RFAL_FEATURE_ADAPTIVE_COLL_RES   false    /* Adaptive collision resolution configuration missing. Disabled by default */
+#endif
+
 #if RFAL_FEATURE_NFCB
 
 /*
@@ -97,7 +101,10 @@ typedef struct{
     uint8_t               curSlotNum;      /*!< Current Slot number (whithin slotted loop)          */
     uint8_t               endSlots;        /*!< Maximum number of slots allowed                     */
     uint8_t               curDevCnt;       /*!< Current device counter (per slotted loop)           */
+    uint8_t               curCollCnt;      /*!< Current collided slots counter (per slotted loop)   */
     bool                  colPend;         /*!< Internal Collision pending flag                     */
+    rfalNfcbColResStats   stats;           /*!< Collision Resolution statistics                     */
+    uint32_t              startCyc;        /*!< Collision Resolution start (HW cycles)              */
     uint32_t              tmr;             /*!< Collision Resolution timer                          */
     rfalNfcbColResState   state;           /*!< Collision Resolution state                          */
 }rfalNfcbColResParams;
@@ -152,6 +159,10 @@ typedef struct
     uint8_t              AFI;                /*!< AFI to be used       */
     uint8_t              PARAM;              /*!< PARAM to be used     */
     rfalNfcbColResParams CR;                 /*!< Collision Resolution */
+    
+    rfalNfcbSensbRes     *sensbRes;          /*!< Location of the SENSB_RES (Check Presence)        */
+    uint8_t              *sensbResLen;       /*!< Location of the SENSB_RES length (Check Presence) */
+    uint16_t             rxLen;              /*!< Received length (Check Presence)                  */
 } rfalNfcb;
 
 /*
@@ -161,6 +172,9 @@ typedef struct
 */
 static ReturnCode rfalNfcbCheckSensbRes( const rfalNfcbSensbRes *sensbRes, uint8_t sensbResLen );
 static ReturnCode rfalNfcbPollerSleepTx( const uint8_t* nfcid0 );
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+static uint8_t    rfalNfcbCollResNextSlots( void );
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
 
 
 /*
@@ -237,8 +251,18 @@ ReturnCode rfalNfcbPollerInitializeWithParams( uint8_t AFI, uint8_t PARAM )
 /*******************************************************************************/
 ReturnCode rfalNfcbPollerCheckPresence( rfalNfcbSensCmd cmd, rfalNfcbSlots slots, rfalNfcbSensbRes *sensbRes, uint8_t *sensbResLen )
 {
-    uint16_t         rxLen;
-    ReturnCode       ret;
+    ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalNfcbPollerStartCheckPresence( cmd, slots, sensbRes, sensbResLen ) );
+    rfalRunBlocking( ret, rfalNfcbPollerGetCheckPresenceStatus() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerStartCheckPresence( rfalNfcbSensCmd cmd, rfalNfcbSlots slots, rfalNfcbSensbRes *sensbRes, uint8_t *sensbResLen )
+{
     rfalNfcbSensbReq sensbReq;
     
 
@@ -252,27 +276,44 @@ ReturnCode rfalNfcbPollerCheckPresence( rfalNfcbSensCmd cmd, rfalNfcbSlots slots
     *sensbResLen = 0;
     ST_MEMSET(sensbRes, 0x00, sizeof(rfalNfcbSensbRes) );
     
+    gRfalNfcb.sensbRes    = sensbRes;
+    gRfalNfcb.sensbResLen = sensbResLen;
+    gRfalNfcb.rxLen       = 0;
+    
     /* Compute SENSB_REQ */
     sensbReq.cmd   = RFAL_NFCB_CMD_SENSB_REQ;
     sensbReq.AFI   = gRfalNfcb.AFI;
     sensbReq.PARAM = (((uint8_t)gRfalNfcb.PARAM & RFAL_NFCB_SENSB_REQ_PARAM) | (uint8_t)cmd | (uint8_t)slots);
     
     /* Send SENSB_REQ and disable AGC to detect collisions */
-    ret = rfalTransceiveBlockingTxRx( (uint8_t*)&sensbReq, sizeof(rfalNfcbSensbReq), (uint8_t*)sensbRes, sizeof(rfalNfcbSensbRes), &rxLen, RFAL_TXRX_FLAGS_DEFAULT, RFAL_NFCB_FWTSENSB );
+    return rfalTransceiveBlockingTx( (uint8_t*)&sensbReq, sizeof(rfalNfcbSensbReq), (uint8_t*)sensbRes, sizeof(rfalNfcbSensbRes), &gRfalNfcb.rxLen, RFAL_TXRX_FLAGS_DEFAULT, RFAL_NFCB_FWTSENSB );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerGetCheckPresenceStatus( void )
+{
+    ReturnCode ret;
     
-    *sensbResLen = (uint8_t)rxLen;
+    ret = rfalGetTransceiveStatus();
+    if( ret == ERR_BUSY )
+    {
+        return ret;
+    }
+    
+    *gRfalNfcb.sensbResLen = (uint8_t)gRfalNfcb.rxLen;
     
     /*  Check if a transmission error was detected */
     if( (ret == ERR_CRC) || (ret == ERR_FRAMING) )
     {
         /* Invalidate received frame as an error was detected (CollisionResolution checks if valid) */
-        *sensbResLen = 0;
+        *gRfalNfcb.sensbResLen = 0;
         return ERR_NONE;
     }
     
     if( ret == ERR_NONE )
     {
-        return rfalNfcbCheckSensbRes( sensbRes, *sensbResLen );
+        return rfalNfcbCheckSensbRes( gRfalNfcb.sensbRes, *gRfalNfcb.sensbResLen );
     }
     
     return ret;
@@ -304,6 +345,35 @@ static ReturnCode rfalNfcbPollerSleepTx( const uint8_t* nfcid0 )
 }
 
 
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+/*******************************************************************************/
+/* Estimates the number of slots (as NI) for the next slotted round. Devices
+ * found are put to sleep, only the ones behind collided slots answer again.
+ * A number of slots close to the number of devices minimises the rounds.      */
+static uint8_t rfalNfcbCollResNextSlots( void )
+{
+    uint16_t backlog;
+    uint8_t  ni;
+    
+    backlog = rfalCollResBacklog( gRfalNfcb.CR.curCollCnt );
+    
+    ni = (uint8_t)RFAL_NFCB_SLOT_NUM_1;
+    while( ((uint16_t)rfalNfcbNI2NumberOfSlots( ni ) < backlog) && (ni < gRfalNfcb.CR.endSlots) )
+    {
+        ni++;
+    }
+    
+    /* Nothing identified on this round, ensure the next one is larger */
+    if( (gRfalNfcb.CR.curDevCnt == 0U) && (ni <= gRfalNfcb.CR.curSlots) )
+    {
+        ni = (gRfalNfcb.CR.curSlots + 1U);
+    }
+    
+    return ni;
+}
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
+
+
 /*******************************************************************************/
 ReturnCode rfalNfcbPollerSleep( const uint8_t* nfcid0 )
 {
@@ -430,8 +500,11 @@ ReturnCode rfalNfcbPollerStartSlottedCollisionResolution( rfalComplianceMode com
     gRfalNfcb.CR.devCnt      = devCnt;
     (*gRfalNfcb.CR.devCnt)   = 0U;
     gRfalNfcb.CR.curDevCnt   = 0U;
+    gRfalNfcb.CR.curCollCnt  = 0U;
     gRfalNfcb.CR.curSlotNum  = 0U;
     gRfalNfcb.CR.tmr         = 0U;
+    gRfalNfcb.CR.startCyc    = platformGetCycles();
+    ST_MEMSET( &gRfalNfcb.CR.stats, 0x00, sizeof(rfalNfcbColResStats) );
     
     gRfalNfcb.CR.state = RFAL_NFCB_CR_SLOTS;
     return ERR_NONE;
@@ -476,6 +549,13 @@ ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
                 ret = rfalNfcbPollerSlotMarker( gRfalNfcb.CR.curSlotNum, &gRfalNfcb.CR.nfcbDevList[*gRfalNfcb.CR.devCnt].sensbRes, &gRfalNfcb.CR.nfcbDevList[*gRfalNfcb.CR.devCnt].sensbResLen );
             }
             
+            if( gRfalNfcb.CR.curSlotNum == 0U )
+            {
+                gRfalNfcb.CR.stats.rounds++;
+            }
+            gRfalNfcb.CR.stats.slots++;
+            gRfalNfcb.CR.stats.airTime = platformCyclesToUs( platformGetCycles() - gRfalNfcb.CR.startCyc );
+            
             /*******************************************************************************/
             if( gRfalNfcb.CR.compMode == RFAL_COMPLIANCE_MODE_EMV )
             {
@@ -561,6 +641,8 @@ ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
                     
                     /* Activity 2.1  9.3.5.9  -  Symbol 8 */
                     (*gRfalNfcb.CR.colPending) = true;
+                    gRfalNfcb.CR.curCollCnt++;
+                    gRfalNfcb.CR.stats.collisions++;
                 }
             }
             
@@ -577,6 +659,21 @@ ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
                     break;
                 }
                 
+            #if RFAL_FEATURE_ADAPTIVE_COLL_RES
+                /* Size the next round on the estimated devices left instead of growing one step at a time */
+                if( gRfalNfcb.CR.compMode == RFAL_COMPLIANCE_MODE_NFC )
+                {
+                    if( (gRfalNfcb.CR.curDevCnt == 0U) && (gRfalNfcb.CR.curSlots >= gRfalNfcb.CR.endSlots) )
+                    {
+                        break;
+                    }
+                    
+                    gRfalNfcb.CR.curSlots = rfalNfcbCollResNextSlots();
+                    gRfalNfcb.CR.state    = RFAL_NFCB_CR_SLEEP;
+                    return ERR_BUSY;
+                }
+            #endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
+                
                 /* Activity 1.1  9.3.5.18  -  Symbol 17 */
                 if( gRfalNfcb.CR.curDevCnt == 0U )
                 {
@@ -611,6 +708,7 @@ ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
             /* Activity 2.1  9.3.5.6  -  Symbol 5 */
             gRfalNfcb.CR.curSlotNum    = 0U;
             gRfalNfcb.CR.curDevCnt     = 0U;
+            gRfalNfcb.CR.curCollCnt    = 0U;
             (*gRfalNfcb.CR.colPending) = false;
 
             gRfalNfcb.CR.state = RFAL_NFCB_CR_SLOTS;
@@ -627,6 +725,19 @@ ReturnCode rfalNfcbPollerGetCollisionResolutionStatus( void )
 }
 
 
+/*******************************************************************************/
+ReturnCode rfalNfcbPollerGetCollisionResolutionStats( rfalNfcbColResStats *stats )
+{
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    (*stats) = gRfalNfcb.CR.stats;
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 uint32_t rfalNfcbTR2ToFDT( uint8_t tr2Code )
 {
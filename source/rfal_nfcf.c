@@ -50,6 +50,10 @@
     #define RFAL_FEATURE_NFCF   false    /* NFC-F module configuration missing. Disabled by default */
 #endif
 
+#ifndef RFAL_FEATURE_ADAPTIVE_COLL_RES
+    #define RFAL_FEATURE_ADAPTIVE_COLL_RES   false    /* Adaptive collision resolution configuration missing. Disabled by default */
+#endif
+
 #if RFAL_FEATURE_NFCF
 
 /*
@@ -77,6 +81,8 @@
 */
 #define RFAL_NFCF_MRT_CHECK_UPDATE   ((4096 * (8 + (15 * 8)) * 64 ) + 16)
 
+#define RFAL_NFCF_CR_MAX_ROUNDS      4U     /*!< Max polling rounds on adaptive Collision Resolution  */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -135,6 +141,10 @@ typedef struct{
     bool                  collPending;     /*!< Collision pending flag                                  */
     bool                  nfcDepFound;
     rfalNfcFColResState   state;            /*!< Single Collision Resolution state (Single CR)           */
+    bool                  isPollSc;         /*!< Last Poll Request was with RC=SC                        */
+    rfalFeliCaPollSlots   slots;            /*!< Time Slots to use on the next Poll Request              */
+    rfalNfcfColResStats   stats;            /*!< Collision Resolution statistics                         */
+    uint32_t              startCyc;         /*!< Collision Resolution start (HW cycles)                  */
 }rfalNfcfColResParams;
 
 
@@ -159,6 +169,9 @@ static rfalNfcf gNfcf;  /*!< RFAL NFC-F instance  */
 ******************************************************************************
 */
 static void rfalNfcfComputeValidSENF( rfalNfcfListenDevice *outDevInfo, uint8_t *curDevIdx, uint8_t devLimit, bool overwrite, bool *nfcDepFound );
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+static rfalFeliCaPollSlots rfalNfcfCollResSlots( uint8_t found, uint8_t collisions );
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
 
 
 /*
@@ -242,6 +255,34 @@ static void rfalNfcfComputeValidSENF( rfalNfcfListenDevice *outDevInfo, uint8_t
     }
 }
 
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+/*******************************************************************************/
+/* Estimates the Time Slots for the next Poll Request. NFC-F devices cannot be 
+ * put to sleep and answer every round, the population is the devices found 
+ * plus the ones estimated behind the collided slots.                          */
+static rfalFeliCaPollSlots rfalNfcfCollResSlots( uint8_t found, uint8_t collisions )
+{
+    uint16_t devs;
+    uint8_t  slotNum;
+    
+    devs    = ((uint16_t)found + rfalCollResBacklog( collisions ));
+    slotNum = 1U;
+    while( ((uint16_t)slotNum < devs) && (slotNum < RFAL_FELICA_POLL_MAX_SLOTS) )
+    {
+        slotNum <<= 1U;
+    }
+    
+    /* Collisions with the same number of slots, ensure the next round is larger */
+    if( (collisions != 0U) && (slotNum <= rfalNfcfSlots2CardNum( gNfcf.CR.slots )) && (slotNum < RFAL_FELICA_POLL_MAX_SLOTS) )
+    {
+        slotNum = MIN( (rfalNfcfSlots2CardNum( gNfcf.CR.slots ) << 1U), RFAL_FELICA_POLL_MAX_SLOTS );
+    }
+    
+    /* PRQA S 4342 1 # MISRA 10.5 - Powers of two up to 16 minus one map to valid rfalFeliCaPollSlots (TSN) */
+    return (rfalFeliCaPollSlots)(slotNum - 1U);
+}
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -326,6 +367,17 @@ ReturnCode rfalNfcfPollerStartCollisionResolution( rfalComplianceMode compMode,
             
     *devCnt      = 0;
     
+    gNfcf.CR.startCyc = platformGetCycles();
+    ST_MEMSET( &gNfcf.CR.stats, 0x00, sizeof(rfalNfcfColResStats) );
+    
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+    /* Size the first round on what was seen on Technology Detection, the estimation is relative to its 4 Time Slots */
+    gNfcf.CR.slots = RFAL_FELICA_4_SLOTS;
+    gNfcf.CR.slots = rfalNfcfCollResSlots( gNfcf.CR.greedyF.pollFound, gNfcf.CR.greedyF.pollCollision );
+#else
+    gNfcf.CR.slots = RFAL_FELICA_16_SLOTS;
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
+    
     /*******************************************************************************************/
     /* ACTIVITY 1.0 - 9.3.6.3 Copy valid SENSF_RES in GRE_POLL_F into GRE_SENSF_RES            */
     /* ACTIVITY 1.0 - 9.3.6.6 The NFC Forum Device MUST remove all entries from GRE_SENSF_RES[]*/
@@ -350,6 +402,9 @@ ReturnCode rfalNfcfPollerStartCollisionResolution( rfalComplianceMode compMode,
 ReturnCode rfalNfcfPollerGetCollisionResolutionStatus( void )
 {
     ReturnCode  ret;
+#if RFAL_FEATURE_ADAPTIVE_COLL_RES
+    rfalFeliCaPollSlots nextSlots;
+#endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
     
     switch( gNfcf.CR.state )
     {
@@ -372,18 +427,26 @@ ReturnCode rfalNfcfPollerGetCollisionResolutionStatus( void )
                 /* Activity 1.1 - 9.3.6.65 Copy and filter duplicates                          */
                 /* For now, due to some devices keep generating different nfcid2, we use 1.0   */
                 /* Phones detected: Samsung Galaxy Nexus,Samsung Galaxy S3,Samsung Nexus S     */
+                /* Further adaptive rounds accumulate on the devices found so far           */
                 /*******************************************************************************/   
-                *gNfcf.CR.devCnt = 0;
+                if( gNfcf.CR.stats.rounds == 0U )
+                {
+                    *gNfcf.CR.devCnt = 0;
+                }
             }
 
-            EXIT_ON_ERR( ret, rfalStartFeliCaPoll( RFAL_FELICA_16_SLOTS, 
+            EXIT_ON_ERR( ret, rfalStartFeliCaPoll( gNfcf.CR.slots, 
                                                    RFAL_NFCF_SYSTEMCODE, 
                                                   (uint8_t)((gNfcf.CR.state == RFAL_NFCF_CR_POLL_SC) ? RFAL_FELICA_POLL_RC_SYSTEM_CODE : RFAL_FELICA_POLL_RC_NO_REQUEST), 
                                                   gNfcf.CR.greedyF.POLL_F, 
-                                                  rfalNfcfSlots2CardNum((uint8_t)RFAL_FELICA_16_SLOTS), 
+                                                  rfalNfcfSlots2CardNum((uint8_t)gNfcf.CR.slots), 
                                                   &gNfcf.CR.greedyF.pollFound, 
                                                   &gNfcf.CR.greedyF.pollCollision ) );
             
+            gNfcf.CR.isPollSc = (gNfcf.CR.state == RFAL_NFCF_CR_POLL_SC);
+            gNfcf.CR.stats.rounds++;
+            gNfcf.CR.stats.slots += rfalNfcfSlots2CardNum((uint8_t)gNfcf.CR.slots);
+            
             gNfcf.CR.state = RFAL_NFCF_CR_PARSE;
             return ERR_BUSY;
 
@@ -397,10 +460,28 @@ ReturnCode rfalNfcfPollerGetCollisionResolutionStatus( void )
                 return ret;
             }
             
+            gNfcf.CR.stats.airTime     = platformCyclesToUs( platformGetCycles() - gNfcf.CR.startCyc );
+            gNfcf.CR.stats.collisions += gNfcf.CR.greedyF.pollCollision;
+            
             if( ret == ERR_NONE )
             {
+            #if RFAL_FEATURE_ADAPTIVE_COLL_RES
+                /* Estimate before the responses are consumed */
+                nextSlots = rfalNfcfCollResSlots( gNfcf.CR.greedyF.pollFound, gNfcf.CR.greedyF.pollCollision );
+            #endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
+                
                 /* Activity 2.1  9.3.6.5 - Symbol 4 Update device list */
                 rfalNfcfComputeValidSENF( gNfcf.CR.nfcfDevList, gNfcf.CR.devCnt, gNfcf.CR.devLimit, false, &gNfcf.CR.nfcDepFound );
+                
+            #if RFAL_FEATURE_ADAPTIVE_COLL_RES
+                /* Devices still hidden behind collisions, poll again with the estimated Time Slots */
+                if( !gNfcf.CR.isPollSc && (gNfcf.CR.greedyF.pollCollision != 0U) && (*gNfcf.CR.devCnt < gNfcf.CR.devLimit) && (gNfcf.CR.stats.rounds < RFAL_NFCF_CR_MAX_ROUNDS) )
+                {
+                    gNfcf.CR.slots = nextSlots;
+                    gNfcf.CR.state = RFAL_NFCF_CR_POLL;
+                    return ERR_BUSY;
+                }
+            #endif /* RFAL_FEATURE_ADAPTIVE_COLL_RES */
             }
             
             /*******************************************************************************/
@@ -428,6 +509,19 @@ ReturnCode rfalNfcfPollerGetCollisionResolutionStatus( void )
     
 }
 
+/*******************************************************************************/
+ReturnCode rfalNfcfPollerGetCollisionResolutionStats( rfalNfcfColResStats *stats )
+{
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    (*stats) = gNfcf.CR.stats;
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalNfcfPollerCheck( const uint8_t* nfcid2, const rfalNfcfServBlockListParam *servBlock, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rcvdLen )
 {
@@ -80,6 +80,8 @@
 #define RFAL_NFCV_RES_FLAG_NOERROR        0x00U  /*!< RES_FLAG indicating no error (checked during activation)          */
 
 #define RFAL_NFCV_MAX_COLL_SUPPORTED      16U    /*!< Maximum number of collisions supported by the Anticollision loop  */
+#define RFAL_NFCV_INV_STACK_LEN           24U    /*!< Pending masks kept by the Inventory engine (depth first)          */
+#define RFAL_NFCV_INV_REQ_AFI_LEN         1U     /*!< INVENTORY_REQ optional AFI length                                 */
 
 #define RFAL_NFCV_FDT_MAX                 rfalConvMsTo1fc(20) /*!< Maximum Wait time FDTV,EOF and MAX2   Digital 2.1 B.5*/
 #define RFAL_NFCV_FDT_MAX1                4394U  /*!< Read alike command FWT FDTV,LISTEN,MAX1  Digital 2.0 B.5          */
@@ -145,12 +147,24 @@ typedef struct
 }rfalNfcvCollision;
 
 
+/*! Inventory engine context */
+typedef struct
+{
+    rfalNfcvCollision    stack[RFAL_NFCV_INV_STACK_LEN];   /*!< Masks still to be inventoried, deepest on top */
+    uint8_t              stackCnt;                         /*!< Number of pending masks                       */
+    rfalISO15693SlotRes  slotRes[RFAL_NFCV_MAX_SLOTS];     /*!< Result of each slot of the current round      */
+    rfalNfcvInventoryRes slotRx[RFAL_NFCV_MAX_SLOTS];      /*!< INVENTORY_RES of each slot                    */
+    uint16_t             chkPresLen;                       /*!< Received length of the Check Presence probe   */
+}rfalNfcvInventoryCtx;
+
+
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
 ******************************************************************************
 */
 static ReturnCode rfalNfcvParseError( uint8_t err );
+static void       rfalNfcvInventoryPush( const rfalNfcvCollision *parent, uint8_t slot );
 
 /*
 ******************************************************************************
@@ -158,6 +172,8 @@ static ReturnCode rfalNfcvParseError( uint8_t err );
 ******************************************************************************
 */
 
+static rfalNfcvInventoryCtx gNfcvInv;  /*!< NFC-V Inventory engine context */
+
 /*
 ******************************************************************************
 * LOCAL FUNCTIONS
@@ -184,6 +200,30 @@ static ReturnCode rfalNfcvParseError( uint8_t err )
     }
 }
 
+
+/*******************************************************************************/
+/* Pushes the mask of a collided slot: the parent mask extended by the 4 bits
+ * of the slot number                                  Activity 2.1  9.3.7.17   */
+static void rfalNfcvInventoryPush( const rfalNfcvCollision *parent, uint8_t slot )
+{
+    rfalNfcvCollision *col;
+    uint8_t           colPos;
+    
+    col    = &gNfcvInv.stack[gNfcvInv.stackCnt];
+    colPos = parent->maskLen;
+    
+    ST_MEMCPY( col->maskVal, parent->maskVal, RFAL_NFCV_MASKVAL_MAX_LEN );
+    col->maskVal[(colPos/RFAL_BITS_IN_BYTE)] &= (uint8_t)((1U << (colPos % RFAL_BITS_IN_BYTE)) - 1U);
+    col->maskVal[(colPos/RFAL_BITS_IN_BYTE)] |= (uint8_t)(slot << (colPos % RFAL_BITS_IN_BYTE));
+    if( ((colPos/RFAL_BITS_IN_BYTE) + 1U) < RFAL_NFCV_MASKVAL_MAX_LEN )
+    {
+        col->maskVal[((colPos/RFAL_BITS_IN_BYTE) + 1U)] = 0U;
+    }
+    col->maskLen = (colPos + 4U);
+    
+    gNfcvInv.stackCnt++;
+}
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTIONS
@@ -210,8 +250,42 @@ ReturnCode rfalNfcvPollerCheckPresence( rfalNfcvInventoryRes *invRes )
 {
     ReturnCode ret;
     
+    EXIT_ON_ERR( ret, rfalNfcvPollerStartCheckPresence( invRes ) );
+    rfalRunBlocking( ret, rfalNfcvPollerGetCheckPresenceStatus() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerStartCheckPresence( rfalNfcvInventoryRes *invRes )
+{
+    rfalNfcvInventoryReq invReq;
+    
+    if( invRes == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
     /* INVENTORY_REQ with 1 slot and no Mask   Activity 2.0 (Candidate) 9.2.3.32 */
-    ret = rfalNfcvPollerInventory( RFAL_NFCV_NUM_SLOTS_1, 0, NULL, invRes, NULL );
+    invReq.INV_FLAG = (RFAL_NFCV_INV_REQ_FLAG | (uint8_t)RFAL_NFCV_NUM_SLOTS_1);
+    invReq.CMD      = RFAL_NFCV_CMD_INVENTORY;
+    invReq.MASK_LEN = 0;
+    
+    /* Only presence matters: sent as a plain frame, skipping the anticollision decoding *
+     * and the wait for a colliding response to end, as an Inventory round requires      */
+    gNfcvInv.chkPresLen = 0;
+    return rfalTransceiveBlockingTx( (uint8_t*)&invReq, RFAL_NFCV_INV_REQ_HEADER_LEN, (uint8_t*)invRes, sizeof(rfalNfcvInventoryRes), &gNfcvInv.chkPresLen, 
+                                     ((uint32_t)RFAL_TXRX_FLAGS_CRC_TX_AUTO | (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP | (uint32_t)RFAL_TXRX_FLAGS_AGC_OFF | (uint32_t)RFAL_TXRX_FLAGS_NFCV_FLAG_AUTO), RFAL_NFCV_FDT_MAX1 );
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerGetCheckPresenceStatus( void )
+{
+    ReturnCode ret;
+    
+    ret = rfalGetTransceiveStatus();
     
     if( (ret == ERR_RF_COLLISION) || (ret == ERR_CRC)  || 
         (ret == ERR_FRAMING)      || (ret == ERR_PROTO)  )
@@ -423,32 +497,149 @@ ReturnCode rfalNfcvPollerCollisionResolution( rfalComplianceMode compMode, uint8
 /*******************************************************************************/
 ReturnCode rfalNfcvPollerSleepCollisionResolution( uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
 {
-    uint8_t    tmpDevCnt;
-    ReturnCode ret;
-    uint8_t    i;
+    ReturnCode             ret;
+    rfalNfcvInventoryParam param;
+    
+    param.useAfi    = false;
+    param.afi       = 0U;
+    param.stayQuiet = true;
+    
+    ret = rfalNfcvPollerInventoryAll( &param, devLimit, nfcvDevList, devCnt );
+    
+    /* As the Activity Collision Resolution, keep the devices found when collisions had to be dropped */
+    return ( (ret == ERR_NOMEM) ? ERR_NONE : ret );
+}
 
-    if( (nfcvDevList == NULL) || (devCnt == NULL) )
+
+/*******************************************************************************/
+ReturnCode rfalNfcvPollerInventoryAll( const rfalNfcvInventoryParam *param, uint8_t devLimit, rfalNfcvListenDevice *nfcvDevList, uint8_t *devCnt )
+{
+    ReturnCode        ret;
+    rfalNfcvCollision cur;
+    uint8_t           req[RFAL_NFCV_INV_REQ_HEADER_LEN + RFAL_NFCV_INV_REQ_AFI_LEN + RFAL_NFCV_MASKVAL_MAX_LEN];
+    uint8_t           reqLen;
+    uint8_t           slot;
+    uint8_t           i;
+    uint8_t           prevCnt;
+    bool              overflow;
+    bool              duplicate;
+    
+    if( (param == NULL) || (nfcvDevList == NULL) || (devCnt == NULL) )
     {
         return ERR_PARAM;
     }
-
+    
     *devCnt = 0;
-
+    
+    if( devLimit == 0U )
+    {
+        return ERR_NONE;
+    }
+    
     do
     {
-        tmpDevCnt = 0;
-        ret = rfalNfcvPollerCollisionResolution( RFAL_COMPLIANCE_MODE_ISO, (devLimit - *devCnt), &nfcvDevList[*devCnt], &tmpDevCnt );
-
-        for( i = *devCnt; i < (*devCnt + tmpDevCnt); i++ )
+        overflow = false;
+        prevCnt  = *devCnt;
+        
+        /* Start from the empty mask */
+        ST_MEMSET( &gNfcvInv.stack[0], 0x00, sizeof(rfalNfcvCollision) );
+        gNfcvInv.stackCnt = 1U;
+        
+        /* Depth first: resolve the deepest collision before its siblings, keeping the pending masks low */
+        while( gNfcvInv.stackCnt > 0U )
         {
-            rfalNfcvPollerSleep( 0x00, nfcvDevList[i].InvRes.UID );
-            nfcvDevList[i].isSleep = true;
+            gNfcvInv.stackCnt--;
+            cur = gNfcvInv.stack[gNfcvInv.stackCnt];
+            
+            /* Compute INVENTORY_REQ with 16 slots   Digital 2.0 9.6.1 */
+            reqLen        = 0;
+            req[reqLen++] = (RFAL_NFCV_INV_REQ_FLAG | (uint8_t)RFAL_NFCV_NUM_SLOTS_16 | (param->useAfi ? (uint8_t)RFAL_NFCV_REQ_FLAG_AFI : 0U));
+            req[reqLen++] = RFAL_NFCV_CMD_INVENTORY;
+            if( param->useAfi )
+            {
+                req[reqLen++] = param->afi;
+            }
+            req[reqLen++] = cur.maskLen;
+            ST_MEMCPY( &req[reqLen], cur.maskVal, rfalConvBitsToBytes(cur.maskLen) );
+            reqLen += (uint8_t)rfalConvBitsToBytes(cur.maskLen);
+            
+            /* Send the INVENTORY_REQ and all the slot EOFs back to back */
+            EXIT_ON_ERR( ret, rfalISO15693TransceiveAnticollisionSlots( req, reqLen, (uint8_t)RFAL_NFCV_MAX_SLOTS, RFAL_NFCV_FDT_V_INVENT_NORES, (uint8_t*)gNfcvInv.slotRx, (uint8_t)sizeof(rfalNfcvInventoryRes), gNfcvInv.slotRes ) );
+            
+            for( slot = 0; slot < RFAL_NFCV_MAX_SLOTS; slot++ )
+            {
+                if( gNfcvInv.slotRes[slot].ret == ERR_TIMEOUT )
+                {
+                    continue;
+                }
+                
+                /* Check if response is a correct frame (no TxRx error)  Activity 2.1  9.3.7.11 */
+                if( (gNfcvInv.slotRes[slot].ret == ERR_NONE) || (gNfcvInv.slotRes[slot].ret == ERR_PROTO) )
+                {
+                    if( !rfalNfcvCheckInvRes( gNfcvInv.slotRx[slot].RES_FLAG, gNfcvInv.slotRes[slot].rxLen ) )
+                    {
+                        continue;
+                    }
+                    
+                    /* A device found on a previous pass may answer again if it could not be put to sleep */
+                    duplicate = false;
+                    for( i = 0; i < *devCnt; i++ )
+                    {
+                        if( ST_BYTECMP( nfcvDevList[i].InvRes.UID, gNfcvInv.slotRx[slot].UID, RFAL_NFCV_UID_LEN ) == 0 )
+                        {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                    if( duplicate )
+                    {
+                        continue;
+                    }
+                    
+                    nfcvDevList[*devCnt].InvRes  = gNfcvInv.slotRx[slot];
+                    nfcvDevList[*devCnt].isSleep = false;
+                    
+                    if( param->stayQuiet )
+                    {
+                        rfalNfcvPollerSleep( 0x00, nfcvDevList[*devCnt].InvRes.UID );
+                        nfcvDevList[*devCnt].isSleep = true;
+                    }
+                    (*devCnt)++;
+                    
+                    if( *devCnt >= devLimit )
+                    {
+                        return ERR_NONE;
+                    }
+                    continue;
+                }
+                
+                /* Treat everything else as collision, a full length mask cannot be extended any further */
+                if( (cur.maskLen + 4U) > RFAL_NFCV_MASKVAL_MAX_16SLOT_LEN )
+                {
+                    continue;
+                }
+                
+                if( gNfcvInv.stackCnt < RFAL_NFCV_INV_STACK_LEN )
+                {
+                    rfalNfcvInventoryPush( &cur, slot );
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
         }
-        *devCnt += tmpDevCnt;
     }
-    while( (ret == ERR_NONE) && (tmpDevCnt > 0U) && (*devCnt < devLimit) );
-
-    return ret;
+    /* Collisions dropped, devices found are quiet so a new pass reaches the remaining ones */
+    while( overflow && param->stayQuiet && (*devCnt > prevCnt) );
+    
+    /* Collisions still dropped, devices may have been missed */
+    if( overflow )
+    {
+        return ERR_NOMEM;
+    }
+    
+    return ERR_NONE;
 }
 
 /*******************************************************************************/
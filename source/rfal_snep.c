@@ -0,0 +1,411 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2020 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file rfal_snep.c
+ *
+ *  \author
+ *
+ *  \brief Implementation of the NFC Forum SNEP client (Put) and default server
+ *
+ *  The client connects to the server by its service name through the SDP.
+ *  The NDEF message is never copied: the SNEP header and the message are
+ *  given to LLCP which fills each I PDU straight from them.
+ *  The server reassembles the fragments received into the caller buffer.
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "rfal_snep.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * ENABLE SWITCH
+ ******************************************************************************
+ */
+
+#ifndef RFAL_FEATURE_SNEP
+    #define RFAL_FEATURE_SNEP   false    /* SNEP module configuration missing. Disabled by default */
+#endif
+
+#if RFAL_FEATURE_SNEP
+
+#if !RFAL_FEATURE_LLCP
+    #error " RFAL: SNEP requires RFAL_FEATURE_LLCP"
+#endif
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define SNEP_VERSION_MAJOR_MASK     0xF0U    /*!< SNEP major version mask                             */
+#define SNEP_HDR_VER_POS            0U       /*!< Version position in the header                      */
+#define SNEP_HDR_CODE_POS           1U       /*!< Request/Response position in the header             */
+#define SNEP_HDR_LEN_POS            2U       /*!< Length position in the header                       */
+
+/*
+ ******************************************************************************
+ * GLOBAL MACROS
+ ******************************************************************************
+ */
+
+#define snepIsVersionOk( v )        (((v) & SNEP_VERSION_MAJOR_MASK) == (RFAL_SNEP_VERSION & SNEP_VERSION_MAJOR_MASK)) /*!< Same major version */
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! SNEP client states */
+typedef enum
+{
+    SNEP_CLI_ST_IDLE,                        /*!< No Put ongoing                                      */
+    SNEP_CLI_ST_CONNECT,                     /*!< Waiting for the connection                          */
+    SNEP_CLI_ST_WAIT_FIRST,                  /*!< First fragment sent, waiting for Continue/response  */
+    SNEP_CLI_ST_WAIT_RES,                    /*!< Whole message sent, waiting for the response        */
+    SNEP_CLI_ST_DISCONNECT                   /*!< Waiting for the disconnection                       */
+} rfalSnepClientState;
+
+
+/*! SNEP client context */
+typedef struct
+{
+    rfalSnepClientState state;               /*!< Client state                                        */
+    uint8_t             link;                /*!< LLCP link                                           */
+    const uint8_t       *ndef;               /*!< NDEF message to be pushed                           */
+    uint32_t            ndefLen;             /*!< NDEF message length                                 */
+    uint32_t            firstLen;            /*!< NDEF bytes sent in the first fragment               */
+    uint8_t             hdr[RFAL_SNEP_HEADER_LEN]; /*!< Put request header                            */
+    bool                isResRcvd;           /*!< Response received                                   */
+    uint8_t             res;                 /*!< Response code received                              */
+    ReturnCode          ret;                 /*!< Put result                                          */
+} rfalSnepClient;
+
+
+/*! SNEP server context */
+typedef struct
+{
+    uint8_t             link;                /*!< LLCP link                                           */
+    uint8_t             *buf;                /*!< NDEF message buffer                                 */
+    uint32_t            bufLen;              /*!< NDEF message buffer length                          */
+    rfalSnepServerCb    cb;                  /*!< NDEF message callback                               */
+    void                *ctx;                /*!< Callback context                                    */
+    bool                isRx;                /*!< Fragments of a Put being received                   */
+    uint32_t            msgLen;              /*!< Length of the NDEF message being received           */
+    uint32_t            rcvdLen;             /*!< NDEF bytes received                                 */
+    uint8_t             res[RFAL_SNEP_HEADER_LEN]; /*!< Response header                               */
+} rfalSnepServer;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static rfalSnepClient gSnepCli;
+static rfalSnepServer gSnepSrv;
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static void rfalSnepPutHeader( uint8_t *hdr, uint8_t code, uint32_t len );
+static void rfalSnepClientRxCb( void *ctx, uint8_t link, const uint8_t *data, uint16_t len );
+static void rfalSnepServerRespond( uint8_t code );
+static void rfalSnepServerRxCb( void *ctx, uint8_t link, const uint8_t *data, uint16_t len );
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+static void rfalSnepPutHeader( uint8_t *hdr, uint8_t code, uint32_t len )
+{
+    hdr[SNEP_HDR_VER_POS]        = RFAL_SNEP_VERSION;
+    hdr[SNEP_HDR_CODE_POS]       = code;
+    hdr[SNEP_HDR_LEN_POS]        = (uint8_t)(len >> 24U);
+    hdr[SNEP_HDR_LEN_POS + 1U]   = (uint8_t)(len >> 16U);
+    hdr[SNEP_HDR_LEN_POS + 2U]   = (uint8_t)(len >> 8U);
+    hdr[SNEP_HDR_LEN_POS + 3U]   = (uint8_t)(len);
+}
+
+
+/*******************************************************************************/
+static void rfalSnepClientRxCb( void *ctx, uint8_t link, const uint8_t *data, uint16_t len )
+{
+    NO_WARNING( ctx );
+    NO_WARNING( link );
+
+    if( (data != NULL) && (len >= RFAL_SNEP_HEADER_LEN) && snepIsVersionOk( data[SNEP_HDR_VER_POS] ) )
+    {
+        gSnepCli.res       = data[SNEP_HDR_CODE_POS];
+        gSnepCli.isResRcvd = true;
+    }
+}
+
+
+/*******************************************************************************/
+static void rfalSnepServerRespond( uint8_t code )
+{
+    rfalSnepPutHeader( gSnepSrv.res, code, 0 );
+
+    /* The previous response has always been placed in a PDU by now */
+    rfalLlcpSend( gSnepSrv.link, gSnepSrv.res, RFAL_SNEP_HEADER_LEN, NULL, 0 );
+}
+
+
+/*******************************************************************************/
+static void rfalSnepServerRxCb( void *ctx, uint8_t link, const uint8_t *data, uint16_t len )
+{
+    uint32_t n;
+
+    NO_WARNING( ctx );
+    NO_WARNING( link );
+
+    /* New connection */
+    if( (data == NULL) || (len == 0U) )
+    {
+        gSnepSrv.isRx = false;
+        return;
+    }
+
+    if( !gSnepSrv.isRx )
+    {
+        if( len < RFAL_SNEP_HEADER_LEN )
+        {
+            rfalSnepServerRespond( RFAL_SNEP_RES_BAD_REQUEST );
+            return;
+        }
+
+        if( !snepIsVersionOk( data[SNEP_HDR_VER_POS] ) )
+        {
+            rfalSnepServerRespond( RFAL_SNEP_RES_UNSUPPORTED_VER );
+            return;
+        }
+
+        /* The default server has no NDEF message to be retrieved   SNEP 1.0 6.1 */
+        if( data[SNEP_HDR_CODE_POS] != RFAL_SNEP_REQ_PUT )
+        {
+            rfalSnepServerRespond( RFAL_SNEP_RES_NOT_IMPLEMENTED );
+            return;
+        }
+
+        gSnepSrv.msgLen = GETU32( &data[SNEP_HDR_LEN_POS] );
+        if( gSnepSrv.msgLen > gSnepSrv.bufLen )
+        {
+            rfalSnepServerRespond( RFAL_SNEP_RES_REJECT );
+            return;
+        }
+
+        n = MIN( (uint32_t)(len - RFAL_SNEP_HEADER_LEN), gSnepSrv.msgLen );
+        ST_MEMCPY( gSnepSrv.buf, &data[RFAL_SNEP_HEADER_LEN], n );
+
+        gSnepSrv.rcvdLen = n;
+        gSnepSrv.isRx    = true;
+
+        if( gSnepSrv.rcvdLen < gSnepSrv.msgLen )
+        {
+            rfalSnepServerRespond( RFAL_SNEP_RES_CONTINUE );
+            return;
+        }
+    }
+    else
+    {
+        n = MIN( (uint32_t)len, (gSnepSrv.msgLen - gSnepSrv.rcvdLen) );
+        ST_MEMCPY( &gSnepSrv.buf[gSnepSrv.rcvdLen], data, n );
+
+        gSnepSrv.rcvdLen += n;
+    }
+
+    if( gSnepSrv.rcvdLen >= gSnepSrv.msgLen )
+    {
+        gSnepSrv.isRx = false;
+        rfalSnepServerRespond( RFAL_SNEP_RES_SUCCESS );
+
+        if( gSnepSrv.cb != NULL )
+        {
+            gSnepSrv.cb( gSnepSrv.ctx, gSnepSrv.buf, gSnepSrv.msgLen );
+        }
+    }
+}
+
+
+/*
+******************************************************************************
+* GLOBAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode rfalSnepClientStartPut( const uint8_t *ndef, uint32_t ndefLen )
+{
+    ReturnCode ret;
+
+    if( (ndef == NULL) || (ndefLen == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    if( gSnepCli.state != SNEP_CLI_ST_IDLE )
+    {
+        return ERR_BUSY;
+    }
+
+    ST_MEMSET( &gSnepCli, 0x00, sizeof(rfalSnepClient) );
+    gSnepCli.ndef    = ndef;
+    gSnepCli.ndefLen = ndefLen;
+    rfalSnepPutHeader( gSnepCli.hdr, RFAL_SNEP_REQ_PUT, ndefLen );
+
+    EXIT_ON_ERR( ret, rfalLlcpConnect( RFAL_LLCP_SAP_SNEP, RFAL_SNEP_SN, rfalSnepClientRxCb, NULL, &gSnepCli.link ) );
+
+    gSnepCli.state = SNEP_CLI_ST_CONNECT;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalSnepClientGetPutStatus( void )
+{
+    rfalLlcpLinkState linkSt;
+    uint16_t          miu;
+
+    if( gSnepCli.state == SNEP_CLI_ST_IDLE )
+    {
+        return ERR_WRONG_STATE;
+    }
+
+    linkSt = rfalLlcpGetLinkState( gSnepCli.link );
+
+    switch( gSnepCli.state )
+    {
+        /*******************************************************************************/
+        case SNEP_CLI_ST_CONNECT:
+
+            if( linkSt == RFAL_LLCP_LINK_ST_CONNECTING )
+            {
+                return ERR_BUSY;
+            }
+
+            miu = rfalLlcpGetLinkMiu( gSnepCli.link );
+            if( (linkSt != RFAL_LLCP_LINK_ST_CONNECTED) || (miu <= RFAL_SNEP_HEADER_LEN) )
+            {
+                break;
+            }
+
+            /* First fragment: header and as much of the message as fits in one I PDU */
+            gSnepCli.firstLen = MIN( gSnepCli.ndefLen, (uint32_t)(miu - RFAL_SNEP_HEADER_LEN) );
+            if( rfalLlcpSend( gSnepCli.link, gSnepCli.hdr, RFAL_SNEP_HEADER_LEN, gSnepCli.ndef, gSnepCli.firstLen ) != ERR_NONE )
+            {
+                break;
+            }
+
+            gSnepCli.state = SNEP_CLI_ST_WAIT_FIRST;
+            return ERR_BUSY;
+
+        /*******************************************************************************/
+        case SNEP_CLI_ST_WAIT_FIRST:
+        case SNEP_CLI_ST_WAIT_RES:
+
+            if( linkSt != RFAL_LLCP_LINK_ST_CONNECTED )
+            {
+                break;
+            }
+
+            if( !gSnepCli.isResRcvd )
+            {
+                return ERR_BUSY;
+            }
+            gSnepCli.isResRcvd = false;
+
+            /* Remaining fragments all handed over, LLCP sends them within the Receive Window */
+            if( (gSnepCli.state == SNEP_CLI_ST_WAIT_FIRST) && (gSnepCli.res == RFAL_SNEP_RES_CONTINUE) && (gSnepCli.firstLen < gSnepCli.ndefLen) )
+            {
+                if( rfalLlcpSend( gSnepCli.link, NULL, 0, &gSnepCli.ndef[gSnepCli.firstLen], (gSnepCli.ndefLen - gSnepCli.firstLen) ) != ERR_NONE )
+                {
+                    break;
+                }
+
+                gSnepCli.state = SNEP_CLI_ST_WAIT_RES;
+                return ERR_BUSY;
+            }
+
+            gSnepCli.ret   = ((gSnepCli.res == RFAL_SNEP_RES_SUCCESS) ? ERR_NONE : ERR_REQUEST);
+            gSnepCli.state = SNEP_CLI_ST_DISCONNECT;
+            rfalLlcpDisconnect( gSnepCli.link );
+            return ERR_BUSY;
+
+        /*******************************************************************************/
+        case SNEP_CLI_ST_DISCONNECT:
+
+            if( linkSt == RFAL_LLCP_LINK_ST_DISCONNECTING )
+            {
+                return ERR_BUSY;
+            }
+
+            rfalLlcpRelease( gSnepCli.link );
+            gSnepCli.state = SNEP_CLI_ST_IDLE;
+            return gSnepCli.ret;
+
+        /*******************************************************************************/
+        default:
+            /* MISRA 16.4: no empty default statement (a comment being enough) */
+            break;
+    }
+
+    /* Connection refused or lost */
+    rfalLlcpRelease( gSnepCli.link );
+    gSnepCli.state = SNEP_CLI_ST_IDLE;
+    return ERR_LINK_LOSS;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalSnepServerStart( uint8_t *buf, uint32_t bufLen, rfalSnepServerCb cb, void *ctx )
+{
+    if( (buf == NULL) || (bufLen == 0U) )
+    {
+        return ERR_PARAM;
+    }
+
+    ST_MEMSET( &gSnepSrv, 0x00, sizeof(rfalSnepServer) );
+    gSnepSrv.buf    = buf;
+    gSnepSrv.bufLen = bufLen;
+    gSnepSrv.cb     = cb;
+    gSnepSrv.ctx    = ctx;
+
+    return rfalLlcpListen( RFAL_LLCP_SAP_SNEP, RFAL_SNEP_SN, rfalSnepServerRxCb, NULL, &gSnepSrv.link );
+}
+
+#endif /* RFAL_FEATURE_SNEP */
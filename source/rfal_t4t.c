@@ -66,12 +66,79 @@
 #define RFAL_T4T_DATA_DO            0x53U        /*!< Tag value for data BER-TLV data object            */
 
 #define RFAL_T4T_MAX_LC             255U         /*!< Maximum Lc value for short Lc coding              */
+#define RFAL_T4T_MAX_LE             256U         /*!< Maximum Le value for short Le coding (Le = 00h)   */
+
+#define RFAL_T4T_NDEF_RESP_LEN      (RFAL_T4T_NDEF_CC_EXT_LEN + RFAL_T4T_MAX_RAPDU_SW1SW2_LEN) /*!< R-APDU head kept by the NDEF engine */
+#define RFAL_T4T_NDEF_OFFSET_MAX    0x7FFFU      /*!< Maximum offset of a READ BINARY (B0h)             */
+#define RFAL_T4T_NDEF_ODO_HDR_MAX   4U           /*!< Maximum length of the 53h data DO header          */
+#define RFAL_T4T_NDEF_TLV           0x04U        /*!< NDEF File Control TLV tag                         */
+#define RFAL_T4T_NDEF_TLV_LEN       0x06U        /*!< NDEF File Control TLV length                      */
+#define RFAL_T4T_ENDEF_TLV          0x06U        /*!< ENDEF File Control TLV tag (T4T 3.0)              */
+#define RFAL_T4T_ENDEF_TLV_LEN      0x08U        /*!< ENDEF File Control TLV length                     */
+#define RFAL_T4T_NLEN_LEN           2U           /*!< NLEN field length                                 */
+#define RFAL_T4T_ENLEN_LEN          4U           /*!< ENLEN field length                                */
+#define RFAL_T4T_BER_LEN_1B         0x81U        /*!< BER-TLV length coded on one following byte        */
+#define RFAL_T4T_BER_LEN_2B         0x82U        /*!< BER-TLV length coded on two following bytes       */
+#define RFAL_T4T_NDEF_CHDR_MAX      13U          /*!< Max C-APDU head streamed before the data: ODO UPDATE BINARY */
+#define RFAL_T4T_NDEF_ODO_WR_OVH    8U           /*!< ODO UPDATE BINARY data overhead: 54 03 offset 53 81 Ld      */
+#define RFAL_T4T_EXT_LC_LEN         3U           /*!< Lc length on extended field coding: 00h LcH LcL   */
  /*
 ******************************************************************************
 * GLOBAL TYPES
 ******************************************************************************
 */
 
+/*! NDEF Read states */
+typedef enum
+{
+    RFAL_T4T_NDEF_ST_IDLE,                       /*!< No NDEF Read ongoing                              */
+    RFAL_T4T_NDEF_ST_SEL_APP,                    /*!< Select NDEF Tag Application                       */
+    RFAL_T4T_NDEF_ST_SEL_APP_V1,                 /*!< Select NDEF Tag Application Mapping Version 1     */
+    RFAL_T4T_NDEF_ST_SEL_CC,                     /*!< Select CC file                                    */
+    RFAL_T4T_NDEF_ST_READ_CC,                    /*!< Read CC file                                      */
+    RFAL_T4T_NDEF_ST_READ_CC_EXT,                /*!< Read CC file ENDEF TLV access conditions          */
+    RFAL_T4T_NDEF_ST_SEL_NDEF,                   /*!< Select NDEF file                                  */
+    RFAL_T4T_NDEF_ST_READ_NLEN,                  /*!< Read NLEN/ENLEN                                   */
+    RFAL_T4T_NDEF_ST_READ_DATA,                  /*!< Read NDEF message                                 */
+    RFAL_T4T_NDEF_ST_WRITE_NLEN0,                /*!< Write NLEN/ENLEN to zero                          */
+    RFAL_T4T_NDEF_ST_WRITE_DATA,                 /*!< Write NDEF message                                */
+    RFAL_T4T_NDEF_ST_WRITE_NLEN                  /*!< Write NLEN/ENLEN                                  */
+} rfalT4tNdefState;
+
+
+/*! NDEF Read/Write context */
+typedef struct
+{
+    rfalT4tNdefState         state;              /*!< Current state                                     */
+    bool                     isWrite;            /*!< NDEF Write ongoing, NDEF Read otherwise           */
+    const rfalIsoDepDevice   *isoDepDev;         /*!< Activated ISO-DEP device                          */
+    rfalIsoDepBufFormat      *txBuf;             /*!< Buffer for one Tx I-Block                         */
+    rfalIsoDepBufFormat      *rxBuf;             /*!< Buffer for one Rx I-Block                         */
+    uint8_t                  *ndefBuf;           /*!< NDEF Read destination                             */
+    uint32_t                 ndefBufLen;         /*!< NDEF Read destination size                        */
+    uint32_t                 *ndefLen;           /*!< NDEF Read message length                          */
+    const uint8_t            *ndefMsg;           /*!< NDEF Write message                                */
+    uint32_t                 *rate;              /*!< NDEF Write throughput                             */
+    uint32_t                 tStart;             /*!< NDEF Write data start (cycles)                    */
+    rfalT4tCc                *ccOut;             /*!< Caller copy of the CC file                        */
+    rfalT4tCc                cc;                 /*!< Parsed CC file                                    */
+    uint8_t                  resp[RFAL_T4T_NDEF_RESP_LEN]; /*!< Head of the current R-APDU              */
+    uint32_t                 rxCnt;              /*!< Current R-APDU length received                    */
+    uint16_t                 sw;                 /*!< Last two bytes received (SW1 SW2)                 */
+    uint16_t                 cApduLen;           /*!< Current C-APDU length                             */
+    uint8_t                  cHdr[RFAL_T4T_NDEF_CHDR_MAX]; /*!< Head of the C-APDU streamed before txData */
+    uint8_t                  cHdrLen;            /*!< C-APDU head length                                */
+    const uint8_t            *txData;            /*!< C-APDU data streamed, NULL if composed on txBuf   */
+    uint16_t                 txDataLen;          /*!< C-APDU data length                                */
+    uint32_t                 txPos;              /*!< C-APDU bytes already handed to ISO-DEP            */
+    uint8_t                  nlenBuf[RFAL_T4T_ENLEN_LEN]; /*!< NLEN/ENLEN to be written                 */
+    uint32_t                 nlen;               /*!< NDEF message length                               */
+    uint32_t                 pos;                /*!< NDEF message bytes read/written                   */
+    uint16_t                 chunk;              /*!< Data requested by the current READ BINARY         */
+    uint8_t                  hdrLen;             /*!< 53h data DO header length of the current R-APDU   */
+    bool                     isOdo;              /*!< Current READ BINARY uses an ODO                   */
+} rfalT4tNdefCtx;
+
 
 /*
 ******************************************************************************
@@ -79,12 +146,36 @@
 ******************************************************************************
 */
 
+#define rfalT4tNdefRate( len, us )   (((us) == 0U) ? 0U : (uint32_t)(((uint64_t)(len) * 1000000U) / (us)))  /*!< Throughput in Bytes/s */
+
 
 /*
  ******************************************************************************
  * LOCAL VARIABLES
  ******************************************************************************
  */
+
+static const uint8_t  gT4tNdefAid[]   = {0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01}; /*!< NDEF Tag Application AID Mapping Version 2/3 */
+static const uint8_t  gT4tNdefAidV1[] = {0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x00}; /*!< NDEF Tag Application AID Mapping Version 1   */
+static const uint8_t  gT4tCcFid[]     = {0xE1, 0x03};                               /*!< CC file identifier                          */
+
+static rfalT4tNdefCtx gT4tNdef;
+
+/*
+******************************************************************************
+* LOCAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+static ReturnCode rfalT4tNdefTxCb( void *ctx, uint8_t *buf, uint16_t maxLen, uint16_t *len, bool *more );
+static ReturnCode rfalT4tNdefRxCb( void *ctx, const uint8_t *data, uint16_t len, bool last );
+static ReturnCode rfalT4tNdefSelectFile( const uint8_t *fid );
+static ReturnCode rfalT4tNdefReadBinary( uint32_t offset, uint16_t len );
+static void rfalT4tNdefUpdateBinary( uint32_t offset, const uint8_t *data, uint16_t len );
+static uint16_t rfalT4tNdefWriteLen( uint32_t offset, uint32_t left );
+static ReturnCode rfalT4tNdefParseCc( void );
+static ReturnCode rfalT4tNdefNext( rfalT4tNdefState state );
+static ReturnCode rfalT4tNdefProcess( void );
+static ReturnCode rfalT4tNdefGetStatus( bool isWrite );
  
  
 /*
@@ -421,4 +512,659 @@ ReturnCode rfalT4TPollerComposeWriteDataODO( rfalIsoDepApduBufFormat *cApduBuf,
 }
 
 
+
+
+/*******************************************************************************/
+/* Hands the C-APDU to ISO-DEP: either already composed in place on txBuf or */
+/* its head followed by the data streamed from the caller buffer             */
+static ReturnCode rfalT4tNdefTxCb( void *ctx, uint8_t *buf, uint16_t maxLen, uint16_t *len, bool *more )
+{
+    uint32_t n;
+    
+    NO_WARNING( ctx );
+    
+    if( gT4tNdef.txData == NULL )
+    {
+        if( gT4tNdef.cApduLen > maxLen )
+        {
+            return ERR_NOMEM;
+        }
+        
+        *len  = gT4tNdef.cApduLen;
+        *more = false;
+        
+        return ERR_NONE;
+    }
+    
+    *len = 0U;
+    
+    if( gT4tNdef.txPos < gT4tNdef.cHdrLen )
+    {
+        n = MIN( (uint32_t)maxLen, (gT4tNdef.cHdrLen - gT4tNdef.txPos) );
+        ST_MEMCPY( buf, &gT4tNdef.cHdr[gT4tNdef.txPos], n );
+        
+        *len            = (uint16_t)n;
+        gT4tNdef.txPos += n;
+    }
+    
+    if( gT4tNdef.txPos >= gT4tNdef.cHdrLen )
+    {
+        n = MIN( (uint32_t)(maxLen - *len), (((uint32_t)gT4tNdef.cHdrLen + gT4tNdef.txDataLen) - gT4tNdef.txPos) );
+        ST_MEMCPY( &buf[*len], &gT4tNdef.txData[gT4tNdef.txPos - gT4tNdef.cHdrLen], n );
+        
+        *len           += (uint16_t)n;
+        gT4tNdef.txPos += n;
+    }
+    
+    *more = (gT4tNdef.txPos < ((uint32_t)gT4tNdef.cHdrLen + gT4tNdef.txDataLen));
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+/* Places the R-APDU data of each I-Block directly on the NDEF buffer         */
+static ReturnCode rfalT4tNdefRxCb( void *ctx, const uint8_t *data, uint16_t len, bool last )
+{
+    uint32_t start;
+    uint32_t end;
+    
+    NO_WARNING( ctx );
+    NO_WARNING( last );
+    
+    /* Keep the head of the R-APDU for the CC file, NLEN and ODO header */
+    if( gT4tNdef.rxCnt < RFAL_T4T_NDEF_RESP_LEN )
+    {
+        ST_MEMCPY( &gT4tNdef.resp[gT4tNdef.rxCnt], data, MIN( (uint32_t)len, (RFAL_T4T_NDEF_RESP_LEN - gT4tNdef.rxCnt) ) );
+    }
+    
+    /* SW1 SW2 are the last two bytes of the R-APDU */
+    if( len >= RFAL_T4T_MAX_RAPDU_SW1SW2_LEN )
+    {
+        gT4tNdef.sw = GETU16( &data[len - RFAL_T4T_MAX_RAPDU_SW1SW2_LEN] );
+    }
+    else if( len > 0U )
+    {
+        gT4tNdef.sw = (uint16_t)((uint16_t)(gT4tNdef.sw << 8U) | data[0]);
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+    
+    if( gT4tNdef.state == RFAL_T4T_NDEF_ST_READ_DATA )
+    {
+        /* ODO R-APDU data is wrapped on a 53h data DO: 53 Ld | 53 81 Ld | 53 82 Ld Ld */
+        if( gT4tNdef.isOdo && (gT4tNdef.rxCnt == 0U) && (len > RFAL_T4T_MAX_RAPDU_SW1SW2_LEN) )
+        {
+            if( (len < RFAL_T4T_NDEF_ODO_HDR_MAX) || (data[0] != RFAL_T4T_DATA_DO) )
+            {
+                return ERR_PROTO;
+            }
+            
+            gT4tNdef.hdrLen = ((data[1] == RFAL_T4T_BER_LEN_2B) ? 4U : ((data[1] == RFAL_T4T_BER_LEN_1B) ? 3U : 2U));
+        }
+        
+        start = MAX( gT4tNdef.rxCnt, (uint32_t)gT4tNdef.hdrLen );
+        end   = MIN( (gT4tNdef.rxCnt + len), ((uint32_t)gT4tNdef.hdrLen + gT4tNdef.chunk) );
+        
+        if( end > start )
+        {
+            ST_MEMCPY( &gT4tNdef.ndefBuf[gT4tNdef.pos + (start - gT4tNdef.hdrLen)], &data[start - gT4tNdef.rxCnt], (end - start) );
+        }
+    }
+    
+    gT4tNdef.rxCnt += len;
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalT4tNdefSelectFile( const uint8_t *fid )
+{
+    if( gT4tNdef.cc.v1Mapping )
+    {
+        return rfalT4TPollerComposeSelectFileV1Mapping( (rfalIsoDepApduBufFormat*)gT4tNdef.txBuf, fid, RFAL_T4T_NLEN_LEN, &gT4tNdef.cApduLen );  /*  PRQA S 0310 # MISRA 11.3 - Intentional cast, only the C-APDU head is written */
+    }
+    
+    return rfalT4TPollerComposeSelectFile( (rfalIsoDepApduBufFormat*)gT4tNdef.txBuf, fid, RFAL_T4T_NLEN_LEN, &gT4tNdef.cApduLen );              /*  PRQA S 0310 # MISRA 11.3 - Intentional cast, only the C-APDU head is written */
+}
+
+
+/*******************************************************************************/
+/* Composes a READ BINARY, ODO beyond 7FFFh and extended Le above 256 bytes   */
+static ReturnCode rfalT4tNdefReadBinary( uint32_t offset, uint16_t len )
+{
+    ReturnCode              ret;
+    rfalIsoDepApduBufFormat *apdu;
+    
+    apdu            = (rfalIsoDepApduBufFormat*)gT4tNdef.txBuf;  /*  PRQA S 0310 # MISRA 11.3 - Intentional cast, only the C-APDU head is written */
+    gT4tNdef.chunk  = len;
+    gT4tNdef.isOdo  = (offset > RFAL_T4T_NDEF_OFFSET_MAX);
+    
+    if( gT4tNdef.isOdo )
+    {
+        /* Le covers the 53h data DO header, which is at most 3 bytes for a short Le */
+        return rfalT4TPollerComposeReadDataODO( apdu, offset, (uint8_t)(len + ((len < 0x80U) ? 2U : 3U)), &gT4tNdef.cApduLen );
+    }
+    
+    EXIT_ON_ERR( ret, rfalT4TPollerComposeReadData( apdu, (uint16_t)offset, (uint8_t)len, &gT4tNdef.cApduLen ) );
+    
+    /* Replace the short Le by the extended one: 00h LeH LeL */
+    if( len > RFAL_T4T_MAX_LE )
+    {
+        apdu->apdu[gT4tNdef.cApduLen - RFAL_T4T_LE_LEN] = 0x00U;
+        apdu->apdu[gT4tNdef.cApduLen++]                 = (uint8_t)(len >> 8U);
+        apdu->apdu[gT4tNdef.cApduLen++]                 = (uint8_t)(len & 0xFFU);
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+/* Composes the head of an UPDATE BINARY, the data is streamed by the TxCb   */
+/*   00h D6h [Offset] Lc | 00h D6h [Offset] 00h LcH LcL                       */
+/*   00h D7h 00h 00h  Lc 54h 03h [Offset] 53h Ld | 53h 81h Ld   beyond 7FFFh  */
+static void rfalT4tNdefUpdateBinary( uint32_t offset, const uint8_t *data, uint16_t len )
+{
+    uint8_t *hdr;
+    uint8_t it;
+    
+    hdr = gT4tNdef.cHdr;
+    it  = 0U;
+    
+    hdr[it++] = RFAL_T4T_CLA;
+    
+    if( offset > RFAL_T4T_NDEF_OFFSET_MAX )
+    {
+        hdr[it++] = (uint8_t)RFAL_T4T_INS_UPDATEBINARY_ODO;
+        hdr[it++] = 0x00U;
+        hdr[it++] = 0x00U;
+        hdr[it++] = (uint8_t)(len + ((len < 0x80U) ? (RFAL_T4T_NDEF_ODO_WR_OVH - 1U) : RFAL_T4T_NDEF_ODO_WR_OVH));
+        hdr[it++] = RFAL_T4T_OFFSET_DO;
+        hdr[it++] = RFAL_T4T_LENGTH_DO;
+        hdr[it++] = (uint8_t)(offset >> 16U);
+        hdr[it++] = (uint8_t)(offset >> 8U);
+        hdr[it++] = (uint8_t)(offset);
+        hdr[it++] = RFAL_T4T_DATA_DO;
+        if( len >= 0x80U )
+        {
+            hdr[it++] = RFAL_T4T_BER_LEN_1B;
+        }
+        hdr[it++] = (uint8_t)len;
+    }
+    else
+    {
+        hdr[it++] = (uint8_t)RFAL_T4T_INS_UPDATEBINARY;
+        hdr[it++] = (uint8_t)(offset >> 8U);
+        hdr[it++] = (uint8_t)(offset & 0xFFU);
+        if( len > RFAL_T4T_MAX_LC )
+        {
+            hdr[it++] = 0x00U;
+            hdr[it++] = (uint8_t)(len >> 8U);
+        }
+        hdr[it++] = (uint8_t)(len & 0xFFU);
+    }
+    
+    gT4tNdef.cHdrLen   = it;
+    gT4tNdef.txData    = data;
+    gT4tNdef.txDataLen = len;
+}
+
+
+/*******************************************************************************/
+/* Largest UPDATE BINARY data allowed by MLc, trimmed so that a C-APDU which */
+/* does not fit into one frame fills whole I-Blocks of the FSC               */
+static uint16_t rfalT4tNdefWriteLen( uint32_t offset, uint32_t left )
+{
+    uint32_t maxLen;
+    uint32_t hdrLen;
+    uint32_t infLen;
+    
+    if( offset > RFAL_T4T_NDEF_OFFSET_MAX )
+    {
+        /* The offset and data DOs are part of the short Lc */
+        maxLen = MIN( (uint32_t)gT4tNdef.cc.MLc, RFAL_T4T_MAX_LC );
+        maxLen = ((maxLen > RFAL_T4T_NDEF_ODO_WR_OVH) ? (maxLen - RFAL_T4T_NDEF_ODO_WR_OVH) : 0U);
+        hdrLen = RFAL_T4T_NDEF_CHDR_MAX;
+    }
+    else
+    {
+        /* MLc above 255 signals extended Lc support */
+        maxLen = gT4tNdef.cc.MLc;
+        hdrLen = (RFAL_T4T_MAX_CAPDU_PROLOGUE_LEN + ((maxLen > RFAL_T4T_MAX_LC) ? RFAL_T4T_EXT_LC_LEN : RFAL_T4T_LC_LEN));
+    }
+    
+    infLen = ((uint32_t)gT4tNdef.isoDepDev->info.FSx - RFAL_ISODEP_PCB_LEN - RFAL_CRC_LEN - (gT4tNdef.isoDepDev->info.supDID ? RFAL_ISODEP_DID_LEN : 0U));
+    
+    if( (maxLen > 0U) && (infLen > hdrLen) && ((hdrLen + maxLen) > infLen) )
+    {
+        maxLen = ((((hdrLen + maxLen) / infLen) * infLen) - hdrLen);
+    }
+    
+    return (uint16_t)MIN( left, maxLen );
+}
+
+
+/*******************************************************************************/
+/* Parses the CC file up to the NDEF/ENDEF File Control TLV   T4T 3.0 5.1     */
+static ReturnCode rfalT4tNdefParseCc( void )
+{
+    const uint8_t *cc;
+    uint8_t       major;
+    
+    cc    = gT4tNdef.resp;
+    major = (cc[2] >> 4U);
+    
+    gT4tNdef.cc.version = cc[2];
+    gT4tNdef.cc.MLe     = GETU16( &cc[3] );
+    gT4tNdef.cc.MLc     = GETU16( &cc[5] );
+    
+    if( (major == 0U) || (major > 3U) )
+    {
+        return ERR_NOTSUPP;
+    }
+    
+    if( gT4tNdef.cc.MLe < RFAL_T4T_NDEF_MLE_MIN )
+    {
+        return ERR_PROTO;
+    }
+    
+    gT4tNdef.cc.fileId[0] = cc[9];
+    gT4tNdef.cc.fileId[1] = cc[10];
+    
+    if( (cc[7] == RFAL_T4T_NDEF_TLV) && (cc[8] == RFAL_T4T_NDEF_TLV_LEN) )
+    {
+        gT4tNdef.cc.maxNdefSize = GETU16( &cc[11] );
+        gT4tNdef.cc.readAccess  = cc[13];
+        gT4tNdef.cc.writeAccess = cc[14];
+        gT4tNdef.cc.nlenLen     = RFAL_T4T_NLEN_LEN;
+    }
+    else if( (cc[7] == RFAL_T4T_ENDEF_TLV) && (cc[8] == RFAL_T4T_ENDEF_TLV_LEN) && (major == 3U) )
+    {
+        /* Access conditions are beyond the first 15 bytes, read on READ_CC_EXT */
+        gT4tNdef.cc.maxNdefSize = GETU32( &cc[11] );
+        gT4tNdef.cc.nlenLen     = RFAL_T4T_ENLEN_LEN;
+    }
+    else
+    {
+        return ERR_PROTO;
+    }
+    
+    if( gT4tNdef.cc.maxNdefSize < gT4tNdef.cc.nlenLen )
+    {
+        return ERR_PROTO;
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+/* Composes the C-APDU of the given state and starts its transceive          */
+static ReturnCode rfalT4tNdefNext( rfalT4tNdefState state )
+{
+    ReturnCode                ret;
+    uint32_t                  left;
+    uint16_t                  maxLen;
+    rfalIsoDepApduStreamParam stream;
+    
+    gT4tNdef.state  = state;
+    gT4tNdef.txData = NULL;
+    gT4tNdef.txPos  = 0U;
+    
+    switch( state )
+    {
+        case RFAL_T4T_NDEF_ST_SEL_APP:
+            EXIT_ON_ERR( ret, rfalT4TPollerComposeSelectAppl( (rfalIsoDepApduBufFormat*)gT4tNdef.txBuf, gT4tNdefAid, (uint8_t)sizeof(gT4tNdefAid), &gT4tNdef.cApduLen ) );     /*  PRQA S 0310 # MISRA 11.3 - Intentional cast, only the C-APDU head is written */
+            break;
+            
+        case RFAL_T4T_NDEF_ST_SEL_APP_V1:
+            EXIT_ON_ERR( ret, rfalT4TPollerComposeSelectAppl( (rfalIsoDepApduBufFormat*)gT4tNdef.txBuf, gT4tNdefAidV1, (uint8_t)sizeof(gT4tNdefAidV1), &gT4tNdef.cApduLen ) ); /*  PRQA S 0310 # MISRA 11.3 - Intentional cast, only the C-APDU head is written */
+            break;
+            
+        case RFAL_T4T_NDEF_ST_SEL_CC:
+            EXIT_ON_ERR( ret, rfalT4tNdefSelectFile( gT4tCcFid ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_READ_CC:
+            EXIT_ON_ERR( ret, rfalT4tNdefReadBinary( 0U, RFAL_T4T_NDEF_CC_LEN ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_READ_CC_EXT:
+            EXIT_ON_ERR( ret, rfalT4tNdefReadBinary( RFAL_T4T_NDEF_CC_LEN, (RFAL_T4T_NDEF_CC_EXT_LEN - RFAL_T4T_NDEF_CC_LEN) ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_SEL_NDEF:
+            EXIT_ON_ERR( ret, rfalT4tNdefSelectFile( gT4tNdef.cc.fileId ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_READ_NLEN:
+            EXIT_ON_ERR( ret, rfalT4tNdefReadBinary( 0U, gT4tNdef.cc.nlenLen ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_READ_DATA:
+            
+            /* Largest chunk allowed by MLe, ODO reads also carry the 53h data DO header */
+            left   = (gT4tNdef.nlen - gT4tNdef.pos);
+            maxLen = ((((uint32_t)gT4tNdef.cc.nlenLen + gT4tNdef.pos) > RFAL_T4T_NDEF_OFFSET_MAX) ? (uint16_t)(MIN( gT4tNdef.cc.MLe, RFAL_T4T_MAX_LE ) - RFAL_T4T_NDEF_ODO_HDR_MAX) : gT4tNdef.cc.MLe);
+            
+            EXIT_ON_ERR( ret, rfalT4tNdefReadBinary( (gT4tNdef.cc.nlenLen + gT4tNdef.pos), (uint16_t)MIN( left, (uint32_t)maxLen ) ) );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_WRITE_NLEN0:
+        case RFAL_T4T_NDEF_ST_WRITE_NLEN:
+            rfalT4tNdefUpdateBinary( 0U, gT4tNdef.nlenBuf, gT4tNdef.cc.nlenLen );
+            break;
+            
+        case RFAL_T4T_NDEF_ST_WRITE_DATA:
+            gT4tNdef.chunk = rfalT4tNdefWriteLen( (gT4tNdef.cc.nlenLen + gT4tNdef.pos), (gT4tNdef.nlen - gT4tNdef.pos) );
+            if( gT4tNdef.chunk == 0U )
+            {
+                return ERR_PROTO;
+            }
+            rfalT4tNdefUpdateBinary( (gT4tNdef.cc.nlenLen + gT4tNdef.pos), &gT4tNdef.ndefMsg[gT4tNdef.pos], gT4tNdef.chunk );
+            break;
+            
+        default:
+            return ERR_WRONG_STATE;
+    }
+    
+    gT4tNdef.rxCnt  = 0U;
+    gT4tNdef.sw     = 0U;
+    gT4tNdef.hdrLen = 0U;
+    
+    stream.txCb   = rfalT4tNdefTxCb;
+    stream.rxCb   = rfalT4tNdefRxCb;
+    stream.ctx    = NULL;
+    stream.txBuf  = gT4tNdef.txBuf;
+    stream.rxBuf  = gT4tNdef.rxBuf;
+    stream.rxLen  = NULL;
+    stream.FWT    = gT4tNdef.isoDepDev->info.FWT;
+    stream.dFWT   = gT4tNdef.isoDepDev->info.dFWT;
+    stream.FSx    = gT4tNdef.isoDepDev->info.FSx;
+    stream.ourFSx = RFAL_ISODEP_FSX_KEEP;
+    stream.DID    = (gT4tNdef.isoDepDev->info.supDID ? gT4tNdef.isoDepDev->info.DID : RFAL_ISODEP_NO_DID);
+    
+    EXIT_ON_ERR( ret, rfalIsoDepStartApduStream( stream ) );
+    return ERR_BUSY;
+}
+
+
+/*******************************************************************************/
+/* Handles the completed R-APDU and moves to the following command           */
+static ReturnCode rfalT4tNdefProcess( void )
+{
+    ReturnCode ret;
+    uint32_t   bodyLen;
+    
+    if( gT4tNdef.rxCnt < RFAL_T4T_MAX_RAPDU_SW1SW2_LEN )
+    {
+        return ERR_PROTO;
+    }
+    bodyLen = (gT4tNdef.rxCnt - RFAL_T4T_MAX_RAPDU_SW1SW2_LEN);
+    
+    if( gT4tNdef.sw != RFAL_T4T_ISO7816_STATUS_COMPLETE )
+    {
+        /* Cards implementing only Mapping Version 1 reject the current AID */
+        if( gT4tNdef.state == RFAL_T4T_NDEF_ST_SEL_APP )
+        {
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_APP_V1 );
+        }
+        return ERR_REQUEST;
+    }
+    
+    switch( gT4tNdef.state )
+    {
+        case RFAL_T4T_NDEF_ST_SEL_APP_V1:
+            gT4tNdef.cc.v1Mapping = true;
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_CC );
+            
+        case RFAL_T4T_NDEF_ST_SEL_APP:
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_CC );
+            
+        case RFAL_T4T_NDEF_ST_SEL_CC:
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_READ_CC );
+            
+        case RFAL_T4T_NDEF_ST_READ_CC:
+            if( bodyLen < RFAL_T4T_NDEF_CC_LEN )
+            {
+                return ERR_PROTO;
+            }
+            EXIT_ON_ERR( ret, rfalT4tNdefParseCc() );
+            
+            if( gT4tNdef.cc.nlenLen == RFAL_T4T_ENLEN_LEN )
+            {
+                return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_READ_CC_EXT );
+            }
+            break;
+            
+        case RFAL_T4T_NDEF_ST_READ_CC_EXT:
+            if( bodyLen < (RFAL_T4T_NDEF_CC_EXT_LEN - RFAL_T4T_NDEF_CC_LEN) )
+            {
+                return ERR_PROTO;
+            }
+            gT4tNdef.cc.readAccess  = gT4tNdef.resp[0];
+            gT4tNdef.cc.writeAccess = gT4tNdef.resp[1];
+            break;
+            
+        case RFAL_T4T_NDEF_ST_SEL_NDEF:
+            if( gT4tNdef.isWrite )
+            {
+                /* nlenBuf is still zeroed: invalidate the NDEF message first */
+                return rfalT4tNdefNext( (gT4tNdef.nlen == 0U) ? RFAL_T4T_NDEF_ST_WRITE_NLEN : RFAL_T4T_NDEF_ST_WRITE_NLEN0 );
+            }
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_READ_NLEN );
+            
+        case RFAL_T4T_NDEF_ST_WRITE_NLEN0:
+            gT4tNdef.tStart = platformGetCycles();                                 /* Throughput timed over the message data */
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_WRITE_DATA );
+            
+        case RFAL_T4T_NDEF_ST_WRITE_DATA:
+            gT4tNdef.pos += gT4tNdef.chunk;
+            
+            if( gT4tNdef.pos < gT4tNdef.nlen )
+            {
+                return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_WRITE_DATA );
+            }
+            
+            /* Message complete, validate it by writing its length */
+            if( gT4tNdef.cc.nlenLen == RFAL_T4T_ENLEN_LEN )
+            {
+                gT4tNdef.nlenBuf[0] = (uint8_t)(gT4tNdef.nlen >> 24U);
+                gT4tNdef.nlenBuf[1] = (uint8_t)(gT4tNdef.nlen >> 16U);
+                gT4tNdef.nlenBuf[2] = (uint8_t)(gT4tNdef.nlen >> 8U);
+                gT4tNdef.nlenBuf[3] = (uint8_t)(gT4tNdef.nlen);
+            }
+            else
+            {
+                gT4tNdef.nlenBuf[0] = (uint8_t)(gT4tNdef.nlen >> 8U);
+                gT4tNdef.nlenBuf[1] = (uint8_t)(gT4tNdef.nlen);
+            }
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_WRITE_NLEN );
+            
+        case RFAL_T4T_NDEF_ST_WRITE_NLEN:
+            if( gT4tNdef.rate != NULL )
+            {
+                *gT4tNdef.rate = rfalT4tNdefRate( gT4tNdef.nlen, platformCyclesToUs( platformGetCycles() - gT4tNdef.tStart ) );
+            }
+            return ERR_NONE;
+            
+        case RFAL_T4T_NDEF_ST_READ_NLEN:
+            if( bodyLen < gT4tNdef.cc.nlenLen )
+            {
+                return ERR_PROTO;
+            }
+            
+            gT4tNdef.nlen = ((gT4tNdef.cc.nlenLen == RFAL_T4T_ENLEN_LEN) ? GETU32( gT4tNdef.resp ) : (uint32_t)GETU16( gT4tNdef.resp ));
+            gT4tNdef.pos  = 0U;
+            
+            if( gT4tNdef.nlen > (gT4tNdef.cc.maxNdefSize - gT4tNdef.cc.nlenLen) )
+            {
+                return ERR_PROTO;
+            }
+            if( gT4tNdef.nlen > gT4tNdef.ndefBufLen )
+            {
+                return ERR_NOMEM;
+            }
+            if( gT4tNdef.nlen == 0U )
+            {
+                *gT4tNdef.ndefLen = 0U;
+                return ERR_NONE;
+            }
+            return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_READ_DATA );
+            
+        case RFAL_T4T_NDEF_ST_READ_DATA:
+            
+            /* Card may return less than requested but never nothing */
+            if( (bodyLen <= gT4tNdef.hdrLen) || ((bodyLen - gT4tNdef.hdrLen) > gT4tNdef.chunk) )
+            {
+                return ERR_PROTO;
+            }
+            
+            gT4tNdef.pos            += (bodyLen - gT4tNdef.hdrLen);
+            *gT4tNdef.ndefLen  = gT4tNdef.pos;
+            
+            if( gT4tNdef.pos < gT4tNdef.nlen )
+            {
+                return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_READ_DATA );
+            }
+            return ERR_NONE;
+            
+        default:
+            return ERR_WRONG_STATE;
+    }
+    
+    /* CC file complete */
+    if( gT4tNdef.ccOut != NULL )
+    {
+        *gT4tNdef.ccOut = gT4tNdef.cc;
+    }
+    
+    if( gT4tNdef.isWrite )
+    {
+        if( gT4tNdef.cc.writeAccess != RFAL_T4T_NDEF_ACCESS_GRANTED )
+        {
+            return ERR_NOTSUPP;
+        }
+        if( gT4tNdef.nlen > (gT4tNdef.cc.maxNdefSize - gT4tNdef.cc.nlenLen) )
+        {
+            return ERR_NOMEM;
+        }
+    }
+    else if( gT4tNdef.cc.readAccess != RFAL_T4T_NDEF_ACCESS_GRANTED )
+    {
+        return ERR_NOTSUPP;
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+    
+    return rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_NDEF );
+}
+
+
+/*******************************************************************************/ 
+ReturnCode rfalT4TPollerStartNdefRead( const rfalT4tNdefReadParam *param )
+{
+    ReturnCode ret;
+    
+    if( (param == NULL) || (param->isoDepDev == NULL) || (param->txBuf == NULL) || (param->rxBuf == NULL) || (param->txBuf == param->rxBuf) || (param->ndefLen == NULL) || ((param->ndefBuf == NULL) && (param->ndefBufLen > 0U)) )
+    {
+        return ERR_PARAM;
+    }
+    
+    ST_MEMSET( &gT4tNdef, 0x00, sizeof(rfalT4tNdefCtx) );
+    gT4tNdef.isoDepDev  = param->isoDepDev;
+    gT4tNdef.txBuf      = param->txBuf;
+    gT4tNdef.rxBuf      = param->rxBuf;
+    gT4tNdef.ndefBuf    = param->ndefBuf;
+    gT4tNdef.ndefBufLen = param->ndefBufLen;
+    gT4tNdef.ndefLen    = param->ndefLen;
+    gT4tNdef.ccOut      = param->cc;
+    *param->ndefLen     = 0U;
+    
+    ret = rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_APP );
+    if( ret != ERR_BUSY )
+    {
+        gT4tNdef.state = RFAL_T4T_NDEF_ST_IDLE;
+        return ret;
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/ 
+ReturnCode rfalT4TPollerGetNdefReadStatus( void )
+{
+    return rfalT4tNdefGetStatus( false );
+}
+
+
+/*******************************************************************************/ 
+ReturnCode rfalT4TPollerStartNdefWrite( const rfalT4tNdefWriteParam *param )
+{
+    ReturnCode ret;
+    
+    if( (param == NULL) || (param->isoDepDev == NULL) || (param->txBuf == NULL) || (param->rxBuf == NULL) || (param->txBuf == param->rxBuf) || ((param->ndefMsg == NULL) && (param->ndefMsgLen > 0U)) )
+    {
+        return ERR_PARAM;
+    }
+    
+    ST_MEMSET( &gT4tNdef, 0x00, sizeof(rfalT4tNdefCtx) );
+    gT4tNdef.isWrite   = true;
+    gT4tNdef.isoDepDev = param->isoDepDev;
+    gT4tNdef.txBuf     = param->txBuf;
+    gT4tNdef.rxBuf     = param->rxBuf;
+    gT4tNdef.ndefMsg   = param->ndefMsg;
+    gT4tNdef.nlen      = param->ndefMsgLen;
+    gT4tNdef.rate      = param->rate;
+    gT4tNdef.ccOut     = param->cc;
+    
+    ret = rfalT4tNdefNext( RFAL_T4T_NDEF_ST_SEL_APP );
+    if( ret != ERR_BUSY )
+    {
+        gT4tNdef.state = RFAL_T4T_NDEF_ST_IDLE;
+        return ret;
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/ 
+ReturnCode rfalT4TPollerGetNdefWriteStatus( void )
+{
+    return rfalT4tNdefGetStatus( true );
+}
+
+
+/*******************************************************************************/
+static ReturnCode rfalT4tNdefGetStatus( bool isWrite )
+{
+    ReturnCode ret;
+    
+    if( (gT4tNdef.state == RFAL_T4T_NDEF_ST_IDLE) || (gT4tNdef.isWrite != isWrite) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    ret = rfalIsoDepGetApduStreamStatus();
+    if( ret == ERR_NONE )
+    {
+        ret = rfalT4tNdefProcess();
+    }
+    
+    if( ret != ERR_BUSY )
+    {
+        gT4tNdef.state = RFAL_T4T_NDEF_ST_IDLE;
+    }
+    
+    return ret;
+}
+
 #endif /* RFAL_FEATURE_T4T */
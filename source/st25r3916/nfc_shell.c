@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Shell commands exposing the RFAL NFC discovery loop statistics:
+ *   nfc stats        - print the latency and failure counters per phase
+ *   nfc stats reset  - clear the statistics
+ */
+
+#if defined(CONFIG_ST25R3916_LIB_SHELL)
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include "rfal_nfc.h"
+
+
+static const char * const techNames[RFAL_NFC_POLL_TECH_CNT] = {
+	"A", "B", "F", "V", "AP2P", "ST25TB", "PROP"
+};
+
+
+static void nfc_shell_phase_print(const struct shell *sh, const char *name,
+				  const char *tech, const rfalNfcPhaseStats *ph)
+{
+	if (ph->cnt == 0U) {
+		return;
+	}
+
+	shell_print(sh, "%-14s %-6s %8u %8u %10u %10u %10u %10u",
+		    name, tech, ph->cnt, ph->failCnt, ph->last, ph->min,
+		    (uint32_t)(ph->total / ph->cnt), ph->max);
+}
+
+
+static int cmd_nfc_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	rfalNfcStats stats;
+	uint8_t i;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (rfalNfcGetStats(&stats) != ERR_NONE) {
+		shell_error(sh, "NFC statistics not available");
+		return -ENOTSUP;
+	}
+
+	shell_print(sh, "Discovery cycles: %u (durations in us)", stats.cycleCnt);
+	shell_print(sh, "%-14s %-6s %8s %8s %10s %10s %10s %10s",
+		    "phase", "tech", "count", "failed", "last", "min", "avg", "max");
+
+	nfc_shell_phase_print(sh, "wake-up", "-", &stats.wakeUp);
+	for (i = 0; i < RFAL_NFC_POLL_TECH_CNT; i++) {
+		nfc_shell_phase_print(sh, "tech-detect", techNames[i], &stats.techDetect[i]);
+	}
+	nfc_shell_phase_print(sh, "coll-res", "-", &stats.collResolution);
+	for (i = 0; i < RFAL_NFC_POLL_TECH_CNT; i++) {
+		nfc_shell_phase_print(sh, "activation", techNames[i], &stats.activation[i]);
+	}
+	nfc_shell_phase_print(sh, "deactivation", "-", &stats.deactivation);
+	nfc_shell_phase_print(sh, "discovery", "-", &stats.discovery);
+
+	return 0;
+}
+
+
+static int cmd_nfc_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	rfalNfcResetStats();
+	shell_print(sh, "NFC statistics cleared");
+
+	return 0;
+}
+
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nfc_stats,
+	SHELL_CMD(reset, NULL, "Clear the discovery statistics", cmd_nfc_stats_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nfc,
+	SHELL_CMD(stats, &sub_nfc_stats, "Print the discovery phase latency statistics", cmd_nfc_stats),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(nfc, &sub_nfc, "ST25R3916 NFC commands", NULL);
+
+#endif /* CONFIG_ST25R3916_LIB_SHELL */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2019 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+
+#include <zephyr/kernel.h>
+#include "pltf_nfc.h"
+#include "rfal_rf.h"
+#include "utils.h"
+
+
+static struct k_poll_signal  irqSignal;   /* Raised on every ST25R3916 interrupt   */
+static struct k_poll_signal *doneSignal;  /* Raised on Data Exchange completion    */
+static volatile ReturnCode   doneErr;     /* Outcome of the blocking Data Exchange */
+static volatile bool         isDone;      /* Blocking Data Exchange has terminated */
+
+
+/*******************************************************************************/
+static void nfcIrqCallback( void )
+{
+	/* Called by st25r3916Isr() once the interrupt status has been read */
+	k_poll_signal_raise( &irqSignal, 0 );
+}
+
+
+/*******************************************************************************/
+static void nfcDataExchangeSignal( ReturnCode err )
+{
+	struct k_poll_signal *sig;
+
+	sig        = doneSignal;
+	doneSignal = NULL;
+
+	if( sig != NULL )
+	{
+		k_poll_signal_raise( sig, (int)err );
+	}
+}
+
+
+/*******************************************************************************/
+static void nfcDataExchangeDone( ReturnCode err )
+{
+	doneErr = err;
+	isDone  = true;
+}
+
+
+/*******************************************************************************/
+void nfcEventInit( void )
+{
+	k_poll_signal_init( &irqSignal );
+	doneSignal = NULL;
+
+	rfalSetUpperLayerCallback( nfcIrqCallback );
+}
+
+
+/*******************************************************************************/
+bool nfcEventWait( k_timeout_t timeout )
+{
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER( K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &irqSignal );
+	int ret;
+
+	ret = k_poll( &evt, 1, timeout );
+
+	/* The status is already stored when raised, a later interrupt raises it again */
+	k_poll_signal_reset( &irqSignal );
+
+	return (ret == 0);
+}
+
+
+/*******************************************************************************/
+ReturnCode nfcDataExchangeStartSignal( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt, struct k_poll_signal *done )
+{
+	ReturnCode err;
+
+	if( done == NULL )
+	{
+		return ERR_PARAM;
+	}
+
+	if( doneSignal != NULL )
+	{
+		return ERR_BUSY;
+	}
+
+	k_poll_signal_reset( done );
+	doneSignal = done;
+
+	err = rfalNfcDataExchangeStartCb( txData, txDataLen, rxData, rvdLen, fwt, nfcDataExchangeSignal );
+	if( err != ERR_NONE )
+	{
+		doneSignal = NULL;
+	}
+
+	return err;
+}
+
+
+/*******************************************************************************/
+ReturnCode nfcDataExchangeBlocking( uint8_t *txData, uint16_t txDataLen, uint8_t **rxData, uint16_t **rvdLen, uint32_t fwt )
+{
+	ReturnCode err;
+
+	isDone = false;
+	EXIT_ON_ERR( err, rfalNfcDataExchangeStartCb( txData, txDataLen, rxData, rvdLen, fwt, nfcDataExchangeDone ) );
+
+	rfalNfcWorker();
+	while( !isDone )
+	{
+		/* Sleep until the ST25R3916 signals, the worker period only serves SW timers */
+		nfcEventWait( K_MSEC( NFC_EVENT_WORKER_PERIOD ) );
+		rfalNfcWorker();
+	}
+
+	return doneErr;
+}
@@ -68,3 +68,17 @@ void timerDelay( uint16_t tOut )
    k_sleep(K_MSEC(tOut)); 
 }
 
+
+
+/*******************************************************************************/
+uint32_t timerGetCycles( void )
+{
+   return k_cycle_get_32();
+}
+
+
+/*******************************************************************************/
+uint32_t timerCyclesToUs( uint32_t cycles )
+{
+   return k_cyc_to_us_floor32( cycles );
+}
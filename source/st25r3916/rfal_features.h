@@ -177,6 +177,11 @@ typedef struct
         bool             aaInclMeas;      /*!< When AutoAvg is enabled, include IRQ measurement           */
         rfalWumAAWeight  aaWeight;        /*!< When AutoAvg is enabled, last measure weight               */
     }cap;                                 /*!< Capacitive Configuration                                   */
+    struct{
+        bool             enabled;         /*!< Derive the deltas from the tracked noise floor             */
+        uint8_t          noiseMult;       /*!< Delta = noise floor * noiseMult + false wake margin        */
+        uint8_t          maxDelta;        /*!< Upper limit for the derived delta; 0: no limit             */
+    }adaptive;                            /*!< Adaptive thresholds; configured deltas act as minimum      */
 } rfalWakeUpConfig;
 
 
@@ -187,18 +192,43 @@ typedef struct
     struct{
         uint8_t          lastMeas;        /*!< Value of the latest measurement                            */
         uint16_t         reference;       /*!< Current reference value (TD format if SW TD enabled)       */
+        uint16_t         noise;           /*!< Tracked noise floor (TD format)                            */
+        uint16_t         delta;           /*!< Delta currently applied (TD format)                        */
         bool             irqWu;           /*!< Amplitude WU IRQ received (cleared upon read)              */
     }indAmp;                              /*!< Inductive Amplitude                                        */
     struct{                                                                                               
         uint8_t          lastMeas;        /*!< Value of the latest measurement                            */
         uint16_t         reference;       /*!< Current reference value (TD format if SW TD enabled)       */
+        uint16_t         noise;           /*!< Tracked noise floor (TD format)                            */
+        uint16_t         delta;           /*!< Delta currently applied (TD format)                        */
         bool             irqWu;           /*!< Phase WU IRQ received (cleared upon read)                  */
     }indPha;                              /*!< Inductive Phase                                            */
     struct{                                                                                               
         uint8_t          lastMeas;        /*!< Value of the latest measurement                            */
         uint16_t         reference;       /*!< Current reference value                                    */
+        uint16_t         noise;           /*!< Tracked noise floor (TD format)                            */
+        uint16_t         delta;           /*!< Delta currently applied (TD format)                        */
         bool             irqWu;           /*!< Capacitive WU IRQ received (cleared upon read)             */
     }cap;                                 /*!< Capacitive                                                 */
+    uint32_t             wakeCnt;         /*!< Wake-ups since initialization                              */
+    uint32_t             falseWakeCnt;    /*!< Wake-ups reported with no device found                     */
+    uint16_t             falseWakeMargin; /*!< Margin currently added to the derived deltas (TD format)   */
 } rfalWakeUpInfo;
 
+
+/*! RFAL Wake-Up Mode duty-cycle and energy statistics */
+typedef struct 
+{
+    uint32_t             wutCnt;          /*!< Wake-Up Timer events (WUT IRQ enabled only)                */
+    uint32_t             wokeCnt;         /*!< Wake-up events                                             */
+    uint32_t             indAmpMeasCnt;   /*!< Inductive Amplitude measurements performed                 */
+    uint32_t             indPhaMeasCnt;   /*!< Inductive Phase measurements performed                     */
+    uint32_t             capMeasCnt;      /*!< Capacitive measurements performed                          */
+    uint32_t             fieldOnCnt;      /*!< Field On events (polling cycles with the field On)         */
+    uint32_t             wumTime;         /*!< Time spent in Wake-Up Mode (ms)                            */
+    uint32_t             fieldOnTime;     /*!< Time spent with the field On (ms)                          */
+    uint32_t             elapsedTime;     /*!< Time since the statistics were reset (ms)                  */
+    uint32_t             chargePerHour;   /*!< Estimated charge drawn per hour (uAh), i.e. average uA     */
+} rfalWakeUpStats;
+
 #endif /* RFAL_FEATURES_H */
@@ -118,11 +118,50 @@ typedef struct{
 } rfalLm;
 
 
+/*! Struct that holds the adaptive threshold state of one Wake-Up sensor                          */
+typedef struct{
+    uint16_t             noise;      /*!< Noise floor: average |measurement - reference| (TD fmt) */
+    uint16_t             delta;      /*!< Delta currently applied (TD format)                     */
+    uint8_t              hwDelta;    /*!< Delta currently written to the measure conf register    */
+}rfalWumAdaptSensor;
+
+
+/*! Struct that holds the adaptive Wake-Up state, kept across Wake-Up Mode start/stop             */
+typedef struct{
+    rfalWumAdaptSensor   indAmp;     /*!< Inductive Amplitude adaptive state                      */
+    rfalWumAdaptSensor   indPha;     /*!< Inductive Phase adaptive state                          */
+    rfalWumAdaptSensor   cap;        /*!< Capacitive adaptive state                               */
+    uint16_t             margin;     /*!< False wake margin added to the derived deltas (TD fmt)  */
+    uint32_t             wakeCnt;    /*!< Number of wake-ups                                      */
+    uint32_t             falseWakeCnt;/*!< Number of wake-ups reported with no device found       */
+    bool                 pending;    /*!< Last wake-up awaits rfalWakeUpModeReportResult()        */
+}rfalWumAdapt;
+
+
+/*! Struct that holds the Wake-Up duty-cycle and energy accounting                                */
+typedef struct{
+    uint32_t             wutCnt;     /*!< Wake-Up Timer events                                    */
+    uint32_t             indAmpCnt;  /*!< Inductive Amplitude measurements (completed WUM runs)   */
+    uint32_t             indPhaCnt;  /*!< Inductive Phase measurements (completed WUM runs)       */
+    uint32_t             capCnt;     /*!< Capacitive measurements (completed WUM runs)            */
+    uint32_t             swTdCnt;    /*!< SW Tag Detection cycles (Ready mode + settle time)      */
+    uint32_t             fieldOnCnt; /*!< Field On events                                         */
+    uint32_t             wumTime;    /*!< Time in Wake-Up Mode (completed WUM runs) (ms)          */
+    uint32_t             fieldOnTime;/*!< Time with the field On (completed periods) (ms)         */
+    uint32_t             startTime;  /*!< Accounting start time                                   */
+    uint32_t             wumStart;   /*!< Current Wake-Up Mode run start time                     */
+    uint32_t             fieldStart; /*!< Current field On period start time                      */
+    bool                 fieldOn;    /*!< Field currently accounted as On                         */
+}rfalWumAcct;
+
+
 /*! Struct that holds all context for the Wake-Up Mode                                            */
 typedef struct{
     rfalWumState            state;       /*!< Current Wake-Up Mode state                          */
     rfalWakeUpConfig        cfg;         /*!< Current Wake-Up Mode config                         */
     rfalWakeUpData          info;        /*!< Current Wake-Up Mode info                           */
+    rfalWumAdapt            adapt;       /*!< Adaptive thresholds and false wake statistics       */
+    rfalWumAcct             acct;        /*!< Duty-cycle and energy accounting                    */
 } rfalWum;
 
 
@@ -317,6 +356,13 @@ typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Both members are of the same type
 #define RFAL_ISO15693_INV_RES_DUR       4U                                            /*!< ISO15693 Inventory response duration @ 26 kbps (ms)                             */
 
 #define RFAL_WU_MIN_WEIGHT_VAL          4U                                            /*!< ST25R3916 minimum Wake-up weight value                                         */
+#define RFAL_WU_ADAPT_NOISE_WEIGHT      16U                                           /*!< Weight of the noise floor average (adaptive Wake-up)                           */
+#define RFAL_WU_ADAPT_MARGIN_STEP       64U                                           /*!< Margin added per false wake-up, TD format: 0.25                                */
+#define RFAL_WU_ADAPT_MARGIN_MAX        0x0400U                                       /*!< Maximum false wake margin, TD format: 4                                        */
+#define RFAL_WU_ADAPT_MARGIN_DECAY      8U                                            /*!< Quiet WUT periods decay the margin by 1/2^n each                               */
+#define RFAL_WU_HW_DELTA_MAX            15U                                           /*!< ST25R3916 maximum Wake-up delta (4 bits)                                       */
+#define RFAL_WU_REG_AA_RESULT_OFFSET    2U                                            /*!< Offset of the Auto Averaging Display Reg from the sensor Measure Conf Reg      */
+#define RFAL_WU_REG_RESULT_OFFSET       3U                                            /*!< Offset of the Measurement Display Reg from the sensor Measure Conf Reg         */
 
 /*******************************************************************************/
 
@@ -329,6 +375,23 @@ typedef union{  /*  PRQA S 0750 # MISRA 19.2 - Both members are of the same type
     #define RFAL_ST25R3916_AAT_SETTLE   5U                                            /*!< Time in ms required for AAT pins and Osc to settle after en bit set             */
 #endif /* RFAL_ST25R3916_AAT_SETTLE */
 
+/* Energy model used by rfalWakeUpModeGetStats(), typical figures to be tuned for the actual antenna/design */
+#ifndef RFAL_ST25R3916_I_WUM_NA
+    #define RFAL_ST25R3916_I_WUM_NA     3600U                                         /*!< Wake-Up Mode current in between measurements (nA)                              */
+#endif /* RFAL_ST25R3916_I_WUM_NA */
+#ifndef RFAL_ST25R3916_Q_MEAS_IND_NC
+    #define RFAL_ST25R3916_Q_MEAS_IND_NC 2000U                                        /*!< Charge per inductive (amplitude|phase) measurement, Osc start + Tx (nC)        */
+#endif /* RFAL_ST25R3916_Q_MEAS_IND_NC */
+#ifndef RFAL_ST25R3916_Q_MEAS_CAP_NC
+    #define RFAL_ST25R3916_Q_MEAS_CAP_NC 500U                                         /*!< Charge per capacitive measurement (nC)                                         */
+#endif /* RFAL_ST25R3916_Q_MEAS_CAP_NC */
+#ifndef RFAL_ST25R3916_I_READY_UA
+    #define RFAL_ST25R3916_I_READY_UA   1500U                                         /*!< Ready mode current: Osc On, field Off (uA)                                     */
+#endif /* RFAL_ST25R3916_I_READY_UA */
+#ifndef RFAL_ST25R3916_I_FIELD_UA
+    #define RFAL_ST25R3916_I_FIELD_UA   100000U                                       /*!< Field On current, antenna dependent (uA)                                       */
+#endif /* RFAL_ST25R3916_I_FIELD_UA */
+
 
 /*! FWT adjustment: 
  *    64 : NRT jitter between TXE and NRT start      */
@@ -464,6 +527,14 @@ static ReturnCode rfalRunListenModeWorker( void );
 #if RFAL_FEATURE_WAKEUP_MODE
 static void rfalRunWakeUpModeWorker( void );
 static uint16_t rfalWakeUpModeFilter( uint16_t curRef, uint16_t curVal, uint8_t weight );
+static void rfalWakeUpModeAdaptUpdate( rfalWumAdaptSensor *sensor, uint16_t reference, uint16_t value, uint16_t minDelta );
+static void rfalWakeUpModeAdaptDelta( rfalWumAdaptSensor *sensor, uint16_t minDelta );
+static uint8_t rfalWakeUpModeAdaptHwDelta( const rfalWumAdaptSensor *sensor, uint8_t cfgDelta );
+static void rfalWakeUpModeAdaptHw( rfalWumAdaptSensor *sensor, uint8_t cfgDelta, bool autoAvg, uint16_t reference, uint8_t regConf, uint8_t dMask, uint8_t dShift );
+static uint32_t rfalWakeUpModeHwMeasCnt( uint32_t wumTime );
+static void rfalWakeUpModeAccountField( bool fieldOn );
+#else
+    #define rfalWakeUpModeAccountField( on )   /* Field On time is only accounted with Wake-Up Mode support */
 #endif /* RFAL_FEATURE_WAKEUP_MODE */
 
 static void rfalFIFOStatusUpdate( void );
@@ -557,6 +628,8 @@ ReturnCode rfalInitialize( void )
 #if RFAL_FEATURE_WAKEUP_MODE
     /* Initialize Wake-Up Mode */
     gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
+    ST_MEMSET( &gRFAL.wum.adapt, 0x00, sizeof(rfalWumAdapt) );
+    rfalWakeUpModeResetStats();
 #endif /* RFAL_FEATURE_WAKEUP_MODE */
 
 #if RFAL_FEATURE_LOWPOWER_MODE
@@ -1232,6 +1305,7 @@ ReturnCode rfalFieldOnAndStartGT( void )
         gRFAL.timings.nTRFW = rfalGennTRFW( gRFAL.timings.nTRFW );
         
         gRFAL.field = st25r3916IsTxEnabled();
+        rfalWakeUpModeAccountField( gRFAL.field );
         
         /* Only turn on Receiver and Transmitter if field was successfully turned On */
         if(gRFAL.field)
@@ -1267,6 +1341,7 @@ ReturnCode rfalFieldOff( void )
     /* Set Analog configurations for Field Off event */
     rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_FIELD_OFF) );
     gRFAL.field = false;
+    rfalWakeUpModeAccountField( false );
     
     return ERR_NONE;
 }
@@ -2783,6 +2858,17 @@ static uint8_t rfalFIFOGetNumIncompleteBits( void )
 ReturnCode rfalISO14443ATransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt )
 {
     ReturnCode ret;
+    
+    EXIT_ON_ERR( ret, rfalISO14443AStartTransceiveShortFrame( txCmd, rxBuf, rxBufLen, rxRcvdLen, fwt ) );
+    rfalRunBlocking( ret, rfalISO14443AGetTransceiveShortFrameStatus() );
+    
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443AStartTransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt )
+{
     uint8_t    directCmd;
 
     /* Check if RFAL is properly initialized */
@@ -2876,22 +2962,37 @@ ReturnCode rfalISO14443ATransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uin
     /* Wait for TXE */
     if( st25r3916WaitForInterruptsTimed( ST25R3916_IRQ_MASK_TXE, (uint16_t)MAX( rfalConv1fcToMs( fwt ), RFAL_ST25R3916_SW_TMR_MIN_1MS ) ) == 0U )
     {
-        ret = ERR_IO;
-    }
-    else
-    {
-        /*Check if Observation Mode is enabled and set it on ST25R391x */
-        rfalCheckEnableObsModeRx();
+        /* Disable Collision interrupt and ReEnable CRC on Rx */
+        st25r3916DisableInterrupts( (ST25R3916_IRQ_MASK_COL) );
+        st25r3916ClrRegisterBits( ST25R3916_REG_AUX, ST25R3916_REG_AUX_no_crc_rx );
         
-        /* Jump into a transceive Rx state for reception (bypass Tx states) */
-        gRFAL.state       = RFAL_STATE_TXRX;
-        gRFAL.TxRx.state  = RFAL_TXRX_STATE_RX_IDLE;
-        gRFAL.TxRx.status = ERR_BUSY;
-        
-        /* Execute Transceive Rx blocking */
-        ret = rfalTransceiveBlockingRx();
+        return ERR_IO;
     }
     
+    /*Check if Observation Mode is enabled and set it on ST25R391x */
+    rfalCheckEnableObsModeRx();
+    
+    /* Jump into a transceive Rx state for reception (bypass Tx states) */
+    gRFAL.state       = RFAL_STATE_TXRX;
+    gRFAL.TxRx.state  = RFAL_TXRX_STATE_RX_IDLE;
+    gRFAL.TxRx.status = ERR_BUSY;
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443AGetTransceiveShortFrameStatus( void )
+{
+    ReturnCode ret;
+    
+    ret = rfalGetTransceiveStatus();
+    
+    /* Wait until reception has terminated */
+    if( ret == ERR_BUSY )
+    {
+        return ret;
+    }
     
     /* Disable Collision interrupt */
     st25r3916DisableInterrupts( (ST25R3916_IRQ_MASK_COL) );
@@ -3019,25 +3120,11 @@ ReturnCode rfalISO14443ATransceiveAnticollisionFrame( uint8_t *buf, uint8_t *byt
 #if RFAL_FEATURE_NFCV
 
 /*******************************************************************************/
-ReturnCode rfalISO15693TransceiveAnticollisionFrame( uint8_t *txBuf, uint8_t txBufLen, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen )
+static ReturnCode rfalISO15693AnticollisionTxRx( uint8_t *txBuf, uint8_t txBufLen, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen )
 {
     ReturnCode            ret;
     rfalTransceiveContext ctx;
     
-    /* Check if RFAL is properly initialized */
-    if( (gRFAL.state < RFAL_STATE_MODE_SET) || ( gRFAL.mode != RFAL_MODE_POLL_NFCV ) )
-    {
-        return ERR_WRONG_STATE;
-    }
-    
-    /*******************************************************************************/
-    /* Set speficic Analog Config for Anticolission if needed */
-    rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_ANTICOL) );
-    
-    
-    /* Ignoring collisions before the UID (RES_FLAG + DSFID) */
-    gRFAL.nfcvData.ignoreBits = (uint16_t)RFAL_ISO15693_IGNORE_BITS;
-    
     /*******************************************************************************/
     /* Prepare for Transceive  */
     ctx.flags     = ((txBufLen==0U)?(uint32_t)RFAL_TXRX_FLAGS_CRC_TX_MANUAL:(uint32_t)RFAL_TXRX_FLAGS_CRC_TX_AUTO) | (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP | (uint32_t)RFAL_TXRX_FLAGS_AGC_OFF | ((txBufLen==0U)?(uint32_t)RFAL_TXRX_FLAGS_NFCV_FLAG_MANUAL:(uint32_t)RFAL_TXRX_FLAGS_NFCV_FLAG_AUTO); /* Disable Automatic Gain Control (AGC) for better detection of collision */
@@ -3066,6 +3153,31 @@ ReturnCode rfalISO15693TransceiveAnticollisionFrame( uint8_t *txBuf, uint8_t txB
         platformDelay( (uint8_t)( (RFAL_ISO15693_INV_RES_LEN - rfalConvBitsToBytes(*ctx.rxRcvdLen)) / ((RFAL_ISO15693_INV_RES_LEN / RFAL_ISO15693_INV_RES_DUR)+1U) ));
     }
     
+    return ret;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO15693TransceiveAnticollisionFrame( uint8_t *txBuf, uint8_t txBufLen, uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen )
+{
+    ReturnCode ret;
+    
+    /* Check if RFAL is properly initialized */
+    if( (gRFAL.state < RFAL_STATE_MODE_SET) || ( gRFAL.mode != RFAL_MODE_POLL_NFCV ) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    /*******************************************************************************/
+    /* Set speficic Analog Config for Anticolission if needed */
+    rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_ANTICOL) );
+    
+    
+    /* Ignoring collisions before the UID (RES_FLAG + DSFID) */
+    gRFAL.nfcvData.ignoreBits = (uint16_t)RFAL_ISO15693_IGNORE_BITS;
+    
+    ret = rfalISO15693AnticollisionTxRx( txBuf, txBufLen, rxBuf, rxBufLen, actLen );
+    
     /* Restore common Analog configurations for this mode */
     rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX) );
     rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX) );
@@ -3074,6 +3186,54 @@ ReturnCode rfalISO15693TransceiveAnticollisionFrame( uint8_t *txBuf, uint8_t txB
     return ret;
 }
 
+
+/*******************************************************************************/
+ReturnCode rfalISO15693TransceiveAnticollisionSlots( uint8_t *txBuf, uint8_t txBufLen, uint8_t slotCnt, uint8_t slotGap, uint8_t *rxBuf, uint8_t rxSlotLen, rfalISO15693SlotRes *slotRes )
+{
+    uint8_t slot;
+    uint8_t dummy;
+    
+    /* Check if RFAL is properly initialized */
+    if( (gRFAL.state < RFAL_STATE_MODE_SET) || ( gRFAL.mode != RFAL_MODE_POLL_NFCV ) )
+    {
+        return ERR_WRONG_STATE;
+    }
+    
+    if( (txBuf == NULL) || (rxBuf == NULL) || (slotRes == NULL) || (slotCnt == 0U) )
+    {
+        return ERR_PARAM;
+    }
+    
+    /*******************************************************************************/
+    /* Anticollision configuration is kept for the whole slot sequence */
+    rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_ANTICOL) );
+    gRFAL.nfcvData.ignoreBits = (uint16_t)RFAL_ISO15693_IGNORE_BITS;
+    
+    for( slot = 0; slot < slotCnt; slot++ )
+    {
+        /* INVENTORY_REQ opens the first slot, an EOF each of the following ones */
+        slotRes[slot].ret = rfalISO15693AnticollisionTxRx( ((slot == 0U) ? txBuf : &dummy), ((slot == 0U) ? txBufLen : 0U), &rxBuf[(slot * rxSlotLen)], rxSlotLen, &slotRes[slot].rxLen );
+        
+        if( slotRes[slot].ret == ERR_TIMEOUT )
+        {
+            slotRes[slot].rxLen = 0;
+        }
+        
+        /* Collision or partial response on this slot, ensure the gap before the next EOF (an empty slot already waited the FWT) */
+        if( (slotRes[slot].ret != ERR_TIMEOUT) && (rfalConvBitsToBytes(slotRes[slot].rxLen) < RFAL_ISO15693_INV_RES_LEN) )
+        {
+            platformDelay( slotGap );
+        }
+    }
+    
+    /* Restore common Analog configurations for this mode */
+    rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.txBR) | RFAL_ANALOG_CONFIG_TX) );
+    rfalSetAnalogConfig( (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | rfalConvBR2ACBR(gRFAL.rxBR) | RFAL_ANALOG_CONFIG_RX) );
+    
+    gRFAL.nfcvData.ignoreBits = 0;
+    return ERR_NONE;
+}
+
 /*******************************************************************************/
 ReturnCode rfalISO15693TransceiveEOFAnticollision( uint8_t *rxBuf, uint8_t rxBufLen, uint16_t *actLen )
 {
@@ -4300,6 +4460,7 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
         gRFAL.wum.cfg.indAmp.fracDelta = 0U;
         gRFAL.wum.cfg.indAmp.reference = RFAL_WUM_REFERENCE_AUTO;
         gRFAL.wum.cfg.indAmp.autoAvg   = false;
+        gRFAL.wum.cfg.adaptive.enabled = false;
         
         /*******************************************************************************/
         /* Check if AAT is enabled and if so make use of the SW Tag Detection          */
@@ -4333,6 +4494,7 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
     
     /* Disable Tx, Rx, External Field Detector and set default ISO14443A mode */
     st25r3916TxRxOff();
+    rfalWakeUpModeAccountField( false );
     st25r3916ClrRegisterBits( ST25R3916_REG_OP_CONTROL, ST25R3916_REG_OP_CONTROL_en_fd_mask );
     st25r3916ChangeRegisterBits( ST25R3916_REG_MODE, (ST25R3916_REG_MODE_targ | ST25R3916_REG_MODE_om_mask), (ST25R3916_REG_MODE_targ_init | ST25R3916_REG_MODE_om_iso14443a) );
     
@@ -4345,12 +4507,19 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
     reg  = (uint8_t)(((uint8_t)gRFAL.wum.cfg.period & 0x0FU) << ST25R3916_REG_WUP_TIMER_CONTROL_wut_shift);
     reg |= (uint8_t)(((uint8_t)gRFAL.wum.cfg.period < (uint8_t)RFAL_WUM_PERIOD_100MS) ? ST25R3916_REG_WUP_TIMER_CONTROL_wur : 0x00U);
     
-    if( gRFAL.wum.cfg.irqTout || gRFAL.wum.cfg.swTagDetect )
+    /* Adaptive thresholds on HW Wake-Up rely on the WUT IRQ to track the noise floor */
+    if( gRFAL.wum.cfg.irqTout || gRFAL.wum.cfg.swTagDetect || gRFAL.wum.cfg.adaptive.enabled )
     {
         reg  |= ST25R3916_REG_WUP_TIMER_CONTROL_wto;
         irqs |= ST25R3916_IRQ_MASK_WT;
     }
        
+    /* Derive the initial deltas from the noise floor tracked on previous runs */
+    rfalWakeUpModeAdaptDelta( &gRFAL.wum.adapt.indAmp, (rfalConvTDFormat( gRFAL.wum.cfg.indAmp.delta ) | rfalAddFracTDFormat( gRFAL.wum.cfg.indAmp.fracDelta )) );
+    rfalWakeUpModeAdaptDelta( &gRFAL.wum.adapt.indPha, (rfalConvTDFormat( gRFAL.wum.cfg.indPha.delta ) | rfalAddFracTDFormat( gRFAL.wum.cfg.indPha.fracDelta )) );
+    rfalWakeUpModeAdaptDelta( &gRFAL.wum.adapt.cap,    rfalConvTDFormat( gRFAL.wum.cfg.cap.delta ) );
+    gRFAL.wum.adapt.pending = false;
+    
     /* Check if HW Wake-up is to be used or SW Tag detection */
     if( gRFAL.wum.cfg.swTagDetect )
     {
@@ -4364,7 +4533,8 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
         /* Check if Inductive Amplitude is to be performed */
         if( gRFAL.wum.cfg.indAmp.enabled )
         {
-            aux  = (uint8_t)((gRFAL.wum.cfg.indAmp.delta) << ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_d_shift);
+            gRFAL.wum.adapt.indAmp.hwDelta = rfalWakeUpModeAdaptHwDelta( &gRFAL.wum.adapt.indAmp, gRFAL.wum.cfg.indAmp.delta );
+            aux  = (uint8_t)((gRFAL.wum.adapt.indAmp.hwDelta) << ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_d_shift);
             aux |= (uint8_t)(gRFAL.wum.cfg.indAmp.aaInclMeas ? ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_aam : 0x00U);
             aux |= (uint8_t)(((uint8_t)gRFAL.wum.cfg.indAmp.aaWeight << ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_aew_shift) & ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_aew_mask);
             aux |= (uint8_t)(gRFAL.wum.cfg.indAmp.autoAvg ? ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_ae : 0x00U);
@@ -4390,7 +4560,8 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
         /* Check if Inductive Phase is to be performed */
         if( gRFAL.wum.cfg.indPha.enabled )
         {
-            aux  = (uint8_t)((gRFAL.wum.cfg.indPha.delta) << ST25R3916_REG_PHASE_MEASURE_CONF_pm_d_shift);
+            gRFAL.wum.adapt.indPha.hwDelta = rfalWakeUpModeAdaptHwDelta( &gRFAL.wum.adapt.indPha, gRFAL.wum.cfg.indPha.delta );
+            aux  = (uint8_t)((gRFAL.wum.adapt.indPha.hwDelta) << ST25R3916_REG_PHASE_MEASURE_CONF_pm_d_shift);
             aux |= (uint8_t)(gRFAL.wum.cfg.indPha.aaInclMeas ? ST25R3916_REG_PHASE_MEASURE_CONF_pm_aam : 0x00U);
             aux |= (uint8_t)(((uint8_t)gRFAL.wum.cfg.indPha.aaWeight << ST25R3916_REG_PHASE_MEASURE_CONF_pm_aew_shift) & ST25R3916_REG_PHASE_MEASURE_CONF_pm_aew_mask);
             aux |= (uint8_t)(gRFAL.wum.cfg.indPha.autoAvg ? ST25R3916_REG_PHASE_MEASURE_CONF_pm_ae : 0x00U);
@@ -4430,7 +4601,8 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
             
             
             /*******************************************************************************/
-            aux  = (uint8_t)((gRFAL.wum.cfg.cap.delta) << ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_d_shift);
+            gRFAL.wum.adapt.cap.hwDelta = rfalWakeUpModeAdaptHwDelta( &gRFAL.wum.adapt.cap, gRFAL.wum.cfg.cap.delta );
+            aux  = (uint8_t)((gRFAL.wum.adapt.cap.hwDelta) << ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_d_shift);
             aux |= (uint8_t)(gRFAL.wum.cfg.cap.aaInclMeas ? ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_aam : 0x00U);
             aux |= (uint8_t)(((uint8_t)gRFAL.wum.cfg.cap.aaWeight << ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_aew_shift) & ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_aew_mask);
             aux |= (uint8_t)(gRFAL.wum.cfg.cap.autoAvg ? ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_ae : 0x00U);
@@ -4468,8 +4640,9 @@ ReturnCode rfalWakeUpModeStart( const rfalWakeUpConfig *config )
                                  ST25R3916_REG_OP_CONTROL_wu );
     
     
-    gRFAL.wum.state = RFAL_WUM_STATE_ENABLED;
-    gRFAL.state     = RFAL_STATE_WUM;
+    gRFAL.wum.state         = RFAL_WUM_STATE_ENABLED;
+    gRFAL.wum.acct.wumStart = platformGetSysTick();
+    gRFAL.state             = RFAL_STATE_WUM;
       
     return ERR_NONE;
 }
@@ -4505,6 +4678,17 @@ ReturnCode rfalWakeUpModeGetInfo( bool force, rfalWakeUpInfo *info )
     /* Update general information */ 
     info->irqWut          = gRFAL.wum.info.irqWut;
     gRFAL.wum.info.irqWut = false;
+    
+    /* Update adaptive thresholds and false wake statistics */
+    info->wakeCnt          = gRFAL.wum.adapt.wakeCnt;
+    info->falseWakeCnt     = gRFAL.wum.adapt.falseWakeCnt;
+    info->falseWakeMargin  = gRFAL.wum.adapt.margin;
+    info->indAmp.noise     = gRFAL.wum.adapt.indAmp.noise;
+    info->indAmp.delta     = gRFAL.wum.adapt.indAmp.delta;
+    info->indPha.noise     = gRFAL.wum.adapt.indPha.noise;
+    info->indPha.delta     = gRFAL.wum.adapt.indPha.delta;
+    info->cap.noise        = gRFAL.wum.adapt.cap.noise;
+    info->cap.delta        = gRFAL.wum.adapt.cap.delta;
 
     /* WUT IRQ is signaled when WUT expires. Delay slightly for the actual measurement to be performed */
     if ( info->irqWut && !gRFAL.wum.cfg.swTagDetect )
@@ -4625,6 +4809,93 @@ static uint16_t rfalWakeUpModeFilter( uint16_t curRef, uint16_t curVal, uint8_t
 }
 
 
+/*******************************************************************************/
+static void rfalWakeUpModeAdaptDelta( rfalWumAdaptSensor *sensor, uint16_t minDelta )
+{
+    uint32_t delta;
+    uint32_t maxDelta;
+    
+    if( !gRFAL.wum.cfg.adaptive.enabled )
+    {
+        sensor->delta = minDelta;
+        return;
+    }
+    
+    /* Delta follows the noise floor plus the margin learnt from false wake-ups, never below the configured delta */
+    delta    = (((uint32_t)sensor->noise * gRFAL.wum.cfg.adaptive.noiseMult) + gRFAL.wum.adapt.margin);
+    maxDelta = ((gRFAL.wum.cfg.adaptive.maxDelta == 0U) ? rfalConvTDFormat( 0xFFU ) : rfalConvTDFormat( gRFAL.wum.cfg.adaptive.maxDelta ));
+    
+    delta = MIN( delta, maxDelta );
+    delta = MAX( delta, minDelta );
+    
+    sensor->delta = (uint16_t)delta;
+}
+
+
+/*******************************************************************************/
+static void rfalWakeUpModeAdaptUpdate( rfalWumAdaptSensor *sensor, uint16_t reference, uint16_t value, uint16_t minDelta )
+{
+    uint16_t dev;
+    
+    /* Average the deviation from the reference, all values in TD format */
+    dev = ((value > reference) ? (value - reference) : (reference - value));
+    
+    if( dev > sensor->noise )
+    {
+        sensor->noise += ((dev - sensor->noise) / RFAL_WU_ADAPT_NOISE_WEIGHT);
+    }
+    else
+    {
+        sensor->noise -= ((sensor->noise - dev) / RFAL_WU_ADAPT_NOISE_WEIGHT);
+    }
+    
+    rfalWakeUpModeAdaptDelta( sensor, minDelta );
+}
+
+
+/*******************************************************************************/
+static uint8_t rfalWakeUpModeAdaptHwDelta( const rfalWumAdaptSensor *sensor, uint8_t cfgDelta )
+{
+    uint16_t hwDelta;
+    
+    if( !gRFAL.wum.cfg.adaptive.enabled )
+    {
+        return cfgDelta;
+    }
+    
+    /* HW delta is an integer, round the derived delta up */
+    hwDelta = ((sensor->delta + (rfalConvTDFormat( 1U ) - 1U)) >> 8U);
+    
+    return (uint8_t)MIN( hwDelta, RFAL_WU_HW_DELTA_MAX );
+}
+
+
+/*******************************************************************************/
+static void rfalWakeUpModeAdaptHw( rfalWumAdaptSensor *sensor, uint8_t cfgDelta, bool autoAvg, uint16_t reference, uint8_t regConf, uint8_t dMask, uint8_t dShift )
+{
+    uint8_t aux;
+    uint8_t hwDelta;
+    
+    /* The WUT IRQ precedes the measurement: the display registers hold the previous period's result */
+    if( autoAvg )
+    {
+        st25r3916ReadRegister( (regConf + RFAL_WU_REG_AA_RESULT_OFFSET), &aux );
+        reference = aux;
+    }
+    st25r3916ReadRegister( (regConf + RFAL_WU_REG_RESULT_OFFSET), &aux );
+    
+    rfalWakeUpModeAdaptUpdate( sensor, rfalConvTDFormat( reference ), rfalConvTDFormat( aux ), rfalConvTDFormat( cfgDelta ) );
+    
+    /* Only access the device when the delta has actually changed */
+    hwDelta = rfalWakeUpModeAdaptHwDelta( sensor, cfgDelta );
+    if( hwDelta != sensor->hwDelta )
+    {
+        sensor->hwDelta = hwDelta;
+        st25r3916ChangeRegisterBits( regConf, dMask, (uint8_t)(hwDelta << dShift) );
+    }
+}
+
+
 /*******************************************************************************/
 static void rfalRunWakeUpModeWorker( void )
 {
@@ -4632,7 +4903,11 @@ static void rfalRunWakeUpModeWorker( void )
     uint8_t  reg;
     uint16_t value;
     uint16_t delta;
+    uint16_t minDelta;
     bool     woke;
+    bool     wasWoke;
+    uint8_t  measCnt;
+    struct st25r3916Measurement meas[2];
     
     if( gRFAL.state != RFAL_STATE_WUM )
     {
@@ -4650,6 +4925,8 @@ static void rfalRunWakeUpModeWorker( void )
                break;  /* No interrupt to process */
             }
             
+            wasWoke = (gRFAL.wum.state == RFAL_WUM_STATE_ENABLED_WOKE);
+            
             /*******************************************************************************/
             /* Check and mark which measurement(s) cause interrupt */
             if((irqs & ST25R3916_IRQ_MASK_WAM) != 0U)
@@ -4673,6 +4950,7 @@ static void rfalRunWakeUpModeWorker( void )
             if((irqs & ST25R3916_IRQ_MASK_WT) != 0U)
             {
                 gRFAL.wum.info.irqWut = true;
+                gRFAL.wum.acct.wutCnt++;
                 
                 /*******************************************************************************/
                 if( gRFAL.wum.cfg.swTagDetect )
@@ -4684,19 +4962,40 @@ static void rfalRunWakeUpModeWorker( void )
                     platformDelay( RFAL_ST25R3916_AAT_SETTLE );
                     
                     
+                    /*******************************************************************************/
+                    /* Perform all enabled measurements back to back */
+                    measCnt = 0;
+                    if( gRFAL.wum.cfg.indAmp.enabled )
+                    {
+                        meas[measCnt++].type = ST25R3916_MEAS_AMPLITUDE;
+                    }
+                    if( gRFAL.wum.cfg.indPha.enabled )
+                    {
+                        meas[measCnt++].type = ST25R3916_MEAS_PHASE;
+                    }
+                    if( measCnt > 0U )
+                    {
+                        st25r3916MeasureBatch( meas, measCnt );
+                    }
+                    gRFAL.wum.acct.indAmpCnt += (gRFAL.wum.cfg.indAmp.enabled ? 1U : 0U);
+                    gRFAL.wum.acct.indPhaCnt += (gRFAL.wum.cfg.indPha.enabled ? 1U : 0U);
+                    gRFAL.wum.acct.swTdCnt++;
+                    measCnt = 0;
+                    
                     /*******************************************************************************/
                     if( gRFAL.wum.cfg.indAmp.enabled )
                     {
-                        /* Perform amplitude measurement */
-                        st25r3916MeasureAmplitude( &reg );
+                        /* Retrieve amplitude measurement */
+                        reg = meas[measCnt++].result;
                         
                         /* Update last measurement info */
                         gRFAL.wum.info.indAmp.lastMeas = reg;
                         
                         /* Convert inputs to TD format */
                         value = rfalConvTDFormat( reg );
-                        delta = rfalConvTDFormat( gRFAL.wum.cfg.indAmp.delta );
-                        delta |= rfalAddFracTDFormat( gRFAL.wum.cfg.indAmp.fracDelta );
+                        minDelta = rfalConvTDFormat( gRFAL.wum.cfg.indAmp.delta );
+                        minDelta |= rfalAddFracTDFormat( gRFAL.wum.cfg.indAmp.fracDelta );
+                        delta = gRFAL.wum.adapt.indAmp.delta;           /* Equals minDelta if not adaptive */
                         
                         /* Set first measurement as reference */
                         if( gRFAL.wum.cfg.indAmp.reference == 0U )
@@ -4714,6 +5013,12 @@ static void rfalRunWakeUpModeWorker( void )
                             /* continue wake-up as for HW */
                         }
                         
+                        /* Track the noise floor on quiet measurements only */
+                        if( gRFAL.wum.cfg.adaptive.enabled && !woke )
+                        {
+                            rfalWakeUpModeAdaptUpdate( &gRFAL.wum.adapt.indAmp, gRFAL.wum.cfg.indAmp.reference, value, minDelta );
+                        }
+                        
                         /* Update moving reference if enabled */
                         if( gRFAL.wum.cfg.indAmp.autoAvg && (gRFAL.wum.cfg.indAmp.aaInclMeas || !woke) )
                         {
@@ -4724,16 +5029,17 @@ static void rfalRunWakeUpModeWorker( void )
                     /*******************************************************************************/
                     if( gRFAL.wum.cfg.indPha.enabled )
                     {
-                        /* Perform Phase measurement */
-                        st25r3916MeasurePhase( &reg );
+                        /* Retrieve Phase measurement */
+                        reg = meas[measCnt++].result;
                         
                         /* Update last measurement info */
                         gRFAL.wum.info.indPha.lastMeas = reg;
                         
                         /* Convert inputs to TD format */
                         value = rfalConvTDFormat( reg );
-                        delta = rfalConvTDFormat( gRFAL.wum.cfg.indPha.delta );
-                        delta |= rfalAddFracTDFormat( gRFAL.wum.cfg.indPha.fracDelta );
+                        minDelta = rfalConvTDFormat( gRFAL.wum.cfg.indPha.delta );
+                        minDelta |= rfalAddFracTDFormat( gRFAL.wum.cfg.indPha.fracDelta );
+                        delta = gRFAL.wum.adapt.indPha.delta;           /* Equals minDelta if not adaptive */
                         
                         /* Set first measurement as reference */
                         if( gRFAL.wum.cfg.indPha.reference == 0U )
@@ -4751,6 +5057,12 @@ static void rfalRunWakeUpModeWorker( void )
                             /* continue wake-up as for HW */
                         }
                         
+                        /* Track the noise floor on quiet measurements only */
+                        if( gRFAL.wum.cfg.adaptive.enabled && !woke )
+                        {
+                            rfalWakeUpModeAdaptUpdate( &gRFAL.wum.adapt.indPha, gRFAL.wum.cfg.indPha.reference, value, minDelta );
+                        }
+                        
                         /* Update moving reference if enabled */
                         if( gRFAL.wum.cfg.indPha.autoAvg && (gRFAL.wum.cfg.indPha.aaInclMeas || !woke) )
                         {
@@ -4761,6 +5073,44 @@ static void rfalRunWakeUpModeWorker( void )
                     /* Re-Enable low power Wake-Up mode for wto to trigger another measurement(s) */
                     st25r3916ChangeRegisterBits( ST25R3916_REG_OP_CONTROL, (ST25R3916_REG_OP_CONTROL_en | ST25R3916_REG_OP_CONTROL_wu), (ST25R3916_REG_OP_CONTROL_wu) );
                 }
+                /*******************************************************************************/
+                else if( gRFAL.wum.cfg.adaptive.enabled && (gRFAL.wum.state != RFAL_WUM_STATE_ENABLED_WOKE) )
+                {
+                    /* Track the noise floor from the HW measurements and adjust the HW deltas */
+                    if( gRFAL.wum.cfg.indAmp.enabled )
+                    {
+                        rfalWakeUpModeAdaptHw( &gRFAL.wum.adapt.indAmp, gRFAL.wum.cfg.indAmp.delta, gRFAL.wum.cfg.indAmp.autoAvg, gRFAL.wum.cfg.indAmp.reference, 
+                                               ST25R3916_REG_AMPLITUDE_MEASURE_CONF, ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_d_mask, ST25R3916_REG_AMPLITUDE_MEASURE_CONF_am_d_shift );
+                    }
+                    if( gRFAL.wum.cfg.indPha.enabled )
+                    {
+                        rfalWakeUpModeAdaptHw( &gRFAL.wum.adapt.indPha, gRFAL.wum.cfg.indPha.delta, gRFAL.wum.cfg.indPha.autoAvg, gRFAL.wum.cfg.indPha.reference, 
+                                               ST25R3916_REG_PHASE_MEASURE_CONF, ST25R3916_REG_PHASE_MEASURE_CONF_pm_d_mask, ST25R3916_REG_PHASE_MEASURE_CONF_pm_d_shift );
+                    }
+                    if( gRFAL.wum.cfg.cap.enabled )
+                    {
+                        rfalWakeUpModeAdaptHw( &gRFAL.wum.adapt.cap, gRFAL.wum.cfg.cap.delta, gRFAL.wum.cfg.cap.autoAvg, gRFAL.wum.cfg.cap.reference, 
+                                               ST25R3916_REG_CAPACITANCE_MEASURE_CONF, ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_d_mask, ST25R3916_REG_CAPACITANCE_MEASURE_CONF_cm_d_shift );
+                    }
+                }
+                else
+                {
+                    /* MISRA 15.7 - Empty else */
+                }
+                
+                /* Relax the false wake margin on every quiet period */
+                if( gRFAL.wum.cfg.adaptive.enabled && (gRFAL.wum.state != RFAL_WUM_STATE_ENABLED_WOKE) && (gRFAL.wum.adapt.margin > 0U) )
+                {
+                    gRFAL.wum.adapt.margin -= MIN( gRFAL.wum.adapt.margin, (uint16_t)((gRFAL.wum.adapt.margin >> RFAL_WU_ADAPT_MARGIN_DECAY) + 1U) );
+                }
+            }
+            
+            /*******************************************************************************/
+            /* Account a new wake-up, its result is to be reported by the caller */
+            if( !wasWoke && (gRFAL.wum.state == RFAL_WUM_STATE_ENABLED_WOKE) )
+            {
+                gRFAL.wum.adapt.wakeCnt++;
+                gRFAL.wum.adapt.pending = true;
             }
             break;
             
@@ -4771,9 +5121,160 @@ static void rfalRunWakeUpModeWorker( void )
 }
 
 
+/*******************************************************************************/
+ReturnCode rfalWakeUpModeReportResult( bool devFound )
+{
+    /* Check if a wake-up is awaiting its result */
+    if( !gRFAL.wum.adapt.pending )
+    {
+        return ERR_WRONG_STATE;
+    }
+    gRFAL.wum.adapt.pending = false;
+    
+    if( devFound )
+    {
+        /* Genuine wake-up, relax the margin */
+        gRFAL.wum.adapt.margin >>= 1U;
+    }
+    else
+    {
+        /* False wake-up, raise the margin on top of the noise floor */
+        gRFAL.wum.adapt.falseWakeCnt++;
+        gRFAL.wum.adapt.margin = MIN( (gRFAL.wum.adapt.margin + RFAL_WU_ADAPT_MARGIN_STEP), RFAL_WU_ADAPT_MARGIN_MAX );
+    }
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+static void rfalWakeUpModeAccountField( bool fieldOn )
+{
+    uint32_t now;
+    
+    now = platformGetSysTick();
+    
+    if( gRFAL.wum.acct.fieldOn )
+    {
+        gRFAL.wum.acct.fieldOnTime += (now - gRFAL.wum.acct.fieldStart);
+    }
+    else if( fieldOn )
+    {
+        gRFAL.wum.acct.fieldOnCnt++;
+    }
+    else
+    {
+        /* MISRA 15.7 - Empty else */
+    }
+    
+    gRFAL.wum.acct.fieldOn    = fieldOn;
+    gRFAL.wum.acct.fieldStart = now;
+}
+
+
+/*******************************************************************************/
+static uint32_t rfalWakeUpModeHwMeasCnt( uint32_t wumTime )
+{
+    uint32_t period;
+    
+    /* SW Tag Detection measurements are accounted as they are performed */
+    if( gRFAL.wum.cfg.swTagDetect )
+    {
+        return 0U;
+    }
+    
+    /* Wake-Up timer uses 10ms steps below 100ms and 100ms steps above */
+    if( (uint8_t)gRFAL.wum.cfg.period < (uint8_t)RFAL_WUM_PERIOD_100MS )
+    {
+        period = (((uint32_t)gRFAL.wum.cfg.period + 1U) * 10U);
+    }
+    else
+    {
+        period = ((((uint32_t)gRFAL.wum.cfg.period & 0x0FU) + 1U) * 100U);
+    }
+    
+    return (wumTime / period);
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalWakeUpModeGetStats( rfalWakeUpStats *stats )
+{
+    uint32_t now;
+    uint32_t aux;
+    uint32_t otherTime;
+    uint64_t charge;
+    
+    if( stats == NULL )
+    {
+        return ERR_PARAM;
+    }
+    
+    now = platformGetSysTick();
+    
+    stats->wutCnt        = gRFAL.wum.acct.wutCnt;
+    stats->wokeCnt       = gRFAL.wum.adapt.wakeCnt;
+    stats->indAmpMeasCnt = gRFAL.wum.acct.indAmpCnt;
+    stats->indPhaMeasCnt = gRFAL.wum.acct.indPhaCnt;
+    stats->capMeasCnt    = gRFAL.wum.acct.capCnt;
+    stats->fieldOnCnt    = gRFAL.wum.acct.fieldOnCnt;
+    stats->wumTime       = gRFAL.wum.acct.wumTime;
+    stats->fieldOnTime   = gRFAL.wum.acct.fieldOnTime;
+    stats->elapsedTime   = (now - gRFAL.wum.acct.startTime);
+    
+    /* Include the ongoing Wake-Up Mode run and field On period */
+    if( gRFAL.state == RFAL_STATE_WUM )
+    {
+        aux = (now - gRFAL.wum.acct.wumStart);
+        stats->wumTime       += aux;
+        stats->indAmpMeasCnt += (gRFAL.wum.cfg.indAmp.enabled ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+        stats->indPhaMeasCnt += (gRFAL.wum.cfg.indPha.enabled ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+        stats->capMeasCnt    += (gRFAL.wum.cfg.cap.enabled    ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+    }
+    if( gRFAL.wum.acct.fieldOn )
+    {
+        stats->fieldOnTime += (now - gRFAL.wum.acct.fieldStart);
+    }
+    
+    /*******************************************************************************/
+    /* Charge in nC: nA * ms / 1000, uA * ms and nC per measurement                */
+    aux       = (stats->wumTime + stats->fieldOnTime);
+    otherTime = ((stats->elapsedTime > aux) ? (stats->elapsedTime - aux) : 0U);
+    
+    charge  = (((uint64_t)stats->wumTime * RFAL_ST25R3916_I_WUM_NA) / 1000U);
+    charge += ((uint64_t)stats->indAmpMeasCnt + stats->indPhaMeasCnt) * RFAL_ST25R3916_Q_MEAS_IND_NC;
+    charge += ((uint64_t)stats->capMeasCnt * RFAL_ST25R3916_Q_MEAS_CAP_NC);
+    charge += ((uint64_t)gRFAL.wum.acct.swTdCnt * RFAL_ST25R3916_AAT_SETTLE * RFAL_ST25R3916_I_READY_UA);
+    charge += ((uint64_t)stats->fieldOnTime * RFAL_ST25R3916_I_FIELD_UA);
+    charge += ((uint64_t)otherTime * RFAL_ST25R3916_I_READY_UA);
+    
+    /* Charge per hour in uAh equals the average current in uA, i.e. nC per ms */
+    stats->chargePerHour = ((stats->elapsedTime != 0U) ? (uint32_t)(charge / stats->elapsedTime) : 0U);
+    
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void rfalWakeUpModeResetStats( void )
+{
+    uint32_t now;
+    
+    now = platformGetSysTick();
+    
+    ST_MEMSET( &gRFAL.wum.acct, 0x00, sizeof(rfalWumAcct) );
+    gRFAL.wum.acct.startTime  = now;
+    gRFAL.wum.acct.wumStart   = now;
+    gRFAL.wum.acct.fieldStart = now;
+    gRFAL.wum.acct.fieldOn    = gRFAL.field;
+}
+
+
 /*******************************************************************************/
 ReturnCode rfalWakeUpModeStop( void )
 {
+    uint32_t aux;
+    
     /* Check if RFAL is in Wake-up mode */
     if( gRFAL.state != RFAL_STATE_WUM )
     {
@@ -4782,6 +5283,13 @@ ReturnCode rfalWakeUpModeStop( void )
     
     gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
     
+    /* Account the time spent and the measurements performed autonomously by the HW */
+    aux = (platformGetSysTick() - gRFAL.wum.acct.wumStart);
+    gRFAL.wum.acct.wumTime   += aux;
+    gRFAL.wum.acct.indAmpCnt += (gRFAL.wum.cfg.indAmp.enabled ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+    gRFAL.wum.acct.indPhaCnt += (gRFAL.wum.cfg.indPha.enabled ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+    gRFAL.wum.acct.capCnt    += (gRFAL.wum.cfg.cap.enabled    ? rfalWakeUpModeHwMeasCnt( aux ) : 0U);
+    
     /* Disable Wake-Up Mode */
     st25r3916ClrRegisterBits( ST25R3916_REG_OP_CONTROL, ST25R3916_REG_OP_CONTROL_wu );
     st25r3916DisableInterrupts( (ST25R3916_IRQ_MASK_WT | ST25R3916_IRQ_MASK_WAM | ST25R3916_IRQ_MASK_WPH | ST25R3916_IRQ_MASK_WCAP) );
@@ -401,6 +401,78 @@ ReturnCode st25r3916MeasureCapacitance( uint8_t* result )
 }
 
 
+/*******************************************************************************/
+ReturnCode st25r3916MeasureBatch( struct st25r3916Measurement *meas, uint8_t len )
+{
+    uint8_t i;
+    uint8_t cmd;
+    uint8_t tOut;
+    uint8_t mpsv;
+    
+    if( (meas == NULL) || (len == 0U) )
+    {
+        return ERR_PARAM;
+    }
+    
+    for( i = 0; i < len; i++ )
+    {
+        if( (uint8_t)meas[i].type > (uint8_t)ST25R3916_MEAS_POWER_SUPPLY )
+        {
+            return ERR_PARAM;
+        }
+    }
+    
+    mpsv = 0xFFU;   /* Supply source not yet set by this batch */
+    
+    /* Clear and enable Direct Command interrupt once for the whole batch */
+    st25r3916GetInterrupt( ST25R3916_IRQ_MASK_DCT );
+    st25r3916EnableInterrupts( ST25R3916_IRQ_MASK_DCT );
+    
+    for( i = 0; i < len; i++ )
+    {
+        switch( meas[i].type )
+        {
+            case ST25R3916_MEAS_AMPLITUDE:
+                cmd  = ST25R3916_CMD_MEASURE_AMPLITUDE;
+                tOut = ST25R3916_TOUT_MEASURE_AMPLITUDE;
+                break;
+                
+            case ST25R3916_MEAS_PHASE:
+                cmd  = ST25R3916_CMD_MEASURE_PHASE;
+                tOut = ST25R3916_TOUT_MEASURE_PHASE;
+                break;
+                
+            case ST25R3916_MEAS_CAPACITANCE:
+                cmd  = ST25R3916_CMD_MEASURE_CAPACITANCE;
+                tOut = ST25R3916_TOUT_MEASURE_CAPACITANCE;
+                break;
+                
+            case ST25R3916_MEAS_POWER_SUPPLY:
+            default:
+                /* Only touch the supply source when it changes */
+                if( meas[i].mpsv != mpsv )
+                {
+                    mpsv = meas[i].mpsv;
+                    st25r3916ChangeRegisterBits( ST25R3916_REG_REGULATOR_CONTROL, ST25R3916_REG_REGULATOR_CONTROL_mpsv_mask, mpsv );
+                }
+                cmd  = ST25R3916_CMD_MEASURE_VDD;
+                tOut = ST25R3916_TOUT_MEASURE_VDD;
+                break;
+        }
+        
+        st25r3916ExecuteCommand( cmd );
+        st25r3916WaitForInterruptsTimed( ST25R3916_IRQ_MASK_DCT, tOut );
+        
+        /* Result register is shared by all measurements, read it before the next command */
+        st25r3916ReadRegister( ST25R3916_REG_AD_RESULT, &meas[i].result );
+    }
+    
+    st25r3916DisableInterrupts( ST25R3916_IRQ_MASK_DCT );
+    
+    return ERR_NONE;
+}
+
+
 /*******************************************************************************/
 ReturnCode st25r3916CalibrateCapacitiveSensor( uint8_t* result )
 {
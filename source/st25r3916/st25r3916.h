@@ -79,6 +79,21 @@ struct st25r3916StreamConfig {
     uint8_t report_period_length;               /*!< Length of the reporting period 2^report_period_length*/
 };
 
+/*! Measurement types supported by st25r3916MeasureBatch()                                              */
+typedef enum {
+    ST25R3916_MEAS_AMPLITUDE    = 0,            /*!< Measure Amplitude                                    */
+    ST25R3916_MEAS_PHASE        = 1,            /*!< Measure Phase                                        */
+    ST25R3916_MEAS_CAPACITANCE  = 2,            /*!< Measure Capacitance                                  */
+    ST25R3916_MEAS_POWER_SUPPLY = 3             /*!< Measure Power Supply                                 */
+} st25r3916MeasType;
+
+/*! Single entry of a measurement batch                                                                   */
+struct st25r3916Measurement {
+    st25r3916MeasType type;                     /*!< Measurement to be performed                          */
+    uint8_t           mpsv;                     /*!< Supply source, only for ST25R3916_MEAS_POWER_SUPPLY  */
+    uint8_t           result;                   /*!< Raw measurement result                               */
+};
+
 
 /*
 ******************************************************************************
@@ -340,6 +355,28 @@ ReturnCode st25r3916MeasurePhase( uint8_t* result );
  */
 ReturnCode st25r3916MeasureCapacitance( uint8_t* result );
 
+/*! 
+ *****************************************************************************
+ *  \brief  Measure Batch
+ *
+ *  This function performs the given list of measurements back to back.
+ *  The Direct Command interrupt is cleared and enabled only once for the 
+ *  whole batch and the Power Supply source is only changed when it differs
+ *  from the previous entry. 
+ *  All measurements share the A/D Converter Output register, so each result
+ *  is read right after its command completes and stored in \a result of
+ *  the respective entry.
+ *
+ *  \param[in,out] meas : list of measurements to perform
+ *  \param[in]     len  : number of entries in \a meas
+ *
+ *  \return ERR_PARAM : Invalid parameter
+ *  \return ERR_NONE  : No error
+ *  
+ *****************************************************************************
+ */
+ReturnCode st25r3916MeasureBatch( struct st25r3916Measurement *meas, uint8_t len );
+
 /*! 
  *****************************************************************************
  *  \brief  Calibrates Capacitive Sensor
@@ -53,6 +53,8 @@
 ******************************************************************************
 */
 #define ST25R3916_AAT_CAP_DELAY_MAX           10                  /*!< Max Variable Capacitor settle delay */
+#define ST25R3916_AAT_GRID_POINTS             4                   /*!< Grid points per axis of the coarse search   */
+#define ST25R3916_AAT_MEMO_LEN                32U                 /*!< Number of measured points kept for reuse    */
 
 /*
 ******************************************************************************
@@ -61,6 +63,36 @@
 */
 #define st25r3916AatLog(...)     /* platformLog(__VA_ARGS__) */   /*!< Logging macro */
 
+/*
+******************************************************************************
+* LOCAL DATA TYPES
+******************************************************************************
+*/
+
+/*! Already measured point, kept for reuse by the grid/simplex search */
+typedef struct{
+    uint8_t a;                    /*!< serial cap    */
+    uint8_t b;                    /*!< parallel cap  */
+    uint8_t amp;                  /*!< amplitude     */
+    uint8_t phs;                  /*!< phase         */
+} aatMemoEntry;
+
+/*! Simplex vertex */
+typedef struct{
+    uint8_t  a;                   /*!< serial cap    */
+    uint8_t  b;                   /*!< parallel cap  */
+    uint32_t f;                   /*!< cost function */
+} aatVertex;
+
+/*! Grid/simplex search context */
+typedef struct{
+    const struct st25r3916AatTuneParams *tp;           /*!< tuning parameters             */
+    struct st25r3916AatTuneResult       *ts;           /*!< best point found so far       */
+    aatMemoEntry memo[ST25R3916_AAT_MEMO_LEN];         /*!< measured points               */
+    uint8_t      memoCnt;                              /*!< number of valid memo entries  */
+    uint8_t      memoNext;                             /*!< next memo entry to replace    */
+} aatSearchCtx;
+
 /*
 ******************************************************************************
 * LOCAL FUNCTION PROTOTYPES
@@ -70,6 +102,12 @@ static ReturnCode aatHillClimb(const struct st25r3916AatTuneParams *tuningParams
 static int32_t aatGreedyDescent(uint32_t *f_min, const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus, int32_t previousDir);
 static int32_t aatSteepestDescent(uint32_t *f_min, const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus, int32_t previousDir, int32_t previousDir2);
 
+static ReturnCode aatGridSimplex(const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus);
+static ReturnCode aatNelderMead(aatSearchCtx *ctx, int16_t wA, int16_t wB);
+static ReturnCode aatVertexMeasure(aatSearchCtx *ctx, aatVertex *v, int16_t a, int16_t b);
+static ReturnCode aatMemoMeasure(aatSearchCtx *ctx, uint8_t a, uint8_t b, uint32_t *f);
+static uint8_t aatClamp(int16_t val, uint8_t min, uint8_t max);
+
 static ReturnCode aatMeasure(uint8_t serCap, uint8_t parCap, uint8_t *amplitude, uint8_t *phase, uint16_t *measureCnt);
 static uint32_t aatCalcF(const struct st25r3916AatTuneParams *tuningParams, uint8_t amplitude, uint8_t phase);
 static ReturnCode aatStepDacVals(const struct st25r3916AatTuneParams *tuningParams,uint8_t *a, uint8_t *b, int32_t dir);
@@ -81,6 +119,7 @@ static ReturnCode aatStepDacVals(const struct st25r3916AatTuneParams *tuningPara
 ReturnCode st25r3916AatTune(const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus)
 {
     ReturnCode err;
+    uint32_t   tStart;
     const struct st25r3916AatTuneParams *tp = tuningParams;
     struct st25r3916AatTuneResult *ts = tuningStatus;
     struct st25r3916AatTuneParams defaultTuningParams = 
@@ -126,8 +165,18 @@ ReturnCode st25r3916AatTune(const struct st25r3916AatTuneParams *tuningParams, s
     if (NULL == ts){ts = &defaultTuneResult;}
 
     ts->measureCnt = 0; /* Clear current measure count */
+    tStart         = platformGetSysTick();
  
-    err = aatHillClimb(tp, ts);
+    if (ST25R3916_AAT_ALGO_GRID_SIMPLEX == tp->algo)
+    {
+        err = aatGridSimplex(tp, ts);
+    }
+    else
+    {
+        err = aatHillClimb(tp, ts);
+    }
+
+    ts->duration = (platformGetSysTick() - tStart);
 
     return err;
 }
@@ -174,9 +223,184 @@ static ReturnCode aatHillClimb(const struct st25r3916AatTuneParams *tuningParams
         tp.aat_b_stepWidth /= 2U;
     } while (tp.doDynamicSteps && ((tp.aat_a_stepWidth>0U) || (tp.aat_b_stepWidth>0U)));
     
+    tuningStatus->f = f_min;
+
     return err;
 }
 
+/*******************************************************************************/
+static ReturnCode aatGridSimplex(const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus)
+{
+    ReturnCode   err = ERR_NONE;
+    aatSearchCtx ctx;
+    int16_t      spanA, spanB, i, j;
+    uint32_t     f;
+
+    ctx.tp       = tuningParams;
+    ctx.ts       = tuningStatus;
+    ctx.memoCnt  = 0;
+    ctx.memoNext = 0;
+
+    tuningStatus->aat_a = tuningParams->aat_a_start;
+    tuningStatus->aat_b = tuningParams->aat_b_start;
+    tuningStatus->f     = UINT32_MAX;
+
+    spanA = ((int16_t)tuningParams->aat_a_max - (int16_t)tuningParams->aat_a_min);
+    spanB = ((int16_t)tuningParams->aat_b_max - (int16_t)tuningParams->aat_b_min);
+
+    /* Coarse grid: measure the centre of each cell */
+    for (i = 0; (i < ST25R3916_AAT_GRID_POINTS) && (ERR_NONE == err); i++)
+    {
+        for (j = 0; (j < ST25R3916_AAT_GRID_POINTS) && (ERR_NONE == err); j++)
+        {
+            err = aatMemoMeasure(&ctx, (uint8_t)((int16_t)tuningParams->aat_a_min + ((spanA * ((2 * i) + 1)) / (2 * ST25R3916_AAT_GRID_POINTS))),
+                                       (uint8_t)((int16_t)tuningParams->aat_b_min + ((spanB * ((2 * j) + 1)) / (2 * ST25R3916_AAT_GRID_POINTS))), &f);
+        }
+    }
+
+    /* Refine around the best cell, the simplex spans half a cell */
+    if (ERR_NONE == err)
+    {
+        err = aatNelderMead(&ctx, (spanA / (2 * ST25R3916_AAT_GRID_POINTS)), (spanB / (2 * ST25R3916_AAT_GRID_POINTS)));
+    }
+
+    /* Leave the best point found applied */
+    st25r3916WriteRegister(ST25R3916_REG_ANT_TUNE_A, tuningStatus->aat_a);
+    st25r3916WriteRegister(ST25R3916_REG_ANT_TUNE_B, tuningStatus->aat_b);
+
+    st25r3916AatLog("best %d %d: %d (%d measures)\n", tuningStatus->aat_a, tuningStatus->aat_b, tuningStatus->f, tuningStatus->measureCnt);
+
+    return err;
+}
+
+/*******************************************************************************/
+static ReturnCode aatNelderMead(aatSearchCtx *ctx, int16_t wA, int16_t wB)
+{
+    ReturnCode err;
+    aatVertex  v[3], t, r, e, k;
+    int16_t    ca, cb;
+    uint8_t    i, iter;
+
+    /* Initial simplex: best point so far and one step along each axis */
+    v[0].a = ctx->ts->aat_a;  v[0].b = ctx->ts->aat_b;  v[0].f = ctx->ts->f;
+    EXIT_ON_ERR(err, aatVertexMeasure(ctx, &v[1], ((int16_t)v[0].a + ((wA > 0) ? wA : 1)), (int16_t)v[0].b));
+    EXIT_ON_ERR(err, aatVertexMeasure(ctx, &v[2], (int16_t)v[0].a, ((int16_t)v[0].b + ((wB > 0) ? wB : 1))));
+
+    /* Memo hits are free, bound the iterations so that a degenerate simplex cannot spin forever */
+    for (iter = 0; iter < ctx->tp->measureLimit; iter++)
+    {
+        /* Order vertices: v[0] best .. v[2] worst */
+        if (v[1].f < v[0].f) { t = v[0]; v[0] = v[1]; v[1] = t; }
+        if (v[2].f < v[1].f) { t = v[1]; v[1] = v[2]; v[2] = t; }
+        if (v[1].f < v[0].f) { t = v[0]; v[0] = v[1]; v[1] = t; }
+
+        /* Centroid of the two best vertices */
+        ca = (int16_t)(((int16_t)v[0].a + (int16_t)v[1].a) / 2);
+        cb = (int16_t)(((int16_t)v[0].b + (int16_t)v[1].b) / 2);
+
+        /* Reflect the worst vertex through the centroid */
+        EXIT_ON_ERR(err, aatVertexMeasure(ctx, &r, ((2 * ca) - (int16_t)v[2].a), ((2 * cb) - (int16_t)v[2].b)));
+
+        if (r.f < v[0].f)
+        { /* Promising direction: try to expand further */
+            EXIT_ON_ERR(err, aatVertexMeasure(ctx, &e, ((3 * ca) - (2 * (int16_t)v[2].a)), ((3 * cb) - (2 * (int16_t)v[2].b))));
+            v[2] = ((e.f < r.f) ? e : r);
+            continue;
+        }
+        if (r.f < v[1].f)
+        {
+            v[2] = r;
+            continue;
+        }
+
+        /* Contract the worst vertex towards the centroid */
+        EXIT_ON_ERR(err, aatVertexMeasure(ctx, &k, ((ca + (int16_t)v[2].a) / 2), ((cb + (int16_t)v[2].b) / 2)));
+        if ((k.f < v[2].f) && ((k.a != v[2].a) || (k.b != v[2].b)))
+        {
+            v[2] = k;
+            continue;
+        }
+
+        /* Shrink towards the best vertex, stop once the simplex cannot get smaller */
+        if ((abs((int16_t)v[1].a - (int16_t)v[0].a) <= 1) && (abs((int16_t)v[1].b - (int16_t)v[0].b) <= 1) &&
+            (abs((int16_t)v[2].a - (int16_t)v[0].a) <= 1) && (abs((int16_t)v[2].b - (int16_t)v[0].b) <= 1))
+        {
+            break;
+        }
+        for (i = 1; i < 3U; i++)
+        {
+            EXIT_ON_ERR(err, aatVertexMeasure(ctx, &v[i], (((int16_t)v[0].a + (int16_t)v[i].a) / 2), (((int16_t)v[0].b + (int16_t)v[i].b) / 2)));
+        }
+    }
+
+    return ERR_NONE;
+}
+
+/*******************************************************************************/
+static ReturnCode aatVertexMeasure(aatSearchCtx *ctx, aatVertex *v, int16_t a, int16_t b)
+{
+    v->a = aatClamp(a, ctx->tp->aat_a_min, ctx->tp->aat_a_max);
+    v->b = aatClamp(b, ctx->tp->aat_b_min, ctx->tp->aat_b_max);
+
+    return aatMemoMeasure(ctx, v->a, v->b, &v->f);
+}
+
+/*******************************************************************************/
+static uint8_t aatClamp(int16_t val, uint8_t min, uint8_t max)
+{
+    if (val < (int16_t)min) { return min; }
+    if (val > (int16_t)max) { return max; }
+    return (uint8_t)val;
+}
+
+/*******************************************************************************/
+static ReturnCode aatMemoMeasure(aatSearchCtx *ctx, uint8_t a, uint8_t b, uint32_t *f)
+{
+    ReturnCode err;
+    uint8_t    i, amp, phs;
+
+    for (i = 0; i < ctx->memoCnt; i++)
+    {
+        if ((ctx->memo[i].a == a) && (ctx->memo[i].b == b))
+        { /* Already measured, no need to touch the chip */
+            *f = aatCalcF(ctx->tp, ctx->memo[i].amp, ctx->memo[i].phs);
+            return ERR_NONE;
+        }
+    }
+
+    if (ctx->ts->measureCnt >= ctx->tp->measureLimit)
+    { /* Hard budget: never measure beyond the limit */
+        return ERR_OVERRUN;
+    }
+
+    EXIT_ON_ERR(err, aatMeasure(a, b, &amp, &phs, &ctx->ts->measureCnt));
+
+    /* Store it, replacing the oldest entry once the table is full */
+    ctx->memo[ctx->memoNext].a   = a;
+    ctx->memo[ctx->memoNext].b   = b;
+    ctx->memo[ctx->memoNext].amp = amp;
+    ctx->memo[ctx->memoNext].phs = phs;
+    ctx->memoNext = (uint8_t)((ctx->memoNext + 1U) % ST25R3916_AAT_MEMO_LEN);
+    if (ctx->memoCnt < ST25R3916_AAT_MEMO_LEN)
+    {
+        ctx->memoCnt++;
+    }
+
+    *f = aatCalcF(ctx->tp, amp, phs);
+    st25r3916AatLog("m : %d %d: %d\n", a, b, *f);
+
+    if (*f < ctx->ts->f)
+    { /* Value is better than all previous ones */
+        ctx->ts->aat_a = a;
+        ctx->ts->aat_b = b;
+        ctx->ts->amp   = amp;
+        ctx->ts->pha   = phs;
+        ctx->ts->f     = *f;
+    }
+
+    return ERR_NONE;
+}
+
 /*******************************************************************************/
 static int32_t aatSteepestDescent(uint32_t *f_min, const struct st25r3916AatTuneParams *tuningParams, struct st25r3916AatTuneResult *tuningStatus, int32_t previousDir, int32_t previousDir2)
 {
@@ -298,12 +522,15 @@ static ReturnCode aatStepDacVals(const struct st25r3916AatTuneParams *tuningPara
 static ReturnCode aatMeasure(uint8_t serCap, uint8_t parCap, uint8_t *amplitude, uint8_t *phase, uint16_t *measureCnt)
 {
     ReturnCode err;
+    uint8_t    caps[2];
 
     *amplitude = 0; 
     *phase     = 0;
 
-    st25r3916WriteRegister(ST25R3916_REG_ANT_TUNE_A, serCap);
-    st25r3916WriteRegister(ST25R3916_REG_ANT_TUNE_B, parCap);
+    /* AAT_A and AAT_B are consecutive registers, set both in a single burst */
+    caps[0] = serCap;
+    caps[1] = parCap;
+    st25r3916WriteMultipleRegisters(ST25R3916_REG_ANT_TUNE_A, caps, 2U);
 
     /* Wait till caps have settled.. */
     platformDelay( ST25R3916_AAT_CAP_DELAY_MAX );
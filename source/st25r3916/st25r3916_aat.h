@@ -45,6 +45,14 @@
 ******************************************************************************
 */
 
+/*!
+ * Search algorithm used by the antenna tuning
+ */
+typedef enum {
+    ST25R3916_AAT_ALGO_HILLCLIMB = 0, /*!< Steepest/greedy descent hill climbing (default)                 */
+    ST25R3916_AAT_ALGO_GRID_SIMPLEX,  /*!< Coarse grid followed by a Nelder-Mead simplex refinement         */
+} st25r3916AatAlgo;
+
 /*!
  * struct representing input parameters for the antenna tuning
  */
@@ -65,6 +73,7 @@ struct st25r3916AatTuneParams{
 
     bool doDynamicSteps;          /*!< dynamically reduce step size in algo */ 
     uint8_t measureLimit;         /*!< max number of allowed steps/measurements */
+    st25r3916AatAlgo algo;        /*!< search algorithm to be used */
 };
 
 
@@ -78,6 +87,8 @@ struct st25r3916AatTuneResult{
     uint8_t pha;                  /*!< phase after tuning */
     uint8_t amp;                  /*!< amplitude after tuning */
     uint16_t measureCnt;          /*!< number of measures performed */
+    uint32_t f;                   /*!< cost function value achieved at (aat_a, aat_b) */
+    uint32_t duration;            /*!< wall time spent on tuning [ms] */
 };
 
 
@@ -89,6 +100,11 @@ struct st25r3916AatTuneResult{
  *  This function starts an antenna tuning procedure by modifying the serial 
  *  and parallel capacitors of the antenna matching circuit via the AAT_A
  *  and AAT_B registers. 
+ *
+ *  With ST25R3916_AAT_ALGO_GRID_SIMPLEX the measureLimit is a hard budget: 
+ *  no more than measureLimit measurements are performed, and points already 
+ *  measured are served from a small memo table instead of being measured again.
+ *  The best point found is written back to AAT_A/AAT_B.
  *   
  *  \param[in] tuningParams : Input parameters for the tuning algorithm. If NULL
  *                            default values will be used.
@@ -96,9 +112,10 @@ struct st25r3916AatTuneResult{
  *                             no further information is returned, only registers
  *                             ST25R3916 (AAT_A,B) will be adapted.
  *
- *  \return ERR_IO    : Error during communication.
- *  \return ERR_PARAM : Invalid input parameters
- *  \return ERR_NONE  : No error.
+ *  \return ERR_IO      : Error during communication.
+ *  \return ERR_PARAM   : Invalid input parameters
+ *  \return ERR_OVERRUN : Measurement limit reached before convergence
+ *  \return ERR_NONE    : No error.
  *
  *****************************************************************************
  */
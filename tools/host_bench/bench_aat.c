@@ -0,0 +1,390 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_aat.c
+ *
+ *  \author
+ *
+ *  \brief Antenna tuning (AAT) search benchmark
+ *
+ *  Runs st25r3916AatTune() against a synthetic antenna response surface and
+ *  compares the search algorithms on the number of measurements, the cost
+ *  function achieved and the (simulated) wall time.
+ *
+ *  The matching network is modelled as an amplitude and a phase that depend
+ *  smoothly on the AAT_A/AAT_B caps, with an optimum placed randomly on each
+ *  trial, a valley oblique to the cap axes and +/-1 LSB of measurement
+ *  noise. A second surface adds a local minimum. The cost of the point
+ *  returned is evaluated on the noise free surface and compared with the
+ *  global minimum found by an exhaustive scan.
+ *
+ *  Usage: bench_aat [trials] [seed]
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include <stdio.h>
+#include <math.h>
+#include "bench_rf.h"
+#include "st25r3916_aat.h"
+#include "st25r3916_com.h"
+#include "rfal_chip.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define BENCH_TRIALS                200U      /*!< Default number of trials per surface                      */
+#define BENCH_CAP_MAX               255       /*!< Largest AAT_A/AAT_B value                                 */
+#define BENCH_OPT_MARGIN            40        /*!< Optimum kept away from the range limits                   */
+
+#define BENCH_AMP_TARGET            196U      /*!< Default amplitude target of st25r3916AatTune()            */
+#define BENCH_PHA_TARGET            128U      /*!< Default phase target of st25r3916AatTune()                */
+
+#define BENCH_VALLEY_ANGLE          0.6       /*!< Valley orientation against the AAT_A axis [rad]           */
+#define BENCH_SCALE                 64.0      /*!< Cap distance of one normalised unit                       */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! Synthetic antenna */
+typedef struct
+{
+    double  a0;                               /*!< AAT_A of the optimum                                      */
+    double  b0;                               /*!< AAT_B of the optimum                                      */
+    bool    hasLocal;                         /*!< A local minimum is present                                */
+    double  aL;                               /*!< AAT_A of the local minimum                                */
+    double  bL;                               /*!< AAT_B of the local minimum                                */
+    bool    isNoisy;                          /*!< Measurements have +/-1 LSB noise                          */
+    uint8_t capA;                             /*!< AAT_A register                                            */
+    uint8_t capB;                             /*!< AAT_B register                                            */
+} benchAntenna;
+
+
+/*! Search configuration under benchmark */
+typedef struct
+{
+    const char       *name;                   /*!< Label                                                     */
+    st25r3916AatAlgo  algo;                   /*!< Search algorithm                                          */
+    bool              doDynamicSteps;         /*!< Reduce the step size (hill climbing)                      */
+    uint8_t           measureLimit;           /*!< Measurement limit                                         */
+} benchAlgo;
+
+
+/*! Averages over all trials of one configuration */
+typedef struct
+{
+    double   measureCnt;                      /*!< Measurements performed                                    */
+    uint16_t measureMax;                      /*!< Largest number of measurements                            */
+    double   f;                               /*!< Cost reported by st25r3916AatTune()                       */
+    double   excess;                          /*!< True cost above the global minimum                        */
+    double   duration;                        /*!< Wall time reported by st25r3916AatTune() [ms]             */
+    uint32_t hits;                            /*!< Trials ending within 8 of the global minimum              */
+    uint32_t overruns;                        /*!< Trials ending with ERR_OVERRUN                            */
+} benchResult;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static benchAntenna gAnt;
+
+static const benchAlgo gAlgo[] =
+{
+    { "hill climb, dynamic",   ST25R3916_AAT_ALGO_HILLCLIMB,    true,  50U },
+    { "hill climb, fixed",     ST25R3916_AAT_ALGO_HILLCLIMB,    false, 50U },
+    { "grid+simplex, 50",      ST25R3916_AAT_ALGO_GRID_SIMPLEX, true,  50U },
+    { "grid+simplex, 30",      ST25R3916_AAT_ALGO_GRID_SIMPLEX, true,  30U },
+};
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+static uint8_t benchClamp( double val )
+{
+    return (uint8_t)((val < 0.0) ? 0.0 : ((val > 255.0) ? 255.0 : val));
+}
+
+
+/*******************************************************************************/
+/* Amplitude and phase of the antenna with the given caps, noise free */
+static void benchAntennaResponse( uint8_t a, uint8_t b, double *amp, double *pha )
+{
+    double u;
+    double v;
+    double p;
+    double q;
+    double g;
+
+    u = (((double)a - gAnt.a0) / BENCH_SCALE);
+    v = (((double)b - gAnt.b0) / BENCH_SCALE);
+
+    /* Steep across the valley (p), shallow along it (q) */
+    p = ((u * cos( BENCH_VALLEY_ANGLE )) + (v * sin( BENCH_VALLEY_ANGLE )));
+    q = ((v * cos( BENCH_VALLEY_ANGLE )) - (u * sin( BENCH_VALLEY_ANGLE )));
+
+    *amp = ((double)BENCH_AMP_TARGET - (150.0 * (1.0 - exp( -((p * p) + (0.15 * q * q)) ))));
+    *pha = ((double)BENCH_PHA_TARGET + (90.0 * tanh( (1.2 * p) - (0.4 * q) )));
+
+    /* Local minimum: response pulled towards the targets around (aL, bL) */
+    if( gAnt.hasLocal )
+    {
+        u = (((double)a - gAnt.aL) / BENCH_SCALE);
+        v = (((double)b - gAnt.bL) / BENCH_SCALE);
+        g = (0.7 * exp( -((u * u) + (v * v)) / 0.08 ));
+
+        *amp += (((double)BENCH_AMP_TARGET - *amp) * g);
+        *pha += (((double)BENCH_PHA_TARGET - *pha) * g);
+    }
+}
+
+
+/*******************************************************************************/
+/* Cost as computed by aatCalcF() with the default weights, on the noise free surface */
+static uint32_t benchCost( uint8_t a, uint8_t b )
+{
+    double amp;
+    double pha;
+    int    ad;
+    int    pd;
+
+    benchAntennaResponse( a, b, &amp, &pha );
+    ad = ((int)benchClamp( amp + 0.5 ) - (int)BENCH_AMP_TARGET);
+    pd = ((int)benchClamp( pha + 0.5 ) - (int)BENCH_PHA_TARGET);
+
+    return (uint32_t)(abs( ad ) + (2 * abs( pd )));
+}
+
+
+/*******************************************************************************/
+static void benchAntennaSetup( bool hasLocal )
+{
+    gAnt.a0       = (double)(BENCH_OPT_MARGIN + (int)(benchRand() % (uint32_t)(BENCH_CAP_MAX - (2 * BENCH_OPT_MARGIN))));
+    gAnt.b0       = (double)(BENCH_OPT_MARGIN + (int)(benchRand() % (uint32_t)(BENCH_CAP_MAX - (2 * BENCH_OPT_MARGIN))));
+    gAnt.hasLocal = hasLocal;
+    gAnt.isNoisy  = true;
+
+    /* Local minimum about a third of the range away from the optimum */
+    gAnt.aL = fmod( (gAnt.a0 + 85.0), 256.0 );
+    gAnt.bL = fmod( (gAnt.b0 + 170.0), 256.0 );
+}
+
+
+/*******************************************************************************/
+static uint32_t benchGlobalMin( void )
+{
+    uint32_t fMin;
+    uint32_t f;
+    int      a;
+    int      b;
+
+    fMin = UINT32_MAX;
+    for( a = 0; a <= BENCH_CAP_MAX; a++ )
+    {
+        for( b = 0; b <= BENCH_CAP_MAX; b++ )
+        {
+            f    = benchCost( (uint8_t)a, (uint8_t)b );
+            fMin = MIN( fMin, f );
+        }
+    }
+
+    return fMin;
+}
+
+
+/*******************************************************************************/
+static void benchSurface( const char *name, bool hasLocal, uint32_t trials )
+{
+    struct st25r3916AatTuneParams tp;
+    struct st25r3916AatTuneResult ts;
+    benchResult                   res[SIZEOF_ARRAY( gAlgo )];
+    ReturnCode                    ret;
+    uint32_t                      fMin;
+    uint32_t                      excess;
+    uint32_t                      t;
+    uint8_t                       i;
+
+    ST_MEMSET( res, 0x00, sizeof(res) );
+
+    for( t = 0; t < trials; t++ )
+    {
+        benchAntennaSetup( hasLocal );
+        fMin = benchGlobalMin();
+
+        for( i = 0; i < SIZEOF_ARRAY( gAlgo ); i++ )
+        {
+            /* Default parameters of st25r3916AatTune(), starting from the middle of the range */
+            tp.aat_a_min       = 0;
+            tp.aat_a_max       = 255;
+            tp.aat_a_start     = 127;
+            tp.aat_a_stepWidth = 32;
+            tp.aat_b_min       = 0;
+            tp.aat_b_max       = 255;
+            tp.aat_b_start     = 127;
+            tp.aat_b_stepWidth = 32;
+            tp.phaTarget       = BENCH_PHA_TARGET;
+            tp.phaWeight       = 2;
+            tp.ampTarget       = BENCH_AMP_TARGET;
+            tp.ampWeight       = 1;
+            tp.doDynamicSteps  = gAlgo[i].doDynamicSteps;
+            tp.measureLimit    = gAlgo[i].measureLimit;
+            tp.algo            = gAlgo[i].algo;
+
+            ST_MEMSET( &ts, 0x00, sizeof(ts) );
+            ret    = st25r3916AatTune( &tp, &ts );
+            excess = (benchCost( ts.aat_a, ts.aat_b ) - fMin);
+
+            res[i].measureCnt += ts.measureCnt;
+            res[i].measureMax  = MAX( res[i].measureMax, ts.measureCnt );
+            res[i].f          += ts.f;
+            res[i].excess     += excess;
+            res[i].duration   += ts.duration;
+            res[i].hits       += ((excess <= 8U) ? 1U : 0U);
+            res[i].overruns   += ((ret == ERR_OVERRUN) ? 1U : 0U);
+        }
+    }
+
+    printf( "\n%s, %u trials\n", name, (unsigned)trials );
+    printf( "  algorithm           | measures |  max | f reported | f above min | within 8 | overrun | time [ms]\n" );
+    for( i = 0; i < SIZEOF_ARRAY( gAlgo ); i++ )
+    {
+        printf( "  %-19s | %8.1f | %4u | %10.1f | %11.1f | %7.1f%% | %6.1f%% | %9.1f\n", gAlgo[i].name,
+                (res[i].measureCnt / trials), res[i].measureMax, (res[i].f / trials), (res[i].excess / trials),
+                ((100.0 * res[i].hits) / trials), ((100.0 * res[i].overruns) / trials), (res[i].duration / trials) );
+    }
+}
+
+
+/*
+ ******************************************************************************
+ * CHIP (simulated antenna)
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+ReturnCode st25r3916ReadRegister( uint8_t reg, uint8_t* val )
+{
+    *val = ((reg == ST25R3916_REG_ANT_TUNE_A) ? gAnt.capA : ((reg == ST25R3916_REG_ANT_TUNE_B) ? gAnt.capB : 0U));
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode st25r3916WriteRegister( uint8_t reg, uint8_t val )
+{
+    return st25r3916WriteMultipleRegisters( reg, &val, 1U );
+}
+
+
+/*******************************************************************************/
+ReturnCode st25r3916WriteMultipleRegisters( uint8_t reg, const uint8_t* values, uint8_t length )
+{
+    uint8_t i;
+
+    for( i = 0; i < length; i++ )
+    {
+        if( (reg + i) == ST25R3916_REG_ANT_TUNE_A )
+        {
+            gAnt.capA = values[i];
+        }
+        else if( (reg + i) == ST25R3916_REG_ANT_TUNE_B )
+        {
+            gAnt.capB = values[i];
+        }
+        else
+        {
+            /* Not part of the antenna model */
+        }
+    }
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalChipMeasureAmplitude( uint8_t* result )
+{
+    double amp;
+    double pha;
+
+    benchAntennaResponse( gAnt.capA, gAnt.capB, &amp, &pha );
+    *result = benchClamp( amp + 0.5 + (gAnt.isNoisy ? ((double)(benchRand() % 3U) - 1.0) : 0.0) );
+
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalChipMeasurePhase( uint8_t* result )
+{
+    double amp;
+    double pha;
+
+    benchAntennaResponse( gAnt.capA, gAnt.capB, &amp, &pha );
+    *result = benchClamp( pha + 0.5 + (gAnt.isNoisy ? ((double)(benchRand() % 3U) - 1.0) : 0.0) );
+
+    return ERR_NONE;
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+int main( int argc, char **argv )
+{
+    uint32_t trials;
+
+    trials = ((argc > 1) ? (uint32_t)strtoul( argv[1], NULL, 0 ) : BENCH_TRIALS);
+    benchSeed( ((argc > 2) ? (uint32_t)strtoul( argv[2], NULL, 0 ) : 0U) );
+
+    if( trials == 0U )
+    {
+        trials = BENCH_TRIALS;
+    }
+
+    benchSurface( "Smooth surface, oblique valley", false, trials );
+    benchSurface( "Surface with a local minimum", true, trials );
+
+    return 0;
+}
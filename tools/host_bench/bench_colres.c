@@ -0,0 +1,457 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_colres.c
+ *
+ *  \author
+ *
+ *  \brief NFC-B and NFC-F adaptive collision resolution benchmark
+ *
+ *  Runs the collision resolution of rfal_nfcb.c and rfal_nfcf.c against a
+ *  simulated population of 1 to 20 cards and reports the rounds, slots,
+ *  collisions and air time as given by their statistics.
+ *
+ *  NFC-B: the adaptive slot estimation (initial 1 slot, up to 16) is
+ *  compared with fixed rounds of 16 slots.
+ *  NFC-F: the adaptive re-polling sized on the Technology Detection is
+ *  compared with the single 16 Time Slot SENSF_REQ it replaces.
+ *
+ *  Usage: bench_colres [trials] [seed]
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include <stdio.h>
+#include "bench_rf.h"
+#include "rfal_nfcb.h"
+#include "rfal_nfcf.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define BENCH_DEV_MAX               20U       /*!< Largest population simulated                              */
+#define BENCH_TRIALS                500U      /*!< Default number of trials per population                   */
+
+#define BENCH_NFCB_CMD_SENSB_REQ    0x05U     /*!< SENSB_REQ / ALLB_REQ / SLOT_MARKER command                */
+#define BENCH_NFCB_CMD_SLPB_REQ     0x50U     /*!< SLPB_REQ command                                          */
+#define BENCH_NFCB_SENSB_RES        0x50U     /*!< SENSB_RES command                                         */
+#define BENCH_NFCB_PARAM_ALL        0x08U     /*!< ALLB_REQ flag in PARAM                                    */
+#define BENCH_NFCB_PARAM_N_MASK     0x07U     /*!< Number of slots code in PARAM                             */
+#define BENCH_NFCB_FSCI_PROTO       0x81U     /*!< FSCI 256 bytes, ISO14443-4 compliant                      */
+#define BENCH_NFCB_FWI_ADC_FO       0x71U     /*!< FWI 7, ADC 0, CID supported                               */
+
+#define BENCH_NFCF_SENSF_RES_LEN    18U       /*!< LEN, CMD, NFCID2 and PAD                                  */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! Simulated NFC-B card (ISO14443-3 Type B) */
+typedef struct
+{
+    uint8_t pupi[RFAL_NFCB_NFCID0_LEN];       /*!< PUPI                                                      */
+    bool    isHalt;                           /*!< HALT state, only answers ALLB_REQ                         */
+    bool    isPending;                        /*!< Waits for its slot in the current round                   */
+    uint8_t slot;                             /*!< Slot picked on the current round                          */
+} benchNfcbCard;
+
+
+/*! Simulated NFC-F card */
+typedef struct
+{
+    uint8_t nfcid2[RFAL_NFCF_NFCID2_LEN];     /*!< NFCID2                                                    */
+    bool    isSeen;                           /*!< Answered alone in a Time Slot at least once               */
+} benchNfcfCard;
+
+
+/*! Averages over all trials of one population */
+typedef struct
+{
+    double found;                             /*!< Devices identified                                        */
+    double rounds;                            /*!< Rounds performed                                          */
+    double slots;                             /*!< Slots opened                                              */
+    double collisions;                        /*!< Slots with a collision                                    */
+    double airTime;                           /*!< Air time [ms]                                             */
+} benchResult;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static benchNfcbCard gCardB[BENCH_DEV_MAX];
+static benchNfcfCard gCardF[BENCH_DEV_MAX];
+static uint8_t       gCardCnt;
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+static void benchNfcbSetup( uint8_t cnt )
+{
+    uint8_t i;
+
+    gCardCnt = cnt;
+    for( i = 0; i < cnt; i++ )
+    {
+        gCardB[i].pupi[0]   = i;                                      /* Keeps the PUPIs unique */
+        gCardB[i].pupi[1]   = (uint8_t)benchRand();
+        gCardB[i].pupi[2]   = (uint8_t)benchRand();
+        gCardB[i].pupi[3]   = (uint8_t)benchRand();
+        gCardB[i].isHalt    = false;
+        gCardB[i].isPending = false;
+    }
+}
+
+
+/*******************************************************************************/
+/* Cards that picked the given slot answer, more than one is seen as a CRC error */
+static ReturnCode benchNfcbSlot( uint8_t slot, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen )
+{
+    uint8_t i;
+    uint8_t cnt;
+    uint8_t last;
+
+    cnt  = 0;
+    last = 0;
+    for( i = 0; i < gCardCnt; i++ )
+    {
+        if( gCardB[i].isPending && (gCardB[i].slot == slot) )
+        {
+            gCardB[i].isPending = false;
+            last = i;
+            cnt++;
+        }
+    }
+
+    if( (cnt == 0U) || (rxBufLen < RFAL_NFCB_SENSB_RES_LEN) )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    ST_MEMSET( rxBuf, 0x00, RFAL_NFCB_SENSB_RES_LEN );
+    rxBuf[0] = BENCH_NFCB_SENSB_RES;
+    ST_MEMCPY( &rxBuf[1], gCardB[last].pupi, RFAL_NFCB_NFCID0_LEN );
+    rxBuf[10] = BENCH_NFCB_FSCI_PROTO;
+    rxBuf[11] = BENCH_NFCB_FWI_ADC_FO;
+    *rxLen    = RFAL_NFCB_SENSB_RES_LEN;
+
+    return ((cnt == 1U) ? ERR_NONE : ERR_CRC);
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchNfcbTxRx( const uint8_t *txBuf, uint16_t txLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen )
+{
+    uint8_t i;
+    uint8_t slots;
+    bool    isAll;
+
+    /* SENSB_REQ | ALLB_REQ: every card not in HALT (any card on ALLB_REQ) picks a slot */
+    if( (txLen == 3U) && (txBuf[0] == BENCH_NFCB_CMD_SENSB_REQ) )
+    {
+        isAll = ((txBuf[2] & BENCH_NFCB_PARAM_ALL) != 0U);
+        slots = (uint8_t)(1U << (txBuf[2] & BENCH_NFCB_PARAM_N_MASK));
+
+        for( i = 0; i < gCardCnt; i++ )
+        {
+            gCardB[i].isPending = false;
+            if( !gCardB[i].isHalt || isAll )
+            {
+                gCardB[i].isHalt    = false;
+                gCardB[i].isPending = true;
+                gCardB[i].slot      = (uint8_t)(benchRand() % slots);
+            }
+        }
+        return benchNfcbSlot( 0, rxBuf, rxBufLen, rxLen );
+    }
+
+    /* SLOT_MARKER: APn opens slot n */
+    if( (txLen == 1U) && ((txBuf[0] & 0x0FU) == BENCH_NFCB_CMD_SENSB_REQ) )
+    {
+        return benchNfcbSlot( (uint8_t)(txBuf[0] >> 4U), rxBuf, rxBufLen, rxLen );
+    }
+
+    /* SLPB_REQ: the addressed card goes to HALT */
+    if( (txLen == (1U + RFAL_NFCB_NFCID0_LEN)) && (txBuf[0] == BENCH_NFCB_CMD_SLPB_REQ) )
+    {
+        for( i = 0; i < gCardCnt; i++ )
+        {
+            if( ST_BYTECMP( gCardB[i].pupi, &txBuf[1], RFAL_NFCB_NFCID0_LEN ) == 0 )
+            {
+                gCardB[i].isHalt    = true;
+                gCardB[i].isPending = false;
+                rxBuf[0] = 0x00;
+                *rxLen   = 1U;
+                return ERR_NONE;
+            }
+        }
+    }
+
+    return ERR_TIMEOUT;
+}
+
+
+/*******************************************************************************/
+static void benchNfcfSetup( uint8_t cnt )
+{
+    uint8_t i;
+    uint8_t j;
+
+    gCardCnt = cnt;
+    for( i = 0; i < cnt; i++ )
+    {
+        gCardF[i].nfcid2[0] = 0x02U;                                  /* T3T, no NFC-DEP */
+        gCardF[i].nfcid2[1] = 0xFEU;
+        gCardF[i].nfcid2[2] = i;                                      /* Keeps the NFCID2s unique */
+        for( j = 3; j < RFAL_NFCF_NFCID2_LEN; j++ )
+        {
+            gCardF[i].nfcid2[j] = (uint8_t)benchRand();
+        }
+        gCardF[i].isSeen = false;
+    }
+}
+
+
+/*******************************************************************************/
+/* NFC-F cards cannot be muted: every card answers every Poll on a random Time Slot */
+static uint8_t benchNfcfPoll( uint8_t tsn, rfalFeliCaPollRes *resList, uint8_t resListSize, uint8_t *collisions )
+{
+    uint8_t slotOf[BENCH_DEV_MAX];
+    uint8_t i;
+    uint8_t s;
+    uint8_t cnt;
+    uint8_t last;
+    uint8_t found;
+
+    for( i = 0; i < gCardCnt; i++ )
+    {
+        slotOf[i] = (uint8_t)(benchRand() % ((uint32_t)tsn + 1U));
+    }
+
+    found       = 0;
+    *collisions = 0;
+    for( s = 0; s <= tsn; s++ )
+    {
+        cnt  = 0;
+        last = 0;
+        for( i = 0; i < gCardCnt; i++ )
+        {
+            if( slotOf[i] == s )
+            {
+                last = i;
+                cnt++;
+            }
+        }
+
+        if( cnt > 1U )
+        {
+            (*collisions)++;
+        }
+        else if( cnt == 1U )
+        {
+            gCardF[last].isSeen = true;
+            if( found < resListSize )
+            {
+                ST_MEMSET( resList[found], 0x00, RFAL_FELICA_POLL_RES_LEN );
+                resList[found][0] = BENCH_NFCF_SENSF_RES_LEN;
+                resList[found][1] = (uint8_t)RFAL_NFCF_CMD_POLLING_RES;
+                ST_MEMCPY( &resList[found][2], gCardF[last].nfcid2, RFAL_NFCF_NFCID2_LEN );
+            }
+            found++;
+        }
+        else
+        {
+            /* Empty Time Slot */
+        }
+    }
+
+    return MIN( found, resListSize );
+}
+
+
+/*******************************************************************************/
+static void benchAccumulate( benchResult *res, uint8_t found, uint8_t rounds, uint16_t slots, uint16_t collisions, uint32_t airTime )
+{
+    res->found      += found;
+    res->rounds     += rounds;
+    res->slots      += slots;
+    res->collisions += collisions;
+    res->airTime    += ((double)airTime / 1000.0);
+}
+
+
+/*******************************************************************************/
+static void benchPrint( uint8_t cards, const char *algo, const benchResult *res, uint32_t trials )
+{
+    printf( "  %5u | %-18s | %6.2f | %6.2f | %6.2f | %10.2f | %8.2f\n", cards, algo,
+            (res->found / trials), (res->rounds / trials), (res->slots / trials), (res->collisions / trials), (res->airTime / trials) );
+}
+
+
+/*******************************************************************************/
+static void benchNfcb( uint32_t trials )
+{
+    static const benchRfPopulation pop = { benchNfcbTxRx, NULL, NULL, NULL };
+    rfalNfcbListenDevice devList[BENCH_DEV_MAX];
+    rfalNfcbColResStats  stats;
+    benchResult          adaptive;
+    benchResult          fixed;
+    uint8_t              devCnt;
+    uint8_t              cards;
+    uint32_t             t;
+    bool                 colPending;
+
+    benchRfSetPopulation( &pop );
+
+    printf( "\nNFC-B collision resolution (NFC Forum mode), %u trials per population\n", (unsigned)trials );
+    printf( "  cards | algorithm          |  found | rounds |  slots | collisions | air [ms]\n" );
+
+    for( cards = 1; cards <= BENCH_DEV_MAX; cards++ )
+    {
+        ST_MEMSET( &adaptive, 0x00, sizeof(benchResult) );
+        ST_MEMSET( &fixed, 0x00, sizeof(benchResult) );
+
+        for( t = 0; t < trials; t++ )
+        {
+            benchNfcbSetup( cards );
+            benchRfResetTime();
+            rfalNfcbPollerInitialize();
+            rfalNfcbPollerSlottedCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_DEV_MAX, RFAL_NFCB_SLOT_NUM_1, RFAL_NFCB_SLOT_NUM_16, devList, &devCnt, &colPending );
+            rfalNfcbPollerGetCollisionResolutionStats( &stats );
+            benchAccumulate( &adaptive, devCnt, stats.rounds, stats.slots, stats.collisions, stats.airTime );
+
+            benchNfcbSetup( cards );
+            benchRfResetTime();
+            rfalNfcbPollerInitialize();
+            rfalNfcbPollerSlottedCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_DEV_MAX, RFAL_NFCB_SLOT_NUM_16, RFAL_NFCB_SLOT_NUM_16, devList, &devCnt, &colPending );
+            rfalNfcbPollerGetCollisionResolutionStats( &stats );
+            benchAccumulate( &fixed, devCnt, stats.rounds, stats.slots, stats.collisions, stats.airTime );
+        }
+
+        benchPrint( cards, "adaptive 1..16", &adaptive, trials );
+        benchPrint( cards, "fixed 16 slots", &fixed, trials );
+    }
+}
+
+
+/*******************************************************************************/
+static void benchNfcf( uint32_t trials )
+{
+    static const benchRfPopulation pop = { NULL, benchNfcfPoll, NULL, NULL };
+    rfalNfcfListenDevice devList[BENCH_DEV_MAX];
+    rfalFeliCaPollRes    pollRes[RFAL_FELICA_POLL_MAX_SLOTS];
+    rfalNfcfColResStats  stats;
+    benchResult          adaptive;
+    benchResult          single;
+    uint8_t              devCnt;
+    uint8_t              found;
+    uint8_t              coll;
+    uint8_t              cards;
+    uint8_t              i;
+    uint32_t             t;
+    uint32_t             start;
+
+    benchRfSetPopulation( &pop );
+
+    printf( "\nNFC-F collision resolution (NFC Forum mode), %u trials per population\n", (unsigned)trials );
+    printf( "  cards | algorithm          |  found | rounds |  slots | collisions | air [ms]\n" );
+
+    for( cards = 1; cards <= BENCH_DEV_MAX; cards++ )
+    {
+        ST_MEMSET( &adaptive, 0x00, sizeof(benchResult) );
+        ST_MEMSET( &single, 0x00, sizeof(benchResult) );
+
+        for( t = 0; t < trials; t++ )
+        {
+            /* Technology Detection (4 Time Slots) feeds the estimation of the first round */
+            benchNfcfSetup( cards );
+            benchRfResetTime();
+            rfalNfcfPollerInitialize( RFAL_BR_212 );
+            rfalNfcfPollerCheckPresence();
+            rfalNfcfPollerCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_DEV_MAX, devList, &devCnt );
+            rfalNfcfPollerGetCollisionResolutionStats( &stats );
+            benchAccumulate( &adaptive, devCnt, stats.rounds, stats.slots, stats.collisions, stats.airTime );
+
+            /* Same Technology Detection followed by a single Poll of 16 Time Slots */
+            benchNfcfSetup( cards );
+            benchRfResetTime();
+            rfalNfcfPollerInitialize( RFAL_BR_212 );
+            rfalNfcfPollerCheckPresence();
+            start = benchRfGetTime();
+            rfalFeliCaPoll( RFAL_FELICA_16_SLOTS, 0xFFFFU, RFAL_FELICA_POLL_RC_NO_REQUEST, pollRes, RFAL_FELICA_POLL_MAX_SLOTS, &found, &coll );
+
+            found = 0;
+            for( i = 0; i < cards; i++ )
+            {
+                found += (gCardF[i].isSeen ? 1U : 0U);
+            }
+            benchAccumulate( &single, found, 1U, RFAL_FELICA_POLL_MAX_SLOTS, coll, (benchRfGetTime() - start) );
+        }
+
+        benchPrint( cards, "adaptive", &adaptive, trials );
+        benchPrint( cards, "single 16 slots", &single, trials );
+    }
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+int main( int argc, char **argv )
+{
+    uint32_t trials;
+
+    trials = ((argc > 1) ? (uint32_t)strtoul( argv[1], NULL, 0 ) : BENCH_TRIALS);
+    benchSeed( ((argc > 2) ? (uint32_t)strtoul( argv[2], NULL, 0 ) : 0U) );
+
+    if( trials == 0U )
+    {
+        trials = BENCH_TRIALS;
+    }
+
+    benchNfcb( trials );
+    benchNfcf( trials );
+
+    return 0;
+}
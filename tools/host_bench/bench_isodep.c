@@ -0,0 +1,386 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_isodep.c
+ *
+ *  \author
+ *
+ *  \brief ISO-DEP bulk transfer throughput benchmark
+ *
+ *  Activates a simulated ISO14443A PICC through rfal_isoDep.c and reads a
+ *  file with extended Le READ BINARY APDUs as large as the APDU buffer
+ *  holds. The PICC accepts frames up to 4096 bytes and chains its responses
+ *  on the FSD announced by the poller, so the frames exchanged only depend
+ *  on the CONFIG_ST25R3916_LIB_ISO_DEP_FRAME_SIZE the program is built with.
+ *
+ *  The transfer is run at 106 kbps and after a PPS to 848 kbps.
+ *
+ *  Usage: bench_isodep [file length]
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_rf.h"
+#include "rfal_isoDep.h"
+#include "rfal_nfcb.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define BENCH_FILE_LEN              16384U    /*!< Default length of the file read                           */
+#define BENCH_FILE_LEN_MAX          65535U    /*!< Largest file READ BINARY offsets address                  */
+
+#define BENCH_PICC_FSCI             0x0CU     /*!< FSCI announced by the PICC: 4096 bytes                    */
+#define BENCH_PICC_FWI              8U        /*!< FWI announced by the PICC (~77ms)                         */
+#define BENCH_PICC_TA               0x77U     /*!< TA: 212, 424 and 848 kbps in both directions              */
+#define BENCH_PICC_APDU_US          1000U     /*!< PICC processing time of an APDU [us]                      */
+
+#define BENCH_CMD_RATS              0xE0U     /*!< RATS                                                      */
+#define BENCH_RATS_FSDI_SHIFT       4U        /*!< FSDI position in the RATS PARAM                           */
+#define BENCH_ATS_TB_FWI_SHIFT      4U        /*!< FWI position in the ATS TB                                */
+#define BENCH_CMD_PPS               0xD0U     /*!< PPSS without CID                                          */
+#define BENCH_CMD_PPS_MASK          0xF0U     /*!< PPSS command bits                                         */
+#define BENCH_PCB_IBLOCK            0x02U     /*!< I-Block                                                   */
+#define BENCH_PCB_IBLOCK_MASK       0xE2U     /*!< I-Block type bits                                         */
+#define BENCH_PCB_RACK              0xA2U     /*!< R(ACK)                                                    */
+#define BENCH_PCB_RBLOCK_MASK       0xF6U     /*!< R-Block type and NAK bits                                 */
+#define BENCH_PCB_DESELECT          0xC2U     /*!< S(DESELECT)                                               */
+#define BENCH_PCB_CHAINING          0x10U     /*!< Chaining bit                                              */
+#define BENCH_PCB_BN                0x01U     /*!< Block number                                              */
+
+#define BENCH_PROLOGUE_LEN          1U        /*!< PCB only: no CID, no NAD                                  */
+#define BENCH_CRC_LEN               2U        /*!< CRC_A, part of the frame size                             */
+
+#define BENCH_APDU_READ_BINARY      0xB0U     /*!< READ BINARY INS                                           */
+#define BENCH_APDU_EXT_LE_LEN       7U        /*!< CLA INS P1 P2 and extended Le (00 Le1 Le2)                */
+#define BENCH_APDU_SW_LEN           2U        /*!< SW1 SW2                                                   */
+#define BENCH_APDU_RESP_MAX         (RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN - BENCH_APDU_SW_LEN) /*!< Data per APDU  */
+
+#define benchFileByte( off )        ((uint8_t)(((off) * 7U) + ((off) >> 8U)))  /*!< Content of the file at off */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! Simulated ISO14443-4 PICC */
+typedef struct
+{
+    uint16_t fsd;                             /*!< Frame size announced by the poller on RATS                */
+    uint8_t  resp[RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN + BENCH_APDU_SW_LEN]; /*!< Pending response APDU     */
+    uint16_t respLen;                         /*!< Response APDU length                                      */
+    uint16_t respOff;                         /*!< Response bytes already sent                               */
+    uint16_t lastOff;                         /*!< Response offset of the last block sent                    */
+    uint8_t  bn;                              /*!< Current block number                                      */
+} benchPicc;
+
+
+/*! Result of one file read */
+typedef struct
+{
+    uint32_t apdus;                           /*!< APDUs exchanged                                           */
+    uint32_t frames;                          /*!< Frames sent by the poller, each one a turnaround          */
+    uint32_t airTime;                         /*!< Transfer time [us]                                        */
+    bool     ok;                              /*!< File read back unaltered                                  */
+} benchResult;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static benchPicc               gPicc;
+static rfalIsoDepApduBufFormat gTxApdu;
+static rfalIsoDepApduBufFormat gRxApdu;
+static rfalIsoDepBufFormat     gTmpBuf;
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+/* Sends the response block starting at off, chained if the rest does not fit the FSD */
+static ReturnCode benchPiccBlock( uint8_t bn, uint16_t off, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen )
+{
+    uint16_t len;
+
+    len = MIN( (uint16_t)(gPicc.respLen - off), (uint16_t)(gPicc.fsd - BENCH_PROLOGUE_LEN - BENCH_CRC_LEN) );
+    if( (len + BENCH_PROLOGUE_LEN) > rxBufLen )
+    {
+        return ERR_PROTO;
+    }
+
+    rxBuf[0] = (uint8_t)(BENCH_PCB_IBLOCK | bn | (((off + len) < gPicc.respLen) ? BENCH_PCB_CHAINING : 0U));
+    ST_MEMCPY( &rxBuf[BENCH_PROLOGUE_LEN], &gPicc.resp[off], len );
+
+    gPicc.bn      = bn;
+    gPicc.lastOff = off;
+    gPicc.respOff = (uint16_t)(off + len);
+    *rxLen        = (uint16_t)(len + BENCH_PROLOGUE_LEN);
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+/* Builds the response of the APDU received   ISO7816-4 READ BINARY, extended Le only */
+static void benchPiccApdu( const uint8_t *apdu, uint16_t apduLen )
+{
+    uint16_t off;
+    uint16_t le;
+    uint16_t i;
+
+    gPicc.respLen = 0;
+    gPicc.respOff = 0;
+
+    if( (apduLen != BENCH_APDU_EXT_LE_LEN) || (apdu[1] != BENCH_APDU_READ_BINARY) || (apdu[4] != 0x00U) )
+    {
+        gPicc.resp[gPicc.respLen++] = 0x6DU;                          /* INS not supported      */
+        gPicc.resp[gPicc.respLen++] = 0x00U;
+        return;
+    }
+
+    off = (uint16_t)(((uint16_t)apdu[2] << 8U) | apdu[3]);
+    le  = (uint16_t)(((uint16_t)apdu[5] << 8U) | apdu[6]);
+    le  = MIN( le, (uint16_t)(sizeof(gPicc.resp) - BENCH_APDU_SW_LEN) );
+
+    for( i = 0; i < le; i++ )
+    {
+        gPicc.resp[gPicc.respLen++] = benchFileByte( (uint32_t)off + i );
+    }
+    gPicc.resp[gPicc.respLen++] = 0x90U;
+    gPicc.resp[gPicc.respLen++] = 0x00U;
+
+    benchRfDelay( BENCH_PICC_APDU_US );
+}
+
+
+/*******************************************************************************/
+static ReturnCode benchPiccTxRx( const uint8_t *txBuf, uint16_t txLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen )
+{
+    /* RATS: FSD from PARAM, answer the ATS   Digital 2.1  14.6.2 */
+    if( (txLen == sizeof(rfalIsoDepRats)) && (txBuf[0] == BENCH_CMD_RATS) )
+    {
+        gPicc.fsd = rfalIsoDepFSxI2FSx( (uint8_t)(txBuf[1] >> BENCH_RATS_FSDI_SHIFT) );
+
+        rxBuf[0] = 5U;                                                /* TL                     */
+        rxBuf[1] = (uint8_t)(RFAL_ISODEP_ATS_T0_TA_PRESENCE_MASK | RFAL_ISODEP_ATS_T0_TB_PRESENCE_MASK | RFAL_ISODEP_ATS_T0_TC_PRESENCE_MASK | BENCH_PICC_FSCI);
+        rxBuf[2] = BENCH_PICC_TA;
+        rxBuf[3] = (uint8_t)(BENCH_PICC_FWI << BENCH_ATS_TB_FWI_SHIFT);
+        rxBuf[4] = 0x00U;                                             /* No DID, no NAD         */
+        *rxLen   = 5U;
+        return ERR_NONE;
+    }
+
+    /* PPS: acknowledged with the PPSS */
+    if( (txBuf[0] & BENCH_CMD_PPS_MASK) == BENCH_CMD_PPS )
+    {
+        rxBuf[0] = txBuf[0];
+        *rxLen   = 1U;
+        return ERR_NONE;
+    }
+
+    /* I-Block: the APDU always fits a single block, answer with its block number */
+    if( (txBuf[0] & BENCH_PCB_IBLOCK_MASK) == BENCH_PCB_IBLOCK )
+    {
+        benchPiccApdu( &txBuf[BENCH_PROLOGUE_LEN], (uint16_t)(txLen - BENCH_PROLOGUE_LEN) );
+        return benchPiccBlock( (txBuf[0] & BENCH_PCB_BN), 0U, rxBuf, rxBufLen, rxLen );
+    }
+
+    /* R(ACK): next chained block, the last one again if it carries the current block number   ISO14443-4 7.5.4.3 */
+    if( (txBuf[0] & BENCH_PCB_RBLOCK_MASK) == BENCH_PCB_RACK )
+    {
+        return benchPiccBlock( (txBuf[0] & BENCH_PCB_BN), (((txBuf[0] & BENCH_PCB_BN) == gPicc.bn) ? gPicc.lastOff : gPicc.respOff), rxBuf, rxBufLen, rxLen );
+    }
+
+    if( txBuf[0] == BENCH_PCB_DESELECT )
+    {
+        rxBuf[0] = BENCH_PCB_DESELECT;
+        *rxLen   = 1U;
+        return ERR_NONE;
+    }
+
+    return ERR_TIMEOUT;
+}
+
+
+/*******************************************************************************/
+/* Activates the PICC and reads fileLen bytes of its file */
+static ReturnCode benchIsoDepRead( rfalBitRate maxBR, uint16_t fileLen, rfalIsoDepDevice *dev, benchResult *res )
+{
+    rfalIsoDepApduTxRxParam param;
+    ReturnCode              ret;
+    uint16_t                off;
+    uint16_t                le;
+    uint16_t                rxLen;
+    uint16_t                i;
+    uint32_t                start;
+    uint32_t                frames;
+
+    ST_MEMSET( res, 0x00, sizeof(benchResult) );
+    res->ok = true;
+
+    /* Activation as done by the NFC layer, the transfer is measured after it */
+    rfalSetMode( RFAL_MODE_POLL_NFCA, RFAL_BR_106, RFAL_BR_106 );
+    rfalSetFDTPoll( RFAL_FDT_POLL_NFCA_POLLER );
+    rfalIsoDepInitialize();
+    EXIT_ON_ERR( ret, rfalIsoDepPollAHandleActivation( RFAL_ISODEP_FSDI_MAX, RFAL_ISODEP_NO_DID, maxBR, dev ) );
+
+    start  = benchRfGetTime();
+    frames = benchRfGetFrameCnt();
+
+    param.txBuf  = &gTxApdu;
+    param.rxBuf  = &gRxApdu;
+    param.rxLen  = &rxLen;
+    param.tmpBuf = &gTmpBuf;
+    param.FWT    = dev->info.FWT;
+    param.dFWT   = dev->info.dFWT;
+    param.FSx    = dev->info.FSx;
+    param.ourFSx = RFAL_ISODEP_FSX_KEEP;
+    param.DID    = dev->info.DID;
+
+    for( off = 0; off < fileLen; off += le )
+    {
+        le = MIN( (uint16_t)(fileLen - off), (uint16_t)BENCH_APDU_RESP_MAX );
+
+        gTxApdu.apdu[0] = 0x00U;
+        gTxApdu.apdu[1] = BENCH_APDU_READ_BINARY;
+        gTxApdu.apdu[2] = (uint8_t)(off >> 8U);
+        gTxApdu.apdu[3] = (uint8_t)off;
+        gTxApdu.apdu[4] = 0x00U;
+        gTxApdu.apdu[5] = (uint8_t)(le >> 8U);
+        gTxApdu.apdu[6] = (uint8_t)le;
+        param.txBufLen  = BENCH_APDU_EXT_LE_LEN;
+
+        EXIT_ON_ERR( ret, rfalIsoDepStartApduTransceive( param ) );
+        rfalRunBlocking( ret, rfalIsoDepGetApduTransceiveStatus() );
+        if( ret != ERR_NONE )
+        {
+            return ret;
+        }
+        res->apdus++;
+
+        if( (rxLen != (le + BENCH_APDU_SW_LEN)) || (gRxApdu.apdu[le] != 0x90U) || (gRxApdu.apdu[le + 1U] != 0x00U) )
+        {
+            res->ok = false;
+            break;
+        }
+        for( i = 0; i < le; i++ )
+        {
+            res->ok = (res->ok && (gRxApdu.apdu[i] == benchFileByte( (uint32_t)off + i )));
+        }
+    }
+
+    res->frames  = (benchRfGetFrameCnt() - frames);
+    res->airTime = (benchRfGetTime() - start);
+
+    rfalIsoDepDeselect();
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+static void benchIsoDep( uint16_t fileLen )
+{
+    static const benchRfPopulation pop = { benchPiccTxRx, NULL, NULL, NULL };
+    static const rfalBitRate       brs[] = { RFAL_BR_106, RFAL_BR_848 };
+    static const uint16_t          brKbps[] = { 106U, 212U, 424U, 848U };
+    rfalIsoDepDevice               dev;
+    benchResult                    res;
+    ReturnCode                     ret;
+    uint8_t                        i;
+
+    benchRfSetPopulation( &pop );
+
+    printf( "\nISO-DEP read of %u bytes, I-Block buffers of %u bytes, APDU buffer of %u bytes\n",
+            fileLen, (unsigned)RFAL_FEATURE_ISO_DEP_IBLOCK_MAX_LEN, (unsigned)RFAL_FEATURE_ISO_DEP_APDU_MAX_LEN );
+    printf( "  kbps |  FSD |  FSC | APDUs | frames | time [ms] | kbit/s | data\n" );
+
+    for( i = 0; i < SIZEOF_ARRAY(brs); i++ )
+    {
+        benchRfResetTime();
+        ret = benchIsoDepRead( brs[i], fileLen, &dev, &res );
+        if( ret != ERR_NONE )
+        {
+            printf( "  %4u | read failed: %d\n", brKbps[brs[i]], ret );
+            continue;
+        }
+
+        printf( "  %4u | %4u | %4u | %5u | %6u | %9.1f | %6.1f | %s\n", brKbps[dev.info.DSI], gPicc.fsd, dev.info.FSx,
+                (unsigned)res.apdus, (unsigned)res.frames, (res.airTime / 1000.0), (((double)fileLen * RFAL_BITS_IN_BYTE * 1000.0) / res.airTime),
+                (res.ok ? "ok" : "CORRUPTED") );
+    }
+}
+
+
+/*
+ ******************************************************************************
+ * MODULES NOT UNDER BENCHMARK
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+uint32_t rfalNfcbTR2ToFDT( uint8_t tr2Code )
+{
+    NO_WARNING( tr2Code );
+
+    return RFAL_FDT_POLL_NFCA_POLLER;
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+int main( int argc, char **argv )
+{
+    uint32_t fileLen;
+
+    fileLen = ((argc > 1) ? (uint32_t)strtoul( argv[1], NULL, 0 ) : BENCH_FILE_LEN);
+    if( (fileLen == 0U) || (fileLen > BENCH_FILE_LEN_MAX) )
+    {
+        fileLen = BENCH_FILE_LEN;
+    }
+
+    benchIsoDep( (uint16_t)fileLen );
+
+    return 0;
+}
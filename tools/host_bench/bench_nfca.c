@@ -0,0 +1,501 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_nfca.c
+ *
+ *  \author
+ *
+ *  \brief NFC-A collision resolution benchmark
+ *
+ *  Runs the full collision resolution of rfal_nfca.c against a simulated
+ *  field of 2 to 16 ISO14443A tags and reports the frames and the air time
+ *  spent per resolved UID.
+ *
+ *  The tags follow the ISO14443-3 state machine (IDLE, READY, ACTIVE, HALT)
+ *  with bit level collisions on the SDD_RES. The same program is built
+ *  against rfal_nfca.c with RFAL_NFCA_CR_PIPELINE enabled (collision tree
+ *  kept between devices) and disabled (each device resolved from the first
+ *  Cascade Level).
+ *
+ *  Usage: bench_nfca [trials] [seed]
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include <stdio.h>
+#include "bench_rf.h"
+#include "rfal_nfca.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#ifndef RFAL_NFCA_CR_PIPELINE
+    #define RFAL_NFCA_CR_PIPELINE   true      /*!< Same default as rfal_nfca.c                               */
+#endif /* RFAL_NFCA_CR_PIPELINE */
+
+#define BENCH_DEV_MIN               2U        /*!< Smallest population simulated                            */
+#define BENCH_DEV_MAX               16U       /*!< Largest population simulated                              */
+#define BENCH_TRIALS                500U      /*!< Default number of trials per population                   */
+
+#define BENCH_NFCA_CMD_REQA         0x26U     /*!< SENS_REQ                                                  */
+#define BENCH_NFCA_CMD_WUPA         0x52U     /*!< ALL_REQ                                                   */
+#define BENCH_NFCA_CMD_SEL_CL1      0x93U     /*!< SDD_REQ/SEL_REQ Cascade Level 1                           */
+#define BENCH_NFCA_CMD_SLP          0x50U     /*!< SLP_REQ (HLTA)                                            */
+#define BENCH_NFCA_SEL_PAR          0x70U     /*!< SEL_PAR of a SEL_REQ (complete NFCID1 CLn)                */
+#define BENCH_NFCA_CT               0x88U     /*!< Cascade Tag                                               */
+#define BENCH_NFCA_MFR_NXP          0x04U     /*!< Manufacturer code of the 7 bytes UIDs                     */
+#define BENCH_NFCA_SAK_CASCADE      0x04U     /*!< SAK: UID not complete                                     */
+#define BENCH_NFCA_SAK_T2T          0x00U     /*!< SAK: T2T                                                  */
+
+#define BENCH_NFCA_SDD_REQ_LEN      2U        /*!< SEL_CMD and SEL_PAR                                       */
+#define BENCH_NFCA_CL_LEN           5U        /*!< NFCID1 CLn and BCC                                        */
+#define BENCH_NFCA_CL_BITS          40U       /*!< NFCID1 CLn and BCC in bits                                */
+#define BENCH_NFCA_SEL_REQ_LEN      7U        /*!< SEL_REQ length (CRC excluded)                             */
+#define BENCH_NFCA_SLP_REQ_LEN      2U        /*!< SLP_REQ length (CRC excluded)                             */
+
+#define benchBit( buf, n )          (((buf)[(n) / 8U] >> ((n) % 8U)) & 1U)  /*!< Bit n of buf, LSB first as on air */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! ISO14443-3 Type A PICC states */
+typedef enum
+{
+    BENCH_NFCA_IDLE,                          /*!< Powered, answers REQA and WUPA                            */
+    BENCH_NFCA_READY,                         /*!< Anticollision/selection ongoing                           */
+    BENCH_NFCA_ACTIVE,                        /*!< Selected                                                  */
+    BENCH_NFCA_HALT                           /*!< Halted, answers WUPA only                                 */
+} benchNfcaState;
+
+
+/*! Simulated ISO14443A tag */
+typedef struct
+{
+    uint8_t        uid[RFAL_NFCA_CASCADE_3_UID_LEN]; /*!< UID                                                */
+    uint8_t        uidLen;                    /*!< UID length: 4, 7 or 10                                    */
+    uint8_t        clNum;                     /*!< Number of Cascade Levels                                  */
+    uint8_t        cl;                        /*!< Cascade Level being resolved                              */
+    benchNfcaState state;                     /*!< PICC state                                                */
+} benchNfcaCard;
+
+
+/*! Averages over all trials of one population */
+typedef struct
+{
+    double found;                             /*!< Distinct UIDs of the field resolved                       */
+    double frames;                            /*!< Frames sent by the poller                                 */
+    double airTime;                           /*!< Air time [us]                                             */
+} benchResult;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static benchNfcaCard gCard[BENCH_DEV_MAX];
+static uint8_t       gCardCnt;
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+static void benchNfcaSetup( uint8_t cnt, uint8_t uidLen )
+{
+    uint8_t i;
+    uint8_t j;
+
+    gCardCnt = cnt;
+    for( i = 0; i < cnt; i++ )
+    {
+        for( j = 0; j < uidLen; j++ )
+        {
+            gCard[i].uid[j] = (uint8_t)benchRand();
+        }
+
+        if( uidLen == RFAL_NFCA_CASCADE_1_UID_LEN )
+        {
+            gCard[i].uid[0] &= 0x7FU;                                 /* Never a Cascade Tag    */
+            gCard[i].uid[3]  = i;                                     /* Keeps the UIDs unique  */
+        }
+        else
+        {
+            gCard[i].uid[0]  = BENCH_NFCA_MFR_NXP;
+            gCard[i].uid[3] &= 0x7FU;                                 /* Never a Cascade Tag    */
+            gCard[i].uid[6]  = i;
+        }
+
+        gCard[i].uidLen = uidLen;
+        gCard[i].clNum  = ((uidLen == RFAL_NFCA_CASCADE_1_UID_LEN) ? 1U : ((uidLen == RFAL_NFCA_CASCADE_2_UID_LEN) ? 2U : 3U));
+        gCard[i].cl     = 0;
+        gCard[i].state  = BENCH_NFCA_IDLE;
+    }
+}
+
+
+/*******************************************************************************/
+/* NFCID1 CLn and BCC of a tag   Digital 1.1  Table 18 */
+static void benchNfcaClData( const benchNfcaCard *card, uint8_t cl, uint8_t *data )
+{
+    uint8_t i;
+    uint8_t off;
+
+    off = (uint8_t)(cl * 3U);
+    if( (cl + 1U) < card->clNum )
+    {
+        data[0] = BENCH_NFCA_CT;
+        ST_MEMCPY( &data[1], &card->uid[off], 3U );
+    }
+    else
+    {
+        ST_MEMCPY( data, &card->uid[off], 4U );
+    }
+
+    data[4] = 0;
+    for( i = 0; i < 4U; i++ )
+    {
+        data[4] ^= data[i];
+    }
+}
+
+
+/*******************************************************************************/
+/* REQA wakes up all tags not in HALT, WUPA all of them. A tag in READY or ACTIVE
+ * restarts its anticollision, as relied on by the poller when backtracking     */
+static ReturnCode benchNfcaShortFrame( uint8_t cmd, uint8_t *rxBuf, uint16_t *rxLen )
+{
+    uint8_t  i;
+    uint16_t atqa;
+    uint16_t cardAtqa;
+    bool     isColl;
+    bool     isAnswer;
+
+    atqa     = 0;
+    isColl   = false;
+    isAnswer = false;
+
+    for( i = 0; i < gCardCnt; i++ )
+    {
+        if( (gCard[i].state == BENCH_NFCA_HALT) && (cmd != BENCH_NFCA_CMD_WUPA) )
+        {
+            continue;
+        }
+
+        gCard[i].state = BENCH_NFCA_READY;
+        gCard[i].cl    = 0;
+
+        /* UID size in b8-b7, bit frame anticollision in b3 */
+        cardAtqa = (uint16_t)(((uint16_t)(gCard[i].clNum - 1U) << 6U) | 0x04U);
+        isColl   = (isColl || (isAnswer && (cardAtqa != atqa)));
+        atqa     = cardAtqa;
+        isAnswer = true;
+    }
+
+    if( !isAnswer )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    rxBuf[0] = (uint8_t)(atqa & 0xFFU);
+    rxBuf[1] = (uint8_t)(atqa >> 8U);
+    *rxLen   = (uint16_t)rfalConvBytesToBits( 2U );
+
+    return (isColl ? ERR_RF_COLLISION : ERR_NONE);
+}
+
+
+/*******************************************************************************/
+/* Tags in READY on the Cascade Level whose NFCID1 CLn matches the bits sent answer
+ * with the remaining bits. The first bit on which they differ is a collision    */
+static ReturnCode benchNfcaAnticol( uint8_t *buf, uint8_t *bytesToSend, uint8_t *bitsToSend, uint16_t *rxLen )
+{
+    uint8_t  data[BENCH_DEV_MAX][BENCH_NFCA_CL_LEN];
+    uint8_t  respCnt;
+    uint8_t  cl;
+    uint8_t  i;
+    uint16_t n;
+    uint16_t b;
+    uint16_t p;
+
+    cl = (uint8_t)((buf[0] - BENCH_NFCA_CMD_SEL_CL1) / 2U);
+    n  = (uint16_t)((rfalConvBytesToBits( *bytesToSend ) - rfalConvBytesToBits( BENCH_NFCA_SDD_REQ_LEN )) + *bitsToSend);
+
+    respCnt = 0;
+    for( i = 0; i < gCardCnt; i++ )
+    {
+        if( (gCard[i].state != BENCH_NFCA_READY) || (gCard[i].cl != cl) )
+        {
+            continue;
+        }
+
+        benchNfcaClData( &gCard[i], cl, data[respCnt] );
+        for( b = 0; b < n; b++ )
+        {
+            if( benchBit( data[respCnt], b ) != benchBit( &buf[BENCH_NFCA_SDD_REQ_LEN], b ) )
+            {
+                break;
+            }
+        }
+
+        if( b == n )
+        {
+            respCnt++;
+        }
+    }
+    if( respCnt == 0U )
+    {
+        return ERR_TIMEOUT;
+    }
+
+    /* First bit on which the responses differ */
+    for( p = n; p < BENCH_NFCA_CL_BITS; p++ )
+    {
+        for( i = 1; i < respCnt; i++ )
+        {
+            if( benchBit( data[i], p ) != benchBit( data[0], p ) )
+            {
+                break;
+            }
+        }
+        if( i < respCnt )
+        {
+            break;
+        }
+    }
+
+    if( p == BENCH_NFCA_CL_BITS )
+    {
+        ST_MEMCPY( &buf[BENCH_NFCA_SDD_REQ_LEN], data[0], BENCH_NFCA_CL_LEN );
+        *rxLen = (uint16_t)(BENCH_NFCA_CL_BITS - n);
+        return ERR_NONE;
+    }
+
+    /* Bits received before the collision, the position is reported as the bytes/bits valid */
+    for( b = n; b < p; b++ )
+    {
+        if( benchBit( data[0], b ) != 0U )
+        {
+            buf[BENCH_NFCA_SDD_REQ_LEN + (b / 8U)] |= (uint8_t)(1U << (b % 8U));
+        }
+        else
+        {
+            buf[BENCH_NFCA_SDD_REQ_LEN + (b / 8U)] &= (uint8_t)~(1U << (b % 8U));
+        }
+    }
+
+    *bytesToSend = (uint8_t)(BENCH_NFCA_SDD_REQ_LEN + (p / 8U));
+    *bitsToSend  = (uint8_t)(p % 8U);
+    *rxLen       = (uint16_t)(p - n);
+
+    return ERR_RF_COLLISION;
+}
+
+
+/*******************************************************************************/
+/* SEL_REQ selects the matching tag, the other tags in READY go back to IDLE.
+ * SLP_REQ halts the tag in ACTIVE                                             */
+static ReturnCode benchNfcaTxRx( const uint8_t *txBuf, uint16_t txLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen )
+{
+    uint8_t    data[BENCH_NFCA_CL_LEN];
+    uint8_t    cl;
+    uint8_t    i;
+    ReturnCode ret;
+
+    ret = ERR_TIMEOUT;
+
+    if( (txLen == BENCH_NFCA_SEL_REQ_LEN) && (txBuf[1] == BENCH_NFCA_SEL_PAR) && (rxBufLen >= 1U) )
+    {
+        cl = (uint8_t)((txBuf[0] - BENCH_NFCA_CMD_SEL_CL1) / 2U);
+
+        for( i = 0; i < gCardCnt; i++ )
+        {
+            if( gCard[i].state != BENCH_NFCA_READY )
+            {
+                continue;
+            }
+
+            benchNfcaClData( &gCard[i], gCard[i].cl, data );
+            if( (gCard[i].cl != cl) || (ST_BYTECMP( data, &txBuf[BENCH_NFCA_SDD_REQ_LEN], BENCH_NFCA_CL_LEN ) != 0) )
+            {
+                gCard[i].state = BENCH_NFCA_IDLE;
+                continue;
+            }
+
+            gCard[i].cl++;
+            if( gCard[i].cl < gCard[i].clNum )
+            {
+                rxBuf[0] = BENCH_NFCA_SAK_CASCADE;
+            }
+            else
+            {
+                rxBuf[0]       = BENCH_NFCA_SAK_T2T;
+                gCard[i].state = BENCH_NFCA_ACTIVE;
+            }
+            *rxLen = 1U;
+            ret    = ERR_NONE;
+        }
+    }
+    else if( (txLen == BENCH_NFCA_SLP_REQ_LEN) && (txBuf[0] == BENCH_NFCA_CMD_SLP) )
+    {
+        for( i = 0; i < gCardCnt; i++ )
+        {
+            if( gCard[i].state == BENCH_NFCA_ACTIVE )
+            {
+                gCard[i].state = BENCH_NFCA_HALT;
+            }
+            else if( gCard[i].state == BENCH_NFCA_READY )
+            {
+                gCard[i].state = BENCH_NFCA_IDLE;
+            }
+            else
+            {
+                /* MISRA 15.7 - Empty else */
+            }
+        }
+    }
+    else
+    {
+        /* Not supported by the tags */
+    }
+
+    return ret;
+}
+
+
+/*******************************************************************************/
+/* Counts the tags of the field resolved, each one once */
+static uint8_t benchNfcaFound( const rfalNfcaListenDevice *devList, uint8_t devCnt )
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t found;
+    bool    isFound[BENCH_DEV_MAX];
+
+    found = 0;
+    ST_MEMSET( isFound, 0x00, sizeof(isFound) );
+
+    for( i = 0; i < devCnt; i++ )
+    {
+        for( j = 0; j < gCardCnt; j++ )
+        {
+            if( !isFound[j] && (devList[i].nfcId1Len == gCard[j].uidLen) && (ST_BYTECMP( devList[i].nfcId1, gCard[j].uid, gCard[j].uidLen ) == 0) )
+            {
+                isFound[j] = true;
+                found++;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+
+/*******************************************************************************/
+static void benchNfca( uint32_t trials, uint8_t uidLen )
+{
+    static const benchRfPopulation pop = { benchNfcaTxRx, NULL, benchNfcaShortFrame, benchNfcaAnticol };
+    rfalNfcaListenDevice devList[BENCH_DEV_MAX];
+    rfalNfcaSensRes      sensRes;
+    benchResult          res;
+    uint8_t              devCnt;
+    uint8_t              cards;
+    uint32_t             t;
+    uint32_t             start;
+    uint32_t             frames;
+
+    benchRfSetPopulation( &pop );
+
+    printf( "\nNFC-A full collision resolution, %u bytes UIDs, collision tree %s, %u trials per population\n",
+            uidLen, ((bool)RFAL_NFCA_CR_PIPELINE ? "kept" : "restarted"), (unsigned)trials );
+    printf( "  tags |  found | frames | frames/UID |  air [ms] | us/UID\n" );
+
+    for( cards = BENCH_DEV_MIN; cards <= BENCH_DEV_MAX; cards++ )
+    {
+        ST_MEMSET( &res, 0x00, sizeof(benchResult) );
+
+        for( t = 0; t < trials; t++ )
+        {
+            benchNfcaSetup( cards, uidLen );
+            benchRfResetTime();
+
+            /* Technology Detection as done by the NFC layer, the resolution is measured from the ALL_REQ */
+            rfalNfcaPollerInitialize();
+            rfalNfcaPollerTechnologyDetection( RFAL_COMPLIANCE_MODE_NFC, &sensRes );
+            start  = benchRfGetTime();
+            frames = benchRfGetFrameCnt();
+
+            devCnt = 0;
+            rfalNfcaPollerFullCollisionResolution( RFAL_COMPLIANCE_MODE_NFC, BENCH_DEV_MAX, devList, &devCnt );
+
+            res.found   += benchNfcaFound( devList, devCnt );
+            res.frames  += (benchRfGetFrameCnt() - frames);
+            res.airTime += (benchRfGetTime() - start);
+        }
+
+        printf( "  %4u | %6.2f | %6.1f | %10.2f | %9.2f | %6.0f\n", cards, (res.found / trials), (res.frames / trials),
+                (res.frames / res.found), ((res.airTime / trials) / 1000.0), (res.airTime / res.found) );
+    }
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+int main( int argc, char **argv )
+{
+    uint32_t trials;
+
+    trials = ((argc > 1) ? (uint32_t)strtoul( argv[1], NULL, 0 ) : BENCH_TRIALS);
+    benchSeed( ((argc > 2) ? (uint32_t)strtoul( argv[2], NULL, 0 ) : 0U) );
+
+    if( trials == 0U )
+    {
+        trials = BENCH_TRIALS;
+    }
+
+    benchNfca( trials, RFAL_NFCA_CASCADE_1_UID_LEN );
+    benchNfca( trials, RFAL_NFCA_CASCADE_2_UID_LEN );
+
+    return 0;
+}
@@ -0,0 +1,608 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_rf.c
+ *
+ *  \author
+ *
+ *  \brief Host simulation of the RF layer used by the RFAL benchmarks
+ *
+ *  Only the RF layer and platform timer entry points used by the poller
+ *  modules under benchmark are provided. Every exchange is concluded
+ *  when it is started, the Get Status functions only report its result.
+ *  Only rfalStartTransceive() defers it to the first status check, as the
+ *  caller may reuse the received length until the reception completes.
+ *
+ */
+
+/*
+ ******************************************************************************
+ * INCLUDES
+ ******************************************************************************
+ */
+#include "bench_rf.h"
+#include "rfal_t1t.h"
+#include "pltf_timer.h"
+#include "utils.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL DEFINES
+ ******************************************************************************
+ */
+
+#define BENCH_FC_HZ                 13560000U /*!< Carrier frequency                                         */
+#define BENCH_CRC_LEN               2U        /*!< CRC appended to standard frames                           */
+#define BENCH_FDT_LISTEN_MIN        1024U     /*!< FDT(Listen) applied when none has been set (1/fc)         */
+
+#define BENCH_NFCA_BIT              128U      /*!< NFC-A 106 kbps bit duration (1/fc), halved per bit rate   */
+#define BENCH_NFCA_BYTE_BITS        9U        /*!< Byte and parity bit                                       */
+#define BENCH_NFCA_SOF_EOF_BITS     2U        /*!< Start and End of communication                            */
+#define BENCH_NFCA_SHORT_BITS       7U        /*!< REQA/WUPA short frame                                     */
+#define BENCH_NFCA_SENS_RES_LEN     2U        /*!< SENS_RES (ATQA) length                                    */
+#define BENCH_NFCA_SDD_BITS         56U       /*!< Complete SDD_REQ/SDD_RES frame (SEL_CMD to BCC)           */
+
+#define BENCH_NFCB_ETU              128U      /*!< NFC-B 106 kbps etu (1/fc), halved per bit rate            */
+#define BENCH_NFCB_BYTE_ETU         10U       /*!< Start bit, byte and stop bit                              */
+#define BENCH_NFCB_SOF_EOF_ETU      23U       /*!< SOF (12 etu) and EOF (11 etu)                             */
+
+#define BENCH_NFCF_BIT              64U       /*!< NFC-F 212 kbps bit duration (1/fc), 424 not simulated     */
+#define BENCH_NFCF_HDR_LEN          9U        /*!< Preamble (6), SYNC (2) and LEN (1)                        */
+
+#define BENCH_FELICA_POLL_DELAY     512U      /*!< FeliCa Poll processing time (64/fc)   Digital 1.1 A4      */
+#define BENCH_FELICA_POLL_SLOT      256U      /*!< FeliCa Poll Time Slot duration (64/fc) Digital 1.1 A4     */
+
+
+/*
+ ******************************************************************************
+ * GLOBAL TYPES
+ ******************************************************************************
+ */
+
+/*! Simulated RF layer context */
+typedef struct
+{
+    uint64_t                 now;          /*!< Simulated time (1/fc)                                        */
+    uint32_t                 frameCnt;     /*!< Frames sent by the poller                                    */
+    rfalMode                 mode;         /*!< Current mode                                                 */
+    rfalBitRate              br;           /*!< Current bit rate, same in both directions                    */
+    uint32_t                 gt;           /*!< Guard Time (1/fc)                                            */
+    uint32_t                 fdtListen;    /*!< FDT(Listen) (1/fc)                                           */
+    uint32_t                 fdtPoll;      /*!< FDT(Poll) (1/fc)                                             */
+    ReturnCode               status;       /*!< Result of the last exchange                                  */
+    rfalTransceiveContext    ctx;          /*!< Exchange started by rfalStartTransceive()                    */
+    bool                     ctxPending;   /*!< ctx not concluded yet                                        */
+    const benchRfPopulation *pop;          /*!< Devices in the field                                         */
+    uint32_t                 rnd;          /*!< Pseudo random generator state                                */
+} benchRf;
+
+
+/*
+ ******************************************************************************
+ * LOCAL VARIABLES
+ ******************************************************************************
+ */
+
+static benchRf gBench = { 0U, 0U, RFAL_MODE_NONE, RFAL_BR_106, 0U, 0U, 0U, ERR_NONE, { NULL, 0U, NULL, 0U, NULL, 0U, 0U }, false, NULL, 0x2545F491U };
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTION PROTOTYPES
+ ******************************************************************************
+ */
+
+static uint32_t benchRfFrameTime( uint16_t len );
+static uint32_t benchRfBitFrameTime( uint16_t bits );
+static void     benchRfTxRx( uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t fwt );
+
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+/* Duration of a standard frame of len bytes (CRC excluded) in the current mode */
+static uint32_t benchRfFrameTime( uint16_t len )
+{
+    switch( gBench.mode )
+    {
+        case RFAL_MODE_POLL_NFCA:
+        case RFAL_MODE_POLL_NFCA_T1T:
+            return (((((uint32_t)len + BENCH_CRC_LEN) * BENCH_NFCA_BYTE_BITS) + BENCH_NFCA_SOF_EOF_BITS) * (BENCH_NFCA_BIT >> (uint8_t)gBench.br));
+
+        case RFAL_MODE_POLL_NFCB:
+            return (((((uint32_t)len + BENCH_CRC_LEN) * BENCH_NFCB_BYTE_ETU) + BENCH_NFCB_SOF_EOF_ETU) * (BENCH_NFCB_ETU >> (uint8_t)gBench.br));
+
+        case RFAL_MODE_POLL_NFCF:
+            return ((((uint32_t)len + BENCH_CRC_LEN + BENCH_NFCF_HDR_LEN) * RFAL_BITS_IN_BYTE) * BENCH_NFCF_BIT);
+
+        default:
+            return 0U;
+    }
+}
+
+
+/*******************************************************************************/
+/* Duration of an NFC-A bit oriented frame (no CRC): parity after each complete byte */
+static uint32_t benchRfBitFrameTime( uint16_t bits )
+{
+    return ((((uint32_t)bits + ((uint32_t)bits / RFAL_BITS_IN_BYTE)) + BENCH_NFCA_SOF_EOF_BITS) * BENCH_NFCA_BIT);
+}
+
+
+/*******************************************************************************/
+static void benchRfTxRx( uint8_t *txBuf, uint16_t txBufLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *actLen, uint32_t fwt )
+{
+    uint8_t  dummy[RFAL_FEATURE_NFC_RF_BUF_LEN];
+    uint16_t rxLen;
+
+    rxLen = 0;
+
+    /* FDT(Poll) from the previous frame, then the command itself */
+    gBench.now += (gBench.fdtPoll + benchRfFrameTime( txBufLen ));
+    gBench.frameCnt++;
+
+    gBench.status = ERR_TIMEOUT;
+    if( (gBench.pop != NULL) && (gBench.pop->txRx != NULL) )
+    {
+        /* Devices answer even if the poller does not wait for it (e.g. SLPB_REQ) */
+        gBench.status = gBench.pop->txRx( txBuf, txBufLen, ((rxBuf != NULL) ? rxBuf : dummy), ((rxBuf != NULL) ? rxBufLen : (uint16_t)sizeof(dummy)), &rxLen );
+    }
+
+    if( gBench.status == ERR_TIMEOUT )
+    {
+        rxLen        = 0;
+        gBench.now  += ((fwt == RFAL_FWT_NONE) ? 0U : fwt);
+    }
+    else if( rxBuf != NULL )
+    {
+        gBench.now  += (MAX( gBench.fdtListen, BENCH_FDT_LISTEN_MIN ) + benchRfFrameTime( rxLen ));
+    }
+    else
+    {
+        /* Tx only, the response is not awaited */
+        gBench.status = ERR_NONE;
+    }
+
+    if( actLen != NULL )
+    {
+        *actLen = rxLen;
+    }
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+void benchRfSetPopulation( const benchRfPopulation *pop )
+{
+    gBench.pop = pop;
+}
+
+
+/*******************************************************************************/
+uint32_t benchRfGetTime( void )
+{
+    return (uint32_t)((gBench.now * 1000000U) / BENCH_FC_HZ);
+}
+
+
+/*******************************************************************************/
+void benchRfResetTime( void )
+{
+    gBench.now      = 0U;
+    gBench.frameCnt = 0U;
+}
+
+
+/*******************************************************************************/
+uint32_t benchRfGetFrameCnt( void )
+{
+    return gBench.frameCnt;
+}
+
+
+/*******************************************************************************/
+void benchRfDelay( uint32_t us )
+{
+    gBench.now += (((uint64_t)us * BENCH_FC_HZ) / 1000000U);
+}
+
+
+/*******************************************************************************/
+uint32_t benchRand( void )
+{
+    gBench.rnd ^= (gBench.rnd << 13U);
+    gBench.rnd ^= (gBench.rnd >> 17U);
+    gBench.rnd ^= (gBench.rnd << 5U);
+
+    return gBench.rnd;
+}
+
+
+/*******************************************************************************/
+void benchSeed( uint32_t seed )
+{
+    gBench.rnd = ((seed != 0U) ? seed : 0x2545F491U);
+}
+
+
+/*
+ ******************************************************************************
+ * PLATFORM TIMERS (simulated time)
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+uint32_t platformGetSysTick_zephyr( void )
+{
+    return (benchRfGetTime() / RFAL_US_IN_MS);
+}
+
+
+/*******************************************************************************/
+uint32_t timerCalculateTimer( uint16_t time )
+{
+    return (benchRfGetTime() + ((uint32_t)time * RFAL_US_IN_MS));
+}
+
+
+/*******************************************************************************/
+bool timerIsExpired( uint32_t timer )
+{
+    /* Whoever polls a timer waits for it: jump to its expiration */
+    if( benchRfGetTime() < timer )
+    {
+        gBench.now = ((((uint64_t)timer * BENCH_FC_HZ) + 999999U) / 1000000U);
+    }
+    return true;
+}
+
+
+/*******************************************************************************/
+void timerDelay( uint16_t time )
+{
+    gBench.now += (((uint64_t)time * BENCH_FC_HZ) / RFAL_US_IN_MS);
+}
+
+
+/*******************************************************************************/
+uint32_t timerGetCycles( void )
+{
+    return benchRfGetTime();
+}
+
+
+/*******************************************************************************/
+uint32_t timerCyclesToUs( uint32_t cycles )
+{
+    return cycles;
+}
+
+
+/*
+ ******************************************************************************
+ * RF LAYER (simulated)
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+ReturnCode rfalSetMode( rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR )
+{
+    NO_WARNING( rxBR );
+
+    gBench.mode = mode;
+    gBench.br   = txBR;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalSetBitRate( rfalBitRate txBR, rfalBitRate rxBR )
+{
+    NO_WARNING( rxBR );
+
+    if( txBR != RFAL_BR_KEEP )
+    {
+        gBench.br = txBR;
+    }
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void rfalSetErrorHandling( rfalEHandling eHandling )
+{
+    NO_WARNING( eHandling );
+}
+
+
+/*******************************************************************************/
+void rfalSetFDTPoll( uint32_t FDTPoll )
+{
+    gBench.fdtPoll = FDTPoll;
+}
+
+
+/*******************************************************************************/
+void rfalSetFDTListen( uint32_t FDTListen )
+{
+    gBench.fdtListen = FDTListen;
+}
+
+
+/*******************************************************************************/
+uint32_t rfalGetFDTPoll( void )
+{
+    return gBench.fdtPoll;
+}
+
+
+/*******************************************************************************/
+void rfalSetGT( uint32_t GT )
+{
+    gBench.gt = GT;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalFieldOnAndStartGT( void )
+{
+    /* The field is always on, the next frame waits for the whole GT */
+    gBench.now += gBench.gt;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void rfalWorker( void )
+{
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalGetTransceiveStatus( void )
+{
+    uint16_t rxLen;
+
+    if( gBench.ctxPending )
+    {
+        gBench.ctxPending = false;
+
+        /* Context lengths are in bits */
+        benchRfTxRx( gBench.ctx.txBuf, (uint16_t)rfalConvBitsToBytes( gBench.ctx.txBufLen ), gBench.ctx.rxBuf, (uint16_t)rfalConvBitsToBytes( gBench.ctx.rxBufLen ), &rxLen, gBench.ctx.fwt );
+
+        if( gBench.ctx.rxRcvdLen != NULL )
+        {
+            *gBench.ctx.rxRcvdLen = (uint16_t)rfalConvBytesToBits( rxLen );
+        }
+    }
+
+    return gBench.status;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalStartTransceive( const rfalTransceiveContext *ctx )
+{
+    if( ctx == NULL )
+    {
+        return ERR_PARAM;
+    }
+
+    gBench.ctx        = *ctx;
+    gBench.ctxPending = true;
+    gBench.status     = ERR_BUSY;
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+bool rfalIsTransceiveInTx( void )
+{
+    return false;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalTransceiveBlockingTx( uint8_t* txBuf, uint16_t txBufLen, uint8_t* rxBuf, uint16_t rxBufLen, uint16_t* actLen, uint32_t flags, uint32_t fwt )
+{
+    NO_WARNING( flags );
+
+    benchRfTxRx( txBuf, txBufLen, rxBuf, rxBufLen, actLen, fwt );
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalTransceiveBlockingTxRx( uint8_t* txBuf, uint16_t txBufLen, uint8_t* rxBuf, uint16_t rxBufLen, uint16_t* actLen, uint32_t flags, uint32_t fwt )
+{
+    NO_WARNING( flags );
+
+    benchRfTxRx( txBuf, txBufLen, rxBuf, rxBufLen, actLen, fwt );
+    return gBench.status;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443ATransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt )
+{
+    ReturnCode ret;
+
+    EXIT_ON_ERR( ret, rfalISO14443AStartTransceiveShortFrame( txCmd, rxBuf, rxBufLen, rxRcvdLen, fwt ) );
+    return rfalISO14443AGetTransceiveShortFrameStatus();
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443AStartTransceiveShortFrame( rfal14443AShortFrameCmd txCmd, uint8_t* rxBuf, uint8_t rxBufLen, uint16_t* rxRcvdLen, uint32_t fwt )
+{
+    uint16_t rxLen;
+
+    if( (rxBuf == NULL) || (rxBufLen < rfalConvBytesToBits( BENCH_NFCA_SENS_RES_LEN )) )
+    {
+        return ERR_PARAM;
+    }
+
+    rxLen = 0;
+    gBench.now += (gBench.fdtPoll + benchRfBitFrameTime( BENCH_NFCA_SHORT_BITS ));
+    gBench.frameCnt++;
+
+    gBench.status = ERR_TIMEOUT;
+    if( (gBench.pop != NULL) && (gBench.pop->shortFrame != NULL) )
+    {
+        gBench.status = gBench.pop->shortFrame( (uint8_t)txCmd, rxBuf, &rxLen );
+    }
+
+    /* SENS_RES is a bit oriented frame (no CRC), rxLen in bits */
+    gBench.now += ((gBench.status == ERR_TIMEOUT) ? fwt : (MAX( gBench.fdtListen, BENCH_FDT_LISTEN_MIN ) + benchRfBitFrameTime( rfalConvBytesToBits( BENCH_NFCA_SENS_RES_LEN ) )));
+
+    if( rxRcvdLen != NULL )
+    {
+        *rxRcvdLen = ((gBench.status == ERR_TIMEOUT) ? 0U : rxLen);
+    }
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443AGetTransceiveShortFrameStatus( void )
+{
+    return gBench.status;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalISO14443ATransceiveAnticollisionFrame( uint8_t *buf, uint8_t *bytesToSend, uint8_t *bitsToSend, uint16_t *rxLength, uint32_t fwt )
+{
+    uint16_t txBits;
+
+    if( (buf == NULL) || (bytesToSend == NULL) || (bitsToSend == NULL) || (rxLength == NULL) )
+    {
+        return ERR_PARAM;
+    }
+
+    txBits    = (uint16_t)(rfalConvBytesToBits( *bytesToSend ) + *bitsToSend);
+    *rxLength = 0;
+
+    gBench.now += (gBench.fdtPoll + benchRfBitFrameTime( txBits ));
+    gBench.frameCnt++;
+
+    gBench.status = ERR_TIMEOUT;
+    if( (gBench.pop != NULL) && (gBench.pop->anticol != NULL) )
+    {
+        gBench.status = gBench.pop->anticol( buf, bytesToSend, bitsToSend, rxLength );
+    }
+
+    /* The colliding devices still transmit the complete SDD_RES */
+    gBench.now += ((gBench.status == ERR_TIMEOUT) ? fwt : (MAX( gBench.fdtListen, BENCH_FDT_LISTEN_MIN ) + benchRfBitFrameTime( (uint16_t)(BENCH_NFCA_SDD_BITS - txBits) )));
+
+    return gBench.status;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalFeliCaPoll( rfalFeliCaPollSlots slots, uint16_t sysCode, uint8_t reqCode, rfalFeliCaPollRes* pollResList, uint8_t pollResListSize, uint8_t *devicesDetected, uint8_t *collisionsDetected )
+{
+    ReturnCode ret;
+
+    EXIT_ON_ERR( ret, rfalStartFeliCaPoll( slots, sysCode, reqCode, pollResList, pollResListSize, devicesDetected, collisionsDetected ) );
+    return rfalGetFeliCaPollStatus();
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalStartFeliCaPoll( rfalFeliCaPollSlots slots, uint16_t sysCode, uint8_t reqCode, rfalFeliCaPollRes* pollResList, uint8_t pollResListSize, uint8_t *devicesDetected, uint8_t *collisionsDetected )
+{
+    uint8_t found;
+    uint8_t coll;
+
+    NO_WARNING( sysCode );
+    NO_WARNING( reqCode );
+
+    /* TSN is a single slot code on the air, 16 slots at most */
+    if( ((uint8_t)slots >= RFAL_FELICA_POLL_MAX_SLOTS) || (pollResListSize > RFAL_FELICA_POLL_MAX_SLOTS) )
+    {
+        return ERR_PARAM;
+    }
+
+    found = 0;
+    coll  = 0;
+
+    /* SENSF_REQ (CMD, SC, RC, TSN), the whole response window is always awaited */
+    gBench.now += (gBench.fdtPoll + benchRfFrameTime( 5U ));
+    gBench.now += ((BENCH_FELICA_POLL_DELAY + (BENCH_FELICA_POLL_SLOT * ((uint32_t)slots + 1U))) * RFAL_1FC_IN_64FC);
+    gBench.frameCnt++;
+
+    if( (gBench.pop != NULL) && (gBench.pop->feliCaPoll != NULL) )
+    {
+        found = gBench.pop->feliCaPoll( (uint8_t)slots, pollResList, pollResListSize, &coll );
+    }
+
+    if( devicesDetected != NULL )
+    {
+        *devicesDetected = found;
+    }
+    if( collisionsDetected != NULL )
+    {
+        *collisionsDetected = coll;
+    }
+
+    gBench.status = (((found != 0U) || (coll != 0U)) ? ERR_NONE : ERR_TIMEOUT);
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalGetFeliCaPollStatus( void )
+{
+    return gBench.status;
+}
+
+
+/*
+ ******************************************************************************
+ * MODULES NOT UNDER BENCHMARK
+ ******************************************************************************
+ */
+
+/*******************************************************************************/
+ReturnCode rfalT1TPollerInitialize( void )
+{
+    return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode rfalT1TPollerRid( rfalT1TRidRes *ridRes )
+{
+    NO_WARNING( ridRes );
+
+    return ERR_TIMEOUT;
+}
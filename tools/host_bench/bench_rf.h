@@ -0,0 +1,149 @@
+/******************************************************************************
+  * @attention
+  *
+  * COPYRIGHT 2019 STMicroelectronics, all rights reserved
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+
+/*
+ *      PROJECT:   ST25R firmware
+ *      Revision:
+ *      LANGUAGE:  ISO C99
+ */
+
+/*! \file bench_rf.h
+ *
+ *  \author
+ *
+ *  \brief Host simulation of the RF layer used by the RFAL benchmarks
+ *
+ *  Replaces the ST25R3916 RF layer and the platform timers so that the
+ *  RFAL poller modules can be compiled and run on a host. Time is a
+ *  simulated clock in microseconds which advances with the air time of
+ *  each exchange: frame durations at the bit rate of the current mode,
+ *  FDT(Listen) before a response and the full FWT upon a timeout.
+ *
+ *  The devices in the field are provided by the benchmark as a
+ *  benchRfPopulation, which answers each frame sent by the poller.
+ *
+ */
+
+#ifndef BENCH_RF_H
+#define BENCH_RF_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "rfal_rf.h"
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! Simulated devices in the field, each hook may be NULL if not used by the benchmark */
+typedef struct
+{
+    /*! Answers a standard frame. Returns ERR_NONE with the response, ERR_TIMEOUT if no one answers or ERR_CRC on a collision */
+    ReturnCode (*txRx)( const uint8_t *txBuf, uint16_t txLen, uint8_t *rxBuf, uint16_t rxBufLen, uint16_t *rxLen );
+
+    /*! Answers a FeliCa Poll on tsn+1 Time Slots. Returns the SENSF_RES received and places the slots with a collision on collisions */
+    uint8_t    (*feliCaPoll)( uint8_t tsn, rfalFeliCaPollRes *resList, uint8_t resListSize, uint8_t *collisions );
+
+    /*! Answers a REQA/WUPA. Returns ERR_NONE with the SENS_RES, ERR_TIMEOUT if no one answers or ERR_RF_COLLISION */
+    ReturnCode (*shortFrame)( uint8_t cmd, uint8_t *rxBuf, uint16_t *rxLen );
+
+    /*! Answers an SDD_REQ as rfalISO14443ATransceiveAnticollisionFrame(), rxLen in bits */
+    ReturnCode (*anticol)( uint8_t *buf, uint8_t *bytesToSend, uint8_t *bitsToSend, uint16_t *rxLen );
+} benchRfPopulation;
+
+
+/*
+******************************************************************************
+* GLOBAL FUNCTION PROTOTYPES
+******************************************************************************
+*/
+
+/*!
+ *****************************************************************************
+ * \brief  Set the simulated population
+ *
+ * \param[in] pop : devices answering the following frames, NULL for none
+ *****************************************************************************
+ */
+void benchRfSetPopulation( const benchRfPopulation *pop );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Get the simulated time
+ *
+ * \return time elapsed since the last benchRfResetTime(), in us
+ *****************************************************************************
+ */
+uint32_t benchRfGetTime( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Restart the simulated time and frame counter
+ *****************************************************************************
+ */
+void benchRfResetTime( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Get the number of frames sent by the poller
+ *
+ * \return frames sent since the last benchRfResetTime()
+ *****************************************************************************
+ */
+uint32_t benchRfGetFrameCnt( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Advance the simulated time
+ *
+ * Used by the simulated devices to account for their processing time
+ * before the response.
+ *
+ * \param[in] us : delay in us
+ *****************************************************************************
+ */
+void benchRfDelay( uint32_t us );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Pseudo random generator shared by the simulated populations
+ *
+ * \return next pseudo random value (xorshift32)
+ *****************************************************************************
+ */
+uint32_t benchRand( void );
+
+
+/*!
+ *****************************************************************************
+ * \brief  Seed the pseudo random generator
+ *
+ * \param[in] seed : seed value, 0 is replaced by a fixed non zero value
+ *****************************************************************************
+ */
+void benchSeed( uint32_t seed );
+
+#endif /* BENCH_RF_H */
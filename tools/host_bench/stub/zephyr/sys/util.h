@@ -0,0 +1 @@
+/* Host build of the RFAL benchmarks: stands in for the Zephyr header included by st25r3916_spi.h */
@@ -0,0 +1,2 @@
+/* Host build of the RFAL benchmarks: stands in for the Zephyr header included by st25r3916_spi.h */
+#include <stdint.h>